@@ -103,6 +103,7 @@ add_library(core
   fboss/agent/DHCPv4Handler.cpp
   fboss/agent/DHCPv6Handler.cpp
   fboss/agent/FibHelpers.cpp
+  fboss/agent/GleanTable.cpp
   fboss/agent/HwSwitch.cpp
   fboss/agent/IPHeaderV4.cpp
   fboss/agent/IPv4Handler.cpp
@@ -191,6 +192,7 @@ target_link_libraries(error
 
 add_library(handler
   fboss/agent/ThriftHandler.cpp
+  fboss/agent/ThriftReadSnapshots.cpp
 )
 
 target_link_libraries(handler
@@ -34,6 +34,10 @@ add_library(hw_port_fb303_stats
   fboss/agent/hw/oss/HwPortFb303Stats.cpp
 )
 
+add_library(hw_port_counter_store
+  fboss/agent/hw/HwPortCounterStore.cpp
+)
+
 add_library(hw_cpu_fb303_stats
   fboss/agent/hw/HwCpuFb303Stats.cpp
 )
@@ -52,6 +56,7 @@ add_library(hw_resource_stats_publisher
 
 target_link_libraries(hw_switch_warmboot_helper
   utils
+  json_file_writer
   Folly::folly
 )
 
@@ -74,6 +79,15 @@ target_link_libraries(hw_port_fb303_stats
   Folly::folly
 )
 
+target_link_libraries(hw_port_counter_store
+  columnar_counter_store
+  hw_port_fb303_stats
+  ctrl_cpp2
+  error
+  fb303::fb303
+  Folly::folly
+)
+
 target_link_libraries(hw_cpu_fb303_stats
   counter_utils
   FBThrift::thriftcpp2
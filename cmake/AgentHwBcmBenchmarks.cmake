@@ -202,6 +202,15 @@ target_link_libraries(bcm_warm_boot_exit_speed
   -Wl,--no-whole-archive
 )
 
+add_executable(bcm_warm_boot_entry_speed /dev/null)
+
+target_link_libraries(bcm_warm_boot_entry_speed
+  -Wl,--whole-archive
+  bcm_switch_ensemble
+  hw_warm_boot_entry_speed
+  -Wl,--no-whole-archive
+)
+
 add_executable(bcm_rx_slow_path_rate /dev/null)
 
 target_link_libraries(bcm_rx_slow_path_rate
@@ -283,6 +292,7 @@ if (BENCHMARK_INSTALL)
   install(TARGETS bcm_stats_collection_speed)
   install(TARGETS bcm_tx_slow_path_rate)
   install(TARGETS bcm_warm_boot_exit_speed)
+  install(TARGETS bcm_warm_boot_entry_speed)
   install(TARGETS bcm_rx_slow_path_rate)
   install(TARGETS bcm_init_and_exit_40Gx10G)
   install(TARGETS bcm_init_and_exit_100Gx10G)
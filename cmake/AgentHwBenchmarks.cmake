@@ -25,6 +25,16 @@ target_link_libraries(hw_warm_boot_exit_speed
   Folly::folly
 )
 
+add_library(hw_warm_boot_entry_speed
+  fboss/agent/hw/benchmarks/HwWarmbootEntryBenchmark.cpp
+)
+
+target_link_libraries(hw_warm_boot_entry_speed
+  hw_switch_ensemble
+  fb303::fb303
+  Folly::folly
+)
+
 add_library(hw_stats_collection_speed
   fboss/agent/hw/benchmarks/HwStatsCollectionBenchmark.cpp
 )
@@ -0,0 +1,23 @@
+# CMake to build libraries and binaries in fboss/agent/hw/sai/fake/tests
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(fake_sai_test
+    fboss/agent/test/oss/Main.cpp
+    fboss/agent/hw/sai/fake/tests/FakeSaiCostModelTest.cpp
+)
+
+target_link_libraries(fake_sai_test
+    fake_sai
+    ${GTEST}
+    ${LIBGMOCK_LIBRARIES}
+)
+
+set_target_properties(fake_sai_test PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+gtest_discover_tests(fake_sai_test)
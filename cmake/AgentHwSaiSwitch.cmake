@@ -70,6 +70,7 @@ target_link_libraries(sai_switch
   sai_api
   sai_store
   ref_map
+  hw_port_counter_store
   Folly::folly
   -Wl,--unresolved-symbols=report-all
 )
@@ -31,6 +31,26 @@ endfunction()
 
 BUILD_SAI_REPLAYER("fake" fake_sai)
 
+# Converts binary traces recorded with --enable_binary_replayer into the
+# replayable C code. Only needs an SAI implementation to satisfy the wrapped
+# sai_api_* symbols, so build it once against fake_sai.
+add_executable(sai_binary_trace_converter
+  fboss/agent/hw/sai/tracer/run/BinaryTraceConverter.cpp
+)
+
+target_link_libraries(sai_binary_trace_converter
+  sai_tracer
+  fake_sai
+  Folly::folly
+)
+
+set_target_properties(sai_binary_trace_converter
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
 # If libsai_impl is provided, build sai replayer linking with it
 find_library(SAI_IMPL sai_impl)
 message(STATUS "SAI_IMPL: ${SAI_IMPL}")
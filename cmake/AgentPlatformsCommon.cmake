@@ -25,6 +25,67 @@ target_link_libraries(platform_mapping
   ${RE2}
 )
 
+add_executable(platform_mapping_benchmark
+  fboss/agent/platforms/common/PlatformMappingBenchmark.cpp
+)
+
+target_link_libraries(platform_mapping_benchmark
+  minipack_platform_mapping
+  yamp_platform_mapping
+  Folly::folly
+  Folly::follybenchmark
+)
+
+add_executable(platform_mapping_compiler
+  fboss/agent/platforms/common/utils/PlatformMappingCompiler.cpp
+)
+
+target_link_libraries(platform_mapping_compiler
+  platform_config_cpp2
+  Folly::folly
+  FBThrift::thriftcpp2
+  ${RE2}
+)
+
+add_executable(platform_mapping_startup
+  fboss/agent/platforms/common/utils/PlatformMappingStartup.cpp
+)
+
+target_link_libraries(platform_mapping_startup
+  elbert_platform_mapping
+  fuji_platform_mapping
+  minipack_platform_mapping
+  wedge100_platform_mapping
+  wedge40_platform_mapping
+  wedge400_platform_mapping
+  wedge400c_platform_mapping
+  wedge400c_ebb_lab_platform_mapping
+  yamp_platform_mapping
+  Folly::folly
+)
+
+# Replace the JSON literals of a platform mapping source with a compact thrift
+# blob generated at build time, see PlatformMappingCompiler.cpp
+function(compile_platform_mapping target source)
+  if (NOT COMPILED_PLATFORM_MAPPINGS)
+    return()
+  endif()
+  string(REGEX REPLACE "\\.cpp$" ".compiled.h" compiled ${source})
+  get_filename_component(compiledDir ${CMAKE_BINARY_DIR}/${compiled} DIRECTORY)
+  add_custom_command(
+    OUTPUT ${CMAKE_BINARY_DIR}/${compiled}
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${compiledDir}
+    COMMAND platform_mapping_compiler
+      --input ${CMAKE_SOURCE_DIR}/${source}
+      --output ${CMAKE_BINARY_DIR}/${compiled}
+    DEPENDS platform_mapping_compiler ${CMAKE_SOURCE_DIR}/${source}
+    COMMENT "Compiling platform mapping ${source}"
+  )
+  target_sources(${target} PRIVATE ${CMAKE_BINARY_DIR}/${compiled})
+  target_include_directories(${target} PRIVATE ${CMAKE_BINARY_DIR})
+  target_compile_definitions(${target} PRIVATE FBOSS_COMPILED_PLATFORM_MAPPINGS)
+endfunction()
+
 add_library(wedge_led_utils
   fboss/agent/platforms/common/utils/GalaxyLedUtils.cpp
   fboss/agent/platforms/common/utils/Wedge100LedUtils.cpp
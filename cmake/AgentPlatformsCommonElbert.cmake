@@ -11,3 +11,7 @@ add_library(elbert_platform_mapping
 target_link_libraries(elbert_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(elbert_platform_mapping
+  fboss/agent/platforms/common/elbert/Elbert16QPimPlatformMapping.cpp
+)
@@ -11,3 +11,7 @@ add_library(minipack_platform_mapping
 target_link_libraries(minipack_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(minipack_platform_mapping
+  fboss/agent/platforms/common/minipack/Minipack16QPimPlatformMapping.cpp
+)
@@ -10,3 +10,7 @@ add_library(wedge100_platform_mapping
 target_link_libraries(wedge100_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(wedge100_platform_mapping
+  fboss/agent/platforms/common/wedge100/Wedge100PlatformMapping.cpp
+)
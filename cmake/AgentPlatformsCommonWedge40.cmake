@@ -10,3 +10,7 @@ add_library(wedge40_platform_mapping
 target_link_libraries(wedge40_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(wedge40_platform_mapping
+  fboss/agent/platforms/common/wedge40/Wedge40PlatformMapping.cpp
+)
@@ -10,3 +10,7 @@ add_library(wedge400_platform_mapping
 target_link_libraries(wedge400_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(wedge400_platform_mapping
+  fboss/agent/platforms/common/wedge400/Wedge400PlatformMapping.cpp
+)
@@ -11,6 +11,10 @@ target_link_libraries(wedge400c_platform_mapping
   platform_mapping
 )
 
+compile_platform_mapping(wedge400c_platform_mapping
+  fboss/agent/platforms/common/wedge400c/Wedge400CPlatformMapping.cpp
+)
+
 
 add_library(wedge400c_ebb_lab_platform_mapping
     fboss/agent/platforms/common/ebb_lab/Wedge400CEbbLabPlatformMapping.cpp
@@ -19,3 +23,7 @@ add_library(wedge400c_ebb_lab_platform_mapping
 target_link_libraries(wedge400c_ebb_lab_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(wedge400c_ebb_lab_platform_mapping
+  fboss/agent/platforms/common/ebb_lab/Wedge400CEbbLabPlatformMapping.cpp
+)
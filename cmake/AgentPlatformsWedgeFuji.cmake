@@ -11,3 +11,7 @@ add_library(fuji_platform_mapping
 target_link_libraries(fuji_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(fuji_platform_mapping
+  fboss/agent/platforms/wedge/fuji/Fuji16QPimPlatformMapping.cpp
+)
@@ -11,3 +11,7 @@ add_library(yamp_platform_mapping
 target_link_libraries(yamp_platform_mapping
   platform_mapping
 )
+
+compile_platform_mapping(yamp_platform_mapping
+  fboss/agent/platforms/common/yamp/Yamp16QPimPlatformMapping.cpp
+)
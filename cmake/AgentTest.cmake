@@ -71,6 +71,16 @@ target_link_libraries(async_logger_test
 
 gtest_discover_tests(async_logger_test)
 
+add_executable(async_logger_benchmark
+  fboss/agent/test/AsyncLoggerBenchmark.cpp
+)
+
+target_link_libraries(async_logger_benchmark
+  async_logger
+  Folly::folly
+  Folly::follybenchmark
+)
+
 if (NOT SAI_ONLY)
 add_executable(multi_node_test
   fboss/agent/test/MultiNodeTest.cpp
@@ -17,3 +17,15 @@ target_link_libraries(thrift_packet_stream_test
     ${GTEST}
     ${LIBGMOCK_LIBRARIES}
 )
+
+add_executable(thrift_packet_stream_benchmark
+    fboss/agent/thrift_packet_stream/tests/PacketStreamBenchmark.cpp
+)
+
+target_link_libraries(thrift_packet_stream_benchmark
+    Folly::folly
+    FBThrift::thriftcpp2
+    bidirectional_packet_stream
+    packet_stream_cpp2
+    Folly::follybenchmark
+)
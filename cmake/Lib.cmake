@@ -29,7 +29,24 @@ target_link_libraries(alert_logger
   Folly::folly
 )
 
+add_library(columnar_counter_store
+  fboss/lib/ColumnarCounterStore.cpp
+)
+
+target_link_libraries(columnar_counter_store
+  Folly::folly
+)
+
+add_library(json_file_writer
+  fboss/lib/JsonFileWriter.cpp
+)
+
+target_link_libraries(json_file_writer
+  Folly::folly
+)
+
 add_library(ref_map
+  fboss/lib/FixedSizeArena.h
   fboss/lib/RefMap.h
 )
 
@@ -65,6 +82,8 @@ add_library(fboss_i2c_lib
   fboss/lib/BmcRestClient.cpp
   fboss/lib/usb/CP2112.cpp
   fboss/lib/usb/CP2112.h
+  fboss/lib/usb/CP2112AsyncEngine.cpp
+  fboss/lib/usb/CP2112AsyncEngine.h
   fboss/lib/usb/PCA9548.cpp
   fboss/lib/usb/PCA9548MultiplexedBus.cpp
   fboss/lib/usb/PCA9548MuxedBus.cpp
@@ -5,6 +5,7 @@
 
 add_library(qsfp_lib
   fboss/qsfp_service/oss/StatsPublisher.cpp
+  fboss/qsfp_service/platforms/wedge/I2cTransactionScheduler.cpp
   fboss/qsfp_service/platforms/wedge/WedgeI2CBusLock.cpp
   fboss/qsfp_service/platforms/wedge/WedgeQsfp.cpp
   fboss/qsfp_service/lib/QsfpClient.cpp
@@ -0,0 +1,16 @@
+# CMake to build libraries and binaries in fboss/util
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(route_churn_generator
+  fboss/util/route_churn_generator.cpp
+)
+
+target_link_libraries(route_churn_generator
+  address_utils
+  ctrl_cpp2
+  error
+  Folly::folly
+  FBThrift::thriftcpp2
+)
@@ -53,6 +53,7 @@
 #include <folly/Range.h>
 #include <algorithm>
 #include <cmath>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -78,6 +79,139 @@ namespace {
 const uint8_t kV6LinkLocalAddrMask{64};
 // Needed until CoPP is removed from code and put into config
 const int kAclStartPriority = 100000;
+// Data plane ACL priorities are in (kAclStartPriority, kAclEndPriority), CPU
+// (CoPP) ACL priorities below kAclStartPriority.
+const int kAclEndPriority = 2 * kAclStartPriority;
+// Room left between consecutive ACL priorities, so an ACL inserted in a
+// policy can get a priority of its own instead of shifting all the ACLs
+// after it, each of which would be reprogrammed in hardware.
+const int kAclPriorityGap = 16;
+// Room left above the first ACL of a new layout, for ACLs added at the top
+const int kAclPriorityHeadroom = 256 * kAclPriorityGap;
+
+/*
+ * Mark the longest strictly increasing subsequence of the given values.
+ */
+std::vector<bool> longestIncreasing(
+    const std::vector<std::optional<int>>& values) {
+  // tails[k] is the index of the smallest value ending an increasing
+  // subsequence of length k + 1
+  std::vector<size_t> tails;
+  std::vector<std::optional<size_t>> prev(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (!values[i]) {
+      continue;
+    }
+    auto pos = std::lower_bound(
+        tails.begin(), tails.end(), *values[i], [&](size_t idx, int value) {
+          return *values[idx] < value;
+        });
+    if (pos != tails.begin()) {
+      prev[i] = *(pos - 1);
+    }
+    if (pos == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *pos = i;
+    }
+  }
+  std::vector<bool> inSequence(values.size(), false);
+  std::optional<size_t> idx;
+  if (!tails.empty()) {
+    idx = tails.back();
+  }
+  for (; idx; idx = prev[*idx]) {
+    inSequence[*idx] = true;
+  }
+  return inSequence;
+}
+
+/*
+ * Assign increasing priorities in (minPriority, maxPriority) to ACLs in
+ * policy order, given the priority each ACL had in the previous config (if
+ * any, and if in range).
+ *
+ * As many ACLs as possible keep their previous priority, so they are not
+ * reprogrammed. Each run of the other ones is spread between its kept
+ * neighbors, kAclPriorityGap apart when there is room. When there is no room
+ * left, the run grows into a window of its neighbors, doubling in size until
+ * the window is sparse enough, and the whole window is spread again. The
+ * larger the window the less sparse it has to be, so rebalancing stays local
+ * unless the priority range as a whole fills up.
+ */
+std::vector<int> allocateAclPriorities(
+    const std::vector<std::optional<int>>& oldPriorities,
+    int minPriority,
+    int maxPriority) {
+  auto numAcls = oldPriorities.size();
+  auto kept = longestIncreasing(oldPriorities);
+  std::vector<int> priorities(numAcls);
+  size_t idx = 0;
+  while (idx < numAcls) {
+    if (kept[idx]) {
+      priorities[idx] = *oldPriorities[idx];
+      ++idx;
+      continue;
+    }
+    // ACLs in [begin, end) get new priorities in (low, high)
+    auto begin = idx;
+    auto end = idx;
+    while (end < numAcls && !kept[end]) {
+      ++end;
+    }
+    int low, high, step;
+    auto computeStep = [&]() {
+      low = begin == 0 ? minPriority : priorities[begin - 1];
+      high = end == numAcls ? maxPriority : *oldPriorities[end];
+      step = (high - low) / static_cast<int>(end - begin + 1);
+    };
+    computeStep();
+    if (step < 1) {
+      auto width = end - begin;
+      int doublings = 0;
+      do {
+        ++doublings;
+        width *= 2;
+        begin = begin > width / 2 ? begin - width / 2 : 0;
+        end = std::min(numAcls, end + width / 2);
+        // The window ends on a kept ACL, whose priority bounds it
+        while (end < numAcls && !kept[end]) {
+          ++end;
+        }
+        computeStep();
+      } while (step < std::max(2, kAclPriorityGap >> doublings) &&
+               (begin > 0 || end < numAcls));
+      if (step < 1) {
+        throw facebook::fboss::FbossError(
+            "Too many ACLs: ",
+            numAcls,
+            " do not fit in priorities (",
+            minPriority,
+            ", ",
+            maxPriority,
+            ")");
+      }
+    }
+    if (begin == 0 || end == numAcls) {
+      // Keep the room at either end of the range for ACLs added there later
+      step = std::min(step, kAclPriorityGap);
+    }
+    if (begin == 0 && end == numAcls) {
+      // New layout, leave room above the first ACL
+      auto spare = (maxPriority - minPriority) -
+          step * static_cast<int>(numAcls + 1);
+      low += std::min(kAclPriorityHeadroom, spare / 2);
+    }
+    for (auto i = begin; i < end; ++i) {
+      // ACLs above the first kept one are packed against it
+      priorities[i] = begin == 0 && end < numAcls
+          ? high - step * static_cast<int>(end - i)
+          : low + step * static_cast<int>(i - begin + 1);
+    }
+    idx = end;
+  }
+  return priorities;
+}
 
 void updateFibFromConfig(
     facebook::fboss::RouterID vrf,
@@ -1754,20 +1888,21 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls() {
   AclMap::NodeContainer newAcls;
   bool changed = false;
   int numExistingProcessed = 0;
-  int priority = kAclStartPriority;
-  int cpuPriority = 1;
+
+  // ACLs in policy order, priorities are assigned once the order is known
+  struct PendingAcl {
+    const cfg::AclEntry* config;
+    std::optional<MatchAction> action;
+  };
+  std::vector<PendingAcl> dataAcls;
+  std::vector<PendingAcl> cpuAcls;
 
   // Start with the DROP acls, these should have highest priority
-  auto acls = folly::gen::from(*cfg_->acls_ref()) |
-      folly::gen::filter([](const cfg::AclEntry& entry) {
-                return *entry.actionType_ref() == cfg::AclActionType::DENY;
-              }) |
-      folly::gen::map([&](const cfg::AclEntry& entry) {
-                auto acl = updateAcl(
-                    entry, priority++, &numExistingProcessed, &changed);
-                return std::make_pair(acl->getID(), acl);
-              }) |
-      folly::gen::appendTo(newAcls);
+  for (const auto& entry : *cfg_->acls_ref()) {
+    if (*entry.actionType_ref() == cfg::AclActionType::DENY) {
+      dataAcls.push_back({&entry, std::nullopt});
+    }
+  }
 
   // Let's get a map of acls to name so we don't have to search the acl list
   // for every new use
@@ -1787,9 +1922,8 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls() {
 
   // Generates new acls from template
   auto addToAcls = [&](const cfg::TrafficPolicyConfig& policy,
-                       bool isCoppAcl = false)
-      -> const std::vector<std::pair<std::string, std::shared_ptr<AclEntry>>> {
-    std::vector<std::pair<std::string, std::shared_ptr<AclEntry>>> entries;
+                       std::vector<PendingAcl>& acls,
+                       bool isCoppAcl = false) {
     for (const auto& mta : *policy.matchToAction_ref()) {
       auto a = aclByName.find(*mta.matcher_ref());
       if (a == aclByName.end()) {
@@ -1797,10 +1931,10 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls() {
             "Invalid config: No acl named ", *mta.matcher_ref(), " found.");
       }
 
-      auto aclCfg = *(a->second);
+      const auto* aclCfg = a->second;
 
       // We've already added any DENY acls
-      if (*aclCfg.actionType_ref() == cfg::AclActionType::DENY) {
+      if (*aclCfg->actionType_ref() == cfg::AclActionType::DENY) {
         continue;
       }
 
@@ -1831,13 +1965,46 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls() {
       if (auto toCpuAction = mta.action_ref()->toCpuAction_ref()) {
         matchAction.setToCpuAction(*toCpuAction);
       }
+      acls.push_back({aclCfg, std::move(matchAction)});
+    }
+  };
 
+  // Add controlPlane traffic acls
+  if (cfg_->cpuTrafficPolicy_ref() &&
+      cfg_->cpuTrafficPolicy_ref()->trafficPolicy_ref()) {
+    addToAcls(
+        *cfg_->cpuTrafficPolicy_ref()->trafficPolicy_ref(), cpuAcls, true);
+  }
+
+  // Add dataPlane traffic acls
+  if (auto dataPlaneTrafficPolicy = cfg_->dataPlaneTrafficPolicy_ref()) {
+    addToAcls(*dataPlaneTrafficPolicy, dataAcls);
+  }
+
+  auto addAcls = [&](const std::vector<PendingAcl>& acls,
+                     int minPriority,
+                     int maxPriority) {
+    std::vector<std::optional<int>> oldPriorities;
+    for (const auto& pendingAcl : acls) {
+      auto origAcl =
+          orig_->getAcls()->getEntryIf(*pendingAcl.config->name_ref());
+      if (origAcl && origAcl->getPriority() > minPriority &&
+          origAcl->getPriority() < maxPriority) {
+        oldPriorities.push_back(origAcl->getPriority());
+      } else {
+        oldPriorities.push_back(std::nullopt);
+      }
+    }
+    auto priorities =
+        allocateAclPriorities(oldPriorities, minPriority, maxPriority);
+    for (size_t i = 0; i < acls.size(); ++i) {
+      const auto& action = acls[i].action;
       auto acl = updateAcl(
-          aclCfg,
-          isCoppAcl ? cpuPriority++ : priority++,
+          *acls[i].config,
+          priorities[i],
           &numExistingProcessed,
           &changed,
-          &matchAction);
+          action ? &action.value() : nullptr);
 
       if (acl->getAclAction().has_value()) {
         const auto& inMirror = acl->getAclAction().value().getIngressMirror();
@@ -1851,24 +2018,12 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls() {
           throw FbossError("Mirror ", egMirror.value(), " is undefined");
         }
       }
-      entries.push_back(std::make_pair(acl->getID(), acl));
+      newAcls.insert(std::make_pair(acl->getID(), acl));
     }
-    return entries;
   };
+  addAcls(cpuAcls, 1, kAclStartPriority);
+  addAcls(dataAcls, kAclStartPriority, kAclEndPriority);
 
-  // Add controlPlane traffic acls
-  if (cfg_->cpuTrafficPolicy_ref() &&
-      cfg_->cpuTrafficPolicy_ref()->trafficPolicy_ref()) {
-    folly::gen::from(
-        addToAcls(*cfg_->cpuTrafficPolicy_ref()->trafficPolicy_ref(), true)) |
-        folly::gen::appendTo(newAcls);
-  }
-
-  // Add dataPlane traffic acls
-  if (auto dataPlaneTrafficPolicy = cfg_->dataPlaneTrafficPolicy_ref()) {
-    folly::gen::from(addToAcls(*dataPlaneTrafficPolicy)) |
-        folly::gen::appendTo(newAcls);
-  }
   if (numExistingProcessed != orig_->getAcls()->size()) {
     // Some existing ACLs were removed.
     changed = true;
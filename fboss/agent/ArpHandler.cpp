@@ -88,7 +88,7 @@ void ArpHandler::handlePacket(
   }
 
   // Look up the Vlan state.
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
   auto vlan = state->getVlans()->getVlanIf(pkt->getSrcVlan());
   if (!vlan) {
     // Hmm, we don't actually have this VLAN configured.
@@ -274,7 +274,7 @@ void ArpHandler::sendArpRequest(
     SwSwitch* sw,
     const shared_ptr<Vlan>& vlan,
     const IPAddressV4& targetIP) {
-  auto state = sw->getState();
+  auto state = sw->getStateSnapshot();
   auto intfID = vlan->getInterfaceID();
 
   if (!Interface::isIpAttached(targetIP, intfID, state)) {
@@ -8,6 +8,8 @@
  *
  */
 
+#include <sys/uio.h>
+#include <algorithm>
 #include <cstdlib>
 #include <exception>
 #include <fstream>
@@ -17,6 +19,7 @@
 #include "fboss/agent/SysError.h"
 
 #include <folly/FileUtil.h>
+#include <folly/logging/xlog.h>
 #include <gflags/gflags.h>
 
 DEFINE_bool(
@@ -24,31 +27,57 @@ DEFINE_bool(
     false,
     "Flag to indicate whether to disable async logging and directly write into the file");
 
-enum BufferToWrite { BUFFER0, BUFFER1 };
+DEFINE_int32(
+    async_logger_buffers,
+    4,
+    "Number of buffers used by the async logger, between 2 and 16. More "
+    "buffers let writers keep appending while earlier buffers are flushed");
+
+DEFINE_bool(
+    async_logger_drop_on_full,
+    false,
+    "Drop log records instead of blocking the caller when every async logger "
+    "buffer is waiting to be flushed");
 
 static std::string exitFilePath;
-static uint32_t offset = 0;
-static BufferToWrite currentBuffer = BUFFER0;
-static std::array<char, facebook::fboss::AsyncLogger::kBufferSize> buffer0;
-static std::array<char, facebook::fboss::AsyncLogger::kBufferSize> buffer1;
+static facebook::fboss::AsyncLogger* liveLogger = nullptr;
+static std::array<
+    std::array<char, facebook::fboss::AsyncLogger::kBufferSize>,
+    facebook::fboss::AsyncLogger::kMaxBuffers>
+    logBuffers;
 
-namespace {
+namespace facebook::fboss {
 
-void terminateHandler() {
-  if (offset > 0) {
+void AsyncLogger::terminateHandler() {
+  if (liveLogger) {
     // Use standard library instead of folly because in unclean exit, folly
     // library could be inaccessible so there's a higher chance of writing into
     // file using standard library.
     std::ofstream logfile;
     logfile.open(exitFilePath, std::ofstream::app);
 
-    if (currentBuffer == BUFFER0) {
-      logfile.write(buffer0.data(), offset);
-    } else {
-      logfile.write(buffer1.data(), offset);
+    // Sealed buffers in flush order first, then whatever made it into the
+    // active buffer
+    uint64_t bytesWritten = 0;
+    auto index = liveLogger->flushIndex_;
+    for (auto i = 0; i < liveLogger->numBuffers_; ++i) {
+      auto& buffer = liveLogger->buffers_[index];
+      auto state = buffer.state.load();
+      if (state == BufferState::FREE) {
+        break;
+      }
+      auto size = buffer.committed.load();
+      logfile.write(buffer.data, size);
+      bytesWritten += size;
+      if (state == BufferState::ACTIVE) {
+        break;
+      }
+      index = liveLogger->nextBuffer(index);
+    }
+    if (bytesWritten > 0) {
+      std::cerr << "Async logger exit with " << bytesWritten
+                << " bytes written to file " << std::endl;
     }
-    std::cerr << "Async logger exit with " << offset
-              << " bytes written to file " << std::endl;
   }
 
   std::exception_ptr eptr = std::current_exception();
@@ -63,70 +92,161 @@ void terminateHandler() {
   abort();
 }
 
-} // namespace
-
-namespace facebook::fboss {
 AsyncLogger::AsyncLogger(std::string filePath, uint32_t logTimeout)
-    : bufferSize_(AsyncLogger::kBufferSize) {
+    : numBuffers_(std::clamp<int32_t>(
+          FLAGS_async_logger_buffers,
+          2,
+          AsyncLogger::kMaxBuffers)) {
   openLogFile(filePath);
 
   if (!FLAGS_disable_async_logger) {
-    logBuffer_ = buffer0.data();
-    flushBuffer_ = buffer1.data();
+    for (auto i = 0; i < numBuffers_; ++i) {
+      buffers_[i].data = logBuffers[i].data();
+    }
+    buffers_[0].state = BufferState::ACTIVE;
+    position_ = pack(0, 0, 0);
 
     exitFilePath = filePath;
+    liveLogger = this;
 
     logTimeout_ = std::chrono::milliseconds(logTimeout);
 
-    std::set_terminate(terminateHandler);
+    std::set_terminate(&AsyncLogger::terminateHandler);
   }
 }
 
 AsyncLogger::~AsyncLogger() {
+  if (!FLAGS_disable_async_logger) {
+    stopFlushThread();
+    writeRemainingOnExit();
+    liveLogger = nullptr;
+
+    auto stats = getStats();
+    if (stats.backpressureWaits || stats.droppedLogs) {
+      XLOG(WARN) << "Async logger blocked " << stats.backpressureWaits
+                 << " times and dropped " << stats.droppedLogs << " logs ("
+                 << stats.droppedBytes << " bytes) on full buffers";
+    }
+  }
   fsync(logFile_.wlock()->fd());
 }
 
-void AsyncLogger::worker_thread() {
-  while (enableLogging_) {
-    std::unique_lock<std::mutex> lock(latch_);
+bool AsyncLogger::trySealAndAdvance(uint64_t position) {
+  auto index = bufferIndex(position);
+  auto next = nextBuffer(index);
+  if (buffers_[next].state.load(std::memory_order_acquire) !=
+      BufferState::FREE) {
+    return false;
+  }
+  if (!position_.compare_exchange_strong(
+          position,
+          pack(generation(position) + 1, next, 0),
+          std::memory_order_acq_rel)) {
+    return false;
+  }
+  // No writer can reserve space in the old buffer anymore, so the offset we
+  // swapped out is its final size
+  buffers_[index].sealedSize.store(
+      bufferOffset(position), std::memory_order_relaxed);
+  buffers_[next].state.store(BufferState::ACTIVE, std::memory_order_relaxed);
+  buffers_[index].state.store(BufferState::SEALED, std::memory_order_release);
+  return true;
+}
 
-    // Wait for either 1. Timeout 2. Force flush or full flush
-    cv_.wait_for(lock, logTimeout_, [this] {
-      return this->forceFlush_ || this->fullFlush_;
-    });
+bool AsyncLogger::waitForFreeBuffer(uint32_t index) {
+  std::unique_lock<std::mutex> lock(freeLatch_);
+  return freeCv_.wait_for(lock, logTimeout_, [this, index] {
+    return buffers_[index].state.load(std::memory_order_acquire) ==
+        BufferState::FREE;
+  });
+}
 
-    // Swap log buffer and flush buffer
-    char* writeBuffer = logBuffer_;
-    uint32_t currSize = offset;
-    offset = 0;
-    currentBuffer = ((currentBuffer == BUFFER0) ? BUFFER1 : BUFFER0);
-    logBuffer_ = flushBuffer_;
+void AsyncLogger::sealActiveBuffer() {
+  auto position = position_.load(std::memory_order_acquire);
+  while (bufferOffset(position) > 0 && !trySealAndAdvance(position)) {
+    if (position_.load(std::memory_order_acquire) == position) {
+      // Next buffer is still waiting for us, make room first
+      flushSealedBuffers();
+    }
+    position = position_.load(std::memory_order_acquire);
+  }
+}
+
+void AsyncLogger::flushSealedBuffers() {
+  std::array<iovec, kMaxBuffers> iov;
+  std::array<uint32_t, kMaxBuffers> indices;
+  int count = 0;
 
-    if (fullFlush_) {
-      fullFlush_ = false;
+  while (count < numBuffers_) {
+    auto& buffer = buffers_[flushIndex_];
+    if (buffer.state.load(std::memory_order_acquire) != BufferState::SEALED) {
+      break;
     }
+    auto size = buffer.sealedSize.load(std::memory_order_relaxed);
+    // Writers that reserved space before the seal may still be copying
+    while (buffer.committed.load(std::memory_order_acquire) != size) {
+      std::this_thread::yield();
+    }
+    iov[count].iov_base = buffer.data;
+    iov[count].iov_len = size;
+    indices[count] = flushIndex_;
+    ++count;
+    flushIndex_ = nextBuffer(flushIndex_);
+  }
 
-    lock.unlock();
-    cv_.notify_one();
+  if (count == 0) {
+    return;
+  }
 
-    // Write content in swap buffer to file
-    if (currSize > 0) {
-      flushCount_++;
-      auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
-        return folly::writeFull(lockedFile.fd(), writeBuffer, currSize);
-      });
+  // Write every sealed buffer with a single syscall
+  auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
+    return folly::writevFull(lockedFile.fd(), iov.data(), count);
+  });
+  if (bytesWritten < 0) {
+    throw SysError(errno, "error writing ", count, " buffers to log file.");
+  }
+  flushCount_ += count;
+  buffersFlushed_.fetch_add(count, std::memory_order_relaxed);
+  writeCalls_.fetch_add(1, std::memory_order_relaxed);
+
+  for (auto i = 0; i < count; ++i) {
+    auto& buffer = buffers_[indices[i]];
+    buffer.committed.store(0, std::memory_order_relaxed);
+    buffer.sealedSize.store(0, std::memory_order_relaxed);
+    buffer.state.store(BufferState::FREE, std::memory_order_release);
+  }
+  {
+    // Take the lock so that a writer between its predicate check and wait
+    // does not miss the notification
+    std::lock_guard<std::mutex> g(freeLatch_);
+  }
+  freeCv_.notify_all();
+}
 
-      if (bytesWritten < 0) {
-        throw SysError(
-            errno, "error writing ", currSize, " bytes to log file.");
-      }
-    }
+void AsyncLogger::worker_thread() {
+  while (enableLogging_) {
+    bool timedOut;
+    {
+      std::unique_lock<std::mutex> lock(latch_);
 
-    memset(writeBuffer, 0, bufferSize_);
-    flushBuffer_ = writeBuffer;
+      // Wait for either 1. Timeout 2. Force flush or full buffer
+      timedOut = !cv_.wait_for(lock, logTimeout_, [this] {
+        return flushRequested_.load() || forceFlush_.load() || !enableLogging_;
+      });
+    }
+    flushRequested_ = false;
+    bool force = forceFlush_;
+
+    // Full buffers are always written out. On timeout or force flush, also
+    // seal and write the partially filled active buffer.
+    flushSealedBuffers();
+    if (timedOut || force) {
+      sealActiveBuffer();
+      flushSealedBuffers();
+    }
 
     // Notify force flush that write completes
-    if (forceFlush_) {
+    if (force) {
       forceFlush_ = false;
       promise_.set_value(0);
       promise_ = std::promise<int>();
@@ -134,6 +254,12 @@ void AsyncLogger::worker_thread() {
   }
 }
 
+void AsyncLogger::writeRemainingOnExit() {
+  // Flush thread is gone, drain from this thread instead
+  sealActiveBuffer();
+  flushSealedBuffers();
+}
+
 void AsyncLogger::startFlushThread() {
   enableLogging_ = true;
   if (!FLAGS_disable_async_logger) {
@@ -143,17 +269,25 @@ void AsyncLogger::startFlushThread() {
 
 void AsyncLogger::stopFlushThread() {
   if (!FLAGS_disable_async_logger && enableLogging_) {
-    enableLogging_ = false;
+    {
+      std::lock_guard<std::mutex> g(latch_);
+      enableLogging_ = false;
+    }
+    cv_.notify_one();
     flushThread_->join();
     delete flushThread_;
   }
 }
 
 void AsyncLogger::forceFlush() {
-  if (!FLAGS_disable_async_logger) {
+  if (!FLAGS_disable_async_logger && enableLogging_) {
+    std::lock_guard<std::mutex> g(forceFlushLock_);
     future_ = promise_.get_future();
 
-    forceFlush_ = true;
+    {
+      std::lock_guard<std::mutex> lock(latch_);
+      forceFlush_ = true;
+    }
     cv_.notify_one();
 
     // Wait for flush to complete
@@ -161,51 +295,93 @@ void AsyncLogger::forceFlush() {
   }
 }
 
+void AsyncLogger::writeDirect(const char* logRecord, size_t logSize) {
+  auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
+    return folly::writeFull(lockedFile.fd(), logRecord, logSize);
+  });
+
+  if (bytesWritten < 0) {
+    throw SysError(errno, "error writing ", logSize, " bytes to log file.");
+  }
+}
+
 void AsyncLogger::appendLog(const char* logRecord, size_t logSize) {
-  if (!enableLogging_) {
+  if (!enableLogging_ || logSize == 0) {
     return;
   }
 
-  if (FLAGS_disable_async_logger && logSize > 0) {
-    auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
-      return folly::writeFull(lockedFile.fd(), logRecord, logSize);
-    });
-
-    if (bytesWritten < 0) {
-      throw SysError(errno, "error writing ", logSize, " bytes to log file.");
-    }
+  if (FLAGS_disable_async_logger) {
+    writeDirect(logRecord, logSize);
     return;
   }
 
-  // Acquire the lock and check if there's enough space in the buffer
-  latch_.lock();
-
-  if (logSize + offset >= bufferSize_) {
-    // Release the lock and notify worker thread to flush logs
-    fullFlush_ = true;
-    latch_.unlock();
-    cv_.notify_one();
+  if (logSize > kBufferSize) {
+    // Can never fit in a buffer. Write everything logged so far, then this
+    // record, to preserve ordering.
+    forceFlush();
+    writeDirect(logRecord, logSize);
+    bytesLogged_.fetch_add(logSize, std::memory_order_relaxed);
+    return;
+  }
 
-    // Wait for worker to finish
-    std::unique_lock<std::mutex> lock(latch_);
-    cv_.wait(lock, [logSize] {
-      return logSize + offset < AsyncLogger::kBufferSize;
-    });
+  while (true) {
+    auto position = position_.load(std::memory_order_acquire);
+    auto offset = bufferOffset(position);
 
-    // Write to buffer
-    memcpy(logBuffer_ + offset, logRecord, logSize);
-    offset += logSize;
+    if (offset + logSize <= kBufferSize) {
+      // Reserve [offset, offset + logSize) in the active buffer
+      if (!position_.compare_exchange_weak(
+              position, position + logSize, std::memory_order_acq_rel)) {
+        continue;
+      }
+      auto& buffer = buffers_[bufferIndex(position)];
+      memcpy(buffer.data + offset, logRecord, logSize);
+      buffer.committed.fetch_add(logSize, std::memory_order_release);
+      bytesLogged_.fetch_add(logSize, std::memory_order_relaxed);
+      return;
+    }
 
-    lock.unlock();
-  } else {
-    // Directly write to buffer
-    memcpy(logBuffer_ + offset, logRecord, logSize);
-    offset += logSize;
+    // Active buffer is full. Seal it and let the flush thread write it out.
+    if (trySealAndAdvance(position)) {
+      {
+        std::lock_guard<std::mutex> lock(latch_);
+        flushRequested_ = true;
+      }
+      cv_.notify_one();
+      continue;
+    }
+    if (position_.load(std::memory_order_acquire) != position) {
+      // Another writer sealed the buffer first, retry in the new one
+      continue;
+    }
 
-    latch_.unlock();
+    // Every buffer is waiting to be flushed
+    if (FLAGS_async_logger_drop_on_full) {
+      droppedLogs_.fetch_add(1, std::memory_order_relaxed);
+      droppedBytes_.fetch_add(logSize, std::memory_order_relaxed);
+      return;
+    }
+    backpressureWaits_.fetch_add(1, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lock(latch_);
+      flushRequested_ = true;
+    }
+    cv_.notify_one();
+    waitForFreeBuffer(nextBuffer(bufferIndex(position)));
   }
 }
 
+AsyncLogger::Stats AsyncLogger::getStats() const {
+  Stats stats;
+  stats.bytesLogged = bytesLogged_.load(std::memory_order_relaxed);
+  stats.buffersFlushed = buffersFlushed_.load(std::memory_order_relaxed);
+  stats.writeCalls = writeCalls_.load(std::memory_order_relaxed);
+  stats.backpressureWaits = backpressureWaits_.load(std::memory_order_relaxed);
+  stats.droppedLogs = droppedLogs_.load(std::memory_order_relaxed);
+  stats.droppedBytes = droppedBytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
 void AsyncLogger::openLogFile(std::string& file_path) {
   // By default, async logger opens log file under /var/facebook/logs/fboss/
   // However, the directory /var/facebook/logs/fboss/ might not exist for test
@@ -10,10 +10,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <future>
 #include <mutex>
+#include <thread>
 
 #include <folly/File.h>
 #include <folly/Synchronized.h>
@@ -40,36 +43,119 @@ class AsyncLogger {
    * number that's not introducing too much memory overhead (roughly 0.035% of
    * current prod usage), but still perform well in frequent updates and
    * benchmark tests.
+   *
+   * The number of buffers in use is configurable (--async_logger_buffers) up
+   * to kMaxBuffers. Unused buffers are never touched and do not add to RSS.
    */
   static auto constexpr kBufferSize = 409600;
+  static auto constexpr kMaxBuffers = 16;
+
+  struct Stats {
+    uint64_t bytesLogged{0};
+    uint64_t buffersFlushed{0};
+    uint64_t writeCalls{0};
+    // Appends that had to wait for the flush thread to free a buffer
+    uint64_t backpressureWaits{0};
+    // Appends discarded because all buffers were in flight
+    // (--async_logger_drop_on_full)
+    uint64_t droppedLogs{0};
+    uint64_t droppedBytes{0};
+  };
 
   void startFlushThread();
   void stopFlushThread();
   void forceFlush();
 
+  /*
+   * Appending is lock free: writers reserve space in the active buffer with a
+   * single compare-and-swap on the packed (buffer, offset) word and copy their
+   * record in parallel. The reservation order is the order records appear in
+   * the file, so concurrent callers (e.g. SAI tracer threads) keep a total
+   * order. When the active buffer fills up, the writer that overflows it seals
+   * it and moves everyone to the next free buffer of the pool. Writers only
+   * block when every buffer is waiting to be flushed.
+   */
   void appendLog(const char* logRecord, size_t logSize);
 
+  Stats getStats() const;
+
   // Expose these variables for testing purpose
   uint32_t flushCount_{0};
 
  private:
+  enum class BufferState : uint8_t { FREE, ACTIVE, SEALED };
+
+  struct Buffer {
+    char* data{nullptr};
+    std::atomic<BufferState> state{BufferState::FREE};
+    // Bytes reserved when the buffer was sealed
+    std::atomic<uint32_t> sealedSize{0};
+    // Bytes actually copied in by writers
+    std::atomic<uint32_t> committed{0};
+  };
+
+  // The write position packs a generation (bumped on every seal, to rule out
+  // ABA on the compare-and-swap), the active buffer index and the offset in
+  // that buffer into one word.
+  static uint64_t
+  pack(uint64_t generation, uint32_t bufferIndex, uint32_t offset) {
+    return (generation << 40) | (static_cast<uint64_t>(bufferIndex) << 32) |
+        offset;
+  }
+  static uint64_t generation(uint64_t position) {
+    return position >> 40;
+  }
+  static uint32_t bufferIndex(uint64_t position) {
+    return (position >> 32) & 0xff;
+  }
+  static uint32_t bufferOffset(uint64_t position) {
+    return static_cast<uint32_t>(position);
+  }
+  uint32_t nextBuffer(uint32_t bufferIndex) const {
+    return (bufferIndex + 1) % numBuffers_;
+  }
+
+  static void terminateHandler();
+
   void worker_thread();
   void openLogFile(std::string& file_path);
+  void writeDirect(const char* logRecord, size_t logSize);
+
+  // Seal the buffer described by position and make the next one active.
+  // Returns false if the next buffer is still waiting to be flushed.
+  bool trySealAndAdvance(uint64_t position);
+  bool waitForFreeBuffer(uint32_t bufferIndex);
+  void flushSealedBuffers();
+  // Seal the active buffer if it has data, so it's picked up by the next flush
+  void sealActiveBuffer();
+  void writeRemainingOnExit();
 
-  bool forceFlush_{false};
-  bool fullFlush_{false};
   bool enableLogging_{false};
 
-  uint32_t bufferSize_;
+  uint32_t numBuffers_;
+  std::array<Buffer, kMaxBuffers> buffers_;
+  std::atomic<uint64_t> position_{0};
+  // Next buffer to be written out, only touched by the flush thread
+  uint32_t flushIndex_{0};
+
+  std::atomic<bool> flushRequested_{false};
+  std::atomic<bool> forceFlush_{false};
 
-  char* logBuffer_;
-  char* flushBuffer_;
+  std::atomic<uint64_t> bytesLogged_{0};
+  std::atomic<uint64_t> buffersFlushed_{0};
+  std::atomic<uint64_t> writeCalls_{0};
+  std::atomic<uint64_t> backpressureWaits_{0};
+  std::atomic<uint64_t> droppedLogs_{0};
+  std::atomic<uint64_t> droppedBytes_{0};
 
   std::promise<int> promise_;
   std::future<int> future_;
   std::mutex latch_;
+  std::mutex forceFlushLock_;
   std::thread* flushThread_;
   std::condition_variable cv_;
+  std::mutex freeLatch_;
+  std::condition_variable freeCv_;
   std::chrono::milliseconds logTimeout_;
 
   folly::Synchronized<folly::File> logFile_;
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/GleanTable.h"
+
+#include <folly/hash/Hash.h>
+#include <gflags/gflags.h>
+
+#include <vector>
+
+DEFINE_int32(
+    glean_probe_interval_ms,
+    100,
+    "Minimum interval between ARP/NDP probes sent to the same unresolved "
+    "neighbor because of packets routed to it, 0 to probe for every packet");
+DEFINE_int32(
+    glean_max_backoff_ms,
+    10000,
+    "Maximum interval between probes to the same unresolved neighbor");
+DEFINE_int32(
+    glean_max_entries,
+    16384,
+    "Maximum number of unresolved neighbors whose probes are rate limited");
+
+namespace facebook::fboss {
+
+namespace {
+
+GleanTable::Clock::rep ticks(std::chrono::milliseconds duration) {
+  return std::chrono::duration_cast<GleanTable::Clock::duration>(duration)
+      .count();
+}
+
+} // namespace
+
+size_t GleanTable::KeyHash::operator()(const Key& key) const {
+  return folly::hash::hash_combine(
+      static_cast<uint32_t>(key.vrf), key.target.hash());
+}
+
+GleanTable::GleanTable(
+    std::chrono::milliseconds probeInterval,
+    std::chrono::milliseconds maxBackoff,
+    size_t maxEntries)
+    : probeInterval_(ticks(probeInterval)),
+      maxBackoff_(std::max(ticks(maxBackoff), ticks(probeInterval))),
+      maxEntries_(maxEntries) {}
+
+GleanTable::GleanTable()
+    : GleanTable(
+          std::chrono::milliseconds(FLAGS_glean_probe_interval_ms),
+          std::chrono::milliseconds(FLAGS_glean_max_backoff_ms),
+          FLAGS_glean_max_entries) {}
+
+bool GleanTable::shouldProbe(
+    RouterID vrf,
+    const folly::IPAddress& target,
+    Clock::time_point now) {
+  if (!probeInterval_) {
+    return true;
+  }
+  auto nowTicks = now.time_since_epoch().count();
+  Key key{vrf, target};
+  auto itr = entries_.find(key);
+  if (itr == entries_.cend()) {
+    if (entries_.size() >= maxEntries_) {
+      purgeIdle(nowTicks);
+      if (entries_.size() >= maxEntries_) {
+        // Don't track the target rather than never probing it
+        return true;
+      }
+    }
+    auto entry = std::make_shared<Entry>(
+        nowTicks, probeInterval_, std::min(2 * probeInterval_, maxBackoff_));
+    auto ret = entries_.emplace(std::move(key), std::move(entry));
+    if (ret.second) {
+      return true;
+    }
+    // Another thread added the target first, it sends the probe
+    return false;
+  }
+
+  auto& entry = *itr->second;
+  auto lastGlean = entry.lastGlean.exchange(nowTicks);
+  if (nowTicks - lastGlean > 2 * maxBackoff_) {
+    entry.backoff = probeInterval_;
+  }
+  auto nextProbe = entry.nextProbe.load();
+  if (nowTicks < nextProbe) {
+    return false;
+  }
+  auto backoff = entry.backoff.load();
+  // Only one of the threads seeing the probe due sends it
+  if (!entry.nextProbe.compare_exchange_strong(
+          nextProbe, nowTicks + backoff)) {
+    return false;
+  }
+  entry.backoff = std::min(2 * backoff, maxBackoff_);
+  return true;
+}
+
+void GleanTable::resolved(RouterID vrf, const folly::IPAddress& target) {
+  entries_.erase(Key{vrf, target});
+}
+
+void GleanTable::purgeIdle(Clock::rep now) {
+  std::vector<Key> idle;
+  for (const auto& [key, entry] : entries_) {
+    if (now - entry->lastGlean.load() > 2 * maxBackoff_) {
+      idle.push_back(key);
+    }
+  }
+  for (const auto& key : idle) {
+    entries_.erase(key);
+  }
+}
+
+} // namespace facebook::fboss
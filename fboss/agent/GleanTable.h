@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+#include <folly/concurrency/ConcurrentHashMap.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace facebook::fboss {
+
+/*
+ * Address resolutions started by glean, i.e. by packets trapped to the CPU
+ * because they are routed to an unresolved neighbor.
+ *
+ * Each such packet used to send an ARP request or neighbor solicitation and
+ * notify the NeighborUpdater, which schedules a state update, so a high
+ * rate flow toward an unresolved host flooded both the update thread and
+ * the wire.  The IPv4 and IPv6 handlers now ask shouldProbe() first.  There
+ * is a single outstanding probe per (VRF, target), and further probes to
+ * the same target are spaced with exponential backoff, from probeInterval
+ * up to maxBackoff.  Targets that see no glean for twice maxBackoff start
+ * over at probeInterval.
+ *
+ * Packets are received on multiple threads: lookups are lock free, and
+ * only adding or removing a target takes a lock.
+ */
+class GleanTable {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // A probeInterval of 0 disables the table, every glean probes
+  GleanTable(
+      std::chrono::milliseconds probeInterval,
+      std::chrono::milliseconds maxBackoff,
+      size_t maxEntries);
+  // Configured from the glean_* flags
+  GleanTable();
+
+  /*
+   * Whether a glean for target should send a probe.  False if a probe to
+   * the target went out less than its current backoff ago.
+   */
+  bool shouldProbe(
+      RouterID vrf,
+      const folly::IPAddress& target,
+      Clock::time_point now = Clock::now());
+
+  // The target is resolved, the next glean for it probes right away
+  void resolved(RouterID vrf, const folly::IPAddress& target);
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+ private:
+  struct Key {
+    RouterID vrf;
+    folly::IPAddress target;
+
+    bool operator==(const Key& other) const {
+      return vrf == other.vrf && target == other.target;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  // Times are Clock ticks
+  struct Entry {
+    Entry(Clock::rep now, Clock::rep probeInterval, Clock::rep backoff)
+        : nextProbe(now + probeInterval),
+          backoff(backoff),
+          lastGlean(now) {}
+
+    std::atomic<Clock::rep> nextProbe;
+    std::atomic<Clock::rep> backoff;
+    std::atomic<Clock::rep> lastGlean;
+  };
+
+  // Remove the targets that saw no glean for twice maxBackoff
+  void purgeIdle(Clock::rep now);
+
+  const Clock::rep probeInterval_;
+  const Clock::rep maxBackoff_;
+  const size_t maxEntries_;
+  folly::ConcurrentHashMap<Key, std::shared_ptr<Entry>, KeyHash> entries_;
+};
+
+} // namespace facebook::fboss
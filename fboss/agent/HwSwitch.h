@@ -35,6 +35,7 @@ class RxPacket;
 class TxPacket;
 class L2Entry;
 class HwSwitchStats;
+class HwPortCounterStore;
 
 enum class L2EntryUpdateType : uint8_t;
 
@@ -218,6 +219,14 @@ class HwSwitch {
 
   virtual folly::F14FastMap<std::string, HwPortStats> getPortStats() const = 0;
 
+  /*
+   * Port counters of all enabled ports with recent history, null if this
+   * HwSwitch does not collect them
+   */
+  virtual const HwPortCounterStore* getPortCounterStore() const {
+    return nullptr;
+  }
+
   virtual void fetchL2Table(std::vector<L2EntryThrift>* l2Table) const = 0;
 
   /*
@@ -226,7 +235,8 @@ class HwSwitch {
   virtual uint64_t getDeviceWatermarkBytes() const = 0;
   /*
    * Allow hardware to perform any warm boot related cleanup
-   * before we exit the application.
+   * before we exit the application. switchState is consumed while it is
+   * written to the warm boot state file.
    */
   virtual void gracefulExit(folly::dynamic& switchState) = 0;
 
@@ -17,6 +17,7 @@
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/DHCPv4Handler.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/GleanTable.h"
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/IPHeaderV4.h"
 #include "fboss/agent/NeighborUpdater.h"
@@ -89,7 +90,7 @@ void IPv4Handler::sendICMPTimeExceeded(
     MacAddress src,
     IPv4Hdr& v4Hdr,
     Cursor cursor) {
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
 
   // payload serialization function
   // 4 bytes unused + ipv4 header + 8 bytes payload
@@ -141,7 +142,7 @@ void IPv4Handler::handlePacket(
   cursor.reset(payload.get());
 
   // retrieve the current switch state
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
   // Need to check if the packet is for self or not. We store our IP
   // in the ARP response table. Use that for now.
   auto vlan = state->getVlans()->getVlanIf(pkt->getSrcVlan());
@@ -240,9 +241,11 @@ void IPv4Handler::handlePacket(
   stats->port(port)->pktDropped();
 }
 
-// Return true if we successfully sent an ARP request, false otherwise
+// Return true if we successfully sent an ARP request, false otherwise. Requests
+// suppressed by the GleanTable are not sent and are counted in
+// glean.suppressed
 bool IPv4Handler::resolveMac(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     PortID ingressPort,
     IPAddressV4 dest,
     VlanID ingressVlan) {
@@ -281,7 +284,13 @@ bool IPv4Handler::resolveMac(
       auto vlan = state->getVlans()->getVlanIf(vlanID);
       if (vlan) {
         auto entry = vlan->getArpTable()->getEntryIf(target);
+        auto gleanTable = sw_->getGleanTable();
         if (entry == nullptr) {
+          if (!gleanTable->shouldProbe(intf->getRouterID(), target)) {
+            // We recently sent an ARP request for target
+            sw_->stats()->gleanSuppressed();
+            continue;
+          }
           // No entry in ARP table, send ARP request
           auto mac = intf->getMac();
           ArpHandler::sendArpRequest(sw_, vlanID, mac, source, target);
@@ -293,6 +302,9 @@ bool IPv4Handler::resolveMac(
           XLOG(DBG4) << "not sending arp for " << target.str() << ", "
                      << ((entry->isPending()) ? "pending " : "")
                      << "entry already exists";
+          if (!entry->isPending()) {
+            gleanTable->resolved(intf->getRouterID(), target);
+          }
         }
       }
     }
@@ -47,7 +47,7 @@ class IPv4Handler {
    * make this private again.
    */
   bool resolveMac(
-      std::shared_ptr<SwitchState> state,
+      const std::shared_ptr<SwitchState>& state,
       PortID ingressPort,
       folly::IPAddressV4 dest,
       VlanID ingressVlan);
@@ -14,6 +14,7 @@
 #include <folly/logging/xlog.h>
 #include "fboss/agent/DHCPv6Handler.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/GleanTable.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/RxPacket.h"
@@ -146,7 +147,7 @@ void IPv6Handler::handlePacket(
   cursor.reset(payload.get());
 
   // retrieve the current switch state
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
   PortID port = pkt->getSrcPort();
 
   // NOTE: DHCPv6 solicit packet from client has hoplimit set to 1,
@@ -294,7 +295,7 @@ void IPv6Handler::handleRouterSolicitation(
 
   cursor.skip(4); // 4 reserved bytes
 
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
   auto vlan = state->getVlans()->getVlanIf(pkt->getSrcVlan());
   if (!vlan) {
     sw_->portStats(pkt)->pktDropped();
@@ -382,7 +383,7 @@ void IPv6Handler::handleNeighborSolicitation(
   }
   XLOG(DBG4) << "got neighbor solicitation for " << targetIP.str();
 
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
   auto vlan = state->getVlans()->getVlanIf(pkt->getSrcVlan());
   if (!vlan) {
     // Hmm, we don't actually have this VLAN configured.
@@ -500,7 +501,7 @@ void IPv6Handler::handleNeighborAdvertisement(
     return;
   }
 
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
   auto vlan = state->getVlans()->getVlanIf(pkt->getSrcVlan());
   if (!vlan) {
     // Hmm, we don't actually have this VLAN configured.
@@ -543,7 +544,7 @@ void IPv6Handler::sendICMPv6TimeExceeded(
     MacAddress src,
     IPv6Hdr& v6Hdr,
     folly::io::Cursor cursor) {
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
 
   /*
    * The payload of ICMPv6TimeExceeded consists of:
@@ -592,7 +593,7 @@ void IPv6Handler::sendICMPv6PacketTooBig(
     IPv6Hdr& v6Hdr,
     int expectedMtu,
     folly::io::Cursor cursor) {
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
 
   // payload serialization function
   // 4 bytes expected MTU + ipv6 header + as much payload as possible to fit MTU
@@ -689,7 +690,7 @@ void IPv6Handler::sendUnicastNeighborSolicitation(
     const folly::MacAddress& srcMac,
     const VlanID& vlanID,
     const std::optional<PortDescriptor>& portDescriptor) {
-  auto state = sw->getState();
+  auto state = sw->getStateSnapshot();
   auto vlan = state->getVlans()->getVlanIf(vlanID);
   if (!Interface::isIpAttached(targetIP, vlan->getInterfaceID(), state)) {
     XLOG(DBG2) << "unicast neighbor solicitation not sent, neighbor address: "
@@ -711,7 +712,7 @@ void IPv6Handler::sendMulticastNeighborSolicitation(
     SwSwitch* sw,
     const IPAddressV6& targetIP,
     const shared_ptr<Vlan>& vlan) {
-  auto state = sw->getState();
+  auto state = sw->getStateSnapshot();
   auto intfID = vlan->getInterfaceID();
 
   auto intf = state->getInterfaces()->getInterfaceIf(intfID);
@@ -733,7 +734,7 @@ void IPv6Handler::resolveDestAndHandlePacket(
   // Right now this either responds with PTB or generate neighbor soliciations
   auto ingressPort = pkt->getSrcPort();
   auto targetIP = hdr.dstAddr;
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
 
   auto ingressInterface =
       state->getInterfaces()->getInterfaceInVlanIf(pkt->getSrcVlan());
@@ -785,6 +786,12 @@ void IPv6Handler::resolveDestAndHandlePacket(
         if (vlan) {
           auto entry = vlan->getNdpTable()->getEntryIf(target);
           if (nullptr == entry) {
+            if (!sw_->getGleanTable()->shouldProbe(
+                    intf->getRouterID(), target)) {
+              // We recently sent a solicitation for target
+              sw_->stats()->gleanSuppressed();
+              continue;
+            }
             // No entry in NDP table, create a neighbor solicitation packet
             sendMulticastNeighborSolicitation(
                 sw_, target, intf->getMac(), vlan->getID());
@@ -795,6 +802,9 @@ void IPv6Handler::resolveDestAndHandlePacket(
                        << target.str() << ", "
                        << ((entry->isPending()) ? "pending" : "")
                        << " entry already exists";
+            if (!entry->isPending()) {
+              sw_->getGleanTable()->resolved(intf->getRouterID(), target);
+            }
           }
         }
       }
@@ -811,7 +821,7 @@ void IPv6Handler::sendMulticastNeighborSolicitations(
     return;
   }
 
-  auto state = sw_->getState();
+  auto state = sw_->getStateSnapshot();
 
   auto route = sw_->longestMatch(state, targetIP, RouterID(0));
   if (!route || !route->isResolved()) {
@@ -837,6 +847,11 @@ void IPv6Handler::sendMulticastNeighborSolicitations(
       if (vlan) {
         auto entry = vlan->getNdpTable()->getEntryIf(target);
         if (entry == nullptr) {
+          if (!sw_->getGleanTable()->shouldProbe(intf->getRouterID(), target)) {
+            // We recently sent a solicitation for target
+            sw_->stats()->gleanSuppressed();
+            continue;
+          }
           // No entry in NDP table, create a neighbor solicitation packet
           sendMulticastNeighborSolicitation(
               sw_, target, intf->getMac(), vlan->getID());
@@ -847,6 +862,9 @@ void IPv6Handler::sendMulticastNeighborSolicitations(
           XLOG(DBG5) << "not sending neighbor solicitation for " << target.str()
                      << ", " << ((entry->isPending()) ? "pending" : "")
                      << " entry already exists";
+          if (!entry->isPending()) {
+            sw_->getGleanTable()->resolved(intf->getRouterID(), target);
+          }
         }
       }
     }
@@ -924,7 +942,7 @@ void IPv6Handler::sendNeighborSolicitation(
     const VlanID& vlanID,
     const std::optional<PortDescriptor>& portDescriptor,
     const NDPOptions& ndpOptions) {
-  auto state = sw->getState();
+  auto state = sw->getStateSnapshot();
 
   uint32_t bodyLength = ICMPHdr::ICMPV6_UNUSED_LEN + IPAddressV6::byteCount() +
       ndpOptions.computeTotalLength();
@@ -72,13 +72,18 @@ void MKAServiceManager::handlePacket(std::unique_ptr<RxPacket> packet) {
     VLOG(3) << "Port '" << portStr << "' not registered by mka service";
     return;
   }
-  folly::IOBuf* buf = packet->buf();
-  TPacket pktToSend;
-  pktToSend.buf_ref() = buf->moveToFbString().toStdString();
+  TIOBufPacket pktToSend;
+  // The stream serializes the packet later, on its own thread, while the
+  // RX buffer may be released (or reused by the SDK) as soon as we return.
+  // So copy it once here, later stages share the copy.
+  pktToSend.buf_ref() = packet->buf()->cloneAsValue();
+  pktToSend.buf_ref()->unshare();
   pktToSend.timestamp_ref() = time(nullptr);
   pktToSend.l2Port_ref() = std::move(portStr);
-  size_t len = pktToSend.buf_ref()->size();
-  if (len != stream_->send(std::move(pktToSend))) {
+  size_t len = pktToSend.buf_ref()->computeChainDataLength();
+  TPacketBatch batch;
+  batch.packets_ref()->push_back(std::move(pktToSend));
+  if (len != stream_->send(std::move(batch))) {
     CHECK_STATS(stats, stats->MKAServiceSendFailue());
     LOG(ERROR) << "Failed to send MkPdu packet received on Port:'"
                << packet->getSrcPort() << "' to mka_service";
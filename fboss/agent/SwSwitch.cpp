@@ -17,6 +17,7 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/FbossHwUpdateError.h"
 #include "fboss/agent/FibHelpers.h"
+#include "fboss/agent/GleanTable.h"
 
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/IPv4Handler.h"
@@ -170,6 +171,7 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       ipv4_(new IPv4Handler(this)),
       ipv6_(new IPv6Handler(this)),
       nUpdater_(new NeighborUpdater(this)),
+      gleanTable_(new GleanTable()),
       pcapMgr_(new PktCaptureManager(this)),
       mirrorManager_(new MirrorManager(this)),
       routeUpdateLogger_(new RouteUpdateLogger(this)),
@@ -852,12 +854,33 @@ void SwSwitch::handlePendingUpdates() {
 }
 
 void SwSwitch::setStateInternal(std::shared_ptr<SwitchState> newAppliedState) {
-  // This is one of the only two places that should ever directly access
-  // stateDontUseDirectly_.  (getState() being the other one.)
+  // This is one of the only three places that should ever directly access
+  // stateDontUseDirectly_.  (getState() and SwitchStateSnapshot being the
+  // other ones.)
   CHECK(bool(newAppliedState));
   CHECK(newAppliedState->isPublished());
   folly::SpinLockGuard guard(stateLock_);
   appliedStateDontUseDirectly_.swap(newAppliedState);
+  stateVersion_.fetch_add(1, std::memory_order_release);
+}
+
+SwitchStateSnapshot::SwitchStateSnapshot(const SwSwitch* sw)
+    : cache_(sw->stateCache_.get()) {
+  if (cache_->depth++ > 0) {
+    // Nested in a live snapshot on this thread, keep using its state
+    return;
+  }
+  if (cache_->state &&
+      cache_->version == sw->stateVersion_.load(std::memory_order_acquire)) {
+    return;
+  }
+  folly::SpinLockGuard guard(sw->stateLock_);
+  cache_->state = sw->appliedStateDontUseDirectly_;
+  cache_->version = sw->stateVersion_.load(std::memory_order_relaxed);
+}
+
+SwitchStateSnapshot::~SwitchStateSnapshot() {
+  --cache_->depth;
 }
 
 std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
@@ -1611,18 +1634,18 @@ bool SwSwitch::isStandaloneRibEnabled() const {
 }
 template <typename AddressT>
 std::shared_ptr<Route<AddressT>> SwSwitch::longestMatch(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     const AddressT& address,
     RouterID vrf) {
   return findLongestMatchRoute(isStandaloneRibEnabled(), vrf, address, state);
 }
 
 template std::shared_ptr<Route<folly::IPAddressV4>> SwSwitch::longestMatch(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     const folly::IPAddressV4& address,
     RouterID vrf);
 template std::shared_ptr<Route<folly::IPAddressV6>> SwSwitch::longestMatch(
-    std::shared_ptr<SwitchState> state,
+    const std::shared_ptr<SwitchState>& state,
     const folly::IPAddressV6& address,
     RouterID vrf);
 
@@ -34,6 +34,7 @@
 namespace facebook::fboss {
 
 class ArpHandler;
+class GleanTable;
 class IPv4Handler;
 class IPv6Handler;
 class LinkAggregationManager;
@@ -89,6 +90,58 @@ inline bool operator&(SwitchFlags lhs, SwitchFlags rhs) {
   return (static_cast<BackingType>(lhs) & static_cast<BackingType>(rhs)) != 0;
 }
 
+/*
+ * Read-only access to the applied switch state for the lifetime of the
+ * object, see SwSwitch::getStateSnapshot().
+ *
+ * Every thread caches the last state it read together with the version it
+ * was published as. Taking a snapshot is a single atomic load to check that
+ * version; only when a newer state was published since does it take
+ * stateLock_ and copy the shared_ptr. Hot readers such as the packet rx
+ * handlers thus touch neither the lock nor the state's refcount cache line.
+ *
+ * Snapshots nest: one taken while another is alive on the same thread reuses
+ * its state, so the thread's cache is never replaced under a live snapshot.
+ * They can't be copied or moved and must not leave the thread that took
+ * them; use get() to take a reference that outlives the snapshot. A thread
+ * keeps its last state alive until it takes its next snapshot.
+ */
+class SwitchStateSnapshot {
+ public:
+  ~SwitchStateSnapshot();
+
+  const std::shared_ptr<SwitchState>& get() const {
+    return cache_->state;
+  }
+  SwitchState* operator->() const {
+    return cache_->state.get();
+  }
+  SwitchState& operator*() const {
+    return *cache_->state;
+  }
+  // So snapshots can be passed to helpers taking the state by const reference
+  operator const std::shared_ptr<SwitchState>&() const {
+    return cache_->state;
+  }
+
+ private:
+  friend class SwSwitch;
+
+  struct ThreadCache {
+    uint64_t version{0};
+    uint32_t depth{0};
+    std::shared_ptr<SwitchState> state;
+  };
+
+  explicit SwitchStateSnapshot(const SwSwitch* sw);
+
+  // Forbidden copy constructor and assignment operator
+  SwitchStateSnapshot(SwitchStateSnapshot const&) = delete;
+  SwitchStateSnapshot& operator=(SwitchStateSnapshot const&) = delete;
+
+  ThreadCache* cache_;
+};
+
 /*
  * A software representation of a switch.
  *
@@ -197,6 +250,18 @@ class SwSwitch : public HwSwitch::Callback {
   std::shared_ptr<SwitchState> getState() const {
     return getAppliedState();
   }
+
+  /*
+   * Same as getState(), but without taking stateLock_ or a reference on the
+   * state as long as no new state was published since this thread last
+   * looked. Meant for per packet and other high rate readers:
+   *
+   *   auto state = sw_->getStateSnapshot();
+   *   auto vlan = state->getVlans()->getVlanIf(vlanID);
+   */
+  SwitchStateSnapshot getStateSnapshot() const {
+    return SwitchStateSnapshot(this);
+  }
   /**
    * Schedule an update to the switch state.
    *
@@ -542,6 +607,14 @@ class SwSwitch : public HwSwitch::Callback {
     return nUpdater_.get();
   }
 
+  /*
+   * Get the GleanTable, which rate limits the ARP requests and neighbor
+   * solicitations sent for packets routed to unresolved neighbors.
+   */
+  GleanTable* getGleanTable() {
+    return gleanTable_.get();
+  }
+
   /*
    * Get the PktCaptureManager object.
    */
@@ -662,7 +735,7 @@ class SwSwitch : public HwSwitch::Callback {
 
   template <typename AddressT>
   std::shared_ptr<Route<AddressT>> longestMatch(
-      std::shared_ptr<SwitchState> state,
+      const std::shared_ptr<SwitchState>& state,
       const AddressT& address,
       RouterID vrf);
 
@@ -685,6 +758,8 @@ class SwSwitch : public HwSwitch::Callback {
     return appliedStateDontUseDirectly_;
   }
 
+  friend class SwitchStateSnapshot;
+
   typedef folly::IntrusiveList<StateUpdate, &StateUpdate::listHook_>
       StateUpdateList;
 
@@ -789,6 +864,10 @@ class SwSwitch : public HwSwitch::Callback {
    */
   std::shared_ptr<SwitchState> appliedStateDontUseDirectly_;
   mutable folly::SpinLock stateLock_;
+  // Bumped, under stateLock_, each time a new applied state is published
+  std::atomic<uint64_t> stateVersion_{0};
+  // Per thread cache of the applied state, see SwitchStateSnapshot
+  mutable folly::ThreadLocal<SwitchStateSnapshot::ThreadCache> stateCache_;
 
   /*
    * A thread for performing various background tasks.
@@ -853,6 +932,7 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<IPv4Handler> ipv4_;
   std::unique_ptr<IPv6Handler> ipv6_;
   std::unique_ptr<NeighborUpdater> nUpdater_;
+  std::unique_ptr<GleanTable> gleanTable_;
   std::unique_ptr<PktCaptureManager> pcapMgr_;
   std::unique_ptr<MirrorManager> mirrorManager_;
   std::unique_ptr<RouteUpdateLogger> routeUpdateLogger_;
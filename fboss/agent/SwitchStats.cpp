@@ -13,6 +13,7 @@
 #include "fboss/agent/PortStats.h"
 
 using facebook::fb303::AVG;
+using facebook::fb303::COUNT;
 using facebook::fb303::RATE;
 using facebook::fb303::SUM;
 
@@ -78,7 +79,13 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           kCounterPrefix + "ip.dst_lookup_failure",
           SUM,
           RATE),
+      gleanSuppressed_(map, kCounterPrefix + "glean.suppressed", SUM, RATE),
       updateState_(map, kCounterPrefix + "state_update.us", 50000, 0, 1000000),
+      updateStateTime_(
+          map,
+          kCounterPrefix + "state_update.time_us",
+          SUM,
+          COUNT),
       routeUpdate_(map, kCounterPrefix + "route_update.us", 50, 0, 500),
       bgHeartbeatDelay_(
           map,
@@ -222,8 +222,13 @@ class SwitchStats : public boost::noncopyable {
     dstLookupFailure_.addValue(1);
   }
 
+  void gleanSuppressed() {
+    gleanSuppressed_.addValue(1);
+  }
+
   void stateUpdate(std::chrono::microseconds us) {
     updateState_.addValue(us.count());
+    updateStateTime_.addValue(us.count());
   }
 
   void routeUpdate(std::chrono::microseconds us, uint64_t routes) {
@@ -437,10 +442,18 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries dstLookupFailureV6_;
   TLTimeseries dstLookupFailure_;
 
+  // ARP/NDP probes not sent as one to the same neighbor went out recently
+  TLTimeseries gleanSuppressed_;
+
   /**
    * Histogram for time used for SwSwitch::updateState() (in ms)
    */
   TLHistogram updateState_;
+  /**
+   * Total time spent in and number of SwSwitch::updateState() calls (in us),
+   * exported as lifetime sums so clients can take exact per-interval deltas
+   */
+  TLTimeseries updateStateTime_;
 
   /**
    * Histogram for time used for route update (in microsecond)
@@ -27,6 +27,7 @@
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/capture/PktCapture.h"
 #include "fboss/agent/capture/PktCaptureManager.h"
+#include "fboss/agent/hw/HwPortCounterStore.h"
 #include "fboss/agent/hw/mock/MockRxPacket.h"
 #include "fboss/agent/if/gen-cpp2/NeighborListenerClient.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
@@ -102,6 +103,20 @@ DEFINE_bool(
     false,
     "Allow external mutations of running config");
 
+DEFINE_int32(
+    thrift_read_snapshot_interval_ms,
+    0,
+    "Build the responses of getAllPortInfo, getArpTable, getNdpTable, "
+    "getL2Table and getAclTable on a thread of their own every this many "
+    "milliseconds, and serve these calls from them without waiting on the "
+    "update, neighbor or hardware threads. 0 disables the snapshots");
+
+DEFINE_int32(
+    thrift_read_snapshot_max_age_ms,
+    5000,
+    "Calls build the response themselves when the snapshot is older than "
+    "this, e.g. when building it is stuck behind programming");
+
 namespace facebook::fboss {
 
 namespace util {
@@ -509,6 +524,47 @@ void translateToFibError(
       });
   throw fibError;
 }
+
+std::vector<NdpEntryThrift> getNdpTableHelper(SwSwitch& sw) {
+  auto entries = sw.getNeighborUpdater()->getNdpCacheData().get();
+  return std::vector<NdpEntryThrift>(
+      std::make_move_iterator(std::begin(entries)),
+      std::make_move_iterator(std::end(entries)));
+}
+
+std::vector<ArpEntryThrift> getArpTableHelper(SwSwitch& sw) {
+  auto entries = sw.getNeighborUpdater()->getArpCacheData().get();
+  return std::vector<ArpEntryThrift>(
+      std::make_move_iterator(std::begin(entries)),
+      std::make_move_iterator(std::end(entries)));
+}
+
+std::vector<L2EntryThrift> getL2TableHelper(const SwSwitch& sw) {
+  std::vector<L2EntryThrift> l2Table;
+  sw.getHw()->fetchL2Table(&l2Table);
+  return l2Table;
+}
+
+std::vector<AclEntryThrift> getAclTableHelper(const SwitchState& state) {
+  std::vector<AclEntryThrift> aclTable;
+  aclTable.reserve(state.getAcls()->numEntries());
+  for (const auto& aclEntry : *(state.getAcls())) {
+    aclTable.push_back(populateAclEntryThrift(*aclEntry));
+  }
+  return aclTable;
+}
+
+std::map<int32_t, PortInfoThrift> getAllPortInfoHelper(
+    const SwSwitch& sw,
+    const SwitchState& state) {
+  std::map<int32_t, PortInfoThrift> portInfoMap;
+  for (const auto& port : *(state.getPorts())) {
+    auto portId = port->getID();
+    auto& portInfo = portInfoMap[portId];
+    getPortInfoHelper(sw, portInfo, port);
+  }
+  return portInfoMap;
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -550,6 +606,48 @@ ThriftHandler::ThriftHandler(SwSwitch* sw) : FacebookBase2("FBOSS"), sw_(sw) {
       }
     });
   }
+  if (sw && FLAGS_thrift_read_snapshot_interval_ms > 0) {
+    initReadSnapshots();
+  }
+}
+
+void ThriftHandler::initReadSnapshots() {
+  readSnapshots_ = std::make_unique<ThriftReadSnapshots>(
+      sw_,
+      std::chrono::milliseconds(FLAGS_thrift_read_snapshot_interval_ms),
+      std::chrono::milliseconds(FLAGS_thrift_read_snapshot_max_age_ms));
+  auto sw = sw_;
+  portInfoSnapshot_ = readSnapshots_->add<std::map<int32_t, PortInfoThrift>>(
+      "portInfo",
+      [sw](const shared_ptr<SwitchState>& state) {
+        return getAllPortInfoHelper(*sw, *state);
+      },
+      false /* stateOnly, has the port stats */);
+  arpTableSnapshot_ = readSnapshots_->add<std::vector<ArpEntryThrift>>(
+      "arpTable",
+      [sw](const shared_ptr<SwitchState>& /*state*/) {
+        return getArpTableHelper(*sw);
+      },
+      false /* stateOnly, has the pending entries */);
+  ndpTableSnapshot_ = readSnapshots_->add<std::vector<NdpEntryThrift>>(
+      "ndpTable",
+      [sw](const shared_ptr<SwitchState>& /*state*/) {
+        return getNdpTableHelper(*sw);
+      },
+      false /* stateOnly, has the pending entries */);
+  l2TableSnapshot_ = readSnapshots_->add<std::vector<L2EntryThrift>>(
+      "l2Table",
+      [sw](const shared_ptr<SwitchState>& /*state*/) {
+        return getL2TableHelper(*sw);
+      },
+      false /* stateOnly, read from the hardware */);
+  aclTableSnapshot_ = readSnapshots_->add<std::vector<AclEntryThrift>>(
+      "aclTable",
+      [](const shared_ptr<SwitchState>& state) {
+        return getAclTableHelper(*state);
+      },
+      true /* stateOnly */);
+  readSnapshots_->start();
 }
 
 fb_status ThriftHandler::getStatus() {
@@ -769,39 +867,37 @@ void ThriftHandler::getInterfaceDetail(
 void ThriftHandler::getNdpTable(std::vector<NdpEntryThrift>& ndpTable) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  auto entries = sw_->getNeighborUpdater()->getNdpCacheData().get();
-  ndpTable.reserve(entries.size());
-  ndpTable.insert(
-      ndpTable.begin(),
-      std::make_move_iterator(std::begin(entries)),
-      std::make_move_iterator(std::end(entries)));
+  if (ndpTableSnapshot_ && ndpTableSnapshot_->serve(ndpTable)) {
+    return;
+  }
+  ndpTable = getNdpTableHelper(*sw_);
 }
 
 void ThriftHandler::getArpTable(std::vector<ArpEntryThrift>& arpTable) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  auto entries = sw_->getNeighborUpdater()->getArpCacheData().get();
-  arpTable.reserve(entries.size());
-  arpTable.insert(
-      arpTable.begin(),
-      std::make_move_iterator(std::begin(entries)),
-      std::make_move_iterator(std::end(entries)));
+  if (arpTableSnapshot_ && arpTableSnapshot_->serve(arpTable)) {
+    return;
+  }
+  arpTable = getArpTableHelper(*sw_);
 }
 
 void ThriftHandler::getL2Table(std::vector<L2EntryThrift>& l2Table) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  sw_->getHw()->fetchL2Table(&l2Table);
+  if (!l2TableSnapshot_ || !l2TableSnapshot_->serve(l2Table)) {
+    l2Table = getL2TableHelper(*sw_);
+  }
   XLOG(DBG6) << "L2 Table size:" << l2Table.size();
 }
 
 void ThriftHandler::getAclTable(std::vector<AclEntryThrift>& aclTable) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  aclTable.reserve(sw_->getState()->getAcls()->numEntries());
-  for (const auto& aclEntry : *(sw_->getState()->getAcls())) {
-    aclTable.push_back(populateAclEntryThrift(*aclEntry));
+  if (aclTableSnapshot_ && aclTableSnapshot_->serve(aclTable)) {
+    return;
   }
+  aclTable = getAclTableHelper(*sw_->getState());
 }
 
 void ThriftHandler::getAggregatePort(
@@ -862,14 +958,13 @@ void ThriftHandler::getAllPortInfo(map<int32_t, PortInfoThrift>& portInfoMap) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
 
+  if (portInfoSnapshot_ && portInfoSnapshot_->serve(portInfoMap)) {
+    return;
+  }
   // NOTE: important to take pointer to switch state before iterating over
   // list of ports
   std::shared_ptr<SwitchState> swState = sw_->getState();
-  for (const auto& port : *(swState->getPorts())) {
-    auto portId = port->getID();
-    auto& portInfo = portInfoMap[portId];
-    getPortInfoHelper(*sw_, portInfo, port);
-  }
+  portInfoMap = getAllPortInfoHelper(*sw_, *swState);
 }
 
 void ThriftHandler::clearPortStats(unique_ptr<vector<int32_t>> ports) {
@@ -1971,6 +2066,37 @@ void ThriftHandler::getPlatformMapping(cfg::PlatformMapping& ret) {
   ret = sw_->getPlatform()->getPlatformMapping()->toThrift();
 }
 
+void ThriftHandler::getReadSnapshotInfo(std::vector<ReadSnapshotInfo>& infos) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  if (readSnapshots_) {
+    infos = readSnapshots_->getInfo();
+  }
+}
+
+void ThriftHandler::getPortCounterAggregates(
+    std::vector<PortCounterAggregate>& aggregates) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  aggregates = getPortCounterStore()->getAggregates();
+}
+
+void ThriftHandler::getPortCounterHistory(
+    std::vector<PortCounterSample>& samples,
+    std::unique_ptr<std::string> portName,
+    std::unique_ptr<std::string> counter) {
+  auto log = LOG_THRIFT_CALL(DBG1, *portName, *counter);
+  ensureConfigured(__func__);
+  samples = getPortCounterStore()->getHistory(*portName, *counter);
+}
+
+const HwPortCounterStore* ThriftHandler::getPortCounterStore() const {
+  auto store = sw_->getHw()->getPortCounterStore();
+  if (!store) {
+    throw FbossError("Port counter store not supported on this platform");
+  }
+  return store;
+}
+
 void ThriftHandler::listHwObjects(
     std::string& out,
     std::unique_ptr<std::vector<HwObjectType>> hwObjects,
@@ -16,6 +16,7 @@
 
 #include "common/fb303/cpp/FacebookBase2.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/ThriftReadSnapshots.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
 #include "fboss/agent/if/gen-cpp2/NeighborListenerClient.h"
@@ -35,6 +36,7 @@ class SwSwitch;
 class Vlan;
 class SwitchState;
 class AclEntry;
+class HwPortCounterStore;
 struct LinkNeighbor;
 
 class ThriftHandler : virtual public FbossCtrlSvIf,
@@ -317,6 +319,15 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
 
   void getPlatformMapping(cfg::PlatformMapping& ret) override;
 
+  void getReadSnapshotInfo(std::vector<ReadSnapshotInfo>& infos) override;
+
+  void getPortCounterAggregates(
+      std::vector<PortCounterAggregate>& aggregates) override;
+  void getPortCounterHistory(
+      std::vector<PortCounterSample>& samples,
+      std::unique_ptr<std::string> portName,
+      std::unique_ptr<std::string> counter) override;
+
  protected:
   void addMplsRoutesImpl(
       std::shared_ptr<SwitchState>* state,
@@ -371,6 +382,11 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
 
   void fillPortStats(PortInfoThrift& portInfo, int numPortQs = 0);
 
+  void initReadSnapshots();
+
+  // Throws FbossError if the HwSwitch has no port counter store
+  const HwPortCounterStore* getPortCounterStore() const;
+
   Vlan* getVlan(int32_t vlanId);
   Vlan* getVlan(const std::string& vlanName);
   template <typename ADDR_TYPE, typename ADDR_CONVERTER>
@@ -399,6 +415,15 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
   std::vector<const TConnectionContext*> brokenClients_;
 
   apache::thrift::SSLPolicy sslPolicy_;
+
+  // Only set with --thrift_read_snapshot_interval_ms
+  std::unique_ptr<ThriftReadSnapshots> readSnapshots_;
+  ThriftReadSnapshot<std::map<int32_t, PortInfoThrift>>* portInfoSnapshot_{
+      nullptr};
+  ThriftReadSnapshot<std::vector<ArpEntryThrift>>* arpTableSnapshot_{nullptr};
+  ThriftReadSnapshot<std::vector<NdpEntryThrift>>* ndpTableSnapshot_{nullptr};
+  ThriftReadSnapshot<std::vector<L2EntryThrift>>* l2TableSnapshot_{nullptr};
+  ThriftReadSnapshot<std::vector<AclEntryThrift>>* aclTableSnapshot_{nullptr};
 };
 
 } // namespace facebook::fboss
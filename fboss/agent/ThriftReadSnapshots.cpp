@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/ThriftReadSnapshots.h"
+
+#include "fboss/agent/SwSwitch.h"
+
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+ThriftReadSnapshots::ThriftReadSnapshots(
+    SwSwitch* sw,
+    std::chrono::milliseconds interval,
+    std::chrono::milliseconds maxAge)
+    : sw_(sw), interval_(interval), maxAge_(maxAge) {}
+
+ThriftReadSnapshots::~ThriftReadSnapshots() {
+  stop();
+}
+
+void ThriftReadSnapshots::start() {
+  scheduler_.setThreadName("ThriftSnapshots");
+  scheduler_.addFunction([this]() { refresh(); }, interval_, "refresh");
+  scheduler_.start();
+}
+
+void ThriftReadSnapshots::stop() {
+  scheduler_.shutdown();
+}
+
+void ThriftReadSnapshots::refresh() {
+  if (!sw_->isFullyConfigured() || sw_->isExiting()) {
+    return;
+  }
+  // All the snapshots of a round are built from the same state
+  auto state = sw_->getState();
+  for (auto& snapshot : snapshots_) {
+    try {
+      snapshot->refresh(state);
+    } catch (const std::exception& ex) {
+      // Keep the last snapshot, getters build the response themselves once
+      // it is too old
+      XLOG(ERR) << "Failed to refresh thrift snapshot " << snapshot->getName()
+                << ": " << folly::exceptionStr(ex);
+    }
+  }
+}
+
+std::vector<ReadSnapshotInfo> ThriftReadSnapshots::getInfo() const {
+  std::vector<ReadSnapshotInfo> infos;
+  infos.reserve(snapshots_.size());
+  for (const auto& snapshot : snapshots_) {
+    infos.push_back(snapshot->getInfo());
+  }
+  return infos;
+}
+
+} // namespace facebook::fboss
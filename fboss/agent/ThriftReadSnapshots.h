@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/experimental/FunctionScheduler.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::fboss {
+
+class SwSwitch;
+
+// The part of ThriftReadSnapshot independent of the response type
+class ThriftReadSnapshotBase {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  ThriftReadSnapshotBase(
+      std::string name,
+      bool stateOnly,
+      std::chrono::milliseconds maxAge)
+      : name_(std::move(name)), stateOnly_(stateOnly), maxAge_(maxAge) {}
+  virtual ~ThriftReadSnapshotBase() {}
+
+  const std::string& getName() const {
+    return name_;
+  }
+
+  /*
+   * Rebuild the snapshot from state.  Snapshots only derived from the switch
+   * state are kept as long as the state generation doesn't change.
+   */
+  virtual void refresh(const std::shared_ptr<SwitchState>& state) = 0;
+  virtual ReadSnapshotInfo getInfo() const = 0;
+
+ protected:
+  const std::string name_;
+  const bool stateOnly_;
+  const std::chrono::milliseconds maxAge_;
+  std::atomic<int64_t> numServed_{0};
+  std::atomic<int64_t> numStale_{0};
+};
+
+/*
+ * The response of a thrift getter, built ahead of the calls.
+ *
+ * Getters read the last snapshot with an atomic load of a shared_ptr, so
+ * they neither take a lock nor wait on the thread building it, which may
+ * itself wait on the update thread, the neighbor thread or the HwSwitch.
+ */
+template <typename T>
+class ThriftReadSnapshot : public ThriftReadSnapshotBase {
+ public:
+  using Builder = std::function<T(const std::shared_ptr<SwitchState>&)>;
+
+  struct Value {
+    std::shared_ptr<const T> response;
+    uint32_t stateGeneration{0};
+    // When the response was last known to be current
+    Clock::time_point refreshedAt;
+    std::chrono::system_clock::time_point refreshedAtWallClock;
+    std::chrono::microseconds buildTime{0};
+  };
+
+  ThriftReadSnapshot(
+      std::string name,
+      Builder builder,
+      bool stateOnly,
+      std::chrono::milliseconds maxAge)
+      : ThriftReadSnapshotBase(std::move(name), stateOnly, maxAge),
+        builder_(std::move(builder)) {}
+
+  // The last snapshot built, null before the first one
+  std::shared_ptr<const Value> get() const {
+    return std::atomic_load(&value_);
+  }
+
+  /*
+   * Copy the snapshot to response, if it was refreshed at most maxAge ago.
+   * Otherwise returns false, and the caller builds the response itself.
+   */
+  bool serve(T& response) {
+    auto value = get();
+    if (!value || Clock::now() - value->refreshedAt > maxAge_) {
+      ++numStale_;
+      return false;
+    }
+    response = *value->response;
+    ++numServed_;
+    return true;
+  }
+
+  void refresh(const std::shared_ptr<SwitchState>& state) override {
+    auto last = get();
+    auto value = std::make_shared<Value>();
+    if (stateOnly_ && last &&
+        last->stateGeneration == state->getGeneration()) {
+      // Still current, share the response
+      *value = *last;
+    } else {
+      auto start = Clock::now();
+      value->response = std::make_shared<const T>(builder_(state));
+      value->stateGeneration = state->getGeneration();
+      value->buildTime = std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now() - start);
+    }
+    value->refreshedAt = Clock::now();
+    value->refreshedAtWallClock = std::chrono::system_clock::now();
+    std::atomic_store(&value_, std::shared_ptr<const Value>(value));
+  }
+
+  ReadSnapshotInfo getInfo() const override {
+    ReadSnapshotInfo info;
+    info.name_ref() = name_;
+    if (auto value = get()) {
+      info.stateGeneration_ref() = value->stateGeneration;
+      info.refreshedAtMs_ref() =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              value->refreshedAtWallClock.time_since_epoch())
+              .count();
+      info.ageMs_ref() = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             Clock::now() - value->refreshedAt)
+                             .count();
+      info.buildTimeUs_ref() = value->buildTime.count();
+    }
+    info.numServed_ref() = numServed_.load();
+    info.numStale_ref() = numStale_.load();
+    return info;
+  }
+
+ private:
+  Builder builder_;
+  // Accessed atomically, replaced by refresh() while getters read it
+  std::shared_ptr<const Value> value_;
+};
+
+/*
+ * Snapshots of thrift responses, rebuilt every interval on a thread of
+ * their own once the switch is fully configured.
+ */
+class ThriftReadSnapshots {
+ public:
+  ThriftReadSnapshots(
+      SwSwitch* sw,
+      std::chrono::milliseconds interval,
+      std::chrono::milliseconds maxAge);
+  ~ThriftReadSnapshots();
+
+  /*
+   * Add a snapshot built by builder.  stateOnly snapshots must only depend
+   * on the state passed to the builder.  Snapshots must all be added before
+   * start().
+   */
+  template <typename T>
+  ThriftReadSnapshot<T>* add(
+      std::string name,
+      typename ThriftReadSnapshot<T>::Builder builder,
+      bool stateOnly) {
+    auto snapshot = std::make_unique<ThriftReadSnapshot<T>>(
+        std::move(name), std::move(builder), stateOnly, maxAge_);
+    auto snapshotPtr = snapshot.get();
+    snapshots_.push_back(std::move(snapshot));
+    return snapshotPtr;
+  }
+
+  void start();
+  void stop();
+
+  // Rebuild all the snapshots now, on the calling thread
+  void refresh();
+
+  std::vector<ReadSnapshotInfo> getInfo() const;
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  ThriftReadSnapshots(ThriftReadSnapshots const&) = delete;
+  ThriftReadSnapshots& operator=(ThriftReadSnapshots const&) = delete;
+
+  SwSwitch* sw_;
+  const std::chrono::milliseconds interval_;
+  const std::chrono::milliseconds maxAge_;
+  std::vector<std::unique_ptr<ThriftReadSnapshotBase>> snapshots_;
+  folly::FunctionScheduler scheduler_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/HwPortCounterStore.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/HwPortFb303Stats.h"
+#include "fboss/agent/hw/StatsConstants.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/Conv.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
+DEFINE_int32(
+    port_counter_history,
+    60,
+    "Number of past stats collection cycles of port counters to keep, "
+    "compressed, in the port counter store");
+
+namespace facebook::fboss {
+
+namespace {
+std::vector<ColumnarCounterStore::Column> portCounterColumns() {
+  std::vector<ColumnarCounterStore::Column> columns;
+  for (auto statKey : HwPortFb303Stats::kPortStatKeys()) {
+    columns.push_back({statKey.str(), ColumnarCounterStore::Encoding::DELTA});
+  }
+  return columns;
+}
+} // namespace
+
+HwPortCounterStore::HwPortCounterStore(size_t maxHistory)
+    : store_(folly::in_place, portCounterColumns(), maxHistory) {}
+
+std::string HwPortCounterStore::aggregateCounterName(
+    folly::StringPiece statKey,
+    folly::StringPiece aggregate) {
+  return folly::to<std::string>("ports.", statKey, ".", aggregate);
+}
+
+void HwPortCounterStore::beginCycle(std::chrono::seconds now) {
+  store_.wlock()->beginCycle(now);
+}
+
+void HwPortCounterStore::updatePort(
+    const std::string& portName,
+    const HwPortStats& stats) {
+  auto values = HwPortFb303Stats::portStatValues(stats);
+  auto store = store_.wlock();
+  auto row = store->rowIndex(portName);
+  for (size_t column = 0; column < values.size(); ++column) {
+    // Stats the port does not support stay uninitialized (-1), keep them
+    // out of the aggregates
+    auto value = values[column];
+    store->set(
+        column,
+        row,
+        value == hardware_stats_constants::STAT_UNINITIALIZED() ? 0 : value);
+  }
+}
+
+void HwPortCounterStore::endCycle() {
+  auto aggregates = [this] {
+    auto store = store_.wlock();
+    store->endCycle();
+    std::vector<std::pair<ColumnarCounterStore::Aggregate, double>> result;
+    for (size_t column = 0; column < store->columns().size(); ++column) {
+      result.emplace_back(store->aggregate(column), store->rateSum(column));
+    }
+    return result;
+  }();
+  auto statKeys = HwPortFb303Stats::kPortStatKeys();
+  for (size_t column = 0; column < aggregates.size(); ++column) {
+    const auto& [aggregate, rate] = aggregates[column];
+    auto statKey = statKeys[column];
+    fb303::fbData->setCounter(
+        aggregateCounterName(statKey, "min"), aggregate.min);
+    fb303::fbData->setCounter(
+        aggregateCounterName(statKey, "max"), aggregate.max);
+    fb303::fbData->setCounter(
+        aggregateCounterName(statKey, "sum"), aggregate.sum);
+    fb303::fbData->setCounter(
+        aggregateCounterName(statKey, "rate"), static_cast<int64_t>(rate));
+  }
+}
+
+void HwPortCounterStore::resetPort(const std::string& portName) {
+  auto store = store_.wlock();
+  if (auto row = store->findRow(portName)) {
+    store->resetRow(*row);
+  }
+}
+
+std::vector<PortCounterAggregate> HwPortCounterStore::getAggregates() const {
+  std::vector<PortCounterAggregate> aggregates;
+  auto store = store_.rlock();
+  for (size_t column = 0; column < store->columns().size(); ++column) {
+    auto aggregate = store->aggregate(column);
+    PortCounterAggregate result;
+    result.counter_ref() = store->columns()[column].name;
+    result.min_ref() = aggregate.min;
+    result.max_ref() = aggregate.max;
+    result.sum_ref() = aggregate.sum;
+    result.rate_ref() = store->rateSum(column);
+    result.timestamp_ref() = store->latestTimestamp().count();
+    aggregates.push_back(std::move(result));
+  }
+  return aggregates;
+}
+
+std::vector<PortCounterSample> HwPortCounterStore::getHistory(
+    const std::string& portName,
+    const std::string& counter) const {
+  auto store = store_.rlock();
+  auto row = store->findRow(portName);
+  if (!row) {
+    throw FbossError("No counters for port ", portName);
+  }
+  const auto& columns = store->columns();
+  auto column = std::find_if(
+      columns.begin(), columns.end(), [&counter](const auto& entry) {
+        return entry.name == counter;
+      });
+  if (column == columns.end()) {
+    throw FbossError("Unknown port counter ", counter);
+  }
+  std::vector<PortCounterSample> samples;
+  for (const auto& [timestamp, value] :
+       store->history(column - columns.begin(), *row)) {
+    PortCounterSample sample;
+    sample.timestamp_ref() = timestamp.count();
+    sample.value_ref() = value;
+    samples.push_back(std::move(sample));
+  }
+  return samples;
+}
+
+} // namespace facebook::fboss
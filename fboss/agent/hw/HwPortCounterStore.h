@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/lib/ColumnarCounterStore.h"
+
+#include <folly/Synchronized.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Port counters of all enabled ports, one row per port name and one column
+ * per HwPortFb303Stats::kPortStatKeys() stat, with recent history.
+ *
+ * The HwSwitch stats collection writes every port once per cycle, between
+ * beginCycle() and endCycle(). endCycle() exports the aggregates over all
+ * ports to fb303 (ports.<stat>.{min,max,sum,rate}), and thrift reads the
+ * aggregates and per port history.
+ */
+class HwPortCounterStore {
+ public:
+  explicit HwPortCounterStore(size_t maxHistory);
+
+  void beginCycle(std::chrono::seconds now);
+  void updatePort(const std::string& portName, const HwPortStats& stats);
+  void endCycle();
+  /*
+   * Zero the counters of a port that went away, so they drop out of the
+   * aggregates. No-op for ports never written.
+   */
+  void resetPort(const std::string& portName);
+
+  std::vector<PortCounterAggregate> getAggregates() const;
+  // Newest first. Throws FbossError for an unknown port or counter.
+  std::vector<PortCounterSample> getHistory(
+      const std::string& portName,
+      const std::string& counter) const;
+
+  static std::string aggregateCounterName(
+      folly::StringPiece statKey,
+      folly::StringPiece aggregate);
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  HwPortCounterStore(HwPortCounterStore const&) = delete;
+  HwPortCounterStore& operator=(HwPortCounterStore const&) = delete;
+
+  folly::Synchronized<ColumnarCounterStore> store_;
+};
+
+} // namespace facebook::fboss
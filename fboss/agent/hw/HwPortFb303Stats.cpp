@@ -44,6 +44,35 @@ std::array<folly::StringPiece, 23> HwPortFb303Stats::kPortStatKeys() {
   };
 }
 
+std::array<int64_t, 23> HwPortFb303Stats::portStatValues(
+    const HwPortStats& portStats) {
+  return {
+      *portStats.inBytes__ref(),
+      *portStats.inUnicastPkts__ref(),
+      *portStats.inMulticastPkts__ref(),
+      *portStats.inBroadcastPkts__ref(),
+      *portStats.inDiscards__ref(),
+      *portStats.inErrors__ref(),
+      *portStats.inPause__ref(),
+      *portStats.inIpv4HdrErrors__ref(),
+      *portStats.inIpv6HdrErrors__ref(),
+      *portStats.inDstNullDiscards__ref(),
+      *portStats.inDiscardsRaw__ref(),
+      *portStats.outBytes__ref(),
+      *portStats.outUnicastPkts__ref(),
+      *portStats.outMulticastPkts__ref(),
+      *portStats.outBroadcastPkts__ref(),
+      *portStats.outDiscards__ref(),
+      *portStats.outErrors__ref(),
+      *portStats.outPause__ref(),
+      *portStats.outCongestionDiscardPkts__ref(),
+      *portStats.wredDroppedPackets__ref(),
+      *portStats.outEcnCounter__ref(),
+      *portStats.fecCorrectableErrors_ref(),
+      *portStats.fecUncorrectableErrors_ref(),
+  };
+}
+
 std::array<folly::StringPiece, 3> HwPortFb303Stats::kQueueStatKeys() {
   return {kOutCongestionDiscards(), kOutBytes(), kOutPkts()};
 }
@@ -71,6 +71,10 @@ class HwPortFb303Stats {
       folly::StringPiece queueName);
 
   static std::array<folly::StringPiece, 23> kPortStatKeys();
+  /*
+   * Values of the kPortStatKeys() stats, in the same order
+   */
+  static std::array<int64_t, 23> portStatValues(const HwPortStats& portStats);
   static std::array<folly::StringPiece, 3> kQueueStatKeys();
   int64_t getCounterLastIncrement(folly::StringPiece statKey) const;
 
@@ -12,11 +12,14 @@
 
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/Utils.h"
+#include "fboss/lib/JsonFileWriter.h"
 
 #include <folly/FileUtil.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
 
+#include <system_error>
+
 DEFINE_bool(can_warm_boot, true, "Enable/disable warm boot functionality");
 DEFINE_string(
     switch_state_file,
@@ -132,10 +135,16 @@ bool HwSwitchWarmBootHelper::checkAndClearWarmBootFlags() {
   return !forceColdBoot && canWarmBoot;
 }
 
-bool HwSwitchWarmBootHelper::storeWarmBootState(
-    const folly::dynamic& switchState) {
-  warmBootStateWritten_ =
-      dumpStateToFile(warmBootSwitchStateFile(), switchState);
+bool HwSwitchWarmBootHelper::storeWarmBootState(folly::dynamic&& switchState) {
+  try {
+    JsonFileWriter writer(warmBootSwitchStateFile());
+    writer.writeAndRelease(std::move(switchState));
+    writer.commit();
+    warmBootStateWritten_ = true;
+  } catch (const std::system_error& ex) {
+    XLOG(ERR) << "Unable to write warm boot state: " << ex.what();
+    warmBootStateWritten_ = false;
+  }
   return warmBootStateWritten_;
 }
 
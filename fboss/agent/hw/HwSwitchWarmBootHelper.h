@@ -40,7 +40,11 @@ class HwSwitchWarmBootHelper {
    */
   void setCanWarmBoot();
 
-  bool storeWarmBootState(const folly::dynamic& switchState);
+  /*
+   * Write the switch state file atomically. The state is freed as it is
+   * written, to keep memory low during graceful exit.
+   */
+  bool storeWarmBootState(folly::dynamic&& switchState);
   folly::dynamic getWarmBootState() const;
 
   std::string startupSdkDumpFile() const;
@@ -51,7 +51,8 @@ namespace facebook::fboss {
 std::ostream& operator<<(
     std::ostream& os,
     const facebook::fboss::BcmMultiPathNextHopKey& key) {
-  return os << "BcmMultiPathNextHop: " << key.second << "@vrf " << key.first;
+  return os << "BcmMultiPathNextHop: " << key.second->nextHops() << "@vrf "
+            << key.first;
 }
 
 using folly::IPAddress;
@@ -57,14 +57,15 @@ BcmLabelSwitchAction::BcmLabelSwitchAction(
       /* PHP reuses same egress objects as those of L3, because PHP are
        * unlabeled next hops */
       nexthop_ = hw->writableMultiPathNextHopTable()->referenceOrEmplaceNextHop(
-          BcmMultiPathNextHopKey(
+          makeBcmMultiPathNextHopKey(
               0 /* vrfid */,
               utility::stripLabelForwarding(entry.normalizedNextHops())));
     } else {
       // put decremented TTL into outgoing L3 packets
       action_.flags |= BCM_MPLS_SWITCH_OUTER_TTL;
       nexthop_ = hw->writableMultiPathNextHopTable()->referenceOrEmplaceNextHop(
-          BcmMultiPathNextHopKey(0 /* vrfid */, entry.normalizedNextHops()));
+          BcmMultiPathNextHopKey(
+              0 /* vrfid */, entry.normalizedInternedNextHops()));
     }
     action_.egress_if = nexthop_->getEgressId();
   }
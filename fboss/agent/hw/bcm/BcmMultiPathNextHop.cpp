@@ -14,7 +14,7 @@ BcmMultiPathNextHop::BcmMultiPathNextHop(
     const BcmSwitchIf* hw,
     BcmMultiPathNextHopKey key)
     : hw_(hw), vrf_(key.first) {
-  auto& fwd = key.second;
+  const auto& fwd = key.second->nextHops();
   CHECK_GT(fwd.size(), 0);
   BcmEcmpEgress::EgressId2Weight egressId2Weight;
   std::vector<std::shared_ptr<BcmNextHop>> nexthops;
@@ -41,7 +41,7 @@ BcmMultiPathNextHop::BcmMultiPathNextHop(
     ecmpEgress_ =
         std::make_unique<BcmEcmpEgress>(hw, std::move(egressId2Weight));
   }
-  fwd_ = std::move(fwd);
+  fwd_ = std::move(key.second);
   nexthops_ = std::move(nexthops);
 }
 
@@ -63,7 +63,7 @@ bcm_if_t BcmMultiPathNextHop::getEgressId() const {
 BcmMultiPathNextHop::~BcmMultiPathNextHop() {
   // Deref ECMP egress first since the ECMP egress entry holds references
   // to egress entries.
-  XLOG(DBG3) << "Removing egress object for " << fwd_;
+  XLOG(DBG3) << "Removing egress object for " << fwd_->nextHops();
 }
 
 long BcmMultiPathNextHopTable::getEcmpEgressCount() const {
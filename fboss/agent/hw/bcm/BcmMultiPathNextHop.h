@@ -26,7 +26,13 @@ namespace facebook::fboss {
  * BcmMultiPathNextHop simply references another egress entry (which maybe
  * either BcmEgress or BcmEcmpEgress).
  */
-using BcmMultiPathNextHopKey = std::pair<bcm_vrf_t, RouteNextHopSet>;
+using BcmMultiPathNextHopKey = std::pair<bcm_vrf_t, InternedNextHopSetPtr>;
+
+inline BcmMultiPathNextHopKey makeBcmMultiPathNextHopKey(
+    bcm_vrf_t vrf,
+    RouteNextHopSet nhops) {
+  return BcmMultiPathNextHopKey(vrf, internNextHopSet(std::move(nhops)));
+}
 
 class BcmNextHop;
 
@@ -48,7 +54,7 @@ class BcmMultiPathNextHop {
 
   const BcmSwitchIf* hw_;
   bcm_vrf_t vrf_;
-  RouteNextHopSet fwd_;
+  InternedNextHopSetPtr fwd_;
   std::vector<std::shared_ptr<BcmNextHop>> nexthops_;
   std::unique_ptr<BcmEcmpEgress> ecmpEgress_;
 };
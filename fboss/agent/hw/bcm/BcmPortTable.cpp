@@ -21,18 +21,25 @@
 
 #include <folly/Memory.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <optional>
 
 extern "C" {
 #include <bcm/port.h>
 }
 
+DECLARE_int32(port_counter_history);
+
 namespace facebook::fboss {
 
 using std::make_pair;
 using std::make_unique;
 using std::unique_ptr;
 
-BcmPortTable::BcmPortTable(BcmSwitch* hw) : hw_(hw) {}
+BcmPortTable::BcmPortTable(BcmSwitch* hw)
+    : hw_(hw), portCounterStore_(FLAGS_port_counter_history) {}
 
 BcmPortTable::~BcmPortTable() {}
 
@@ -152,10 +159,24 @@ BcmPort* BcmPortTable::getBcmPortIf(PortID id) const {
 }
 
 void BcmPortTable::updatePortStats() {
+  auto now = std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+  portCounterStore_.beginCycle(now);
   for (const auto& entry : bcmPhysicalPorts_) {
     BcmPort* bcmPort = entry.second.get();
     bcmPort->updateStats();
+    // Disabled ports keep their last stats, drop them from the store
+    std::optional<HwPortStats> stats;
+    if (bcmPort->isEnabled()) {
+      stats = bcmPort->getPortStats();
+    }
+    if (stats) {
+      portCounterStore_.updatePort(bcmPort->getPortName(), *stats);
+    } else {
+      portCounterStore_.resetPort(bcmPort->getPortName());
+    }
   }
+  portCounterStore_.endCycle();
 }
 
 void BcmPortTable::initPortGroups() {
@@ -16,6 +16,7 @@ extern "C" {
 
 #include <folly/concurrency/ConcurrentHashMap.h>
 #include "fboss/agent/Utils.h"
+#include "fboss/agent/hw/HwPortCounterStore.h"
 #include "fboss/agent/hw/bcm/BcmPort.h"
 #include "fboss/agent/types.h"
 
@@ -72,10 +73,14 @@ class BcmPortTable {
   }
 
   /*
-   * Update all ports' statistics.
+   * Update all ports' statistics, as one cycle of the port counter store.
    */
   void updatePortStats();
 
+  const HwPortCounterStore& getPortCounterStore() const {
+    return portCounterStore_;
+  }
+
   bool portExists(PortID port) const {
     return getBcmPortIf(port) != nullptr;
   }
@@ -133,6 +138,8 @@ class BcmPortTable {
   // outside of the BcmPort objects. This is mainly here to keep a simple
   // ownership model for the port group objects
   BcmPortGroupList bcmPortGroups_;
+
+  HwPortCounterStore portCounterStore_;
 };
 
 } // namespace facebook::fboss
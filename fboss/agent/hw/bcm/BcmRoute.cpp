@@ -202,7 +202,7 @@ void BcmRoute::program(
     // need to get an entry from the host table for the forward info
     nexthopReference =
         hw_->writableMultiPathNextHopTable()->referenceOrEmplaceNextHop(
-            BcmMultiPathNextHopKey(vrf_, fwd.getNextHopSet()));
+            BcmMultiPathNextHopKey(vrf_, fwd.getInternedNextHopSet()));
     egressId = nexthopReference->getEgressId();
   }
 
@@ -413,7 +413,8 @@ void BcmRouteTable::addRoute(bcm_vrf_t vrf, const RouteT* route) {
   CHECK(route->isResolved());
   RouteNextHopEntry fwd(route->getForwardInfo());
   if (fwd.getAction() == RouteForwardAction::NEXTHOPS) {
-    fwd = RouteNextHopEntry(fwd.normalizedNextHops(), fwd.getAdminDistance());
+    fwd = RouteNextHopEntry(
+        fwd.normalizedInternedNextHops(), fwd.getAdminDistance());
   }
   ret.first->second->program(fwd, route->getClassID());
 }
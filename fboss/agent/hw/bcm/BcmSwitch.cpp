@@ -484,7 +484,9 @@ void BcmSwitch::gracefulExit(folly::dynamic& switchState) {
   dumpState(platform_->getWarmBootHelper()->shutdownSdkDumpFile());
 
   switchState[kHwSwitch] = toFollyDynamic();
-  unitObject_->writeWarmBootState(switchState);
+  // The state is not needed past this point, let the writer free it as it
+  // goes
+  unitObject_->writeWarmBootState(std::move(switchState));
   unitObject_.reset();
   XLOG(INFO)
       << "[Exit] BRCM Graceful Exit time "
@@ -2571,6 +2573,10 @@ folly::F14FastMap<std::string, HwPortStats> BcmSwitch::getPortStats() const {
   return portStats;
 }
 
+const HwPortCounterStore* BcmSwitch::getPortCounterStore() const {
+  return &portTable_->getPortCounterStore();
+}
+
 shared_ptr<BcmSwitchEventCallback> BcmSwitch::registerSwitchEventCallback(
     bcm_switch_event_t eventID,
     shared_ptr<BcmSwitchEventCallback> callback) {
@@ -373,6 +373,8 @@ class BcmSwitch : public BcmSwitchIf {
 
   folly::F14FastMap<std::string, HwPortStats> getPortStats() const override;
 
+  const HwPortCounterStore* getPortCounterStore() const override;
+
   uint64_t getDeviceWatermarkBytes() const override;
 
   /*
@@ -183,7 +183,7 @@ int bdeSpiWrite(soc_cm_dev_t* dev, uint32_t addr, uint8_t* buf, int len) {
 } // unnamed namespace
 
 namespace facebook::fboss {
-void BcmUnit::writeWarmBootState(const folly::dynamic& switchState) {
+void BcmUnit::writeWarmBootState(folly::dynamic&& switchState) {
   if (!BcmAPI::isHwUsingHSDK()) {
     XLOG(INFO) << " [Exit] Syncing BRCM switch state to file";
     steady_clock::time_point bcmWarmBootSyncStart = steady_clock::now();
@@ -200,7 +200,7 @@ void BcmUnit::writeWarmBootState(const folly::dynamic& switchState) {
   // Now write our state to file
   XLOG(INFO) << " [Exit] Syncing FBOSS switch state to file";
   steady_clock::time_point fbossWarmBootSyncStart = steady_clock::now();
-  if (!warmBootHelper()->storeWarmBootState(switchState)) {
+  if (!warmBootHelper()->storeWarmBootState(std::move(switchState))) {
     XLOG(FATAL) << "Unable to write switch state JSON to file";
   }
   steady_clock::time_point fbossWarmBootSyncDone = steady_clock::now();
@@ -49,7 +49,7 @@ class BcmUnit {
   /*
    * Flush warm boot state to disk,
    */
-  void writeWarmBootState(const folly::dynamic& switchState);
+  void writeWarmBootState(folly::dynamic&& switchState);
 
   bool isAttached() const {
     return attached_.load(std::memory_order_acquire);
@@ -10,14 +10,20 @@
 #include "fboss/agent/hw/bcm/BcmWarmBootCache.h"
 
 #include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <string>
 #include <utility>
 
+#include <fb303/ServiceData.h>
 #include <folly/Conv.h>
 #include <folly/dynamic.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include "fboss/agent/Constants.h"
@@ -81,6 +87,12 @@ using std::string;
 using std::vector;
 using namespace facebook::fboss;
 
+DEFINE_int32(
+    bcm_warm_boot_cache_threads,
+    4,
+    "Number of threads populating the warm boot cache from the SDK tables, "
+    "1 populates them one after the other");
+
 namespace {
 auto constexpr kEcmpObjects = "ecmpObjects";
 auto constexpr kTrunks = "trunks";
@@ -405,7 +417,92 @@ BcmWarmBootCache::findEgressFromLabeledHostKey(const BcmLabeledHostKey& key) {
 }
 
 void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
-  populateFromWarmBootState(warmBootState);
+  /*
+   * Population runs in two phases of independent tasks, each task filling
+   * its own maps:
+   *  - reading the warm boot state file and traversing the tables which
+   *    don't need it (hosts, routes, acls, mirrors, qos maps, ...)
+   *  - traversing the tables which are cross-referenced with the warm boot
+   *    state: vlans and their l3 interfaces, egresses and ecmp egresses.
+   * The SDK serializes accesses to each table, so traversals of different
+   * tables can run concurrently.
+   */
+  auto populateStart = std::chrono::steady_clock::now();
+  bcm_l3_info_t l3Info;
+  bcm_l3_info_t_init(&l3Info);
+  bcm_l3_info(hw_->getUnit(), &l3Info);
+
+  runPopulateTasks({
+      {"warm_boot_state",
+       [this, &warmBootState]() { populateFromWarmBootState(warmBootState); }},
+      {"hosts", [this, &l3Info]() { populateHosts(l3Info); }},
+      {"routes", [this, &l3Info]() { populateRoutes(l3Info); }},
+      // populate acls, acl stats
+      {"acls",
+       [this]() {
+         populateAcls(
+             hw_->getPlatform()->getAsic()->getDefaultACLGroupID(),
+             this->aclEntry2AclStat_,
+             this->priority2BcmAclEntryHandle_);
+       }},
+      {"rtag7", [this]() { populateRtag7State(); }},
+      {"mirrors",
+       [this]() {
+         populateMirrors();
+         populateMirroredPorts();
+       }},
+      {"qos_maps", [this]() { populateQosMaps(); }},
+      {"label_switch_actions", [this]() { populateLabelSwitchActions(); }},
+      {"switch_settings", [this]() { populateSwitchSettings(); }},
+      {"rx_reason_to_queue", [this]() { populateRxReasonToQueue(); }},
+  });
+  runPopulateTasks({
+      {"vlans", [this]() { populateVlans(); }},
+      {"egresses", [this]() { populateEgresses(); }},
+      {"ecmp_egresses", [this]() { populateEcmpEgresses(); }},
+  });
+
+  auto populateMsecs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - populateStart)
+                           .count();
+  XLOG(DBG1) << "Warm boot cache populated in " << populateMsecs << "ms";
+  fb303::fbData->setCounter("warm_boot.cache_populate.msecs", populateMsecs);
+}
+
+void BcmWarmBootCache::runPopulateTasks(
+    const std::vector<std::pair<std::string, std::function<void()>>>& tasks) {
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+  if (FLAGS_bcm_warm_boot_cache_threads > 1) {
+    executor = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::min<size_t>(FLAGS_bcm_warm_boot_cache_threads, tasks.size()),
+        std::make_shared<folly::NamedThreadFactory>("WarmBootCache"));
+  }
+  std::vector<folly::Future<folly::Unit>> results;
+  for (const auto& [name, task] : tasks) {
+    auto timedTask = [&name = name, &task = task]() {
+      auto start = std::chrono::steady_clock::now();
+      task();
+      auto msecs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+      XLOG(DBG1) << "Warm boot cache populated " << name << " in " << msecs
+                 << "ms";
+      fb303::fbData->setCounter(
+          folly::to<std::string>("warm_boot.cache_populate.", name, ".msecs"),
+          msecs);
+    };
+    if (executor) {
+      results.push_back(folly::via(executor.get(), timedTask));
+    } else {
+      timedTask();
+    }
+  }
+  for (auto& result : folly::collectAll(results).get()) {
+    result.throwIfFailed();
+  }
+}
+
+void BcmWarmBootCache::populateVlans() {
   bcm_vlan_data_t* vlanList = nullptr;
   int vlanCount = 0;
   SCOPE_EXIT {
@@ -470,12 +567,12 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
       }
     }
   }
-  bcm_l3_info_t l3Info;
-  bcm_l3_info_t_init(&l3Info);
-  bcm_l3_info(hw_->getUnit(), &l3Info);
+}
+
+void BcmWarmBootCache::populateHosts(const bcm_l3_info_t& l3Info) {
   if (hw_->getPlatform()->getAsic()->isSupported(HwAsic::Feature::HOSTTABLE)) {
     // Traverse V4 hosts
-    rv = bcm_l3_host_traverse(
+    auto rv = bcm_l3_host_traverse(
         hw_->getUnit(),
         0,
         0,
@@ -494,8 +591,11 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
         this);
     bcmCheckError(rv, "Failed to traverse v6 hosts");
   }
+}
+
+void BcmWarmBootCache::populateRoutes(const bcm_l3_info_t& l3Info) {
   // Traverse V4 routes
-  rv = bcm_l3_route_traverse(
+  auto rv = bcm_l3_route_traverse(
       hw_->getUnit(),
       0,
       0,
@@ -513,10 +613,18 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
       routeTraversalCallback,
       this);
   bcmCheckError(rv, "Failed to traverse v6 routes");
+}
+
+void BcmWarmBootCache::populateEgresses() {
   // Get egress entries.
-  rv = bcm_l3_egress_traverse(hw_->getUnit(), egressTraversalCallback, this);
+  auto rv =
+      bcm_l3_egress_traverse(hw_->getUnit(), egressTraversalCallback, this);
   bcmCheckError(rv, "Failed to traverse egress");
+}
+
+void BcmWarmBootCache::populateEcmpEgresses() {
   // Traverse ecmp egress entries
+  int rv;
   if (hw_->getPlatform()->getAsic()->isSupported(HwAsic::Feature::HSDK)) {
     rv = bcm_l3_ecmp_traverse(
         hw_->getUnit(),
@@ -527,20 +635,6 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
         hw_->getUnit(), ecmpEgressTraversalCallback<bcm_if_t>, this);
   }
   bcmCheckError(rv, "Failed to traverse ecmp egress");
-
-  // populate acls, acl stats
-  populateAcls(
-      hw_->getPlatform()->getAsic()->getDefaultACLGroupID(),
-      this->aclEntry2AclStat_,
-      this->priority2BcmAclEntryHandle_);
-
-  populateRtag7State();
-  populateMirrors();
-  populateMirroredPorts();
-  populateQosMaps();
-  populateLabelSwitchActions();
-  populateSwitchSettings();
-  populateRxReasonToQueue();
 }
 
 bool BcmWarmBootCache::fillVlanPortInfo(Vlan* vlan) {
@@ -26,6 +26,7 @@ extern "C" {
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <algorithm>
+#include <functional>
 #include <list>
 #include <memory>
 #include <optional>
@@ -607,6 +608,18 @@ class BcmWarmBootCache {
   const EgressId2Weight& getPathsForEcmp(EgressId ecmp) const;
   folly::dynamic getWarmBootState() const;
   void populateFromWarmBootState(const folly::dynamic& warmBootState);
+  /*
+   * Run independent population tasks, concurrently unless
+   * --bcm_warm_boot_cache_threads is 1, and export how long each one took
+   * as warm_boot.cache_populate.<name>.msecs counters.
+   */
+  void runPopulateTasks(
+      const std::vector<std::pair<std::string, std::function<void()>>>& tasks);
+  void populateVlans();
+  void populateHosts(const bcm_l3_info_t& l3Info);
+  void populateRoutes(const bcm_l3_info_t& l3Info);
+  void populateEgresses();
+  void populateEcmpEgresses();
   // No copy or assignment.
   BcmWarmBootCache(const BcmWarmBootCache&) = delete;
   BcmWarmBootCache& operator=(const BcmWarmBootCache&) = delete;
@@ -112,7 +112,7 @@ folly::dynamic BcmWarmBootState::toFollyDynamic(
   folly::dynamic ecmpHost = folly::dynamic::object;
   ecmpHost[kVrf] = key.first;
   folly::dynamic nhops = folly::dynamic::array;
-  for (const auto& nhop : key.second) {
+  for (const auto& nhop : key.second->nextHops()) {
     nhops.push_back(nhop.toFollyDynamic());
   }
   ecmpHost[kNextHops] = std::move(nhops);
@@ -93,7 +93,7 @@ const BcmMultiPathNextHop* BcmEcmpTest::getBcmMultiPathNextHop() const {
   for (const auto& nhop : resolvedRoute->getForwardInfo().getNextHopSet()) {
     nhops.insert(ResolvedNextHop(nhop.addr(), nhop.intf(), ws[nhop.addr()]));
   }
-  return multiPathTable->getNextHop(BcmMultiPathNextHopKey(kRid, nhops));
+  return multiPathTable->getNextHop(makeBcmMultiPathNextHopKey(kRid, nhops));
 }
 
 const BcmEcmpEgress* BcmEcmpTest::getEcmpEgress() const {
@@ -116,12 +116,12 @@ class BcmLabelSwitchActionTest : public BcmTest {
       // for push & swap, use labeled egresses
       auto reference = getHwSwitch()->getMultiPathNextHopTable()->getNextHop(
           BcmMultiPathNextHopKey(
-              0, entry->getLabelNextHop().normalizedNextHops()));
+              0, entry->getLabelNextHop().normalizedInternedNextHops()));
       EXPECT_EQ(info.egress_if, reference->getEgressId());
     } else {
       // for php reuse L3 egresses
       auto reference = getHwSwitch()->getMultiPathNextHopTable()->getNextHop(
-          BcmMultiPathNextHopKey(
+          makeBcmMultiPathNextHopKey(
               0,
               utility::stripLabelForwarding(
                   entry->getLabelNextHop().normalizedNextHops())));
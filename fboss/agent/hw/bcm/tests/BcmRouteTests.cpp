@@ -328,7 +328,7 @@ class BcmRouteHostReferenceTest : public BcmRouteTest {
         RouteNextHopEntry(
             ResolvedNextHop(nexthop, InterfaceID(interface), weight),
             AdminDistance::MAX_ADMIN_DISTANCE)
-            .getNextHopSet());
+            .getInternedNextHopSet());
   }
 
   long referenceCount(const BcmMultiPathNextHopKey& key) {
@@ -701,14 +701,14 @@ void BcmRouteTest::routeReferenceCountTest(
 void BcmRouteTest::verifyBcmHostReference(
     bcm_vrf_t vrf,
     const RouteNextHopSet& nexthops) {
-  auto count =
-      referenceCount(std::make_pair(vrf, nexthops)); // initial ref count
+  auto key = makeBcmMultiPathNextHopKey(vrf, nexthops);
+  auto count = referenceCount(key); // initial ref count
 
-  auto* ecmpHost = getHwSwitch()->getMultiPathNextHopTable()->getNextHopIf(
-      BcmMultiPathNextHopKey(vrf, nexthops));
+  auto* ecmpHost =
+      getHwSwitch()->getMultiPathNextHopTable()->getNextHopIf(key);
   EXPECT_NE(ecmpHost, nullptr);
 
-  EXPECT_EQ(referenceCount(std::make_pair(vrf, nexthops)), count);
+  EXPECT_EQ(referenceCount(key), count);
 }
 
 void BcmRouteTest::verifyNextHopReferences(
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/Platform.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/String.h>
+#include <folly/dynamic.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+
+DEFINE_bool(json, true, "Output in json form");
+DEFINE_string(
+    phase_counter_prefix,
+    "warm_boot.",
+    "Also report counters with this prefix, which HwSwitches export for "
+    "the phases of warm boot entry (e.g. populating the warm boot cache)");
+DEFINE_bool(
+    setup_for_warmboot,
+    false,
+    "Set to true will prepare the device for warmboot");
+
+/*
+ * Measures how long the HwSwitch takes to come up from warm boot, i.e.
+ * reloading SAI/SDK state and rebuilding the switch state from it. Run it
+ * after sai_warm_boot_exit_speed (or any run that exited for warm boot), with
+ * --setup_for_warmboot to be able to chain several runs.
+ *
+ * Phases timed by the HwSwitch itself, e.g. BCM warm boot cache population,
+ * are reported next to the total.
+ */
+namespace facebook::fboss {
+
+void runBenchmark() {
+  std::unique_ptr<HwSwitchEnsemble> ensemble;
+  std::chrono::duration<double, std::milli> durationMillseconds;
+  {
+    auto startTime = std::chrono::steady_clock::now();
+    ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
+    durationMillseconds = std::chrono::steady_clock::now() - startTime;
+  }
+  if (ensemble->getHwSwitch()->getBootType() != BootType::WARM_BOOT) {
+    XLOG(FATAL) << "Switch did not warm boot, run a warm boot exit first";
+  }
+  std::map<std::string, int64_t> phaseMsecs;
+  for (const auto& [name, value] : fb303::fbData->getCounters()) {
+    if (!FLAGS_phase_counter_prefix.empty() &&
+        folly::StringPiece(name).startsWith(FLAGS_phase_counter_prefix)) {
+      phaseMsecs[name] = value;
+    }
+  }
+  if (FLAGS_json) {
+    folly::dynamic warmBootTime = folly::dynamic::object;
+    warmBootTime["warm_boot_entry_msecs"] = durationMillseconds.count();
+    for (const auto& [name, msecs] : phaseMsecs) {
+      warmBootTime[name] = msecs;
+    }
+    std::cout << warmBootTime << std::endl;
+  } else {
+    XLOG(INFO) << " warm boot entry msecs: " << durationMillseconds.count();
+    for (const auto& [name, msecs] : phaseMsecs) {
+      XLOG(INFO) << " " << name << ": " << msecs;
+    }
+  }
+
+  if (FLAGS_setup_for_warmboot) {
+    ensemble->gracefulExit();
+    // Leak HwSwitchEnsemble for warmboot, so that
+    // we don't run destructors and unprogram h/w.
+    __attribute__((unused)) auto leakedHwEnsemble = ensemble.release();
+  }
+}
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  facebook::fboss::runBenchmark();
+  return 0;
+}
@@ -18,13 +18,17 @@
 #include "fboss/agent/test/EcmpSetupHelper.h"
 #include "fboss/agent/test/RouteScaleGenerators.h"
 
+#include <folly/FileUtil.h>
 #include <folly/IPAddressV6.h>
+#include <folly/String.h>
 #include <folly/dynamic.h>
 #include <folly/init/Init.h>
 #include <folly/json.h>
 
 #include <chrono>
 #include <iostream>
+#include <string>
+#include <vector>
 
 DEFINE_bool(json, true, "Output in json form");
 DEFINE_bool(
@@ -33,18 +37,50 @@ DEFINE_bool(
     "Set to true will prepare the device for warmboot");
 
 namespace {
+/*
+ * Peak RSS (VmHWM) of this process in KB, since start or since the last
+ * resetPeakRss()
+ */
+int64_t peakRssKb() {
+  std::string status;
+  if (!folly::readFile("/proc/self/status", status)) {
+    return -1;
+  }
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', status, lines);
+  for (auto line : lines) {
+    if (line.removePrefix("VmHWM:")) {
+      return folly::to<int64_t>(
+          folly::trimWhitespace(line.subpiece(0, line.find("kB"))));
+    }
+  }
+  return -1;
+}
+
+void resetPeakRss() {
+  // Resets VmHWM to the current RSS
+  if (!folly::writeFile(std::string("5"), "/proc/self/clear_refs")) {
+    XLOG(WARNING) << "Unable to reset peak RSS, peak covers the whole run";
+  }
+}
+
 class StopWatch {
  public:
-  StopWatch() : startTime_(std::chrono::steady_clock::now()) {}
+  StopWatch() : startTime_(std::chrono::steady_clock::now()) {
+    resetPeakRss();
+  }
   ~StopWatch() {
     std::chrono::duration<double, std::milli> durationMillseconds =
         std::chrono::steady_clock::now() - startTime_;
+    auto peakRss = peakRssKb();
     if (FLAGS_json) {
       folly::dynamic warmBootTime = folly::dynamic::object;
       warmBootTime["warm_boot_msecs"] = durationMillseconds.count();
+      warmBootTime["warm_boot_peak_rss_kb"] = peakRss;
       std::cout << warmBootTime << std::endl;
     } else {
       XLOG(INFO) << " warm boot msecs: " << durationMillseconds.count();
+      XLOG(INFO) << " warm boot peak rss KB: " << peakRss;
     }
   }
 
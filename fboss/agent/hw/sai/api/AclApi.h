@@ -543,26 +543,39 @@ class AclApi : public SaiApi<AclApi> {
     return api_->remove_acl_counter(id);
   }
 
-  sai_status_t _getAttribute(AclTableGroupSaiId id, sai_attribute_t* attr)
-      const {
-    return api_->get_acl_table_group_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      AclTableGroupSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_acl_table_group_attribute(id, count, attr);
   }
 
-  sai_status_t _getAttribute(AclTableGroupMemberSaiId id, sai_attribute_t* attr)
-      const {
-    return api_->get_acl_table_group_member_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      AclTableGroupMemberSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_acl_table_group_member_attribute(id, count, attr);
   }
 
-  sai_status_t _getAttribute(AclTableSaiId id, sai_attribute_t* attr) const {
-    return api_->get_acl_table_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      AclTableSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_acl_table_attribute(id, count, attr);
   }
 
-  sai_status_t _getAttribute(AclEntrySaiId id, sai_attribute_t* attr) const {
-    return api_->get_acl_entry_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      AclEntrySaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_acl_entry_attribute(id, count, attr);
   }
 
-  sai_status_t _getAttribute(AclCounterSaiId id, sai_attribute_t* attr) const {
-    return api_->get_acl_counter_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      AclCounterSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_acl_counter_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(AclTableGroupSaiId id, const sai_attribute_t* attr)
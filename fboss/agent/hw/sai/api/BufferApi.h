@@ -120,8 +120,11 @@ class BufferApi : public SaiApi<BufferApi> {
   sai_status_t _remove(BufferPoolSaiId id) {
     return api_->remove_buffer_pool(id);
   }
-  sai_status_t _getAttribute(BufferPoolSaiId key, sai_attribute_t* attr) const {
-    return api_->get_buffer_pool_attribute(key, 1, attr);
+  sai_status_t _getAttribute(
+      BufferPoolSaiId key,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_buffer_pool_attribute(key, count, attr);
   }
   sai_status_t _setAttribute(BufferPoolSaiId key, const sai_attribute_t* attr) {
     return api_->set_buffer_pool_attribute(key, attr);
@@ -158,9 +161,11 @@ class BufferApi : public SaiApi<BufferApi> {
   sai_status_t _remove(BufferProfileSaiId id) {
     return api_->remove_buffer_profile(id);
   }
-  sai_status_t _getAttribute(BufferProfileSaiId key, sai_attribute_t* attr)
-      const {
-    return api_->get_buffer_profile_attribute(key, 1, attr);
+  sai_status_t _getAttribute(
+      BufferProfileSaiId key,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_buffer_profile_attribute(key, count, attr);
   }
   sai_status_t _setAttribute(
       BufferProfileSaiId key,
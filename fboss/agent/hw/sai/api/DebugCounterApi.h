@@ -78,9 +78,11 @@ class DebugCounterApi : public SaiApi<DebugCounterApi> {
     return api_->remove_debug_counter(id);
   }
 
-  sai_status_t _getAttribute(DebugCounterSaiId id, sai_attribute_t* attr)
-      const {
-    return api_->get_debug_counter_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      DebugCounterSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_debug_counter_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(
@@ -180,12 +180,17 @@ class HostifApi : public SaiApi<HostifApi> {
   sai_status_t _remove(HostifTrapSaiId hostif_trap_id) {
     return api_->remove_hostif_trap(hostif_trap_id);
   }
-  sai_status_t _getAttribute(HostifTrapGroupSaiId id, sai_attribute_t* attr)
-      const {
-    return api_->get_hostif_trap_group_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      HostifTrapGroupSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_hostif_trap_group_attribute(id, count, attr);
   }
-  sai_status_t _getAttribute(HostifTrapSaiId id, sai_attribute_t* attr) const {
-    return api_->get_hostif_trap_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      HostifTrapSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_hostif_trap_attribute(id, count, attr);
   }
   sai_status_t _setAttribute(
       HostifTrapGroupSaiId id,
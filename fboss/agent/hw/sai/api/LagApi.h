@@ -98,11 +98,17 @@ class LagApi : public SaiApi<LagApi> {
     return api_->remove_lag_member(id);
   }
 
-  sai_status_t _getAttribute(LagSaiId id, sai_attribute_t* attr) const {
-    return api_->get_lag_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      LagSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_lag_attribute(id, count, attr);
   }
-  sai_status_t _getAttribute(LagMemberSaiId id, sai_attribute_t* attr) const {
-    return api_->get_lag_member_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      LagMemberSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_lag_member_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(LagSaiId id, const sai_attribute_t* attr) {
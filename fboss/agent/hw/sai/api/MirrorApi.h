@@ -259,8 +259,11 @@ class MirrorApi : public SaiApi<MirrorApi> {
     return api_->remove_mirror_session(id);
   }
 
-  sai_status_t _getAttribute(MirrorSaiId id, sai_attribute_t* attr) const {
-    return api_->get_mirror_session_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      MirrorSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_mirror_session_attribute(id, count, attr);
   }
   sai_status_t _setAttribute(MirrorSaiId id, const sai_attribute_t* attr) {
     return api_->set_mirror_session_attribute(id, attr);
@@ -336,8 +336,11 @@ class PortApi : public SaiApi<PortApi> {
   sai_status_t _remove(PortSaiId key) {
     return api_->remove_port(key);
   }
-  sai_status_t _getAttribute(PortSaiId key, sai_attribute_t* attr) const {
-    return api_->get_port_attribute(key, 1, attr);
+  sai_status_t _getAttribute(
+      PortSaiId key,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_port_attribute(key, count, attr);
   }
   sai_status_t _setAttribute(PortSaiId key, const sai_attribute_t* attr) {
     return api_->set_port_attribute(key, attr);
@@ -355,8 +358,11 @@ class PortApi : public SaiApi<PortApi> {
     return api_->remove_port_serdes(id);
   }
 
-  sai_status_t _getAttribute(PortSerdesSaiId key, sai_attribute_t* attr) const {
-    return api_->get_port_serdes_attribute(key, 1, attr);
+  sai_status_t _getAttribute(
+      PortSerdesSaiId key,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_port_serdes_attribute(key, count, attr);
   }
 
   sai_status_t _setAttribute(PortSerdesSaiId key, const sai_attribute_t* attr) {
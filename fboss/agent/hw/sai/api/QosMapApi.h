@@ -76,8 +76,11 @@ class QosMapApi : public SaiApi<QosMapApi> {
   sai_status_t _remove(QosMapSaiId id) {
     return api_->remove_qos_map(id);
   }
-  sai_status_t _getAttribute(QosMapSaiId id, sai_attribute_t* attr) const {
-    return api_->get_qos_map_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      QosMapSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_qos_map_attribute(id, count, attr);
   }
   sai_status_t _setAttribute(QosMapSaiId id, const sai_attribute_t* attr) {
     return api_->set_qos_map_attribute(id, attr);
@@ -121,8 +121,9 @@ class RouteApi : public SaiApi<RouteApi> {
   }
   sai_status_t _getAttribute(
       const SaiRouteTraits::RouteEntry& routeEntry,
-      sai_attribute_t* attr) const {
-    return api_->get_route_entry_attribute(routeEntry.entry(), 1, attr);
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_route_entry_attribute(routeEntry.entry(), count, attr);
   }
   sai_status_t _setAttribute(
       const SaiRouteTraits::RouteEntry& routeEntry,
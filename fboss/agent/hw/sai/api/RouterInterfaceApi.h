@@ -88,9 +88,11 @@ class RouterInterfaceApi : public SaiApi<RouterInterfaceApi> {
   sai_status_t _remove(RouterInterfaceSaiId router_interface_id) {
     return api_->remove_router_interface(router_interface_id);
   }
-  sai_status_t _getAttribute(RouterInterfaceSaiId id, sai_attribute_t* attr)
-      const {
-    return api_->get_router_interface_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      RouterInterfaceSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_router_interface_attribute(id, count, attr);
   }
   sai_status_t _setAttribute(
       RouterInterfaceSaiId key,
@@ -19,11 +19,14 @@
 #include "fboss/lib/TupleUtils.h"
 
 #include <folly/Format.h>
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
 
 #include <algorithm>
 #include <exception>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -86,7 +89,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     sai_status_t status;
     {
       TIME_CALL;
@@ -121,7 +124,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     sai_status_t status;
     {
       TIME_CALL;
@@ -147,7 +150,7 @@ class SaiApi {
           "Attempting to remove SAI obj {} while hw writes are blocked",
           key);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     sai_status_t status;
     {
       TIME_CALL;
@@ -181,7 +184,7 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    SaiApiReadGuard g{SaiApiLock::getInstance()->lock};
     sai_status_t status;
     {
       TIME_CALL;
@@ -285,6 +288,86 @@ class SaiApi {
     }
   }
 
+  /*
+   * Get a tuple of attributes of one object, fetching all the attributes
+   * with primitive values in a single get call with several attributes,
+   * rather than one call each. This is not a SAI bulk api call, which would
+   * span objects. Attributes with lists still go through getAttribute(),
+   * which knows how to size them.
+   *
+   * Should the adapter fail the combined get, we fall back to getAttribute()
+   * for every attribute of the object. If the failure says an attribute or
+   * the combined get is not implemented or supported, every object of that
+   * type would fail the same way, so we stop trying combined gets for the
+   * object type.
+   */
+  template <typename SaiObjectTraits, typename TupleT>
+  TupleT getMultipleAttributes(
+      const typename SaiObjectTraits::AdapterKey& key,
+      const TupleT& attrTuple) {
+    constexpr auto objectType = SaiObjectTraits::ObjectType;
+    TupleT result = attrTuple;
+    std::vector<sai_attribute_t> saiAttrs;
+    if (!multiGetUnsupported_.rlock()->count(objectType)) {
+      tupleForEach(
+          [&saiAttrs](const auto& attr) {
+            using MultiGetT =
+                IsSaiAttributeMultiGettable<std::decay_t<decltype(attr)>>;
+            if constexpr (MultiGetT::value) {
+              saiAttrs.push_back(
+                  *typename MultiGetT::AttributeType{}.saiAttr());
+            }
+          },
+          result);
+    }
+    if (saiAttrs.size() < 2) {
+      result = getAttribute(key, result);
+      return result;
+    }
+    sai_status_t status;
+    {
+      SaiApiReadGuard g{SaiApiLock::getInstance()->lock};
+      TIME_CALL;
+      status = impl()._getAttribute(key, saiAttrs.data(), saiAttrs.size());
+    }
+    if (status != SAI_STATUS_SUCCESS) {
+      auto unsupported = status == SAI_STATUS_NOT_IMPLEMENTED ||
+          status == SAI_STATUS_NOT_SUPPORTED ||
+          SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status) ||
+          SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+          SAI_STATUS_IS_UNKNOWN_ATTRIBUTE(status);
+      XLOGF(
+          WARN,
+          "Get of {} attributes of {} in one call failed with {}, falling "
+          "back to per attribute gets{}",
+          saiAttrs.size(),
+          key,
+          status,
+          unsupported ? " for this object type" : "");
+      if (unsupported) {
+        multiGetUnsupported_.wlock()->insert(objectType);
+      }
+      result = getAttribute(key, result);
+      return result;
+    }
+    auto saiAttr = saiAttrs.begin();
+    tupleForEach(
+        [&key, &saiAttr, this](auto& attr) {
+          using MultiGetT =
+              IsSaiAttributeMultiGettable<std::decay_t<decltype(attr)>>;
+          if constexpr (MultiGetT::value) {
+            typename MultiGetT::AttributeType got;
+            *got.saiAttr() = *saiAttr++;
+            attr = got;
+          } else {
+            attr = getAttribute(key, attr);
+          }
+        },
+        result);
+    XLOGF(DBG5, "got SAI attributes in one call: {}: {}", key, result);
+    return result;
+  }
+
   template <typename AdapterKeyT, typename AttrT>
   void setAttributeUnlocked(const AdapterKeyT& key, const AttrT& attr) {
     if (UNLIKELY(skipHwWrites())) {
@@ -321,7 +404,7 @@ class SaiApi {
   }
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     setAttributeUnlocked(key, attr);
   }
 
@@ -333,7 +416,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size(), mode);
   }
@@ -344,7 +427,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     XLOGF(DBG6, "got SAI stats for {}", key);
     return mode == SAI_STATS_MODE_READ
         ? getStatsImpl<SaiObjectTraits>(
@@ -366,7 +449,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     clearStatsImpl<SaiObjectTraits>(key, counterIds.data(), counterIds.size());
   }
   template <typename SaiObjectTraits>
@@ -374,7 +457,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    std::lock_guard<std::shared_mutex> g{SaiApiLock::getInstance()->lock};
     clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIdsToRead.data(),
@@ -446,6 +529,8 @@ class SaiApi {
     return static_cast<const ApiT&>(*this);
   }
   HwWriteBehavior hwWriteBehavior_{HwWriteBehavior::WRITE};
+  // Object types whose attributes can't be fetched in a single get call
+  folly::Synchronized<std::set<sai_object_type_t>> multiGetUnsupported_;
 };
 
 } // namespace facebook::fboss
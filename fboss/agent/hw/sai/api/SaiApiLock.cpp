@@ -11,7 +11,13 @@
 #include "fboss/agent/hw/sai/api/SaiApiLock.h"
 
 #include <folly/Singleton.h>
-#include <mutex>
+
+DEFINE_bool(
+    sai_concurrent_gets,
+    false,
+    "Let SAI attribute gets run concurrently with each other, e.g. when "
+    "reloading the SaiStore on warm boot. Only for adapters whose get "
+    "functions are thread safe, gets never overlap other SAI calls");
 
 namespace {
 struct singleton_tag_type {};
@@ -9,11 +9,52 @@
  */
 #pragma once
 
+#include <gflags/gflags.h>
+
 #include <memory>
-#include <mutex>
+#include <shared_mutex>
+
+DECLARE_bool(sai_concurrent_gets);
 
 class SaiApiLock {
  public:
   static std::shared_ptr<SaiApiLock> getInstance();
-  std::mutex lock;
+  /*
+   * Held exclusively by every SAI call, except attribute gets with
+   * --sai_concurrent_gets, which share it (see SaiApiReadGuard).
+   */
+  std::shared_mutex lock;
+};
+
+/*
+ * Taken by attribute gets. With --sai_concurrent_gets, for adapters whose
+ * gets are thread safe, it shares the lock with other gets, e.g. those of
+ * the SaiStore reload threads. A get never runs concurrently with a create,
+ * remove, set or stats call.
+ */
+class SaiApiReadGuard {
+ public:
+  explicit SaiApiReadGuard(std::shared_mutex& lock)
+      : lock_(lock), shared_(FLAGS_sai_concurrent_gets) {
+    if (shared_) {
+      lock_.lock_shared();
+    } else {
+      lock_.lock();
+    }
+  }
+  ~SaiApiReadGuard() {
+    if (shared_) {
+      lock_.unlock_shared();
+    } else {
+      lock_.unlock();
+    }
+  }
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  SaiApiReadGuard(SaiApiReadGuard const&) = delete;
+  SaiApiReadGuard& operator=(SaiApiReadGuard const&) = delete;
+
+  std::shared_mutex& lock_;
+  const bool shared_;
 };
@@ -837,6 +837,32 @@ template <typename T>
 struct IsSaiAttribute<T, std::enable_if_t<IsSaiExtensionAttribute<T>::value>>
     : std::true_type {};
 
+/*
+ * Detects attributes whose value lives entirely in the sai_attribute_t, i.e.
+ * with no caller allocated list to size up front. Several of those can be
+ * fetched with a single get call on their object. AttributeType is the
+ * attribute itself, with any std::optional stripped.
+ */
+template <typename T, typename = void>
+struct IsSaiAttributeMultiGettable : public std::false_type {};
+
+template <
+    typename AttrEnumT,
+    AttrEnumT AttrEnum,
+    typename DataT,
+    typename DefaultGetterT>
+struct IsSaiAttributeMultiGettable<
+    SaiAttribute<AttrEnumT, AttrEnum, DataT, DefaultGetterT, void>,
+    std::enable_if_t<!IsSaiTypeWrapper<DataT>::value>>
+    : public std::true_type {
+  using AttributeType =
+      SaiAttribute<AttrEnumT, AttrEnum, DataT, DefaultGetterT, void>;
+};
+
+template <typename AttrT>
+struct IsSaiAttributeMultiGettable<std::optional<AttrT>>
+    : public IsSaiAttributeMultiGettable<AttrT> {};
+
 template <typename AttrT>
 struct AttributeName {
   // N.B., we can't just use static_assert(false, msg) because the
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "fboss/agent/hw/sai/api/SaiApiError.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
 
@@ -63,6 +64,8 @@ std::vector<typename SaiObjectTraits::AdapterKey> getObjectKeys(
     return ret;
   }
   std::vector<sai_object_key_t> keys;
+  // Object stores are reloaded concurrently, lock like SaiApi gets do
+  SaiApiReadGuard g{SaiApiLock::getInstance()->lock};
   uint32_t c = getObjectCount<SaiObjectTraits>(switch_id);
   keys.resize(c);
   sai_status_t status = sai_get_object_key(
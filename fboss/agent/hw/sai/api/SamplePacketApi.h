@@ -69,9 +69,11 @@ class SamplePacketApi : public SaiApi<SamplePacketApi> {
   sai_status_t _remove(SamplePacketSaiId id) {
     return api_->remove_samplepacket(id);
   }
-  sai_status_t _getAttribute(SamplePacketSaiId id, sai_attribute_t* attr)
-      const {
-    return api_->get_samplepacket_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      SamplePacketSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_samplepacket_attribute(id, count, attr);
   }
   sai_status_t _setAttribute(
       SamplePacketSaiId id,
@@ -135,8 +135,11 @@ class TamApi : public SaiApi<TamApi> {
     return api_->remove_tam(id);
   }
 
-  sai_status_t _getAttribute(TamSaiId id, sai_attribute_t* attr) const {
-    return api_->get_tam_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      TamSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_tam_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(TamSaiId id, const sai_attribute_t* attr) const {
@@ -156,8 +159,11 @@ class TamApi : public SaiApi<TamApi> {
     return api_->remove_tam_event(id);
   }
 
-  sai_status_t _getAttribute(TamEventSaiId id, sai_attribute_t* attr) const {
-    return api_->get_tam_event_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      TamEventSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_tam_event_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(TamEventSaiId id, const sai_attribute_t* attr)
@@ -179,9 +185,11 @@ class TamApi : public SaiApi<TamApi> {
     return api_->remove_tam_event_action(id);
   }
 
-  sai_status_t _getAttribute(TamEventActionSaiId id, sai_attribute_t* attr)
-      const {
-    return api_->get_tam_event_action_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      TamEventActionSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_tam_event_action_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(
@@ -203,8 +211,11 @@ class TamApi : public SaiApi<TamApi> {
     return api_->remove_tam_report(id);
   }
 
-  sai_status_t _getAttribute(TamReportSaiId id, sai_attribute_t* attr) const {
-    return api_->get_tam_report_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      TamReportSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_tam_report_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(TamReportSaiId id, const sai_attribute_t* attr)
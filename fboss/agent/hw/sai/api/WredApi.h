@@ -92,8 +92,11 @@ class WredApi : public SaiApi<WredApi> {
     return api_->remove_wred(id);
   }
 
-  sai_status_t _getAttribute(WredSaiId id, sai_attribute_t* attr) const {
-    return api_->get_wred_attribute(id, 1, attr);
+  sai_status_t _getAttribute(
+      WredSaiId id,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    return api_->get_wred_attribute(id, count, attr);
   }
 
   sai_status_t _setAttribute(WredSaiId id, const sai_attribute_t* attr) {
@@ -180,6 +180,104 @@ TEST_F(RouteApiTest, formatRouteNextHopId) {
   EXPECT_EQ(expected, fmt::format("{}", nhid));
 }
 
+namespace {
+/*
+ * Route api whose gets of several attributes in one call fail with
+ * multiGetStatus, to exercise the per attribute fallback
+ */
+class FlakyRouteApi : public SaiApi<FlakyRouteApi> {
+ public:
+  static constexpr sai_api_t ApiType = SAI_API_ROUTE;
+  FlakyRouteApi() {
+    sai_status_t status =
+        sai_api_query(ApiType, reinterpret_cast<void**>(&api_));
+    saiApiCheckError(status, ApiType, "Failed to query for route api");
+  }
+
+  sai_status_t multiGetStatus{SAI_STATUS_SUCCESS};
+  mutable int multiGets{0};
+  mutable int singleGets{0};
+
+ private:
+  sai_status_t _getAttribute(
+      const SaiRouteTraits::RouteEntry& routeEntry,
+      sai_attribute_t* attr,
+      uint32_t count = 1) const {
+    if (count > 1) {
+      ++multiGets;
+      if (multiGetStatus != SAI_STATUS_SUCCESS) {
+        return multiGetStatus;
+      }
+    } else {
+      ++singleGets;
+    }
+    return api_->get_route_entry_attribute(routeEntry.entry(), count, attr);
+  }
+
+  sai_route_api_t* api_;
+  friend class SaiApi<FlakyRouteApi>;
+};
+} // namespace
+
+TEST_F(RouteApiTest, getMultipleAttributes) {
+  SaiRouteTraits::RouteEntry r(0, 0, folly::CIDRNetwork(ip4, 24));
+  SaiRouteTraits::CreateAttributes attrs{
+      SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD},
+      SaiRouteTraits::Attributes::NextHopId(5),
+      SaiRouteTraits::Attributes::Metadata(42)};
+  routeApi->create<SaiRouteTraits>(r, attrs);
+
+  FlakyRouteApi api;
+  auto got = api.getMultipleAttributes<SaiRouteTraits>(
+      r, SaiRouteTraits::CreateAttributes{});
+  EXPECT_EQ(got, attrs);
+  EXPECT_EQ(api.multiGets, 1);
+  EXPECT_EQ(api.singleGets, 0);
+}
+
+TEST_F(RouteApiTest, getMultipleAttributesFallback) {
+  SaiRouteTraits::RouteEntry r1(0, 0, folly::CIDRNetwork(ip4, 24));
+  SaiRouteTraits::RouteEntry r2(0, 0, folly::CIDRNetwork(ip6, 64));
+  SaiRouteTraits::CreateAttributes attrs{
+      SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD},
+      SaiRouteTraits::Attributes::NextHopId(5),
+      SaiRouteTraits::Attributes::Metadata(42)};
+  routeApi->create<SaiRouteTraits>(r1, attrs);
+  routeApi->create<SaiRouteTraits>(r2, attrs);
+
+  FlakyRouteApi api;
+  // Not a sign the adapter can't do it, only this object falls back
+  api.multiGetStatus = SAI_STATUS_FAILURE;
+  EXPECT_EQ(
+      api.getMultipleAttributes<SaiRouteTraits>(
+          r1, SaiRouteTraits::CreateAttributes{}),
+      attrs);
+  EXPECT_EQ(api.multiGets, 1);
+  EXPECT_EQ(api.singleGets, 3);
+  EXPECT_EQ(
+      api.getMultipleAttributes<SaiRouteTraits>(
+          r2, SaiRouteTraits::CreateAttributes{}),
+      attrs);
+  EXPECT_EQ(api.multiGets, 2);
+  EXPECT_EQ(api.singleGets, 6);
+
+  // Unsupported, stop trying for routes
+  api.multiGetStatus = SAI_STATUS_NOT_SUPPORTED;
+  EXPECT_EQ(
+      api.getMultipleAttributes<SaiRouteTraits>(
+          r1, SaiRouteTraits::CreateAttributes{}),
+      attrs);
+  EXPECT_EQ(api.multiGets, 3);
+  EXPECT_EQ(api.singleGets, 9);
+  api.multiGetStatus = SAI_STATUS_SUCCESS;
+  EXPECT_EQ(
+      api.getMultipleAttributes<SaiRouteTraits>(
+          r2, SaiRouteTraits::CreateAttributes{}),
+      attrs);
+  EXPECT_EQ(api.multiGets, 3);
+  EXPECT_EQ(api.singleGets, 12);
+}
+
 TEST(RouteEntryTest, serDeserv6) {
   folly::CIDRNetwork prefix("42::", 64);
   SaiRouteTraits::RouteEntry r(0, 0, prefix);
@@ -57,6 +57,9 @@ void FakeSai::clear() {
   fs->tamEventManager.clear();
   fs->tamEventActionManager.clear();
   fs->tamReportManager.clear();
+  if (auto costModel = facebook::fboss::FakeSaiCostModel::get()) {
+    costModel->clearObjectCounts();
+  }
 }
 
 sai_object_id_t FakeSai::getCpuPort() {
@@ -12,6 +12,7 @@
 #include "fboss/agent/hw/sai/fake/FakeSaiAcl.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiBridge.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiBuffer.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiCostModel.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiDebugCounter.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiFdb.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiHash.h"
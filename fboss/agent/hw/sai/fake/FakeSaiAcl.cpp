@@ -14,12 +14,18 @@
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_acl_table_fn(
     sai_object_id_t* acl_table_id,
     sai_object_id_t /*switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_table", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
 
   std::optional<sai_int32_t> stage;
@@ -167,18 +173,22 @@ sai_status_t create_acl_table_fn(
       fieldRouteDstUserMeta,
       fieldNeighborDstUserMeta);
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_acl_table_fn(sai_object_id_t acl_table_id) {
+  FakeSaiCall call("acl_table", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->aclTableManager.remove(acl_table_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_acl_table_attribute_fn(
     sai_object_id_t /*acl_table_id*/,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("acl_table", FakeSaiOp::SET);
   switch (attr->id) {
     default:
       // SAI spec does not support setting any attribute for ACL table post
@@ -193,6 +203,7 @@ sai_status_t get_acl_table_attribute_fn(
     sai_object_id_t acl_table_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("acl_table", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   for (int i = 0; i < attr_count; ++i) {
     switch (attr[i].id) {
@@ -350,6 +361,7 @@ sai_status_t get_acl_table_attribute_fn(
 sai_status_t set_acl_entry_attribute_fn(
     sai_object_id_t acl_entry_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("acl_entry", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& aclEntry = fs->aclEntryManager.get(acl_entry_id);
   sai_status_t res;
@@ -566,6 +578,7 @@ sai_status_t get_acl_entry_attribute_fn(
     sai_object_id_t acl_entry_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_entry", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& aclEntry = fs->aclEntryManager.get(acl_entry_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -755,6 +768,10 @@ sai_status_t create_acl_entry_fn(
     sai_object_id_t switch_id,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_entry", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
 
   std::optional<sai_object_id_t> tableId;
@@ -786,18 +803,22 @@ sai_status_t create_acl_entry_fn(
     }
   }
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_acl_entry_fn(sai_object_id_t acl_entry_id) {
+  FakeSaiCall call("acl_entry", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->aclEntryManager.remove(acl_entry_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_acl_counter_attribute_fn(
     sai_object_id_t acl_counter_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("acl_counter", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& aclCounter = fs->aclCounterManager.get(acl_counter_id);
   sai_status_t res;
@@ -825,6 +846,7 @@ sai_status_t get_acl_counter_attribute_fn(
     sai_object_id_t acl_counter_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_counter", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& aclCounter = fs->aclCounterManager.get(acl_counter_id);
 
@@ -857,6 +879,10 @@ sai_status_t create_acl_counter_fn(
     sai_object_id_t /*switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_counter", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
 
   std::optional<sai_object_id_t> tableId;
@@ -897,12 +923,15 @@ sai_status_t create_acl_counter_fn(
     }
   }
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_acl_counter_fn(sai_object_id_t acl_counter_id) {
+  FakeSaiCall call("acl_counter", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->aclCounterManager.remove(acl_counter_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -911,16 +940,22 @@ sai_status_t create_acl_range_fn(
     sai_object_id_t /*switch_id*/,
     uint32_t /*attr_count*/,
     const sai_attribute_t* /*attr_list*/) {
+  FakeSaiCall call("acl_range", FakeSaiOp::CREATE);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   return SAI_STATUS_NOT_IMPLEMENTED;
 }
 
 sai_status_t remove_acl_range_fn(sai_object_id_t /*acl_range_id*/) {
+  FakeSaiCall call("acl_range", FakeSaiOp::REMOVE);
   return SAI_STATUS_NOT_IMPLEMENTED;
 }
 
 sai_status_t set_acl_range_attribute_fn(
     sai_object_id_t /*acl_range_id*/,
     const sai_attribute_t* /*attr*/) {
+  FakeSaiCall call("acl_range", FakeSaiOp::SET);
   return SAI_STATUS_NOT_IMPLEMENTED;
 }
 
@@ -928,6 +963,7 @@ sai_status_t get_acl_range_attribute_fn(
     sai_object_id_t acl_range_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_range", FakeSaiOp::GET, attr_count);
   return SAI_STATUS_NOT_IMPLEMENTED;
 }
 
@@ -936,6 +972,10 @@ sai_status_t create_acl_table_group_fn(
     sai_object_id_t switch_id,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_table_group", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
 
   std::optional<sai_int32_t> stage;
@@ -968,18 +1008,22 @@ sai_status_t create_acl_table_group_fn(
   *acl_table_group_id =
       fs->aclTableGroupManager.create(stage.value(), bindPointTypeList, type);
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_acl_table_group_fn(sai_object_id_t acl_table_group_id) {
+  FakeSaiCall call("acl_table_group", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->aclTableGroupManager.remove(acl_table_group_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_acl_table_group_attribute_fn(
     sai_object_id_t /*acl_table_group_id*/,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("acl_table_group", FakeSaiOp::SET);
   switch (attr->id) {
     default:
       // SAI spec does not support setting any attribute for ACL table group
@@ -994,6 +1038,7 @@ sai_status_t get_acl_table_group_attribute_fn(
     sai_object_id_t acl_table_group_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_table_group", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
 
   for (int i = 0; i < attr_count; ++i) {
@@ -1051,6 +1096,10 @@ sai_status_t create_acl_table_group_member_fn(
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_table_group_member", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
 
   std::optional<sai_object_id_t> tableGroupId;
@@ -1081,19 +1130,23 @@ sai_status_t create_acl_table_group_member_fn(
       tableId.value(),
       priority.value());
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_acl_table_group_member_fn(
     sai_object_id_t acl_table_group_member_id) {
+  FakeSaiCall call("acl_table_group_member", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->aclTableGroupManager.removeMember(acl_table_group_member_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_acl_table_group_member_attribute_fn(
     sai_object_id_t /*acl_table_group_member_id*/,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("acl_table_group_member", FakeSaiOp::SET);
   return SAI_STATUS_NOT_IMPLEMENTED;
 
   switch (attr->id) {
@@ -1110,6 +1163,7 @@ sai_status_t get_acl_table_group_member_attribute_fn(
     sai_object_id_t acl_table_group_member_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("acl_table_group_member", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& aclTableGroupMember =
       fs->aclTableGroupManager.getMember(acl_table_group_member_id);
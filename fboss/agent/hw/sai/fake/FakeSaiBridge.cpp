@@ -15,10 +15,13 @@
 #include <optional>
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t set_bridge_attribute_fn(
     sai_object_id_t /* bridge_id */,
     const sai_attribute_t* /* attr */) {
+  FakeSaiCall call("bridge", FakeSaiOp::SET);
   return SAI_STATUS_FAILURE;
 }
 
@@ -27,6 +30,10 @@ sai_status_t create_bridge_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("bridge", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_bridge_type_t> bridgeType;
   // See if we have a bridge type.
@@ -52,12 +59,15 @@ sai_status_t create_bridge_fn(
       return res;
     }
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_bridge_fn(sai_object_id_t bridge_id) {
+  FakeSaiCall call("bridge", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->bridgeManager.remove(bridge_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -65,6 +75,7 @@ sai_status_t get_bridge_attribute_fn(
     sai_object_id_t bridge_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("bridge", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& bridge = fs->bridgeManager.get(bridge_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -84,6 +95,10 @@ sai_status_t create_bridge_port_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("bridge_port", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_object_id_t> portId;
   std::optional<int32_t> type;
@@ -116,12 +131,15 @@ sai_status_t create_bridge_port_fn(
       portId.value(),
       adminState.value(),
       learningMode.value());
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_bridge_port_fn(sai_object_id_t bridge_port_id) {
+  FakeSaiCall call("bridge_port", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->bridgeManager.removeMember(bridge_port_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -129,6 +147,7 @@ sai_status_t get_bridge_port_attribute_fn(
     sai_object_id_t bridge_port_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("bridge_port", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& bridgePort = fs->bridgeManager.getMember(bridge_port_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -158,6 +177,7 @@ sai_status_t get_bridge_port_attribute_fn(
 sai_status_t set_bridge_port_attribute_fn(
     sai_object_id_t bridge_port_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("bridge_port", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& bridgePort = fs->bridgeManager.getMember(bridge_port_id);
   sai_status_t res;
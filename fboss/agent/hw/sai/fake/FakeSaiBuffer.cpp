@@ -15,12 +15,18 @@
 
 using facebook::fboss::FakeQueue;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_buffer_pool_fn(
     sai_object_id_t* buffer_pool_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("buffer_pool", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_buffer_pool_type_t> poolType;
   std::optional<sai_uint64_t> poolSize;
@@ -46,18 +52,22 @@ sai_status_t create_buffer_pool_fn(
   }
   *buffer_pool_id = fs->bufferPoolManager.create(
       poolType.value(), poolSize.value(), threshMode.value());
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_buffer_pool_fn(sai_object_id_t pool_id) {
+  FakeSaiCall call("buffer_pool", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->bufferPoolManager.remove(pool_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_buffer_pool_attribute_fn(
     sai_object_id_t /*buffer_pool_id*/,
     const sai_attribute_t* /*attr*/) {
+  FakeSaiCall call("buffer_pool", FakeSaiOp::SET);
   return SAI_STATUS_NOT_SUPPORTED;
 }
 
@@ -65,6 +75,7 @@ sai_status_t get_buffer_pool_attribute_fn(
     sai_object_id_t pool_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("buffer_pool", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto pool = fs->bufferPoolManager.get(pool_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -90,6 +101,7 @@ sai_status_t get_buffer_pool_stats_fn(
     uint32_t num_of_counters,
     const sai_stat_id_t* /*counter_ids*/,
     uint64_t* counters) {
+  FakeSaiCall call("buffer_pool", FakeSaiOp::GET_STATS, num_of_counters);
   for (auto i = 0; i < num_of_counters; ++i) {
     counters[i] = 0;
   }
@@ -107,6 +119,7 @@ sai_status_t get_buffer_pool_stats_ext_fn(
     const sai_stat_id_t* counter_ids,
     sai_stats_mode_t /*mode*/,
     uint64_t* counters) {
+  FakeSaiCall call("buffer_pool", FakeSaiOp::GET_STATS, num_of_counters);
   return get_buffer_pool_stats_fn(
       buffer_pool, num_of_counters, counter_ids, counters);
 }
@@ -119,6 +132,7 @@ sai_status_t clear_buffer_pool_stats_fn(
     sai_object_id_t buffer_pool_id,
     uint32_t number_of_counters,
     const sai_stat_id_t* counter_ids) {
+  FakeSaiCall call("buffer_pool", FakeSaiOp::CLEAR_STATS, number_of_counters);
   return SAI_STATUS_SUCCESS;
 }
 
@@ -127,6 +141,10 @@ sai_status_t create_buffer_profile_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("buffer_profile", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_object_id_t> poolId;
   std::optional<sai_uint64_t> reservedBytes;
@@ -157,12 +175,14 @@ sai_status_t create_buffer_profile_fn(
   }
   *buffer_profile_id = fs->bufferProfileManager.create(
       poolId.value(), reservedBytes, threshMode, dynamicThreshold);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_buffer_profile_attribute_fn(
     sai_object_id_t profile_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("buffer_profile", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& profile = fs->bufferProfileManager.get(profile_id);
   switch (attr->id) {
@@ -183,8 +203,10 @@ sai_status_t set_buffer_profile_attribute_fn(
 }
 
 sai_status_t remove_buffer_profile_fn(sai_object_id_t profile_id) {
+  FakeSaiCall call("buffer_profile", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->bufferProfileManager.remove(profile_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -192,6 +214,7 @@ sai_status_t get_buffer_profile_attribute_fn(
     sai_object_id_t profile_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("buffer_profile", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto profile = fs->bufferProfileManager.get(profile_id);
   for (int i = 0; i < attr_count; ++i) {
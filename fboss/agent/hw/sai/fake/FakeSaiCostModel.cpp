@@ -0,0 +1,235 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/fake/FakeSaiCostModel.h"
+
+#include <folly/FileUtil.h>
+#include <folly/json.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+DEFINE_string(
+    fake_sai_cost_profile,
+    "",
+    "JSON profile of FakeSai API costs, see FakeSaiCostModel.h. "
+    "FakeSai calls cost nothing when unset");
+
+namespace {
+
+constexpr auto kDefaultObject = "default";
+constexpr std::array<const char*, 6> kOpNames = {
+    "create",
+    "remove",
+    "set",
+    "get",
+    "get_stats",
+    "clear_stats",
+};
+static_assert(
+    kOpNames.size() ==
+        static_cast<size_t>(facebook::fboss::FakeSaiOp::NUM_OPS),
+    "kOpNames must name every FakeSaiOp");
+
+// Spin rather than sleep, sleeps are far too coarse for microsecond costs
+void spinFor(double us) {
+  if (us <= 0) {
+    return;
+  }
+  auto end = std::chrono::steady_clock::now() +
+      std::chrono::nanoseconds(static_cast<int64_t>(us * 1000));
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+double sample(
+    const facebook::fboss::FakeSaiCostModel::Latency& latency,
+    uint32_t attrCount) {
+  double us = latency.meanUs;
+  if (latency.stddevUs > 0) {
+    static thread_local std::mt19937 gen(std::random_device{}());
+    std::normal_distribution<double> dist(latency.meanUs, latency.stddevUs);
+    us = dist(gen);
+  }
+  return std::max(0.0, us + latency.perAttributeUs * attrCount);
+}
+
+facebook::fboss::FakeSaiCostModel::ObjectCost parseObjectCost(
+    const folly::dynamic& object) {
+  facebook::fboss::FakeSaiCostModel::ObjectCost cost;
+  if (auto capacity = object.get_ptr("capacity")) {
+    cost.capacity = capacity->asInt();
+  }
+  for (size_t i = 0; i < kOpNames.size(); ++i) {
+    if (auto op = object.get_ptr(kOpNames[i])) {
+      auto& latency = cost.ops[i];
+      latency.meanUs = op->getDefault("meanUs", 0).asDouble();
+      latency.stddevUs = op->getDefault("stddevUs", 0).asDouble();
+      latency.perAttributeUs = op->getDefault("perAttributeUs", 0).asDouble();
+    }
+  }
+  return cost;
+}
+
+thread_local int callDepth = 0;
+
+} // namespace
+
+namespace facebook::fboss {
+
+FakeSaiCostModel::FakeSaiCostModel(const folly::dynamic& profile) {
+  lockHoldUs_ = profile.getDefault("lockHoldUs", 0).asDouble();
+  if (auto objects = profile.get_ptr("objects")) {
+    for (const auto& object : objects->items()) {
+      auto name = object.first.asString();
+      if (name == kDefaultObject) {
+        defaultCost_ = parseObjectCost(object.second);
+      } else {
+        costs_.emplace(name, parseObjectCost(object.second));
+      }
+    }
+  }
+}
+
+std::unique_ptr<FakeSaiCostModel> FakeSaiCostModel::load(
+    const std::string& path) {
+  std::string json;
+  if (!folly::readFile(path.c_str(), json)) {
+    throw std::runtime_error("Unable to read FakeSai cost profile " + path);
+  }
+  return std::make_unique<FakeSaiCostModel>(
+      folly::parseJson(folly::json::stripComments(json)));
+}
+
+namespace {
+std::unique_ptr<FakeSaiCostModel>& currentModel() {
+  static std::unique_ptr<FakeSaiCostModel> model = []() {
+    std::unique_ptr<FakeSaiCostModel> loaded;
+    if (!FLAGS_fake_sai_cost_profile.empty()) {
+      loaded = FakeSaiCostModel::load(FLAGS_fake_sai_cost_profile);
+      XLOG(INFO) << "Loaded FakeSai cost profile "
+                 << FLAGS_fake_sai_cost_profile;
+    }
+    return loaded;
+  }();
+  return model;
+}
+} // namespace
+
+FakeSaiCostModel* FakeSaiCostModel::get() {
+  return currentModel().get();
+}
+
+void FakeSaiCostModel::setForTesting(
+    std::unique_ptr<FakeSaiCostModel> model) {
+  currentModel() = std::move(model);
+}
+
+const FakeSaiCostModel::ObjectCost& FakeSaiCostModel::getObjectCost(
+    const std::string& object) const {
+  auto cost = costs_.find(object);
+  return cost == costs_.end() ? defaultCost_ : cost->second;
+}
+
+uint64_t FakeSaiCostModel::getLiveObjects(const char* object) {
+  std::lock_guard<std::mutex> g(objectsLock_);
+  return getObjectState(object).live;
+}
+
+FakeSaiCostModel::ObjectState& FakeSaiCostModel::getObjectState(
+    const char* object) {
+  auto it = objects_.find(object);
+  if (it == objects_.end()) {
+    auto cost = costs_.find(object);
+    it = objects_
+             .emplace(
+                 object,
+                 ObjectState{
+                     cost == costs_.end() ? &defaultCost_ : &cost->second})
+             .first;
+  }
+  return it->second;
+}
+
+bool FakeSaiCostModel::charge(
+    const char* object,
+    FakeSaiOp op,
+    uint32_t attrCount) {
+  const ObjectCost* cost;
+  {
+    std::lock_guard<std::mutex> g(objectsLock_);
+    auto& state = getObjectState(object);
+    cost = state.cost;
+    if (op == FakeSaiOp::CREATE) {
+      if (cost->capacity && state.live >= *cost->capacity) {
+        return false;
+      }
+      // Held while the create runs, so concurrent creates can't overshoot
+      ++state.live;
+    }
+  }
+
+  auto us = sample(cost->ops[static_cast<size_t>(op)], attrCount);
+  auto lockedUs = std::min(us, lockHoldUs_);
+  {
+    std::lock_guard<std::mutex> g(sdkLock_);
+    spinFor(lockedUs);
+  }
+  spinFor(us - lockedUs);
+  return true;
+}
+
+void FakeSaiCostModel::complete(
+    const char* object,
+    FakeSaiOp op,
+    bool succeeded) {
+  // A create holds its slot since charge(), and only keeps it on success
+  bool release = op == FakeSaiOp::CREATE ? !succeeded
+                                         : op == FakeSaiOp::REMOVE && succeeded;
+  if (!release) {
+    return;
+  }
+  std::lock_guard<std::mutex> g(objectsLock_);
+  auto& state = getObjectState(object);
+  if (state.live > 0) {
+    --state.live;
+  }
+}
+
+void FakeSaiCostModel::clearObjectCounts() {
+  std::lock_guard<std::mutex> g(objectsLock_);
+  for (auto& object : objects_) {
+    object.second.live = 0;
+  }
+}
+
+FakeSaiCall::FakeSaiCall(const char* object, FakeSaiOp op, uint32_t attrCount)
+    : object_(object), op_(op) {
+  auto model = callDepth == 0 ? FakeSaiCostModel::get() : nullptr;
+  ++callDepth;
+  if (model) {
+    tableFull_ = !model->charge(object, op, attrCount);
+    if (!tableFull_) {
+      model_ = model;
+    }
+  }
+}
+
+FakeSaiCall::~FakeSaiCall() {
+  --callDepth;
+  if (model_) {
+    model_->complete(object_, op_, succeeded_);
+  }
+}
+
+} // namespace facebook::fboss
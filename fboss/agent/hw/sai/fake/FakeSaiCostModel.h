@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/dynamic.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::fboss {
+
+enum class FakeSaiOp : uint8_t {
+  CREATE,
+  REMOVE,
+  SET,
+  GET,
+  GET_STATS,
+  CLEAR_STATS,
+  NUM_OPS,
+};
+
+/*
+ * Optional cost model for FakeSai, so benchmarks built against fake_sai
+ * measure something closer to programming a real ASIC.
+ *
+ * When --fake_sai_cost_profile names a profile, every FakeSai API call takes
+ * time drawn from a normal distribution for its object type and operation,
+ * part of which is spent holding a lock shared by all calls (like the global
+ * lock of vendor SDKs), and creates fail with SAI_STATUS_TABLE_FULL once an
+ * object type reaches its capacity. Without a profile FakeSai calls cost
+ * nothing, as before.
+ *
+ * The profile is JSON, comments allowed. Object types are named as in the SAI
+ * function names (route_entry, next_hop_group_member, ...), "default" applies
+ * to types not listed. All fields are optional:
+ *
+ *   {
+ *     "lockHoldUs": 2,
+ *     "objects": {
+ *       "route_entry": {
+ *         "capacity": 131072,
+ *         "create": {"meanUs": 12, "stddevUs": 3, "perAttributeUs": 0.5},
+ *         "remove": {"meanUs": 8},
+ *         "set": {"meanUs": 10},
+ *         "get": {"meanUs": 2, "perAttributeUs": 0.2}
+ *       },
+ *       "default": {"create": {"meanUs": 5}}
+ *     }
+ *   }
+ *
+ * Stats calls use "get_stats"/"clear_stats", with perAttributeUs charged per
+ * counter. fboss/agent/hw/sai/fake/cost_profiles/sample.json is a complete
+ * example.
+ */
+class FakeSaiCostModel {
+ public:
+  struct Latency {
+    double meanUs{0};
+    double stddevUs{0};
+    // Added per attribute (or counter) passed in the call
+    double perAttributeUs{0};
+  };
+
+  struct ObjectCost {
+    std::optional<uint64_t> capacity;
+    std::array<Latency, static_cast<size_t>(FakeSaiOp::NUM_OPS)> ops;
+  };
+
+  explicit FakeSaiCostModel(const folly::dynamic& profile);
+
+  // Throws std::runtime_error if the profile can't be read
+  static std::unique_ptr<FakeSaiCostModel> load(const std::string& path);
+
+  /*
+   * Model loaded from --fake_sai_cost_profile, nullptr if none was given.
+   */
+  static FakeSaiCostModel* get();
+  // Replace the model used by FakeSai calls, nullptr for none
+  static void setForTesting(std::unique_ptr<FakeSaiCostModel> model);
+
+  /*
+   * Spend the cost of one call. Returns false, without spending anything, if
+   * the call is a create that would exceed the object's capacity. Otherwise
+   * a create holds one slot of the capacity until completed.
+   */
+  bool charge(const char* object, FakeSaiOp op, uint32_t attrCount);
+  /*
+   * Account for the outcome of a charged create or remove: a failed create
+   * gives its slot back, a successful remove frees one.
+   */
+  void complete(const char* object, FakeSaiOp op, bool succeeded);
+
+  // Forget live object counts, on FakeSai::clear()
+  void clearObjectCounts();
+
+  const ObjectCost& getObjectCost(const std::string& object) const;
+  // Objects created and not yet removed, plus creates in progress
+  uint64_t getLiveObjects(const char* object);
+
+ private:
+  struct ObjectState {
+    const ObjectCost* cost;
+    uint64_t live{0};
+  };
+
+  // Forbidden copy constructor and assignment operator
+  FakeSaiCostModel(FakeSaiCostModel const&) = delete;
+  FakeSaiCostModel& operator=(FakeSaiCostModel const&) = delete;
+
+  ObjectState& getObjectState(const char* object);
+
+  double lockHoldUs_{0};
+  std::unordered_map<std::string, ObjectCost> costs_;
+  ObjectCost defaultCost_;
+
+  std::mutex objectsLock_;
+  std::unordered_map<std::string, ObjectState> objects_;
+  // Stands in for the SDK lock serializing calls
+  std::mutex sdkLock_;
+};
+
+/*
+ * Charges the cost of a FakeSai API call on construction. Calls made from
+ * within another call (e.g. creates applying attributes through the set
+ * function) are free.
+ *
+ * Creates and removes call succeeded() once the object was actually created
+ * or removed, only those change the object counts checked against capacity.
+ */
+class FakeSaiCall {
+ public:
+  FakeSaiCall(const char* object, FakeSaiOp op, uint32_t attrCount = 0);
+  ~FakeSaiCall();
+
+  bool tableFull() const {
+    return tableFull_;
+  }
+  void succeeded() {
+    succeeded_ = true;
+  }
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  FakeSaiCall(FakeSaiCall const&) = delete;
+  FakeSaiCall& operator=(FakeSaiCall const&) = delete;
+
+  const char* object_;
+  FakeSaiOp op_;
+  // Set if this call was charged, and must be completed
+  FakeSaiCostModel* model_{nullptr};
+  bool tableFull_{false};
+  bool succeeded_{false};
+};
+
+} // namespace facebook::fboss
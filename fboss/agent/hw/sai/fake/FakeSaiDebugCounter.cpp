@@ -14,10 +14,13 @@
 
 using facebook::fboss::FakeDebugCounter;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t set_debug_counter_attribute_fn(
     sai_object_id_t id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("debug_counter", FakeSaiOp::SET);
   if (!attr) {
     return SAI_STATUS_INVALID_PARAMETER;
   }
@@ -57,6 +60,7 @@ sai_status_t get_debug_counter_attribute_fn(
     sai_object_id_t debug_counter_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("debug_counter", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& debugCounter = fs->debugCounterManager.get(debug_counter_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -106,17 +110,24 @@ sai_status_t create_debug_counter_fn(
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("debug_counter", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   *id = fs->debugCounterManager.create();
   for (int i = 0; i < attr_count; ++i) {
     set_debug_counter_attribute_fn(*id, &attr_list[i]);
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_debug_counter_fn(sai_object_id_t debug_counter_id) {
+  FakeSaiCall call("debug_counter", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->debugCounterManager.remove(debug_counter_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
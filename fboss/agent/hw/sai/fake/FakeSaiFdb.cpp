@@ -17,11 +17,17 @@
 
 using facebook::fboss::FakeFdb;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_fdb_entry_fn(
     const sai_fdb_entry_t* fdb_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("fdb_entry", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   sai_object_id_t bridgePortId = 0;
@@ -44,20 +50,24 @@ sai_status_t create_fdb_entry_fn(
       std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac),
       bridgePortId,
       metadata);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_fdb_entry_fn(const sai_fdb_entry_t* fdb_entry) {
+  FakeSaiCall call("fdb_entry", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   fs->fdbManager.remove(
       std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac));
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_fdb_entry_attribute_fn(
     const sai_fdb_entry_t* fdb_entry,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("fdb_entry", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   auto fdbKey = std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac);
@@ -79,6 +89,7 @@ sai_status_t get_fdb_entry_attribute_fn(
     const sai_fdb_entry_t* fdb_entry,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("fdb_entry", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
   auto fdbKey = std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac);
@@ -14,10 +14,13 @@
 
 using facebook::fboss::FakeHash;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t set_hash_attribute_fn(
     sai_object_id_t id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("hash", FakeSaiOp::SET);
   if (!attr) {
     return SAI_STATUS_INVALID_PARAMETER;
   }
@@ -51,17 +54,24 @@ sai_status_t create_hash_fn(
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("hash", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   *id = fs->hashManager.create();
   for (int i = 0; i < attr_count; ++i) {
     set_hash_attribute_fn(*id, &attr_list[i]);
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_hash_fn(sai_object_id_t hash_id) {
+  FakeSaiCall call("hash", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->hashManager.remove(hash_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -69,6 +79,7 @@ sai_status_t get_hash_attribute_fn(
     sai_object_id_t hash_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("hash", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& hash = fs->hashManager.get(hash_id);
   for (int i = 0; i < attr_count; ++i) {
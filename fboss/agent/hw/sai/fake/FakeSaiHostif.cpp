@@ -17,6 +17,8 @@
 using facebook::fboss::FakeHostifTrapGroupManager;
 using facebook::fboss::FakeHostifTrapManager;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t send_hostif_fn(
     sai_object_id_t /* switch_id */,
@@ -51,6 +53,10 @@ sai_status_t create_hostif_trap_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("hostif_trap", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_hostif_trap_type_t> trapType;
   std::optional<sai_packet_action_t> packetAction;
@@ -84,18 +90,22 @@ sai_status_t create_hostif_trap_fn(
   }
   *hostif_trap_id = fs->hostIfTrapManager.create(
       trapType.value(), packetAction.value(), priority, trapGroup);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_hostif_trap_fn(sai_object_id_t hostif_trap_id) {
+  FakeSaiCall call("hostif_trap", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->hostIfTrapManager.remove(hostif_trap_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_hostif_trap_attribute_fn(
     sai_object_id_t hostif_trap_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("hostif_trap", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& trap = fs->hostIfTrapManager.get(hostif_trap_id);
   switch (attr->id) {
@@ -118,6 +128,7 @@ sai_status_t get_hostif_trap_attribute_fn(
     sai_object_id_t hostif_trap_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("hostif_trap", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& hostifTrap = fs->hostIfTrapManager.get(hostif_trap_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -146,6 +157,10 @@ sai_status_t create_hostif_trap_group_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("hostif_trap_group", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   uint32_t queueId = 0;
   sai_object_id_t policer = 0;
@@ -162,18 +177,22 @@ sai_status_t create_hostif_trap_group_fn(
     }
   }
   *hostif_trap_group_id = fs->hostifTrapGroupManager.create(queueId, policer);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_hostif_trap_group_fn(sai_object_id_t hostif_trap_group_id) {
+  FakeSaiCall call("hostif_trap_group", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->hostifTrapGroupManager.remove(hostif_trap_group_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_hostif_trap_group_attribute_fn(
     sai_object_id_t /* hostif_trap_group_id */,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("hostif_trap_group", FakeSaiOp::SET);
   switch (attr->id) {
     default:
       return SAI_STATUS_INVALID_PARAMETER;
@@ -185,6 +204,7 @@ sai_status_t get_hostif_trap_group_attribute_fn(
     sai_object_id_t hostif_trap_group_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("hostif_trap_group", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& hostifTrapGroup =
       fs->hostifTrapGroupManager.get(hostif_trap_group_id);
@@ -6,19 +6,24 @@
 
 namespace {
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 using facebook::fboss::FakeSaiInSegEntry;
 
 sai_status_t sai_remove_inseg_entry(const sai_inseg_entry_t* inseg_entry) {
+  FakeSaiCall call("inseg_entry", FakeSaiOp::REMOVE);
   auto fakesai = FakeSai::getInstance();
   if (fakesai->inSegEntryManager.remove(FakeSaiInSegEntry(*inseg_entry)) == 0) {
     return SAI_STATUS_FAILURE;
   };
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_set_inseg_entry_attribute(
     const sai_inseg_entry_t* inseg_entry,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("inseg_entry", FakeSaiOp::SET);
   auto fakesai = FakeSai::getInstance();
   auto& entry = fakesai->inSegEntryManager.get(FakeSaiInSegEntry(*inseg_entry));
   switch (attr->id) {
@@ -41,6 +46,7 @@ sai_status_t sai_get_inseg_entry_attribute(
     const sai_inseg_entry_t* inseg_entry,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("inseg_entry", FakeSaiOp::GET, attr_count);
   auto fakesai = FakeSai::getInstance();
   auto& entry = fakesai->inSegEntryManager.get(FakeSaiInSegEntry(*inseg_entry));
   for (auto i = 0; i < attr_count; i++) {
@@ -66,11 +72,16 @@ sai_status_t sai_create_inseg_entry(
     const sai_inseg_entry_t* inseg_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("inseg_entry", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fakesai = FakeSai::getInstance();
   fakesai->inSegEntryManager.create(FakeSaiInSegEntry(*inseg_entry));
   for (auto i = 0; i < attr_count; i++) {
     sai_set_inseg_entry_attribute(inseg_entry, &attr_list[i]);
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
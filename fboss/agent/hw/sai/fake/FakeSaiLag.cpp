@@ -7,16 +7,21 @@
 using facebook::fboss::FakeLag;
 using facebook::fboss::FakeLagMember;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t remove_lag_fn(sai_object_id_t lag_id) {
+  FakeSaiCall call("lag", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->lagManager.remove(lag_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_lag_attribute_fn(
     sai_object_id_t lag_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("lag", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   switch (attr->id) {
     // TODO: upgrade OSS to 1.7.1
@@ -42,6 +47,7 @@ sai_status_t get_lag_attribute_fn(
     sai_object_id_t lag_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("lag", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   for (int i = 0; i < attr_count; ++i) {
     switch (attr_list[i].id) {
@@ -80,6 +86,10 @@ sai_status_t create_lag_fn(
     sai_object_id_t /*switch_id*/,
     uint32_t count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("lag", FakeSaiOp::CREATE, count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   *lag_id = fs->lagManager.create();
   for (auto i = 0; i < count; i++) {
@@ -88,6 +98,7 @@ sai_status_t create_lag_fn(
       return rv;
     }
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -96,6 +107,10 @@ sai_status_t create_lag_member_fn(
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("lag_member", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
 
   sai_object_id_t lag_id = SAI_NULL_OBJECT_ID;
@@ -114,18 +129,22 @@ sai_status_t create_lag_member_fn(
     }
   }
   *lag_member_id = fs->lagManager.createMember(lag_id, lag_id, port_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_lag_member_fn(sai_object_id_t lag_member_id) {
+  FakeSaiCall call("lag_member", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->lagManager.removeMember(lag_member_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_lag_member_attribute_fn(
     sai_object_id_t /*lag_member_id*/,
     const sai_attribute_t* /*attr*/) {
+  FakeSaiCall call("lag_member", FakeSaiOp::SET);
   return SAI_STATUS_NOT_IMPLEMENTED;
 }
 
@@ -133,6 +152,7 @@ sai_status_t get_lag_member_attribute_fn(
     sai_object_id_t lag_member_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("lag_member", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& lagMember = fs->lagManager.getMember(lag_member_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -17,12 +17,18 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_mirror_session_fn(
     sai_object_id_t* mirror_session_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("mirror_session", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_mirror_session_type_t> type;
   std::optional<sai_object_id_t> monitorPort;
@@ -134,18 +140,22 @@ sai_status_t create_mirror_session_fn(
     return SAI_STATUS_INVALID_PARAMETER;
   }
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_mirror_session_fn(sai_object_id_t mirror_session_id) {
+  FakeSaiCall call("mirror_session", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->mirrorManager.remove(mirror_session_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_mirror_session_attribute_fn(
     sai_object_id_t mirror_session_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("mirror_session", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& mirrorSession = fs->mirrorManager.get(mirror_session_id);
   switch (attr->id) {
@@ -202,6 +212,7 @@ sai_status_t get_mirror_session_attribute_fn(
     sai_object_id_t mirror_session_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("mirror_session", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& mirrorSession = fs->mirrorManager.get(mirror_session_id);
   for (int i = 0; i < attr_count; ++i) {
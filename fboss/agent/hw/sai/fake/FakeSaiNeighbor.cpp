@@ -17,11 +17,17 @@
 
 using facebook::fboss::FakeNeighbor;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_neighbor_entry_fn(
     const sai_neighbor_entry_t* neighbor_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("neighbor_entry", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   std::optional<folly::MacAddress> dstMac;
@@ -45,21 +51,25 @@ sai_status_t create_neighbor_entry_fn(
       std::make_tuple(neighbor_entry->switch_id, neighbor_entry->rif_id, ip),
       dstMac.value(),
       metadata);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_neighbor_entry_fn(
     const sai_neighbor_entry_t* neighbor_entry) {
+  FakeSaiCall call("neighbor_entry", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   fs->neighborManager.remove(
       std::make_tuple(neighbor_entry->switch_id, neighbor_entry->rif_id, ip));
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_neighbor_entry_attribute_fn(
     const sai_neighbor_entry_t* neighbor_entry,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("neighbor_entry", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   auto n =
@@ -82,6 +92,7 @@ sai_status_t get_neighbor_entry_attribute_fn(
     const sai_neighbor_entry_t* neighbor_entry,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("neighbor_entry", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
   auto n =
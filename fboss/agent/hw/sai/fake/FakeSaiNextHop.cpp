@@ -17,12 +17,18 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_next_hop_fn(
     sai_object_id_t* next_hop_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("next_hop", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_next_hop_type_t> type;
   std::optional<folly::IPAddress> ip;
@@ -66,18 +72,22 @@ sai_status_t create_next_hop_fn(
       labelStack,
       disableTtlDecrement);
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_next_hop_fn(sai_object_id_t next_hop_id) {
+  FakeSaiCall call("next_hop", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->nextHopManager.remove(next_hop_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_next_hop_attribute_fn(
     sai_object_id_t /* next_hop_id */,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("next_hop", FakeSaiOp::SET);
   switch (attr->id) {
     default:
       return SAI_STATUS_INVALID_PARAMETER;
@@ -89,6 +99,7 @@ sai_status_t get_next_hop_attribute_fn(
     sai_object_id_t next_hop_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("next_hop", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& nextHop = fs->nextHopManager.get(next_hop_id);
   for (int i = 0; i < attr_count; ++i) {
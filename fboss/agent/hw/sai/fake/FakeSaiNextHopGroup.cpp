@@ -17,12 +17,18 @@
 using facebook::fboss::FakeNextHopGroup;
 using facebook::fboss::FakeNextHopGroupMember;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_next_hop_group_fn(
     sai_object_id_t* next_hop_group_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("next_hop_group", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<int32_t> type;
   for (int i = 0; i < attr_count; ++i) {
@@ -42,12 +48,15 @@ sai_status_t create_next_hop_group_fn(
     return SAI_STATUS_INVALID_PARAMETER;
   }
   *next_hop_group_id = fs->nextHopGroupManager.create(type.value());
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_next_hop_group_fn(sai_object_id_t next_hop_group_id) {
+  FakeSaiCall call("next_hop_group", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->nextHopGroupManager.remove(next_hop_group_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -55,6 +64,7 @@ sai_status_t get_next_hop_group_attribute_fn(
     sai_object_id_t next_hop_group_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("next_hop_group", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& nextHopGroup = fs->nextHopGroupManager.get(next_hop_group_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -85,6 +95,7 @@ sai_status_t get_next_hop_group_attribute_fn(
 sai_status_t set_next_hop_group_attribute_fn(
     sai_object_id_t /* next_hop_group_id */,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("next_hop_group", FakeSaiOp::SET);
   switch (attr->id) {
     default:
       return SAI_STATUS_NOT_SUPPORTED;
@@ -97,6 +108,10 @@ sai_status_t create_next_hop_group_member_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("next_hop_group_member", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_object_id_t> nextHopGroupId;
   std::optional<sai_object_id_t> nextHopId;
@@ -124,13 +139,16 @@ sai_status_t create_next_hop_group_member_fn(
       nextHopGroupId.value(),
       nextHopId.value(),
       weight);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_next_hop_group_member_fn(
     sai_object_id_t next_hop_group_member_id) {
+  FakeSaiCall call("next_hop_group_member", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->nextHopGroupManager.removeMember(next_hop_group_member_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -138,6 +156,7 @@ sai_status_t get_next_hop_group_member_attribute_fn(
     sai_object_id_t next_hop_group_member_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("next_hop_group_member", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& nextHopGroupMember =
       fs->nextHopGroupManager.getMember(next_hop_group_member_id);
@@ -164,6 +183,7 @@ sai_status_t get_next_hop_group_member_attribute_fn(
 sai_status_t set_next_hop_group_member_attribute_fn(
     sai_object_id_t next_hop_group_member_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("next_hop_group_member", FakeSaiOp::SET);
   switch (attr->id) {
     default:
       return SAI_STATUS_NOT_SUPPORTED;
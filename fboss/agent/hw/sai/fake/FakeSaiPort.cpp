@@ -16,12 +16,18 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_port_fn(
     sai_object_id_t* port_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("port", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<bool> adminState;
   std::vector<uint32_t> lanes;
@@ -188,10 +194,12 @@ sai_status_t create_port_fn(
     }
   }
   port.interface_type = interface_type;
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_port_fn(sai_object_id_t port_id) {
+  FakeSaiCall call("port", FakeSaiOp::REMOVE);
   if (FakeSai::getInstance()->getCpuPort() == port_id) {
     // ignore removing CPU port
     return SAI_STATUS_SUCCESS;
@@ -202,12 +210,14 @@ sai_status_t remove_port_fn(sai_object_id_t port_id) {
     fs->queueManager.remove(saiQueueId);
   }
   fs->portManager.remove(port_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_port_attribute_fn(
     sai_object_id_t port_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("port", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& port = fs->portManager.get(port_id);
   sai_status_t res = SAI_STATUS_SUCCESS;
@@ -318,6 +328,7 @@ sai_status_t get_port_attribute_fn(
     sai_object_id_t port_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("port", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& port = fs->portManager.get(port_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -459,6 +470,7 @@ sai_status_t get_port_stats_fn(
     uint32_t num_of_counters,
     const sai_stat_id_t* /*counter_ids*/,
     uint64_t* counters) {
+  FakeSaiCall call("port", FakeSaiOp::GET_STATS, num_of_counters);
   for (auto i = 0; i < num_of_counters; ++i) {
     counters[i] = 0;
   }
@@ -477,6 +489,7 @@ sai_status_t get_port_stats_ext_fn(
     const sai_stat_id_t* counter_ids,
     sai_stats_mode_t /*mode*/,
     uint64_t* counters) {
+  FakeSaiCall call("port", FakeSaiOp::GET_STATS, num_of_counters);
   return get_port_stats_fn(port, num_of_counters, counter_ids, counters);
 }
 /*
@@ -488,6 +501,7 @@ sai_status_t clear_port_stats_fn(
     sai_object_id_t port_id,
     uint32_t number_of_counters,
     const sai_stat_id_t* counter_ids) {
+  FakeSaiCall call("port", FakeSaiOp::CLEAR_STATS, number_of_counters);
   return SAI_STATUS_SUCCESS;
 }
 
@@ -500,6 +514,10 @@ sai_status_t create_port_serdes_fn(
     sai_object_id_t /*switch_id*/,
     uint32_t count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("port_serdes", FakeSaiOp::CREATE, count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   bool created = false;
   for (auto i = 0; i < count; i++) {
@@ -521,18 +539,22 @@ sai_status_t create_port_serdes_fn(
       return status;
     }
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_port_serdes_fn(sai_object_id_t port_serdes_id) {
+  FakeSaiCall call("port_serdes", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->portSerdesManager.remove(port_serdes_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_port_serdes_attribute_fn(
     sai_object_id_t port_serdes_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("port_serdes", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& portSerdes = fs->portSerdesManager.get(port_serdes_id);
   auto& port = fs->portManager.get(portSerdes.port);
@@ -674,6 +696,7 @@ sai_status_t get_port_serdes_attribute_fn(
     sai_object_id_t port_serdes_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("port_serdes", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& portSerdes = fs->portSerdesManager.get(port_serdes_id);
   auto checkListSize = [](auto& list, auto& vec) {
@@ -16,12 +16,18 @@
 
 using facebook::fboss::FakeQosMap;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_qos_map_fn(
     sai_object_id_t* qos_map_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("qos_map", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<int32_t> type;
   std::vector<sai_qos_map_t> mapToValueList;
@@ -46,18 +52,22 @@ sai_status_t create_qos_map_fn(
   } else {
     return SAI_STATUS_INVALID_PARAMETER;
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_qos_map_fn(sai_object_id_t qos_map_id) {
+  FakeSaiCall call("qos_map", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->qosMapManager.remove(qos_map_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_qos_map_attribute_fn(
     sai_object_id_t qos_map_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("qos_map", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& qm = fs->qosMapManager.get(qos_map_id);
   switch (attr->id) {
@@ -79,6 +89,7 @@ sai_status_t get_qos_map_attribute_fn(
     sai_object_id_t qos_map_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("qos_map", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& qm = fs->qosMapManager.get(qos_map_id);
   for (int i = 0; i < attr_count; ++i) {
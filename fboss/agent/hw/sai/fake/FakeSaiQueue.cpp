@@ -15,12 +15,18 @@
 
 using facebook::fboss::FakeQueue;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_queue_fn(
     sai_object_id_t* queue_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("queue", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_object_id_t> port;
   std::optional<sai_object_id_t> parentScheduler;
@@ -67,18 +73,22 @@ sai_status_t create_queue_fn(
       schedulerProfileId,
       wredProfileId,
       bufferProfileId);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_queue_fn(sai_object_id_t queue_id) {
+  FakeSaiCall call("queue", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->queueManager.remove(queue_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_queue_attribute_fn(
     sai_object_id_t queue_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("queue", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& queue = fs->queueManager.get(queue_id);
   sai_status_t res;
@@ -113,6 +123,7 @@ sai_status_t get_queue_attribute_fn(
     sai_object_id_t queue_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("queue", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto queue = fs->queueManager.get(queue_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -150,6 +161,7 @@ sai_status_t get_queue_stats_fn(
     uint32_t num_of_counters,
     const sai_stat_id_t* /*counter_ids*/,
     uint64_t* counters) {
+  FakeSaiCall call("queue", FakeSaiOp::GET_STATS, num_of_counters);
   for (auto i = 0; i < num_of_counters; ++i) {
     counters[i] = 0;
   }
@@ -168,6 +180,7 @@ sai_status_t get_queue_stats_ext_fn(
     const sai_stat_id_t* counter_ids,
     sai_stats_mode_t /*mode*/,
     uint64_t* counters) {
+  FakeSaiCall call("queue", FakeSaiOp::GET_STATS, num_of_counters);
   return get_queue_stats_fn(queue, num_of_counters, counter_ids, counters);
 }
 /*
@@ -179,6 +192,7 @@ sai_status_t clear_queue_stats_fn(
     sai_object_id_t queue_id,
     uint32_t number_of_counters,
     const sai_stat_id_t* counter_ids) {
+  FakeSaiCall call("queue", FakeSaiOp::CLEAR_STATS, number_of_counters);
   return SAI_STATUS_SUCCESS;
 }
 
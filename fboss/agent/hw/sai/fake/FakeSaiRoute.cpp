@@ -16,10 +16,13 @@
 
 using facebook::fboss::FakeRoute;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t set_route_entry_attribute_fn(
     const sai_route_entry_t* route_entry,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("route_entry", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -46,6 +49,10 @@ sai_status_t create_route_entry_fn(
     const sai_route_entry_t* route_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("route_entry", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -55,10 +62,12 @@ sai_status_t create_route_entry_fn(
   for (int i = 0; i < attr_count; ++i) {
     set_route_entry_attribute_fn(route_entry, &attr_list[i]);
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_route_entry_fn(const sai_route_entry_t* route_entry) {
+  FakeSaiCall call("route_entry", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -67,6 +76,7 @@ sai_status_t remove_route_entry_fn(const sai_route_entry_t* route_entry) {
   if (fs->routeManager.remove(re) == 0) {
     return SAI_STATUS_FAILURE;
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -74,6 +84,7 @@ sai_status_t get_route_entry_attribute_fn(
     const sai_route_entry_t* route_entry,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("route_entry", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -16,12 +16,18 @@
 
 using facebook::fboss::FakeRouterInterface;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_router_interface_fn(
     sai_object_id_t* router_interface_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("router_interface", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<int32_t> type;
   std::optional<sai_object_id_t> vlanId;
@@ -65,18 +71,22 @@ sai_status_t create_router_interface_fn(
     auto& ri = fs->routeInterfaceManager.get(*router_interface_id);
     ri.mtu = mtu.value();
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_router_interface_fn(sai_object_id_t router_interface_id) {
+  FakeSaiCall call("router_interface", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->routeInterfaceManager.remove(router_interface_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_router_interface_attribute_fn(
     sai_object_id_t router_interface_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("router_interface", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& ri = fs->routeInterfaceManager.get(router_interface_id);
   switch (attr->id) {
@@ -96,6 +106,7 @@ sai_status_t get_router_interface_attribute_fn(
     sai_object_id_t router_interface_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("router_interface", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& ri = fs->routeInterfaceManager.get(router_interface_id);
   for (int i = 0; i < attr_count; ++i) {
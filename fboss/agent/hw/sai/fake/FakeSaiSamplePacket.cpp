@@ -17,12 +17,18 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_samplepacket_fn(
     sai_object_id_t* samplepacket_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("samplepacket", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_samplepacket_type_t> type;
   std::optional<sai_samplepacket_mode_t> mode;
@@ -48,18 +54,22 @@ sai_status_t create_samplepacket_fn(
   }
   *samplepacket_id = fs->samplePacketManager.create(
       sampleRate.value(), type.value(), mode.value());
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_samplepacket_fn(sai_object_id_t samplepacket_id) {
+  FakeSaiCall call("samplepacket", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->samplePacketManager.remove(samplepacket_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_samplepacket_attribute_fn(
     sai_object_id_t samplepacket_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("samplepacket", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& samplePacket = fs->samplePacketManager.get(samplepacket_id);
   switch (attr->id) {
@@ -76,6 +86,7 @@ sai_status_t get_samplepacket_attribute_fn(
     sai_object_id_t samplepacket_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("samplepacket", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& samplePacket = fs->samplePacketManager.get(samplepacket_id);
   for (int i = 0; i < attr_count; ++i) {
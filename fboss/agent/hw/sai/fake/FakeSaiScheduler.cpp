@@ -14,6 +14,8 @@
 #include <optional>
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 using facebook::fboss::FakeScheduler;
 
 sai_status_t create_scheduler_fn(
@@ -21,6 +23,10 @@ sai_status_t create_scheduler_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("scheduler", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   std::optional<sai_scheduling_type_t> schedulingType;
   std::optional<sai_uint8_t> weight;
   std::optional<sai_meter_type_t> meterType;
@@ -80,18 +86,22 @@ sai_status_t create_scheduler_fn(
   if (maxBandwidthBurstRate) {
     scheduler.maxBandwidthBurstRate = maxBandwidthBurstRate.value();
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_scheduler_fn(sai_object_id_t scheduler_id) {
+  FakeSaiCall call("scheduler", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->scheduleManager.remove(scheduler_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_scheduler_attribute_fn(
     sai_object_id_t scheduler_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("scheduler", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& scheduler = fs->scheduleManager.get(scheduler_id);
   sai_status_t res = SAI_STATUS_SUCCESS;
@@ -132,6 +142,7 @@ sai_status_t get_scheduler_attribute_fn(
     sai_object_id_t scheduler_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("scheduler", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto scheduler = fs->scheduleManager.get(scheduler_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -13,6 +13,8 @@
 #include <folly/logging/xlog.h>
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 namespace {
 static constexpr uint16_t kDefaultVlanId = 4095;
@@ -130,6 +132,7 @@ sai_status_t facebook::fboss::FakeSwitch::getLed(sai_attribute_t* attr) const {
 sai_status_t set_switch_attribute_fn(
     sai_object_id_t switch_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("switch", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& sw = fs->switchManager.get(switch_id);
   sai_status_t res;
@@ -254,6 +257,10 @@ sai_status_t create_switch_fn(
     sai_object_id_t* switch_id,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("switch", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   *switch_id = fs->switchManager.create();
   for (int i = 0; i < attr_count; ++i) {
@@ -261,12 +268,15 @@ sai_status_t create_switch_fn(
   }
   fs->switchManager.get(*switch_id)
       .setDefaultVlanId(fs->vlanManager.create(kDefaultVlanId));
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_switch_fn(sai_object_id_t switch_id) {
+  FakeSaiCall call("switch", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->switchManager.remove(switch_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -274,6 +284,7 @@ sai_status_t get_switch_attribute_fn(
     sai_object_id_t switch_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("switch", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& sw = fs->switchManager.get(switch_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -7,12 +7,18 @@
 namespace {
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_tam(
     sai_object_id_t* id,
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   std::vector<sai_object_id_t> events;
   std::vector<sai_int32_t> bindpoints;
   for (auto i = 0; i < attr_count; i++) {
@@ -37,12 +43,15 @@ sai_status_t create_tam(
   }
   auto fs = FakeSai::getInstance();
   *id = fs->tamManager.create(events, bindpoints);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_tam(sai_object_id_t id) {
+  FakeSaiCall call("tam", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->tamManager.remove(id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -50,6 +59,7 @@ sai_status_t get_tam_attribute(
     sai_object_id_t id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& tam = fs->tamManager.get(id);
   for (auto i = 0; i < attr_count; i++) {
@@ -84,6 +94,7 @@ sai_status_t get_tam_attribute(
 sai_status_t set_tam_attribute(
     sai_object_id_t id,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam", FakeSaiOp::SET);
   std::vector<sai_object_id_t> events;
   std::vector<sai_int32_t> bindpoints;
   switch (attr_list[0].id) {
@@ -119,6 +130,10 @@ sai_status_t create_tam_event(
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_event", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   sai_int32_t eventType{};
   std::vector<sai_object_id_t> actions{};
   std::vector<sai_object_id_t> collectors{};
@@ -158,12 +173,15 @@ sai_status_t create_tam_event(
   auto fs = FakeSai::getInstance();
   *id =
       fs->tamEventManager.create(eventType, actions, collectors, switchEvents);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_tam_event(sai_object_id_t id) {
+  FakeSaiCall call("tam_event", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->tamEventManager.remove(id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -171,6 +189,7 @@ sai_status_t get_tam_event_attribute(
     sai_object_id_t id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_event", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& eventAction = fs->tamEventManager.get(id);
   for (auto i = 0; i < attr_count; i++) {
@@ -220,6 +239,7 @@ sai_status_t get_tam_event_attribute(
 sai_status_t set_tam_event_attribute(
     sai_object_id_t id,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_event", FakeSaiOp::SET);
   sai_int32_t eventType{};
   std::vector<sai_object_id_t> actions{};
   std::vector<sai_object_id_t> collectors{};
@@ -272,6 +292,10 @@ sai_status_t create_tam_event_action(
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_event_action", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   sai_object_id_t reportType{};
   for (auto i = 0; i < attr_count; i++) {
     switch (attr_list[i].id) {
@@ -284,12 +308,15 @@ sai_status_t create_tam_event_action(
   }
   auto fs = FakeSai::getInstance();
   *id = fs->tamEventActionManager.create(reportType);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_tam_event_action(sai_object_id_t id) {
+  FakeSaiCall call("tam_event_action", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->tamEventActionManager.remove(id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -297,6 +324,7 @@ sai_status_t get_tam_event_action_attribute(
     sai_object_id_t id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_event_action", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& eventAction = fs->tamEventActionManager.get(id);
   for (auto i = 0; i < attr_count; i++) {
@@ -314,6 +342,7 @@ sai_status_t get_tam_event_action_attribute(
 sai_status_t set_tam_event_action_attribute(
     sai_object_id_t id,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_event_action", FakeSaiOp::SET);
   sai_object_id_t reportType{};
   switch (attr_list[0].id) {
     case SAI_TAM_EVENT_ACTION_ATTR_REPORT_TYPE:
@@ -337,6 +366,10 @@ sai_status_t create_tam_report(
     sai_object_id_t /*switch_id*/,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_report", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   sai_int32_t type;
   for (auto i = 0; i < attr_count; i++) {
     switch (attr_list[i].id) {
@@ -349,12 +382,15 @@ sai_status_t create_tam_report(
   }
   auto fs = FakeSai::getInstance();
   *id = fs->tamReportManager.create(type);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_tam_report(sai_object_id_t id) {
+  FakeSaiCall call("tam_report", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->tamReportManager.remove(id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -362,6 +398,7 @@ sai_status_t get_tam_report_attribute(
     sai_object_id_t id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_report", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& tamReport = fs->tamReportManager.get(id);
   for (auto i = 0; i < attr_count; i++) {
@@ -379,6 +416,7 @@ sai_status_t get_tam_report_attribute(
 sai_status_t set_tam_report_attribute(
     sai_object_id_t id,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("tam_report", FakeSaiOp::SET);
   sai_int32_t type;
   switch (attr_list[0].id) {
     case SAI_TAM_REPORT_ATTR_TYPE:
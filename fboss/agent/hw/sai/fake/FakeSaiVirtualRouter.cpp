@@ -15,6 +15,8 @@
 #include <folly/logging/xlog.h>
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 using facebook::fboss::FakeVirtualRouter;
 
 sai_status_t create_virtual_router_fn(
@@ -22,20 +24,28 @@ sai_status_t create_virtual_router_fn(
     sai_object_id_t /* switch_id */,
     uint32_t /* attr_count */,
     const sai_attribute_t* /* attr_list */) {
+  FakeSaiCall call("virtual_router", FakeSaiOp::CREATE);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   *virtual_router_id = fs->virtualRouteManager.create(FakeVirtualRouter());
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_virtual_router_fn(sai_object_id_t virtual_router_id) {
+  FakeSaiCall call("virtual_router", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->virtualRouteManager.remove(virtual_router_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t set_virtual_router_attribute_fn(
     sai_object_id_t virtual_router_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("virtual_router", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& virtualRouter = fs->virtualRouteManager.get(virtual_router_id);
   sai_status_t res = SAI_STATUS_SUCCESS;
@@ -58,6 +68,7 @@ sai_status_t get_virtual_router_attribute_fn(
     sai_object_id_t virtual_router_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("virtual_router", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& virtualRouter = fs->virtualRouteManager.get(virtual_router_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -15,6 +15,8 @@
 #include <optional>
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 using facebook::fboss::FakeVlan;
 using facebook::fboss::FakeVlanMember;
 
@@ -23,6 +25,10 @@ sai_status_t create_vlan_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("vlan", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<uint16_t> vlanId;
   for (int i = 0; i < attr_count; ++i) {
@@ -39,12 +45,15 @@ sai_status_t create_vlan_fn(
     return SAI_STATUS_INVALID_PARAMETER;
   }
   *vlan_id = fs->vlanManager.create(vlanId.value());
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_vlan_fn(sai_object_id_t vlan_id) {
+  FakeSaiCall call("vlan", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->vlanManager.remove(vlan_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -52,6 +61,7 @@ sai_status_t get_vlan_attribute_fn(
     sai_object_id_t vlan_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("vlan", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   const auto& vlan = fs->vlanManager.get(vlan_id);
   for (int i = 0; i < attr_count; ++i) {
@@ -81,6 +91,7 @@ sai_status_t get_vlan_attribute_fn(
 sai_status_t set_vlan_attribute_fn(
     sai_object_id_t /* vlan_id */,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("vlan", FakeSaiOp::SET);
   switch (attr->id) {
     default:
       return SAI_STATUS_NOT_SUPPORTED;
@@ -91,6 +102,7 @@ sai_status_t set_vlan_attribute_fn(
 sai_status_t set_vlan_member_attribute_fn(
     sai_object_id_t /* vlan_member_id */,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("vlan_member", FakeSaiOp::SET);
   sai_status_t res;
   if (!attr) {
     return SAI_STATUS_INVALID_PARAMETER;
@@ -108,6 +120,10 @@ sai_status_t create_vlan_member_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("vlan_member", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
   std::optional<sai_object_id_t> vlanId;
   for (int i = 0; i < attr_count; ++i) {
@@ -135,12 +151,15 @@ sai_status_t create_vlan_member_fn(
         return SAI_STATUS_INVALID_PARAMETER;
     }
   }
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_vlan_member_fn(sai_object_id_t vlan_member_id) {
+  FakeSaiCall call("vlan_member", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->vlanManager.removeMember(vlan_member_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -148,6 +167,7 @@ sai_status_t get_vlan_member_attribute_fn(
     sai_object_id_t vlan_member_id,
     uint32_t attr_count,
     sai_attribute_t* attr) {
+  FakeSaiCall call("vlan_member", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& vlanMember = fs->vlanManager.getMember(vlan_member_id);
   for (int i = 0; i < attr_count; ++i) {
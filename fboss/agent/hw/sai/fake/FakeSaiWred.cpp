@@ -13,10 +13,13 @@
 #include <folly/logging/xlog.h>
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiCall;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t set_wred_attribute_fn(
     sai_object_id_t wred_id,
     const sai_attribute_t* attr) {
+  FakeSaiCall call("wred", FakeSaiOp::SET);
   auto fs = FakeSai::getInstance();
   auto& wred = fs->wredManager.get(wred_id);
   sai_status_t res;
@@ -55,6 +58,10 @@ sai_status_t create_wred_fn(
     sai_object_id_t /*switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  FakeSaiCall call("wred", FakeSaiOp::CREATE, attr_count);
+  if (call.tableFull()) {
+    return SAI_STATUS_TABLE_FULL;
+  }
   auto fs = FakeSai::getInstance();
 
   std::optional<bool> greenEnable;
@@ -103,12 +110,15 @@ sai_status_t create_wred_fn(
       ecnGreenMinThreshold.value(),
       ecnGreenMaxThreshold.value());
 
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_wred_fn(sai_object_id_t wred_id) {
+  FakeSaiCall call("wred", FakeSaiOp::REMOVE);
   auto fs = FakeSai::getInstance();
   fs->wredManager.remove(wred_id);
+  call.succeeded();
   return SAI_STATUS_SUCCESS;
 }
 
@@ -116,6 +126,7 @@ sai_status_t get_wred_attribute_fn(
     sai_object_id_t wred_id,
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
+  FakeSaiCall call("wred", FakeSaiOp::GET, attr_count);
   auto fs = FakeSai::getInstance();
   auto& wred = fs->wredManager.get(wred_id);
   for (int i = 0; i < attr_count; ++i) {
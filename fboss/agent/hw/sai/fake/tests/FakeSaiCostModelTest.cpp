@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/fake/FakeSaiCostModel.h"
+
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/json.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kProfile = R"(
+// Comments are allowed
+{
+  "lockHoldUs": 1,
+  "objects": {
+    "route_entry": {
+      "capacity": 2,
+      "create": {"meanUs": 12, "stddevUs": 3, "perAttributeUs": 0.5},
+      "get_stats": {"meanUs": 4}
+    },
+    "default": {"remove": {"meanUs": 5}}
+  }
+}
+)";
+
+const FakeSaiCostModel::Latency& latency(
+    const FakeSaiCostModel::ObjectCost& cost,
+    FakeSaiOp op) {
+  return cost.ops[static_cast<size_t>(op)];
+}
+} // namespace
+
+class FakeSaiCostModelTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto model = std::make_unique<FakeSaiCostModel>(
+        folly::parseJson(folly::json::stripComments(kProfile)));
+    model_ = model.get();
+    FakeSaiCostModel::setForTesting(std::move(model));
+  }
+  void TearDown() override {
+    FakeSaiCostModel::setForTesting(nullptr);
+  }
+
+ protected:
+  FakeSaiCostModel* model_;
+};
+
+TEST_F(FakeSaiCostModelTest, parseProfile) {
+  folly::test::TemporaryFile file;
+  folly::writeFile(std::string(kProfile), file.path().string().c_str());
+  auto model = FakeSaiCostModel::load(file.path().string());
+
+  const auto& route = model->getObjectCost("route_entry");
+  EXPECT_EQ(route.capacity, 2);
+  EXPECT_DOUBLE_EQ(latency(route, FakeSaiOp::CREATE).meanUs, 12);
+  EXPECT_DOUBLE_EQ(latency(route, FakeSaiOp::CREATE).stddevUs, 3);
+  EXPECT_DOUBLE_EQ(latency(route, FakeSaiOp::CREATE).perAttributeUs, 0.5);
+  EXPECT_DOUBLE_EQ(latency(route, FakeSaiOp::GET_STATS).meanUs, 4);
+  // Ops not listed are free, the default only applies to unlisted objects
+  EXPECT_DOUBLE_EQ(latency(route, FakeSaiOp::REMOVE).meanUs, 0);
+
+  const auto& other = model->getObjectCost("next_hop");
+  EXPECT_FALSE(other.capacity);
+  EXPECT_DOUBLE_EQ(latency(other, FakeSaiOp::REMOVE).meanUs, 5);
+  EXPECT_DOUBLE_EQ(latency(other, FakeSaiOp::CREATE).meanUs, 0);
+
+  EXPECT_THROW(
+      FakeSaiCostModel::load(file.path().string() + ".missing"),
+      std::runtime_error);
+}
+
+TEST_F(FakeSaiCostModelTest, chargeSpendsCost) {
+  auto start = std::chrono::steady_clock::now();
+  // 5us for the default remove
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(model_->charge("next_hop", FakeSaiOp::REMOVE, 0));
+  }
+  EXPECT_GE(
+      std::chrono::steady_clock::now() - start, std::chrono::microseconds(500));
+}
+
+TEST_F(FakeSaiCostModelTest, tableFull) {
+  for (int i = 0; i < 2; ++i) {
+    FakeSaiCall call("route_entry", FakeSaiOp::CREATE);
+    EXPECT_FALSE(call.tableFull());
+    call.succeeded();
+  }
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 2);
+  {
+    FakeSaiCall call("route_entry", FakeSaiOp::CREATE);
+    EXPECT_TRUE(call.tableFull());
+  }
+  // Objects without a capacity never fill up
+  for (int i = 0; i < 10; ++i) {
+    FakeSaiCall call("next_hop", FakeSaiOp::CREATE);
+    EXPECT_FALSE(call.tableFull());
+    call.succeeded();
+  }
+
+  {
+    FakeSaiCall call("route_entry", FakeSaiOp::REMOVE);
+    call.succeeded();
+  }
+  FakeSaiCall call("route_entry", FakeSaiOp::CREATE);
+  EXPECT_FALSE(call.tableFull());
+}
+
+TEST_F(FakeSaiCostModelTest, countOnlySuccess) {
+  {
+    FakeSaiCall call("route_entry", FakeSaiOp::CREATE);
+    // Held while the create runs
+    EXPECT_EQ(model_->getLiveObjects("route_entry"), 1);
+  }
+  // Failed create gives the slot back
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 0);
+  {
+    FakeSaiCall call("route_entry", FakeSaiOp::CREATE);
+    call.succeeded();
+  }
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 1);
+  {
+    // Failed remove
+    FakeSaiCall call("route_entry", FakeSaiOp::REMOVE);
+  }
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 1);
+  {
+    FakeSaiCall call("route_entry", FakeSaiOp::REMOVE);
+    call.succeeded();
+  }
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 0);
+  {
+    // Removing more than was created doesn't wrap around
+    FakeSaiCall call("route_entry", FakeSaiOp::REMOVE);
+    call.succeeded();
+  }
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 0);
+
+  {
+    FakeSaiCall call("route_entry", FakeSaiOp::CREATE);
+    call.succeeded();
+  }
+  model_->clearObjectCounts();
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 0);
+}
+
+TEST_F(FakeSaiCostModelTest, nestedCallsAreFree) {
+  FakeSaiCall outer("route_entry", FakeSaiOp::CREATE);
+  EXPECT_FALSE(outer.tableFull());
+  {
+    FakeSaiCall inner("route_entry", FakeSaiOp::CREATE);
+    EXPECT_FALSE(inner.tableFull());
+    inner.succeeded();
+  }
+  {
+    FakeSaiCall inner("route_entry", FakeSaiOp::REMOVE);
+    inner.succeeded();
+  }
+  // Only the outer create is counted
+  EXPECT_EQ(model_->getLiveObjects("route_entry"), 1);
+  outer.succeeded();
+}
+
+TEST_F(FakeSaiCostModelTest, noModel) {
+  FakeSaiCostModel::setForTesting(nullptr);
+  FakeSaiCall call("route_entry", FakeSaiOp::CREATE);
+  EXPECT_FALSE(call.tableFull());
+}
@@ -200,27 +200,27 @@ class SaiObject {
       : adapterKey_(adapterKey) {
     auto& api =
         SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
-    // N.B., fills out attributes_ as a side effect
-    // XXX TODO: side-effect mode does NOT work with optionals
-    attributes_ = api.getAttribute(adapterKey_, attributes_);
+    attributes_ = api.template getMultipleAttributes<SaiObjectTraits>(
+        adapterKey_, attributes_);
     live_ = true;
-    adapterHostKey_ =
-        detail::adapterHostKey<SaiObjectTraits>(adapterKey_, attributes_);
+    if constexpr (!kAdapterHostKeyIsAdapterKey) {
+      adapterHostKey_ =
+          detail::adapterHostKey<SaiObjectTraits>(adapterKey_, attributes_);
+    }
   }
 
   // load with adapter key and adapter host key
   explicit SaiObject(
       const typename SaiObjectTraits::AdapterKey& adapterKey,
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey)
-      : adapterKey_(adapterKey), adapterHostKey_(adapterHostKey) {
+      : adapterHostKey_(adapterHostKey), adapterKey_(adapterKey) {
     static_assert(
         !AdapterHostKeyWarmbootRecoverable<SaiObjectTraits>::value,
         "object adapter host key is recoverable");
     auto& api =
         SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
-    // N.B., fills out attributes_ as a side effect
-    // XXX TODO: side-effect mode does NOT work with optionals
-    attributes_ = api.getAttribute(adapterKey_, attributes_);
+    attributes_ = api.template getMultipleAttributes<SaiObjectTraits>(
+        adapterKey_, attributes_);
     live_ = true;
   }
 
@@ -229,7 +229,8 @@ class SaiObject {
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
       const typename SaiObjectTraits::CreateAttributes& attributes,
       sai_object_id_t switchId)
-      : adapterHostKey_(adapterHostKey), attributes_(attributes) {
+      : adapterHostKey_(toAdapterHostKeyStorage(adapterHostKey)),
+        attributes_(attributes) {
     adapterKey_ = createHelper(adapterHostKey, attributes, switchId);
     live_ = true;
   }
@@ -250,10 +251,9 @@ class SaiObject {
 
   SaiObject& operator=(SaiObject&& other) {
     if (LIKELY(other.live_)) {
-      // TODO(borisb): move members instead of copy?!
-      adapterKey_ = other.adapterKey();
-      adapterHostKey_ = other.adapterHostKey();
-      attributes_ = other.attributes();
+      adapterKey_ = std::move(other.adapterKey_);
+      adapterHostKey_ = std::move(other.adapterHostKey_);
+      attributes_ = std::move(other.attributes_);
       live_ = true;
       other.live_ = false;
     } else {
@@ -305,7 +305,7 @@ class SaiObject {
     if (UNLIKELY(!live_)) {
       XLOG(FATAL) << "Attempted to get Adapter Host Key of non-live SaiObject";
     }
-    return adapterHostKey_;
+    return adapterHostKeyUnchecked();
   }
 
   const typename SaiObjectTraits::CreateAttributes& attributes() const {
@@ -322,7 +322,7 @@ class SaiObject {
     if constexpr (IsPublisherKeyCustomType<SaiObjectTraits>::value) {
       return publisherKey_;
     } else if constexpr (IsPublisherKeyAdapterHostKey<SaiObjectTraits>::value) {
-      return adapterHostKey_;
+      return adapterHostKeyUnchecked();
     } else {
       static_assert(
           IsPublisherKeyCreateAttributes<SaiObjectTraits>::value,
@@ -444,6 +444,39 @@ class SaiObject {
   }
 
  private:
+  /*
+   * Entry struct objects (routes, neighbors, fdb entries, ...) use the entry
+   * as both adapter key and adapter host key. For those, with hundreds of
+   * thousands of instances, we don't store a second copy of the key.
+   */
+  static constexpr bool kAdapterHostKeyIsAdapterKey =
+      AdapterKeyIsEntryStruct<SaiObjectTraits>::value &&
+      std::is_same_v<
+          typename SaiObjectTraits::AdapterKey,
+          typename SaiObjectTraits::AdapterHostKey>;
+  using AdapterHostKeyStorage = std::conditional_t<
+      kAdapterHostKeyIsAdapterKey,
+      std::monostate,
+      typename SaiObjectTraits::AdapterHostKey>;
+
+  static AdapterHostKeyStorage toAdapterHostKeyStorage(
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
+    if constexpr (kAdapterHostKeyIsAdapterKey) {
+      return std::monostate{};
+    } else {
+      return adapterHostKey;
+    }
+  }
+
+  const typename SaiObjectTraits::AdapterHostKey& adapterHostKeyUnchecked()
+      const {
+    if constexpr (kAdapterHostKeyIsAdapterKey) {
+      return adapterKey_;
+    } else {
+      return adapterHostKey_;
+    }
+  }
+
   template <typename AttrT>
   void setNewAttributeHelper(const AttrT& newAttr) {
     auto& api =
@@ -457,14 +490,15 @@ class SaiObject {
       setNewAttributeHelper(newAttrOpt.value());
     }
   }
+  // Small members first, so that the flags and empty keys share one word
   bool live_{false};
   // For some object types we can ignore missing in HW errors
   // on when deleting.
   bool ignoreMissingInHwOnDelete_{false};
+  AdapterHostKeyStorage adapterHostKey_;
+  typename PublisherKey<SaiObjectTraits>::custom_type publisherKey_{};
   typename SaiObjectTraits::AdapterKey adapterKey_;
-  typename SaiObjectTraits::AdapterHostKey adapterHostKey_;
   typename SaiObjectTraits::CreateAttributes attributes_;
-  typename PublisherKey<SaiObjectTraits>::custom_type publisherKey_{};
 };
 
 /*
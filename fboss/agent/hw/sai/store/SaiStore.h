@@ -18,10 +18,14 @@
 #include "fboss/agent/hw/sai/store/SaiObject.h"
 #include "fboss/agent/hw/sai/store/SaiObjectWithCounters.h"
 #include "fboss/agent/hw/sai/store/Traits.h"
+#include "fboss/lib/FixedSizeArena.h"
 #include "fboss/lib/RefMap.h"
 
 #include <folly/dynamic.h>
+#include <gflags/gflags.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -31,6 +35,8 @@ extern "C" {
 #include <sai.h>
 }
 
+DECLARE_int32(sai_store_reload_threads);
+
 namespace facebook::fboss {
 
 inline constexpr auto kAdapterKey2AdapterHostKey = "adapterKey2AdapterHostKey";
@@ -42,6 +48,37 @@ struct AdapterHostKeyWarmbootRecoverable<SaiNextHopGroupTraits>
 template <>
 struct AdapterHostKeyWarmbootRecoverable<SaiLagTraits> : std::false_type {};
 
+/*
+ * Object types with a very large number of instances, whose objects and
+ * shared_ptr control blocks are allocated from arenas rather than the heap.
+ */
+template <typename SaiObjectTraits>
+struct IsSaiObjectArenaAllocated : std::false_type {};
+template <>
+struct IsSaiObjectArenaAllocated<SaiRouteTraits> : std::true_type {};
+template <>
+struct IsSaiObjectArenaAllocated<SaiNeighborTraits> : std::true_type {};
+template <>
+struct IsSaiObjectArenaAllocated<SaiFdbTraits> : std::true_type {};
+template <>
+struct IsSaiObjectArenaAllocated<SaiIpNextHopTraits> : std::true_type {};
+template <>
+struct IsSaiObjectArenaAllocated<SaiMplsNextHopTraits> : std::true_type {};
+
+/*
+ * Memory held for the objects of one SaiObjectStore. For arena allocated
+ * types, this is the store's share of the slabs its arena reserved: arenas
+ * are shared by every type of the same size, so each store is charged in
+ * proportion to the blocks it holds. For other types it is the size of the
+ * objects. shared_ptr control blocks, map nodes and heap memory owned by
+ * attributes (e.g. lists) are not accounted for.
+ */
+struct SaiObjectStoreMemoryUsage {
+  uint64_t objects{0};
+  uint64_t bytes{0};
+  bool arenaAllocated{false};
+};
+
 /*
  * SaiObjectStore is the critical component of SaiStore,
  * it provides the needed operations on a single type of SaiObject
@@ -56,6 +93,14 @@ class SaiObjectStore {
       SaiObjectWithCounters<SaiObjectTraits>,
       SaiObject<SaiObjectTraits>>::type;
   using ObjectTraits = SaiObjectTraits;
+  using Allocator = std::conditional_t<
+      IsSaiObjectArenaAllocated<SaiObjectTraits>::value,
+      ArenaAllocator<ObjectType>,
+      std::allocator<ObjectType>>;
+  using ObjectMap = UnorderedRefMap<
+      typename SaiObjectTraits::AdapterHostKey,
+      ObjectType,
+      Allocator>;
 
   explicit SaiObjectStore(sai_object_id_t switchId) : switchId_(switchId) {}
   SaiObjectStore() {}
@@ -247,28 +292,38 @@ class SaiObjectStore {
     objects_.clear();
   }
 
-  const UnorderedRefMap<typename SaiObjectTraits::AdapterHostKey, ObjectType>&
-  objects() const {
+  const ObjectMap& objects() const {
     return objects_;
   }
 
   uint64_t size() const {
     return objects_.size();
   }
-  typename UnorderedRefMap<
-      typename SaiObjectTraits::AdapterHostKey,
-      ObjectType>::MapType::const_iterator
-  begin() const {
+  typename ObjectMap::MapType::const_iterator begin() const {
     return objects_.begin();
   }
 
-  typename UnorderedRefMap<
-      typename SaiObjectTraits::AdapterHostKey,
-      ObjectType>::MapType::const_iterator
-  end() const {
+  typename ObjectMap::MapType::const_iterator end() const {
     return objects_.end();
   }
 
+  SaiObjectStoreMemoryUsage memoryUsage() const {
+    SaiObjectStoreMemoryUsage usage;
+    usage.objects = objects_.size();
+    usage.arenaAllocated = IsSaiObjectArenaAllocated<SaiObjectTraits>::value;
+    if constexpr (IsSaiObjectArenaAllocated<SaiObjectTraits>::value) {
+      const auto& arena = Allocator::Arena::get();
+      auto arenaBlocks = arena.allocatedBlocks();
+      if (arenaBlocks) {
+        usage.bytes = arena.reservedBytes() *
+            std::min<uint64_t>(usage.objects, arenaBlocks) / arenaBlocks;
+      }
+    } else {
+      usage.bytes = usage.objects * sizeof(ObjectType);
+    }
+    return usage;
+  }
+
   void setObjectOwnedByAdapter(bool objectOwnedByAdapter) {
     objectOwnedByAdapter_ = objectOwnedByAdapter;
   }
@@ -387,8 +442,7 @@ class SaiObjectStore {
 
   std::optional<sai_object_id_t> switchId_;
   bool objectOwnedByAdapter_{false};
-  UnorderedRefMap<typename SaiObjectTraits::AdapterHostKey, ObjectType>
-      objects_;
+  ObjectMap objects_;
   std::unordered_map<
       typename SaiObjectTraits::AdapterHostKey,
       std::shared_ptr<ObjectType>>
@@ -428,6 +482,8 @@ class SaiStore {
 
   /*
    * Reload the SaiStore from the current SAI state via SAI api calls.
+   * Object stores are reloaded in parallel on --sai_store_reload_threads
+   * threads.
    */
   void reload(
       const folly::dynamic* adapterKeys = nullptr,
@@ -454,6 +510,9 @@ class SaiStore {
 
   folly::dynamic adapterKeys2AdapterHostKeysFollyDynamic() const;
 
+  // Estimated memory held by each object store, by object type name
+  std::map<std::string, SaiObjectStoreMemoryUsage> memoryUsage() const;
+
   void checkUnexpectedUnclaimedWarmbootHandles() const;
 
   void removeUnexpectedUnclaimedWarmbootHandles();
@@ -172,3 +172,66 @@ TEST_F(SaiStoreTest, toStrV6Route) {
 
   verifyToStr<SaiRouteTraits>();
 }
+
+TEST_F(SaiStoreTest, loadRoutesParallel) {
+  auto& routeApi = saiApiTable->routeApi();
+  std::vector<SaiRouteTraits::RouteEntry> routes;
+  for (auto i = 0; i < 100; ++i) {
+    folly::CIDRNetwork dest(
+        folly::IPAddress(folly::sformat("10.10.{}.0", i)), 24);
+    routes.emplace_back(0, 0, dest);
+    routeApi.create<SaiRouteTraits>(
+        routes.back(),
+        {SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD},
+         SaiRouteTraits::Attributes::NextHopId(i),
+         SaiRouteTraits::Attributes::Metadata(i + 1)});
+  }
+
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_store_reload_threads = 1;
+  SaiStore serial(0);
+  serial.reload();
+  FLAGS_sai_store_reload_threads = 8;
+  FLAGS_sai_concurrent_gets = true;
+  SaiStore parallel(0);
+  parallel.reload();
+
+  EXPECT_EQ(parallel.get<SaiRouteTraits>().size(), routes.size());
+  for (const auto& route : routes) {
+    auto got = parallel.get<SaiRouteTraits>().get(route);
+    auto expected = serial.get<SaiRouteTraits>().get(route);
+    ASSERT_NE(got, nullptr);
+    ASSERT_NE(expected, nullptr);
+    EXPECT_EQ(got->attributes(), expected->attributes());
+  }
+}
+
+TEST_F(SaiStoreTest, routeMemoryUsage) {
+  auto& routeApi = saiApiTable->routeApi();
+  for (auto i = 0; i < 10; ++i) {
+    folly::CIDRNetwork dest(
+        folly::IPAddress(folly::sformat("10.10.{}.0", i)), 24);
+    routeApi.create<SaiRouteTraits>(
+        SaiRouteTraits::RouteEntry(0, 0, dest),
+        {SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD}});
+  }
+  SaiStore s(0);
+  s.reload();
+
+  auto& store = s.get<SaiRouteTraits>();
+  auto usage = store.memoryUsage();
+  EXPECT_TRUE(usage.arenaAllocated);
+  EXPECT_EQ(usage.objects, 10);
+  using Arena = SaiObjectStore<SaiRouteTraits>::Allocator::Arena;
+  EXPECT_GE(Arena::get().allocatedBlocks(), 10);
+  // A share of the slabs reserved by the arena, which has room for at least
+  // the blocks in use
+  EXPECT_GE(usage.bytes, 10 * Arena::kBlockSize);
+  EXPECT_LE(usage.bytes, Arena::get().reservedBytes());
+
+  auto storeUsage = s.memoryUsage();
+  auto routeUsage = storeUsage.find("route-entry");
+  ASSERT_NE(routeUsage, storeUsage.end());
+  EXPECT_EQ(routeUsage->second.objects, usage.objects);
+  EXPECT_EQ(routeUsage->second.bytes, usage.bytes);
+}
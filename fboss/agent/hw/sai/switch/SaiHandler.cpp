@@ -9,7 +9,9 @@
  */
 #include "fboss/agent/hw/sai/switch/SaiHandler.h"
 
+#include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
+#include "fboss/lib/LogThriftCall.h"
 
 #include <folly/logging/xlog.h>
 
@@ -56,4 +58,17 @@ void SaiHandler::diagCmd(
   result = diagCmdServer_.diagCmd(std::move(cmd), std::move(client));
 }
 
+void SaiHandler::getSaiStoreMemoryUsage(
+    std::vector<SaiObjectMemoryUsage>& memoryUsage) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  for (const auto& [objectType, usage] : hw_->getSaiStoreMemoryUsage()) {
+    SaiObjectMemoryUsage entry;
+    entry.objectType_ref() = objectType;
+    entry.objects_ref() = usage.objects;
+    entry.bytes_ref() = usage.bytes;
+    entry.arenaAllocated_ref() = usage.arenaAllocated;
+    memoryUsage.push_back(std::move(entry));
+  }
+}
+
 } // namespace facebook::fboss
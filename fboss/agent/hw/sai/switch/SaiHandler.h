@@ -37,6 +37,9 @@ class SaiHandler : virtual public SaiCtrlSvIf, public ThriftHandler {
       int16_t serverTimeoutMsecs = 0,
       bool bypassFilter = false) override;
 
+  void getSaiStoreMemoryUsage(
+      std::vector<SaiObjectMemoryUsage>& memoryUsage) override;
+
  private:
   const SaiSwitch* hw_;
   StreamingDiagShellServer diagShell_;
@@ -133,7 +133,12 @@ class SaiNextHopGroupManager {
       const SaiPlatform* platform);
 
   std::shared_ptr<SaiNextHopGroupHandle> incRefOrAddNextHopGroup(
-      const RouteNextHopEntry::NextHopSet& swNextHops);
+      const InternedNextHopSetPtr& swNextHops);
+
+  std::shared_ptr<SaiNextHopGroupHandle> incRefOrAddNextHopGroup(
+      const RouteNextHopEntry::NextHopSet& swNextHops) {
+    return incRefOrAddNextHopGroup(internNextHopSet(swNextHops));
+  }
 
  private:
   SaiManagerTable* managerTable_;
@@ -141,7 +146,9 @@ class SaiNextHopGroupManager {
   // TODO(borisb): improve SaiObject/SaiStore to the point where they
   // support the next hop group use case correctly, rather than this
   // abomination of multiple levels of RefMaps :(
-  FlatRefMap<RouteNextHopEntry::NextHopSet, SaiNextHopGroupHandle> handles_;
+  // Interned next hop sets are equal iff they are the same object, so the
+  // handles are keyed by pointer
+  UnorderedRefMap<InternedNextHopSetPtr, SaiNextHopGroupHandle> handles_;
   FlatRefMap<
       std::pair<typename SaiNextHopGroupTraits::AdapterKey, ResolvedNextHop>,
       ManagedNextHopGroupMember>
@@ -34,6 +34,8 @@
 
 using namespace std::chrono;
 
+DECLARE_int32(port_counter_history);
+
 namespace facebook::fboss {
 namespace {
 void fillHwPortStats(
@@ -129,7 +131,8 @@ SaiPortManager::SaiPortManager(
     ConcurrentIndices* concurrentIndices)
     : managerTable_(managerTable),
       platform_(platform),
-      concurrentIndices_(concurrentIndices) {
+      concurrentIndices_(concurrentIndices),
+      portCounterStore_(FLAGS_port_counter_history) {
   /*
    * FDB entries will be initially owned by SDK since learn mode is HW
    * by default. Once the config is applied, object owned by adapter
@@ -382,6 +385,9 @@ void SaiPortManager::removePort(const std::shared_ptr<Port>& swPort) {
       PortDescriptorSaiId(itr->second->port->adapterKey()));
   addRemovedHandle(itr->first);
   handles_.erase(itr);
+  if (swPort->isEnabled()) {
+    portCounterStore_.resetPort(swPort->getName());
+  }
   portStats_.erase(swId);
   // TODO: do FDB entries associated with this port need to be removed
   // now?
@@ -608,10 +614,12 @@ void SaiPortManager::changePort(
       // Port was already enabled, but Port name changed - update stats
       portStats_.find(newPort->getID())
           ->second->portNameChanged(newPort->getName());
+      portCounterStore_.resetPort(oldPort->getName());
     }
   } else if (oldPort->isEnabled()) {
     // Port transitioned from enabled to disabled, remove stats
     portStats_.erase(newPort->getID());
+    portCounterStore_.resetPort(oldPort->getName());
   }
   changeQueue(
       newPort->getID(), oldPort->getPortQueues(), newPort->getPortQueues());
@@ -825,6 +833,17 @@ void SaiPortManager::updateStats(PortID portId) {
   managerTable_->queueManager().updateStats(
       handle->configuredQueues, curPortStats);
   portStats_[portId]->updateStats(curPortStats, now);
+  portCounterStore_.updatePort(
+      portStatItr->second->portName(), curPortStats);
+}
+
+void SaiPortManager::startStatsCycle() {
+  portCounterStore_.beginCycle(
+      duration_cast<seconds>(system_clock::now().time_since_epoch()));
+}
+
+void SaiPortManager::finishStatsCycle() {
+  portCounterStore_.endCycle();
 }
 
 std::map<PortID, HwPortStats> SaiPortManager::getPortStats() const {
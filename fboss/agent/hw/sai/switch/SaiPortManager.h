@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "fboss/agent/hw/HwPortCounterStore.h"
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
 #include "fboss/agent/hw/sai/api/PortApi.h"
 #include "fboss/agent/hw/sai/store/SaiObjectWithCounters.h"
@@ -132,7 +133,18 @@ class SaiPortManager {
   std::shared_ptr<Port> swPortFromAttributes(
       SaiPortTraits::CreateAttributes attributees) const;
 
+  /*
+   * One stats collection cycle: startStatsCycle(), updateStats() for every
+   * port, then finishStatsCycle() to publish the cycle to the port counter
+   * store.
+   */
+  void startStatsCycle();
   void updateStats(PortID portID);
+  void finishStatsCycle();
+
+  const HwPortCounterStore& getPortCounterStore() const {
+    return portCounterStore_;
+  }
 
   void clearStats(PortID portID);
 
@@ -198,6 +210,7 @@ class SaiPortManager {
   // removed port handle so it does not invoke remove port api.
   Handles removedHandles_;
   Stats portStats_;
+  HwPortCounterStore portCounterStore_;
   std::shared_ptr<SaiQosMap> globalDscpToTcQosMap_;
   std::shared_ptr<SaiQosMap> globalTcToQueueQosMap_;
   std::optional<cfg::L2LearningMode> l2LearningMode_{std::nullopt};
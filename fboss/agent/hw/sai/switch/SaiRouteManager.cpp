@@ -181,7 +181,7 @@ void SaiRouteManager::addOrUpdateRoute(
        */
       auto nextHopGroupHandle =
           managerTable_->nextHopGroupManager().incRefOrAddNextHopGroup(
-              fwd.normalizedNextHops());
+              fwd.normalizedInternedNextHops());
       NextHopGroupSaiId nextHopGroupId{
           nextHopGroupHandle->nextHopGroup->adapterKey()};
       attributes = SaiRouteTraits::CreateAttributes{
@@ -682,6 +682,10 @@ bool SaiSwitch::sendPacketOutOfPortAsync(
 }
 
 void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
+  {
+    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    managerTable_->portManager().startStatsCycle();
+  }
   auto iter = concurrentIndices_->portIds.begin();
   while (iter != concurrentIndices_->portIds.end()) {
     {
@@ -690,6 +694,10 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     }
     ++iter;
   }
+  {
+    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    managerTable_->portManager().finishStatsCycle();
+  }
   {
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
     managerTable_->hostifManager().updateStats();
@@ -719,6 +727,11 @@ folly::F14FastMap<std::string, HwPortStats> SaiSwitch::getPortStats() const {
   return getPortStatsLocked(lock);
 }
 
+const HwPortCounterStore* SaiSwitch::getPortCounterStore() const {
+  // Synchronized on its own, the port manager lives as long as we do
+  return &managerTable_->portManager().getPortCounterStore();
+}
+
 folly::F14FastMap<std::string, HwPortStats> SaiSwitch::getPortStatsLocked(
     const std::lock_guard<std::mutex>& /* lock */) const {
   folly::F14FastMap<std::string, HwPortStats> portStatsMap;
@@ -749,7 +762,9 @@ void SaiSwitch::gracefulExitLocked(
   SaiSwitchTraits::Attributes::SwitchRestartWarm restartWarm{true};
   SaiApiTable::getInstance()->switchApi().setAttribute(switchId_, restartWarm);
   switchState[kHwSwitch] = toFollyDynamicLocked(lock);
-  platform_->getWarmBootHelper()->storeWarmBootState(switchState);
+  // The state is not needed past this point, let the writer free it as it
+  // goes
+  platform_->getWarmBootHelper()->storeWarmBootState(std::move(switchState));
   platform_->getWarmBootHelper()->setCanWarmBoot();
   std::chrono::steady_clock::time_point wbSaiSwitchWrite =
       std::chrono::steady_clock::now();
@@ -1828,4 +1843,10 @@ std::string SaiSwitch::listObjects(
   std::lock_guard<std::mutex> lk(saiSwitchMutex_);
   return listObjectsLocked(objTypes, cached, lk);
 }
+
+std::map<std::string, SaiObjectStoreMemoryUsage>
+SaiSwitch::getSaiStoreMemoryUsage() const {
+  std::lock_guard<std::mutex> lk(saiSwitchMutex_);
+  return SaiStore::getInstance()->memoryUsage();
+}
 } // namespace facebook::fboss
@@ -20,6 +20,7 @@
 
 #include <folly/io/async/EventBase.h>
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -27,6 +28,7 @@
 namespace facebook::fboss {
 
 class ConcurrentIndices;
+struct SaiObjectStoreMemoryUsage;
 /*
  * This is equivalent to sai_fdb_event_notification_data_t. Copy only the
  * necessary FDB event attributes from sai_fdb_event_notification_data_t.
@@ -97,6 +99,8 @@ class SaiSwitch : public HwSwitch {
 
   folly::F14FastMap<std::string, HwPortStats> getPortStats() const override;
 
+  const HwPortCounterStore* getPortCounterStore() const override;
+
   uint64_t getDeviceWatermarkBytes() const override;
 
   void fetchL2Table(std::vector<L2EntryThrift>* l2Table) const override;
@@ -163,6 +167,8 @@ class SaiSwitch : public HwSwitch {
   std::string listObjects(const std::vector<HwObjectType>& types, bool cached)
       const override;
   void dumpDebugState(const std::string& /*path*/) const override;
+  std::map<std::string, SaiObjectStoreMemoryUsage> getSaiStoreMemoryUsage()
+      const;
 
   std::shared_ptr<SwitchState> stateChangedTransaction(
       const StateDelta& delta) override;
@@ -6,9 +6,19 @@ namespace py3 neteng.fboss
 include "fboss/agent/if/fboss.thrift"
 include "fboss/agent/if/ctrl.thrift"
 
+struct SaiObjectMemoryUsage {
+  1: string objectType
+  2: i64 objects
+  // Bytes held by the SaiStore for these objects, see SaiObjectStoreMemoryUsage
+  3: i64 bytes
+  4: bool arenaAllocated
+}
+
 service SaiCtrl extends ctrl.FbossCtrl {
   string, stream<string> startDiagShell()
     throws (1: fboss.FbossBaseError error)
   void produceDiagShellInput(1: string input, 2: ctrl.ClientInformation client)
     throws (1: fboss.FbossBaseError error)
+  list<SaiObjectMemoryUsage> getSaiStoreMemoryUsage()
+    throws (1: fboss.FbossBaseError error)
 }
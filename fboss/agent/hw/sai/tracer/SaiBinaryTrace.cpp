@@ -0,0 +1,702 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+
+#include "fboss/agent/AsyncLogger.h"
+#include "fboss/agent/FbossError.h"
+
+#include <folly/Bits.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+DEFINE_int32(
+    sai_binary_log_ring_size,
+    1 << 20,
+    "Size in bytes of the per-thread ring used by the binary SAI tracer. "
+    "Rounded up to a power of 2");
+
+namespace facebook::fboss {
+
+namespace {
+
+std::atomic<uint64_t> nextGeneration{0};
+
+uint64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void appendBytes(std::string& out, const void* data, size_t size) {
+  out.append(static_cast<const char*>(data), size);
+}
+
+const void* listData(
+    const sai_attribute_value_t& value,
+    SaiBinaryTraceListType listType) {
+  switch (listType) {
+    case SaiBinaryTraceListType::OBJECT_LIST:
+      return value.objlist.list;
+    case SaiBinaryTraceListType::S8_LIST:
+      return value.s8list.list;
+    case SaiBinaryTraceListType::S32_LIST:
+      return value.s32list.list;
+    case SaiBinaryTraceListType::U32_LIST:
+      return value.u32list.list;
+    case SaiBinaryTraceListType::QOS_MAP_LIST:
+      return value.qosmap.list;
+    case SaiBinaryTraceListType::ACL_ACTION_OBJECT_LIST:
+      return value.aclaction.parameter.objlist.list;
+    case SaiBinaryTraceListType::NONE:
+      break;
+  }
+  return nullptr;
+}
+
+uint32_t listCount(
+    const sai_attribute_value_t& value,
+    SaiBinaryTraceListType listType) {
+  switch (listType) {
+    case SaiBinaryTraceListType::OBJECT_LIST:
+      return value.objlist.count;
+    case SaiBinaryTraceListType::S8_LIST:
+      return value.s8list.count;
+    case SaiBinaryTraceListType::S32_LIST:
+      return value.s32list.count;
+    case SaiBinaryTraceListType::U32_LIST:
+      return value.u32list.count;
+    case SaiBinaryTraceListType::QOS_MAP_LIST:
+      return value.qosmap.count;
+    case SaiBinaryTraceListType::ACL_ACTION_OBJECT_LIST:
+      return value.aclaction.parameter.objlist.count;
+    case SaiBinaryTraceListType::NONE:
+      break;
+  }
+  return 0;
+}
+
+void setListPointer(
+    sai_attribute_value_t& value,
+    SaiBinaryTraceListType listType,
+    void* data) {
+  switch (listType) {
+    case SaiBinaryTraceListType::OBJECT_LIST:
+      value.objlist.list = static_cast<sai_object_id_t*>(data);
+      break;
+    case SaiBinaryTraceListType::S8_LIST:
+      value.s8list.list = static_cast<sai_int8_t*>(data);
+      break;
+    case SaiBinaryTraceListType::S32_LIST:
+      value.s32list.list = static_cast<sai_int32_t*>(data);
+      break;
+    case SaiBinaryTraceListType::U32_LIST:
+      value.u32list.list = static_cast<sai_uint32_t*>(data);
+      break;
+    case SaiBinaryTraceListType::QOS_MAP_LIST:
+      value.qosmap.list = static_cast<sai_qos_map_t*>(data);
+      break;
+    case SaiBinaryTraceListType::ACL_ACTION_OBJECT_LIST:
+      value.aclaction.parameter.objlist.list =
+          static_cast<sai_object_id_t*>(data);
+      break;
+    case SaiBinaryTraceListType::NONE:
+      break;
+  }
+}
+
+void appendAttributes(
+    std::string& out,
+    sai_object_type_t objectType,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList) {
+  for (auto i = 0; i < attrCount; ++i) {
+    SaiBinaryTraceAttributeHeader attrHeader{};
+    attrHeader.id = attrList[i].id;
+    attrHeader.listType = saiBinaryTraceListType(objectType, attrList[i].id);
+    attrHeader.value = attrList[i].value;
+
+    auto data = listData(attrList[i].value, attrHeader.listType);
+    attrHeader.listCount =
+        data ? listCount(attrList[i].value, attrHeader.listType) : 0;
+    appendBytes(out, &attrHeader, sizeof(attrHeader));
+    if (attrHeader.listCount) {
+      appendBytes(
+          out,
+          data,
+          attrHeader.listCount *
+              saiBinaryTraceListElementSize(attrHeader.listType));
+    }
+  }
+}
+
+} // namespace
+
+SaiBinaryTraceListType saiBinaryTraceListType(
+    sai_object_type_t objectType,
+    sai_attr_id_t attrId) {
+  // Keep in sync with the list attributes handled by set*Attributes in the
+  // *ApiTracer.cpp files. Everything else is stored inline in
+  // sai_attribute_value_t.
+  switch (objectType) {
+    case SAI_OBJECT_TYPE_ACL_ENTRY:
+      switch (attrId) {
+        case SAI_ACL_ENTRY_ATTR_ACTION_MIRROR_INGRESS:
+        case SAI_ACL_ENTRY_ATTR_ACTION_MIRROR_EGRESS:
+          return SaiBinaryTraceListType::ACL_ACTION_OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_ACL_TABLE:
+      switch (attrId) {
+        case SAI_ACL_TABLE_ATTR_ACL_BIND_POINT_TYPE_LIST:
+        case SAI_ACL_TABLE_ATTR_ACL_ACTION_TYPE_LIST:
+          return SaiBinaryTraceListType::S32_LIST;
+        case SAI_ACL_TABLE_ATTR_ENTRY_LIST:
+          return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_ACL_TABLE_GROUP:
+      switch (attrId) {
+        case SAI_ACL_TABLE_GROUP_ATTR_ACL_BIND_POINT_TYPE_LIST:
+          return SaiBinaryTraceListType::S32_LIST;
+        case SAI_ACL_TABLE_GROUP_ATTR_MEMBER_LIST:
+          return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_BRIDGE:
+      if (attrId == SAI_BRIDGE_ATTR_PORT_LIST) {
+        return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_HASH:
+      switch (attrId) {
+        case SAI_HASH_ATTR_NATIVE_HASH_FIELD_LIST:
+          return SaiBinaryTraceListType::S32_LIST;
+        case SAI_HASH_ATTR_UDF_GROUP_LIST:
+          return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_LAG:
+      if (attrId == SAI_LAG_ATTR_PORT_LIST) {
+        return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_NEXT_HOP:
+      if (attrId == SAI_NEXT_HOP_ATTR_LABELSTACK) {
+        return SaiBinaryTraceListType::U32_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_NEXT_HOP_GROUP:
+      if (attrId == SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_MEMBER_LIST) {
+        return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_PORT:
+      switch (attrId) {
+        case SAI_PORT_ATTR_HW_LANE_LIST:
+        case SAI_PORT_ATTR_SERDES_PREEMPHASIS:
+          return SaiBinaryTraceListType::U32_LIST;
+        case SAI_PORT_ATTR_QOS_QUEUE_LIST:
+          return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_PORT_SERDES:
+      switch (attrId) {
+        case SAI_PORT_SERDES_ATTR_PREEMPHASIS:
+        case SAI_PORT_SERDES_ATTR_IDRIVER:
+        case SAI_PORT_SERDES_ATTR_TX_FIR_PRE1:
+        case SAI_PORT_SERDES_ATTR_TX_FIR_PRE2:
+        case SAI_PORT_SERDES_ATTR_TX_FIR_MAIN:
+        case SAI_PORT_SERDES_ATTR_TX_FIR_POST1:
+        case SAI_PORT_SERDES_ATTR_TX_FIR_POST2:
+        case SAI_PORT_SERDES_ATTR_TX_FIR_POST3:
+          return SaiBinaryTraceListType::U32_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_QOS_MAP:
+      if (attrId == SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST) {
+        return SaiBinaryTraceListType::QOS_MAP_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_SWITCH:
+      switch (attrId) {
+        case SAI_SWITCH_ATTR_PORT_LIST:
+        case SAI_SWITCH_ATTR_TAM_OBJECT_ID:
+          return SaiBinaryTraceListType::OBJECT_LIST;
+        case SAI_SWITCH_ATTR_SWITCH_HARDWARE_INFO:
+          return SaiBinaryTraceListType::S8_LIST;
+      }
+      break;
+    case SAI_OBJECT_TYPE_VLAN:
+      if (attrId == SAI_VLAN_ATTR_MEMBER_LIST) {
+        return SaiBinaryTraceListType::OBJECT_LIST;
+      }
+      break;
+    default:
+      break;
+  }
+  return SaiBinaryTraceListType::NONE;
+}
+
+size_t saiBinaryTraceListElementSize(SaiBinaryTraceListType listType) {
+  switch (listType) {
+    case SaiBinaryTraceListType::OBJECT_LIST:
+    case SaiBinaryTraceListType::ACL_ACTION_OBJECT_LIST:
+      return sizeof(sai_object_id_t);
+    case SaiBinaryTraceListType::S8_LIST:
+      return sizeof(sai_int8_t);
+    case SaiBinaryTraceListType::S32_LIST:
+      return sizeof(sai_int32_t);
+    case SaiBinaryTraceListType::U32_LIST:
+      return sizeof(sai_uint32_t);
+    case SaiBinaryTraceListType::QOS_MAP_LIST:
+      return sizeof(sai_qos_map_t);
+    case SaiBinaryTraceListType::NONE:
+      break;
+  }
+  return 0;
+}
+
+SaiBinaryTraceRing::SaiBinaryTraceRing(size_t capacity)
+    : buffer_(folly::nextPowTwo(capacity)), mask_(buffer_.size() - 1) {}
+
+bool SaiBinaryTraceRing::tryWrite(folly::ByteRange record) {
+  auto head = head_.load(std::memory_order_relaxed);
+  auto tail = tail_.load(std::memory_order_acquire);
+  if (record.size() > buffer_.size() - (head - tail)) {
+    return false;
+  }
+  auto start = head & mask_;
+  auto firstChunk = std::min(record.size(), buffer_.size() - start);
+  memcpy(buffer_.data() + start, record.data(), firstChunk);
+  memcpy(
+      buffer_.data(), record.data() + firstChunk, record.size() - firstChunk);
+  // Publish the whole record at once so the consumer never sees a partial one
+  head_.store(head + record.size(), std::memory_order_release);
+  return true;
+}
+
+size_t SaiBinaryTraceRing::drainTo(std::string& out) {
+  auto tail = tail_.load(std::memory_order_relaxed);
+  auto head = head_.load(std::memory_order_acquire);
+  auto size = head - tail;
+  if (size == 0) {
+    return 0;
+  }
+  auto start = tail & mask_;
+  auto firstChunk = std::min<size_t>(size, buffer_.size() - start);
+  appendBytes(out, buffer_.data() + start, firstChunk);
+  appendBytes(out, buffer_.data(), size - firstChunk);
+  tail_.store(head, std::memory_order_release);
+  return size;
+}
+
+folly::StringPiece SaiBinaryTraceReader::readBytes(size_t size) {
+  if (size > data_.size()) {
+    throw FbossError(
+        "Truncated binary trace, need ",
+        size,
+        " bytes but only ",
+        data_.size(),
+        " left");
+  }
+  auto bytes = data_.subpiece(0, size);
+  data_.advance(size);
+  return bytes;
+}
+
+bool SaiBinaryTraceReader::atFileHeader() const {
+  uint64_t magic = 0;
+  if (data_.size() >= sizeof(magic)) {
+    memcpy(&magic, data_.data(), sizeof(magic));
+  }
+  return magic == kSaiBinaryTraceMagic;
+}
+
+void SaiBinaryTraceReader::readFileHeader() {
+  auto fileHeader = read<SaiBinaryTraceFileHeader>();
+  if (fileHeader.magic != kSaiBinaryTraceMagic) {
+    throw FbossError("Not a binary SAI trace");
+  }
+  if (fileHeader.version != kSaiBinaryTraceVersion ||
+      fileHeader.attributeValueSize != sizeof(sai_attribute_value_t)) {
+    throw FbossError(
+        "Binary SAI trace version ",
+        fileHeader.version,
+        " (attribute size ",
+        fileHeader.attributeValueSize,
+        ") does not match this reader");
+  }
+}
+
+std::unique_ptr<SaiBinaryTraceRecord> SaiBinaryTraceReader::readRecord() {
+  auto record = std::make_unique<SaiBinaryTraceRecord>();
+  auto start = data_.size();
+  record->header = read<SaiBinaryTraceRecordHeader>();
+  const auto& header = record->header;
+  record->key = readBytes(header.keySize).str();
+  record->name = readBytes(header.nameSize).str();
+  record->payload = readBytes(header.payloadSize).str();
+
+  record->attrs.resize(header.attrCount);
+  // Reserved up front, attrs point into the strings
+  record->lists.reserve(header.attrCount);
+  for (auto i = 0; i < header.attrCount; ++i) {
+    auto attrHeader = read<SaiBinaryTraceAttributeHeader>();
+    auto& attr = record->attrs[i];
+    attr.id = attrHeader.id;
+    attr.value = attrHeader.value;
+    if (attrHeader.listType == SaiBinaryTraceListType::NONE) {
+      continue;
+    }
+    auto listBytes = readBytes(
+        attrHeader.listCount *
+        saiBinaryTraceListElementSize(attrHeader.listType));
+    record->lists.push_back(listBytes.str());
+    setListPointer(
+        attr.value, attrHeader.listType, record->lists.back().data());
+  }
+  if (start - data_.size() != header.length) {
+    throw FbossError(
+        "Corrupt binary trace, record ",
+        header.sequence,
+        " is ",
+        start - data_.size(),
+        " bytes but its header says ",
+        header.length);
+  }
+  return record;
+}
+
+bool SaiBinaryTraceReader::nextRun(
+    std::vector<std::unique_ptr<SaiBinaryTraceRecord>>& records) {
+  records.clear();
+  missingRecords_ = 0;
+  if (data_.empty()) {
+    return false;
+  }
+  readFileHeader();
+  while (!data_.empty() && !atFileHeader()) {
+    records.push_back(readRecord());
+  }
+  std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+    return a->header.sequence < b->header.sequence;
+  });
+  if (!records.empty()) {
+    // Sequence numbers of a run start at 0 with no gaps
+    missingRecords_ = records.back()->header.sequence + 1 - records.size();
+  }
+  return true;
+}
+
+SaiBinaryTracer::SaiBinaryTracer(
+    AsyncLogger* asyncLogger,
+    uint32_t flushIntervalMs)
+    : generation_(nextGeneration.fetch_add(1, std::memory_order_relaxed)),
+      asyncLogger_(asyncLogger),
+      flushInterval_(flushIntervalMs) {
+  SaiBinaryTraceFileHeader fileHeader{};
+  fileHeader.magic = kSaiBinaryTraceMagic;
+  fileHeader.version = kSaiBinaryTraceVersion;
+  fileHeader.attributeValueSize = sizeof(sai_attribute_value_t);
+  asyncLogger_->appendLog(
+      reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+
+  drainThread_ = std::thread([this] { drainThread(); });
+}
+
+SaiBinaryTracer::~SaiBinaryTracer() {
+  {
+    std::lock_guard<std::mutex> g(wakeLock_);
+    stop_ = true;
+  }
+  wakeCv_.notify_one();
+  drainThread_.join();
+  drainAll();
+  if (auto stalls = ringFullStalls()) {
+    XLOG(WARN) << "Binary SAI tracer stalled " << stalls
+               << " times on a full ring, consider raising "
+               << "--sai_binary_log_ring_size";
+  }
+}
+
+SaiBinaryTraceRing* SaiBinaryTracer::localRing() {
+  // Keyed on the generation rather than this, a new tracer may be allocated
+  // where a destroyed one used to be
+  thread_local std::pair<uint64_t, std::shared_ptr<SaiBinaryTraceRing>> ring{
+      std::numeric_limits<uint64_t>::max(), nullptr};
+  if (ring.first != generation_) {
+    ring.first = generation_;
+    ring.second =
+        std::make_shared<SaiBinaryTraceRing>(FLAGS_sai_binary_log_ring_size);
+    rings_.wlock()->push_back(ring.second);
+  }
+  return ring.second.get();
+}
+
+void SaiBinaryTracer::logRecord(
+    SaiBinaryTraceOp op,
+    sai_object_type_t objectType,
+    sai_object_id_t objectId,
+    sai_object_id_t switchId,
+    sai_status_t rv,
+    folly::ByteRange key,
+    folly::StringPiece name,
+    folly::ByteRange payload,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList) {
+  // Scratch buffer is reused across calls to avoid an allocation per record
+  thread_local std::string record;
+  record.clear();
+
+  SaiBinaryTraceRecordHeader header{};
+  header.op = op;
+  header.keySize = key.size();
+  header.timestampNs = nowNs();
+  header.objectId = objectId;
+  header.switchId = switchId;
+  header.objectType = objectType;
+  header.rv = rv;
+  header.attrCount = attrCount;
+  header.nameSize = name.size();
+  header.payloadSize = payload.size();
+
+  record.resize(sizeof(header));
+  appendBytes(record, key.data(), key.size());
+  appendBytes(record, name.data(), name.size());
+  appendBytes(record, payload.data(), payload.size());
+  appendAttributes(record, objectType, attrCount, attrList);
+
+  header.length = record.size();
+  auto ring = localRing();
+  if (record.size() > ring->capacity()) {
+    throw FbossError(
+        "SAI binary trace record of ",
+        record.size(),
+        " bytes exceeds ring size ",
+        ring->capacity());
+  }
+  // Sequence number is taken last so that it reflects the order in which
+  // calls returned from the SDK
+  header.sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+  memcpy(record.data(), &header, sizeof(header));
+
+  auto recordRange = folly::ByteRange(
+      reinterpret_cast<const uint8_t*>(record.data()), record.size());
+  while (!ring->tryWrite(recordRange)) {
+    // Never drop records, the trace must be replayable. Wake up the drain
+    // thread and wait for space instead.
+    ringFullStalls_.fetch_add(1, std::memory_order_relaxed);
+    wakeCv_.notify_one();
+    std::this_thread::yield();
+  }
+}
+
+void SaiBinaryTracer::logApiInitialize(
+    const char** variables,
+    const char** values,
+    int size) {
+  std::string payload;
+  auto appendString = [&payload](const char* str) {
+    uint16_t len = strlen(str);
+    appendBytes(payload, &len, sizeof(len));
+    appendBytes(payload, str, len);
+  };
+  uint32_t count = size;
+  appendBytes(payload, &count, sizeof(count));
+  for (int i = 0; i < size; ++i) {
+    appendString(variables[i]);
+    appendString(values[i]);
+  }
+  logRecord(
+      SaiBinaryTraceOp::API_INITIALIZE,
+      SAI_OBJECT_TYPE_NULL,
+      SAI_NULL_OBJECT_ID,
+      SAI_NULL_OBJECT_ID,
+      SAI_STATUS_SUCCESS,
+      folly::ByteRange(),
+      folly::StringPiece(),
+      folly::ByteRange(folly::StringPiece(payload)),
+      0,
+      nullptr);
+}
+
+void SaiBinaryTracer::logApiQuery(
+    sai_api_t api_id,
+    const std::string& api_var) {
+  logRecord(
+      SaiBinaryTraceOp::API_QUERY,
+      SAI_OBJECT_TYPE_NULL,
+      api_id,
+      SAI_NULL_OBJECT_ID,
+      SAI_STATUS_SUCCESS,
+      folly::ByteRange(),
+      api_var,
+      folly::ByteRange(),
+      0,
+      nullptr);
+}
+
+void SaiBinaryTracer::logCreate(
+    SaiBinaryTraceOp op,
+    folly::StringPiece fnName,
+    sai_object_id_t objectId,
+    sai_object_id_t switchId,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList,
+    sai_object_type_t objectType,
+    sai_status_t rv) {
+  logRecord(
+      op,
+      objectType,
+      objectId,
+      switchId,
+      rv,
+      folly::ByteRange(),
+      fnName,
+      folly::ByteRange(),
+      attrCount,
+      attrList);
+}
+
+void SaiBinaryTracer::logRemove(
+    folly::StringPiece fnName,
+    sai_object_id_t objectId,
+    sai_object_type_t objectType,
+    sai_status_t rv) {
+  logRecord(
+      SaiBinaryTraceOp::REMOVE,
+      objectType,
+      objectId,
+      SAI_NULL_OBJECT_ID,
+      rv,
+      folly::ByteRange(),
+      fnName,
+      folly::ByteRange(),
+      0,
+      nullptr);
+}
+
+void SaiBinaryTracer::logSetAttribute(
+    folly::StringPiece fnName,
+    sai_object_id_t objectId,
+    const sai_attribute_t* attr,
+    sai_object_type_t objectType,
+    sai_status_t rv) {
+  logRecord(
+      SaiBinaryTraceOp::SET_ATTRIBUTE,
+      objectType,
+      objectId,
+      SAI_NULL_OBJECT_ID,
+      rv,
+      folly::ByteRange(),
+      fnName,
+      folly::ByteRange(),
+      1,
+      attr);
+}
+
+void SaiBinaryTracer::logEntry(
+    SaiBinaryTraceOp op,
+    folly::ByteRange entry,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList,
+    sai_object_type_t objectType,
+    sai_status_t rv) {
+  logRecord(
+      op,
+      objectType,
+      SAI_NULL_OBJECT_ID,
+      SAI_NULL_OBJECT_ID,
+      rv,
+      entry,
+      folly::StringPiece(),
+      folly::ByteRange(),
+      attrCount,
+      attrList);
+}
+
+void SaiBinaryTracer::logSendHostifPacket(
+    sai_object_id_t hostifId,
+    sai_size_t bufferSize,
+    const uint8_t* buffer,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList,
+    sai_status_t rv) {
+  logRecord(
+      SaiBinaryTraceOp::SEND_HOSTIF_PACKET,
+      SAI_OBJECT_TYPE_HOSTIF_PACKET,
+      hostifId,
+      SAI_NULL_OBJECT_ID,
+      rv,
+      folly::ByteRange(),
+      folly::StringPiece(),
+      folly::ByteRange(buffer, bufferSize),
+      attrCount,
+      attrList);
+}
+
+void SaiBinaryTracer::drainAll() {
+  std::lock_guard<std::mutex> g(drainLock_);
+  thread_local std::string out;
+  auto rings = rings_.copy();
+  for (auto& ring : rings) {
+    out.clear();
+    if (ring->drainTo(out)) {
+      appendRecords(out);
+    }
+  }
+}
+
+void SaiBinaryTracer::appendRecords(const std::string& records) {
+  static_assert(
+      offsetof(SaiBinaryTraceRecordHeader, length) == 0,
+      "Records must start with their length");
+  // With --async_logger_drop_on_full the logger drops whole appends. Cutting
+  // on record boundaries keeps the file decodable when it does, and chunks
+  // that fit a buffer don't force the logger to write synchronously.
+  size_t chunkStart = 0;
+  size_t offset = 0;
+  while (offset < records.size()) {
+    uint32_t length;
+    memcpy(&length, records.data() + offset, sizeof(length));
+    if (offset > chunkStart &&
+        offset + length - chunkStart > AsyncLogger::kBufferSize) {
+      asyncLogger_->appendLog(
+          records.data() + chunkStart, offset - chunkStart);
+      chunkStart = offset;
+    }
+    offset += length;
+  }
+  if (offset > chunkStart) {
+    asyncLogger_->appendLog(records.data() + chunkStart, offset - chunkStart);
+  }
+}
+
+void SaiBinaryTracer::drainThread() {
+  std::unique_lock<std::mutex> lock(wakeLock_);
+  while (!stop_) {
+    wakeCv_.wait_for(lock, flushInterval_);
+    lock.unlock();
+    drainAll();
+    lock.lock();
+  }
+}
+
+void SaiBinaryTracer::flush() {
+  drainAll();
+  asyncLogger_->forceFlush();
+}
+
+} // namespace facebook::fboss
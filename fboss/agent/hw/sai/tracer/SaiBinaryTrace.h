@@ -0,0 +1,302 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/Range.h>
+#include <folly/Synchronized.h>
+#include <folly/lang/Align.h>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+class AsyncLogger;
+
+/*
+ * Compact binary representation of the SAI calls intercepted by SaiTracer.
+ *
+ * In text mode SaiTracer formats every create/set/remove into C source on
+ * the caller's thread. In binary mode, it instead copies the raw api arguments
+ * (object ids, entry keys and attribute values) into a per-thread ring and a
+ * single drain thread hands the bytes to AsyncLogger. The offline tool
+ * sai_binary_trace_converter turns the binary trace back into the replayable C
+ * code that SaiTracer produces in text mode. sai_tracer_benchmark compares the
+ * per call cost of both modes.
+ *
+ * File layout:
+ *   SaiBinaryTraceFileHeader
+ *   record*  (SaiBinaryTraceRecordHeader, key, name, payload, attribute*)
+ *
+ * Records from different threads are interleaved in the file in drain order.
+ * Every record carries a global sequence number and the converter restores
+ * call order by sorting on it.
+ *
+ * Records are handed to AsyncLogger whole, never split across appends, so
+ * records dropped by --async_logger_drop_on_full leave the rest of the file
+ * decodable. The reader reports them as gaps in the sequence numbers.
+ */
+
+constexpr uint64_t kSaiBinaryTraceMagic = 0x3143525442494153; // "SAIBTRC1"
+constexpr uint32_t kSaiBinaryTraceVersion = 1;
+
+enum class SaiBinaryTraceOp : uint16_t {
+  API_INITIALIZE = 1,
+  API_QUERY = 2,
+  CREATE_SWITCH = 3,
+  CREATE = 4,
+  REMOVE = 5,
+  SET_ATTRIBUTE = 6,
+  CREATE_ENTRY = 7,
+  REMOVE_ENTRY = 8,
+  SET_ENTRY_ATTRIBUTE = 9,
+  SEND_HOSTIF_PACKET = 10,
+};
+
+// Identifies which member of sai_attribute_value_t points to a list, so that
+// the list elements can be copied next to the attribute and the pointer
+// fixed up again on decode.
+enum class SaiBinaryTraceListType : uint8_t {
+  NONE = 0,
+  OBJECT_LIST = 1,
+  S8_LIST = 2,
+  S32_LIST = 3,
+  U32_LIST = 4,
+  QOS_MAP_LIST = 5,
+  ACL_ACTION_OBJECT_LIST = 6,
+};
+
+struct SaiBinaryTraceFileHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t attributeValueSize;
+};
+
+struct SaiBinaryTraceRecordHeader {
+  // Total size of the record, including this header
+  uint32_t length;
+  SaiBinaryTraceOp op;
+  uint16_t keySize;
+  uint64_t sequence;
+  uint64_t timestampNs;
+  uint64_t objectId;
+  uint64_t switchId;
+  int32_t objectType;
+  int32_t rv;
+  uint32_t attrCount;
+  uint16_t nameSize;
+  uint16_t reserved;
+  uint32_t payloadSize;
+  uint32_t reserved2;
+};
+
+struct SaiBinaryTraceAttributeHeader {
+  uint32_t id;
+  SaiBinaryTraceListType listType;
+  uint8_t reserved[3];
+  uint32_t listCount;
+  uint32_t reserved2;
+  sai_attribute_value_t value;
+};
+
+SaiBinaryTraceListType saiBinaryTraceListType(
+    sai_object_type_t objectType,
+    sai_attr_id_t attrId);
+
+size_t saiBinaryTraceListElementSize(SaiBinaryTraceListType listType);
+
+/*
+ * Single producer, single consumer byte ring. The owning thread appends whole
+ * records and the drain thread consumes everything published so far; neither
+ * side takes a lock.
+ */
+class SaiBinaryTraceRing {
+ public:
+  explicit SaiBinaryTraceRing(size_t capacity);
+
+  bool tryWrite(folly::ByteRange record);
+  size_t drainTo(std::string& out);
+
+  size_t capacity() const {
+    return buffer_.size();
+  }
+
+ private:
+  std::vector<uint8_t> buffer_;
+  size_t mask_;
+  alignas(folly::hardware_destructive_interference_size)
+      std::atomic<uint64_t> head_{0};
+  alignas(folly::hardware_destructive_interference_size)
+      std::atomic<uint64_t> tail_{0};
+};
+
+/*
+ * A record decoded from a binary trace, with its attribute list pointers
+ * fixed up to point into lists.
+ */
+struct SaiBinaryTraceRecord {
+  SaiBinaryTraceRecordHeader header;
+  std::string key;
+  std::string name;
+  std::string payload;
+  std::vector<sai_attribute_t> attrs;
+  // Backing storage for list attributes, attrs point into these
+  std::vector<std::string> lists;
+};
+
+/*
+ * Decodes a binary trace. The same file is appended to across agent
+ * restarts, each run starts with a file header and its own sequence numbers,
+ * so the trace is read run by run. Throws FbossError on a malformed or
+ * truncated trace.
+ */
+class SaiBinaryTraceReader {
+ public:
+  explicit SaiBinaryTraceReader(folly::StringPiece data) : data_(data) {}
+
+  /*
+   * Decode the next run into records, in call order. Returns false once the
+   * whole trace was read.
+   */
+  bool nextRun(std::vector<std::unique_ptr<SaiBinaryTraceRecord>>& records);
+
+  /*
+   * Records of the last run that never made it to the file, e.g. dropped by
+   * --async_logger_drop_on_full. Drops after the last record written can't be
+   * detected.
+   */
+  uint64_t missingRecords() const {
+    return missingRecords_;
+  }
+
+ private:
+  template <typename T>
+  T read() {
+    T val;
+    memcpy(&val, readBytes(sizeof(T)).data(), sizeof(T));
+    return val;
+  }
+  folly::StringPiece readBytes(size_t size);
+  bool atFileHeader() const;
+  void readFileHeader();
+  std::unique_ptr<SaiBinaryTraceRecord> readRecord();
+
+  folly::StringPiece data_;
+  uint64_t missingRecords_{0};
+};
+
+class SaiBinaryTracer {
+ public:
+  SaiBinaryTracer(AsyncLogger* asyncLogger, uint32_t flushIntervalMs);
+  ~SaiBinaryTracer();
+
+  void logApiInitialize(const char** variables, const char** values, int size);
+
+  void logApiQuery(sai_api_t api_id, const std::string& api_var);
+
+  void logCreate(
+      SaiBinaryTraceOp op,
+      folly::StringPiece fnName,
+      sai_object_id_t objectId,
+      sai_object_id_t switchId,
+      uint32_t attrCount,
+      const sai_attribute_t* attrList,
+      sai_object_type_t objectType,
+      sai_status_t rv);
+
+  void logRemove(
+      folly::StringPiece fnName,
+      sai_object_id_t objectId,
+      sai_object_type_t objectType,
+      sai_status_t rv);
+
+  void logSetAttribute(
+      folly::StringPiece fnName,
+      sai_object_id_t objectId,
+      const sai_attribute_t* attr,
+      sai_object_type_t objectType,
+      sai_status_t rv);
+
+  void logEntry(
+      SaiBinaryTraceOp op,
+      folly::ByteRange entry,
+      uint32_t attrCount,
+      const sai_attribute_t* attrList,
+      sai_object_type_t objectType,
+      sai_status_t rv);
+
+  void logSendHostifPacket(
+      sai_object_id_t hostifId,
+      sai_size_t bufferSize,
+      const uint8_t* buffer,
+      uint32_t attrCount,
+      const sai_attribute_t* attrList,
+      sai_status_t rv);
+
+  // Block until all records published so far are handed to the logger
+  void flush();
+
+  uint64_t ringFullStalls() const {
+    return ringFullStalls_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void logRecord(
+      SaiBinaryTraceOp op,
+      sai_object_type_t objectType,
+      sai_object_id_t objectId,
+      sai_object_id_t switchId,
+      sai_status_t rv,
+      folly::ByteRange key,
+      folly::StringPiece name,
+      folly::ByteRange payload,
+      uint32_t attrCount,
+      const sai_attribute_t* attrList);
+
+  SaiBinaryTraceRing* localRing();
+  void drainThread();
+  void drainAll();
+  // Append drained records in chunks that fit an AsyncLogger buffer, cut on
+  // record boundaries
+  void appendRecords(const std::string& records);
+
+  // Unique across all tracers of the process. Keys the per-thread ring, so a
+  // tracer created at the address of a destroyed one gets fresh rings.
+  const uint64_t generation_;
+  AsyncLogger* asyncLogger_;
+  std::chrono::milliseconds flushInterval_;
+
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<uint64_t> ringFullStalls_{0};
+
+  // Rings are only added here, once per producing thread. They stay
+  // registered after the thread exits so no record is lost.
+  folly::Synchronized<std::vector<std::shared_ptr<SaiBinaryTraceRing>>>
+      rings_;
+
+  std::mutex drainLock_;
+  std::mutex wakeLock_;
+  std::condition_variable wakeCv_;
+  bool stop_{false};
+  std::thread drainThread_;
+};
+
+} // namespace facebook::fboss
@@ -31,6 +31,7 @@
 #include "fboss/agent/hw/sai/tracer/QueueApiTracer.h"
 #include "fboss/agent/hw/sai/tracer/RouteApiTracer.h"
 #include "fboss/agent/hw/sai/tracer/RouterInterfaceApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
 #include "fboss/agent/hw/sai/tracer/SaiTracer.h"
 #include "fboss/agent/hw/sai/tracer/SamplePacketApiTracer.h"
 #include "fboss/agent/hw/sai/tracer/SchedulerApiTracer.h"
@@ -66,6 +67,18 @@ DEFINE_string(
     "/var/facebook/logs/fboss/sai_replayer.log",
     "File path to the SAI Replayer logs");
 
+DEFINE_bool(
+    enable_binary_replayer,
+    false,
+    "Record SAI calls in a compact binary format instead of generating C code "
+    "on the calling thread. Use sai_binary_trace_converter to turn the binary "
+    "trace into replayable C code");
+
+DEFINE_string(
+    sai_binary_log,
+    "/var/facebook/logs/fboss/sai_replayer.bin",
+    "File path to the binary SAI Replayer logs");
+
 DEFINE_int32(
     default_list_size,
     1024,
@@ -296,12 +309,38 @@ inline void printHex(std::ostringstream& outStringStream, uint8_t u8) {
                   << static_cast<int>(u8);
 }
 
+// Entry structs are recorded as their raw bytes
+template <typename EntryT>
+void logBinaryEntry(
+    facebook::fboss::SaiBinaryTracer& tracer,
+    facebook::fboss::SaiBinaryTraceOp op,
+    const EntryT* entry,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList,
+    sai_object_type_t objectType,
+    sai_status_t rv) {
+  tracer.logEntry(
+      op,
+      folly::ByteRange(reinterpret_cast<const uint8_t*>(entry), sizeof(*entry)),
+      attrCount,
+      attrList,
+      objectType,
+      rv);
+}
+
 } // namespace
 
 namespace facebook::fboss {
 
 SaiTracer::SaiTracer() {
-  if (FLAGS_enable_replayer) {
+  if (FLAGS_enable_replayer && FLAGS_enable_binary_replayer) {
+    asyncLogger_ =
+        std::make_unique<AsyncLogger>(FLAGS_sai_binary_log, FLAGS_log_timeout);
+
+    asyncLogger_->startFlushThread();
+    binaryTracer_ = std::make_unique<SaiBinaryTracer>(
+        asyncLogger_.get(), FLAGS_log_timeout);
+  } else if (FLAGS_enable_replayer) {
     asyncLogger_ =
         std::make_unique<AsyncLogger>(FLAGS_sai_log, FLAGS_log_timeout);
 
@@ -314,7 +353,12 @@ SaiTracer::SaiTracer() {
 }
 
 SaiTracer::~SaiTracer() {
-  if (FLAGS_enable_replayer) {
+  if (binaryTracer_) {
+    // Drain the per-thread rings before the logger goes away
+    binaryTracer_.reset();
+    asyncLogger_->forceFlush();
+    asyncLogger_->stopFlushThread();
+  } else if (FLAGS_enable_replayer) {
     writeFooter();
     asyncLogger_->forceFlush();
     asyncLogger_->stopFlushThread();
@@ -340,6 +384,11 @@ void SaiTracer::logApiInitialize(
     const char** variables,
     const char** values,
     int size) {
+  if (binaryTracer_) {
+    binaryTracer_->logApiInitialize(variables, values, size);
+    return;
+  }
+
   vector<string> lines;
 
   for (int i = 0; i < size; ++i) {
@@ -375,6 +424,11 @@ void SaiTracer::logApiQuery(sai_api_t api_id, const std::string& api_var) {
 
   init_api_.emplace(api_id, api_var);
 
+  if (binaryTracer_) {
+    binaryTracer_->logApiQuery(api_id, api_var);
+    return;
+  }
+
   writeToFile(
       {to<string>("sai_", api_var, "_t* ", api_var),
        to<string>(
@@ -390,6 +444,19 @@ void SaiTracer::logSwitchCreateFn(
     return;
   }
 
+  if (binaryTracer_) {
+    binaryTracer_->logCreate(
+        SaiBinaryTraceOp::CREATE_SWITCH,
+        "create_switch",
+        *switch_id,
+        SAI_NULL_OBJECT_ID,
+        attr_count,
+        attr_list,
+        SAI_OBJECT_TYPE_SWITCH,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_SWITCH);
@@ -432,6 +499,18 @@ void SaiTracer::logRouteEntryCreateFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::CREATE_ENTRY,
+        route_entry,
+        attr_count,
+        attr_list,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_ROUTE_ENTRY);
@@ -468,6 +547,18 @@ void SaiTracer::logNeighborEntryCreateFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::CREATE_ENTRY,
+        neighbor_entry,
+        attr_count,
+        attr_list,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
@@ -504,6 +595,18 @@ void SaiTracer::logFdbEntryCreateFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::CREATE_ENTRY,
+        fdb_entry,
+        attr_count,
+        attr_list,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_FDB_ENTRY);
@@ -540,6 +643,18 @@ void SaiTracer::logInsegEntryCreateFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::CREATE_ENTRY,
+        inseg_entry,
+        attr_count,
+        attr_list,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_INSEG_ENTRY);
@@ -579,6 +694,19 @@ void SaiTracer::logCreateFn(
     return;
   }
 
+  if (binaryTracer_) {
+    binaryTracer_->logCreate(
+        SaiBinaryTraceOp::CREATE,
+        fn_name,
+        *create_object_id,
+        switch_id,
+        attr_count,
+        attr_list,
+        object_type,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines = setAttrList(attr_list, attr_count, object_type);
 
@@ -608,6 +736,18 @@ void SaiTracer::logRouteEntryRemoveFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::REMOVE_ENTRY,
+        route_entry,
+        0,
+        nullptr,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setRouteEntry(route_entry, lines);
 
@@ -635,6 +775,18 @@ void SaiTracer::logNeighborEntryRemoveFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::REMOVE_ENTRY,
+        neighbor_entry,
+        0,
+        nullptr,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setNeighborEntry(neighbor_entry, lines);
 
@@ -662,6 +814,18 @@ void SaiTracer::logFdbEntryRemoveFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::REMOVE_ENTRY,
+        fdb_entry,
+        0,
+        nullptr,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setFdbEntry(fdb_entry, lines);
 
@@ -689,6 +853,18 @@ void SaiTracer::logInsegEntryRemoveFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::REMOVE_ENTRY,
+        inseg_entry,
+        0,
+        nullptr,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setInsegEntry(inseg_entry, lines);
 
@@ -718,6 +894,11 @@ void SaiTracer::logRemoveFn(
     return;
   }
 
+  if (binaryTracer_) {
+    binaryTracer_->logRemove(fn_name, remove_object_id, object_type, rv);
+    return;
+  }
+
   vector<string> lines{};
 
   // Log current timestamp, object id and return value
@@ -750,6 +931,18 @@ void SaiTracer::logRouteEntrySetAttrFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::SET_ENTRY_ATTRIBUTE,
+        route_entry,
+        1,
+        attr,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_ROUTE_ENTRY);
 
@@ -781,6 +974,18 @@ void SaiTracer::logNeighborEntrySetAttrFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::SET_ENTRY_ATTRIBUTE,
+        neighbor_entry,
+        1,
+        attr,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
 
@@ -812,6 +1017,18 @@ void SaiTracer::logFdbEntrySetAttrFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::SET_ENTRY_ATTRIBUTE,
+        fdb_entry,
+        1,
+        attr,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_FDB_ENTRY);
 
@@ -843,6 +1060,18 @@ void SaiTracer::logInsegEntrySetAttrFn(
     return;
   }
 
+  if (binaryTracer_) {
+    logBinaryEntry(
+        *binaryTracer_,
+        SaiBinaryTraceOp::SET_ENTRY_ATTRIBUTE,
+        inseg_entry,
+        1,
+        attr,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_INSEG_ENTRY);
 
@@ -876,6 +1105,12 @@ void SaiTracer::logSetAttrFn(
     return;
   }
 
+  if (binaryTracer_) {
+    binaryTracer_->logSetAttribute(
+        fn_name, set_object_id, attr, object_type, rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, object_type);
 
@@ -909,6 +1144,12 @@ void SaiTracer::logSendHostifPacketFn(
     return;
   }
 
+  if (binaryTracer_) {
+    binaryTracer_->logSendHostifPacket(
+        hostif_id, buffer_size, buffer, attr_count, attr_list, rv);
+    return;
+  }
+
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_HOSTIF_PACKET);
 
@@ -1248,7 +1489,7 @@ string SaiTracer::rvCheck(sai_status_t rv) {
 }
 
 string SaiTracer::logTimeAndRv(sai_status_t rv, sai_object_id_t object_id) {
-  auto now = std::chrono::system_clock::now();
+  auto now = timestampOverride_.value_or(std::chrono::system_clock::now());
   auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                     now.time_since_epoch()) %
       1000;
@@ -9,8 +9,10 @@
  */
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 #include <tuple>
 
 #include "fboss/agent/AsyncLogger.h"
@@ -26,9 +28,13 @@ extern "C" {
 
 DECLARE_bool(enable_replayer);
 DECLARE_bool(enable_packet_log);
+DECLARE_bool(enable_binary_replayer);
+DECLARE_string(sai_log);
 
 namespace facebook::fboss {
 
+class SaiBinaryTracer;
+
 class SaiTracer {
  public:
   explicit SaiTracer();
@@ -139,6 +145,13 @@ class SaiTracer {
   uint32_t
   checkListCount(uint32_t list_count, uint32_t elem_size, uint32_t elem_count);
 
+  // Used when converting a binary trace to C code, so that the generated code
+  // carries the timestamps of the original calls
+  void setTimestampOverride(
+      std::optional<std::chrono::system_clock::time_point> timestamp) {
+    timestampOverride_ = timestamp;
+  }
+
   sai_acl_api_t* aclApi_;
   sai_bridge_api_t* bridgeApi_;
   sai_buffer_api_t* bufferApi_;
@@ -219,6 +232,10 @@ class SaiTracer {
   uint32_t maxListCount_;
   uint32_t numCalls_;
   std::unique_ptr<AsyncLogger> asyncLogger_;
+  // Set when --enable_binary_replayer is on. All log* calls are then recorded
+  // in binary form and no C code is generated at runtime.
+  std::unique_ptr<SaiBinaryTracer> binaryTracer_;
+  std::optional<std::chrono::system_clock::time_point> timestampOverride_;
 
   // Variables mappings in generated C code
   // varCounts map from object type to the current counter
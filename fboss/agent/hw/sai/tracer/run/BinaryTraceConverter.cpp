@@ -0,0 +1,236 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Offline tool that converts a binary SAI trace (--enable_binary_replayer)
+ * into the C code that SaiTracer generates in text mode. Records are decoded
+ * and fed through the regular SaiTracer log* methods, so variable naming,
+ * list handling and attribute serialization are identical to a text trace.
+ *
+ *   sai_binary_trace_converter --binary_trace=sai_replayer.bin \
+ *       --sai_log=/tmp/SaiReplayer.cpp
+ */
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+
+DEFINE_string(binary_trace, "", "Binary SAI trace to convert");
+
+using namespace facebook::fboss;
+
+namespace {
+
+template <typename EntryT>
+const EntryT* entry(const SaiBinaryTraceRecord& record) {
+  if (record.key.size() != sizeof(EntryT)) {
+    throw FbossError(
+        "Unexpected entry size ",
+        record.key.size(),
+        " for object type ",
+        record.header.objectType);
+  }
+  return reinterpret_cast<const EntryT*>(record.key.data());
+}
+
+void convertApiInitialize(
+    SaiTracer* tracer,
+    const SaiBinaryTraceRecord& record) {
+  folly::StringPiece payload(record.payload);
+  auto readBytes = [&payload](size_t size) {
+    if (size > payload.size()) {
+      throw FbossError("Truncated sai_api_initialize record");
+    }
+    auto bytes = payload.subpiece(0, size);
+    payload.advance(size);
+    return bytes;
+  };
+  auto readInt = [&readBytes](auto val) {
+    memcpy(&val, readBytes(sizeof(val)).data(), sizeof(val));
+    return val;
+  };
+  auto count = readInt(uint32_t());
+  std::vector<std::string> strings;
+  strings.reserve(count * 2);
+  for (auto i = 0; i < count * 2; ++i) {
+    auto len = readInt(uint16_t());
+    strings.push_back(readBytes(len).str());
+  }
+  std::vector<const char*> variables;
+  std::vector<const char*> values;
+  for (auto i = 0; i < count; ++i) {
+    variables.push_back(strings[2 * i].c_str());
+    values.push_back(strings[2 * i + 1].c_str());
+  }
+  tracer->logApiInitialize(variables.data(), values.data(), count);
+}
+
+void convertEntry(SaiTracer* tracer, const SaiBinaryTraceRecord& record) {
+  auto op = record.header.op;
+  auto rv = record.header.rv;
+  auto attrCount = record.header.attrCount;
+  auto attrs = record.attrs.data();
+  switch (record.header.objectType) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY: {
+      auto e = entry<sai_route_entry_t>(record);
+      if (op == SaiBinaryTraceOp::CREATE_ENTRY) {
+        tracer->logRouteEntryCreateFn(e, attrCount, attrs, rv);
+      } else if (op == SaiBinaryTraceOp::REMOVE_ENTRY) {
+        tracer->logRouteEntryRemoveFn(e, rv);
+      } else {
+        tracer->logRouteEntrySetAttrFn(e, attrs, rv);
+      }
+      break;
+    }
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY: {
+      auto e = entry<sai_neighbor_entry_t>(record);
+      if (op == SaiBinaryTraceOp::CREATE_ENTRY) {
+        tracer->logNeighborEntryCreateFn(e, attrCount, attrs, rv);
+      } else if (op == SaiBinaryTraceOp::REMOVE_ENTRY) {
+        tracer->logNeighborEntryRemoveFn(e, rv);
+      } else {
+        tracer->logNeighborEntrySetAttrFn(e, attrs, rv);
+      }
+      break;
+    }
+    case SAI_OBJECT_TYPE_FDB_ENTRY: {
+      auto e = entry<sai_fdb_entry_t>(record);
+      if (op == SaiBinaryTraceOp::CREATE_ENTRY) {
+        tracer->logFdbEntryCreateFn(e, attrCount, attrs, rv);
+      } else if (op == SaiBinaryTraceOp::REMOVE_ENTRY) {
+        tracer->logFdbEntryRemoveFn(e, rv);
+      } else {
+        tracer->logFdbEntrySetAttrFn(e, attrs, rv);
+      }
+      break;
+    }
+    case SAI_OBJECT_TYPE_INSEG_ENTRY: {
+      auto e = entry<sai_inseg_entry_t>(record);
+      if (op == SaiBinaryTraceOp::CREATE_ENTRY) {
+        tracer->logInsegEntryCreateFn(e, attrCount, attrs, rv);
+      } else if (op == SaiBinaryTraceOp::REMOVE_ENTRY) {
+        tracer->logInsegEntryRemoveFn(e, rv);
+      } else {
+        tracer->logInsegEntrySetAttrFn(e, attrs, rv);
+      }
+      break;
+    }
+    default:
+      throw FbossError(
+          "Unsupported entry object type ", record.header.objectType);
+  }
+}
+
+void convertRecord(SaiTracer* tracer, const SaiBinaryTraceRecord& record) {
+  const auto& header = record.header;
+  tracer->setTimestampOverride(std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds(header.timestampNs))));
+
+  auto objectType = static_cast<sai_object_type_t>(header.objectType);
+  auto rv = static_cast<sai_status_t>(header.rv);
+  switch (header.op) {
+    case SaiBinaryTraceOp::API_INITIALIZE:
+      convertApiInitialize(tracer, record);
+      break;
+    case SaiBinaryTraceOp::API_QUERY:
+      tracer->logApiQuery(static_cast<sai_api_t>(header.objectId), record.name);
+      break;
+    case SaiBinaryTraceOp::CREATE_SWITCH: {
+      sai_object_id_t switchId = header.objectId;
+      tracer->logSwitchCreateFn(
+          &switchId, header.attrCount, record.attrs.data(), rv);
+      break;
+    }
+    case SaiBinaryTraceOp::CREATE: {
+      sai_object_id_t objectId = header.objectId;
+      tracer->logCreateFn(
+          record.name,
+          &objectId,
+          header.switchId,
+          header.attrCount,
+          record.attrs.data(),
+          objectType,
+          rv);
+      break;
+    }
+    case SaiBinaryTraceOp::REMOVE:
+      tracer->logRemoveFn(record.name, header.objectId, objectType, rv);
+      break;
+    case SaiBinaryTraceOp::SET_ATTRIBUTE:
+      tracer->logSetAttrFn(
+          record.name, header.objectId, record.attrs.data(), objectType, rv);
+      break;
+    case SaiBinaryTraceOp::CREATE_ENTRY:
+    case SaiBinaryTraceOp::REMOVE_ENTRY:
+    case SaiBinaryTraceOp::SET_ENTRY_ATTRIBUTE:
+      convertEntry(tracer, record);
+      break;
+    case SaiBinaryTraceOp::SEND_HOSTIF_PACKET:
+      tracer->logSendHostifPacketFn(
+          header.objectId,
+          record.payload.size(),
+          reinterpret_cast<const uint8_t*>(record.payload.data()),
+          header.attrCount,
+          record.attrs.data(),
+          rv);
+      break;
+    default:
+      throw FbossError(
+          "Unknown binary trace op ", static_cast<int>(header.op));
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+
+  // The converter drives SaiTracer in text mode, it must not record itself
+  FLAGS_enable_replayer = true;
+  FLAGS_enable_binary_replayer = false;
+  FLAGS_enable_packet_log = true;
+
+  std::string data;
+  if (!folly::readFile(FLAGS_binary_trace.c_str(), data)) {
+    XLOG(ERR) << "Failed to read " << FLAGS_binary_trace;
+    return 1;
+  }
+
+  auto tracer = SaiTracer::getInstance();
+  SaiBinaryTraceReader reader(data);
+  std::vector<std::unique_ptr<SaiBinaryTraceRecord>> records;
+  size_t numRecords = 0;
+  while (reader.nextRun(records)) {
+    if (auto missing = reader.missingRecords()) {
+      XLOG(WARN) << missing << " records of this run are missing from "
+                 << FLAGS_binary_trace
+                 << ", was it recorded with --async_logger_drop_on_full? "
+                 << "The generated code may not replay";
+    }
+    for (const auto& record : records) {
+      convertRecord(tracer.get(), *record);
+    }
+    numRecords += records.size();
+  }
+  tracer->setTimestampOverride(std::nullopt);
+  tracer.reset();
+
+  XLOG(INFO) << "Converted " << numRecords << " records from "
+             << FLAGS_binary_trace << " to " << FLAGS_sai_log;
+  // Destroying the tracer writes the footer and flushes the generated code
+  folly::SingletonVault::singleton()->destroyInstances();
+  return 0;
+}
@@ -0,0 +1,240 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+#include "fboss/agent/AsyncLogger.h"
+#include "fboss/agent/FbossError.h"
+
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::fboss;
+
+namespace {
+
+sai_route_entry_t makeRouteEntry() {
+  sai_route_entry_t routeEntry{};
+  routeEntry.switch_id = 1;
+  routeEntry.vr_id = 2;
+  routeEntry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+  routeEntry.destination.addr.ip4 = 0x0a000000;
+  routeEntry.destination.mask.ip4 = 0xffffff00;
+  return routeEntry;
+}
+
+folly::ByteRange entryBytes(const sai_route_entry_t& routeEntry) {
+  return folly::ByteRange(
+      reinterpret_cast<const uint8_t*>(&routeEntry), sizeof(routeEntry));
+}
+
+} // namespace
+
+class SaiBinaryTraceTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    logger_ = std::make_unique<AsyncLogger>(tracePath(), 100);
+    logger_->startFlushThread();
+    tracer_ = std::make_unique<SaiBinaryTracer>(logger_.get(), 100);
+  }
+
+  void TearDown() override {
+    tracer_.reset();
+    logger_.reset();
+  }
+
+  std::string tracePath() const {
+    return (tmpDir_.path() / "sai_replayer.bin").string();
+  }
+
+  // Drain everything logged so far and read the trace back
+  std::string finishTrace() {
+    tracer_.reset();
+    logger_->forceFlush();
+    logger_.reset();
+    std::string data;
+    EXPECT_TRUE(folly::readFile(tracePath().c_str(), data));
+    return data;
+  }
+
+ protected:
+  folly::test::TemporaryDirectory tmpDir_;
+  std::unique_ptr<AsyncLogger> logger_;
+  std::unique_ptr<SaiBinaryTracer> tracer_;
+};
+
+TEST(SaiBinaryTraceRingTest, wrapAround) {
+  SaiBinaryTraceRing ring(10);
+  EXPECT_EQ(ring.capacity(), 16);
+  std::string record(12, 'a');
+  std::string out;
+  EXPECT_TRUE(ring.tryWrite(folly::ByteRange(folly::StringPiece(record))));
+  // No room for a second one until drained
+  EXPECT_FALSE(ring.tryWrite(folly::ByteRange(folly::StringPiece(record))));
+  EXPECT_EQ(ring.drainTo(out), 12);
+  EXPECT_EQ(out, record);
+
+  // Wraps around the end of the buffer
+  record = "0123456789ab";
+  out.clear();
+  EXPECT_TRUE(ring.tryWrite(folly::ByteRange(folly::StringPiece(record))));
+  EXPECT_EQ(ring.drainTo(out), 12);
+  EXPECT_EQ(out, record);
+  EXPECT_EQ(ring.drainTo(out), 0);
+}
+
+TEST_F(SaiBinaryTraceTest, roundTrip) {
+  tracer_->logApiQuery(SAI_API_ROUTE, "route_api");
+
+  std::vector<sai_uint32_t> lanes{1, 2, 3, 4};
+  std::array<sai_attribute_t, 2> portAttrs{};
+  portAttrs[0].id = SAI_PORT_ATTR_HW_LANE_LIST;
+  portAttrs[0].value.u32list.count = lanes.size();
+  portAttrs[0].value.u32list.list = lanes.data();
+  portAttrs[1].id = SAI_PORT_ATTR_SPEED;
+  portAttrs[1].value.u32 = 100000;
+  tracer_->logCreate(
+      SaiBinaryTraceOp::CREATE,
+      "create_port",
+      42,
+      1,
+      portAttrs.size(),
+      portAttrs.data(),
+      SAI_OBJECT_TYPE_PORT,
+      SAI_STATUS_SUCCESS);
+
+  auto routeEntry = makeRouteEntry();
+  sai_attribute_t routeAttr{};
+  routeAttr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+  routeAttr.value.oid = 7;
+  tracer_->logEntry(
+      SaiBinaryTraceOp::CREATE_ENTRY,
+      entryBytes(routeEntry),
+      1,
+      &routeAttr,
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      SAI_STATUS_SUCCESS);
+
+  // Logged from another thread, goes through another ring
+  std::thread([this] {
+    tracer_->logRemove(
+        "remove_port", 42, SAI_OBJECT_TYPE_PORT, SAI_STATUS_FAILURE);
+  }).join();
+
+  auto data = finishTrace();
+  SaiBinaryTraceReader reader(data);
+  std::vector<std::unique_ptr<SaiBinaryTraceRecord>> records;
+  ASSERT_TRUE(reader.nextRun(records));
+  EXPECT_EQ(reader.missingRecords(), 0);
+  ASSERT_EQ(records.size(), 4);
+  for (auto i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i]->header.sequence, i);
+  }
+
+  const auto& query = *records[0];
+  EXPECT_EQ(query.header.op, SaiBinaryTraceOp::API_QUERY);
+  EXPECT_EQ(query.header.objectId, SAI_API_ROUTE);
+  EXPECT_EQ(query.name, "route_api");
+
+  const auto& create = *records[1];
+  EXPECT_EQ(create.header.op, SaiBinaryTraceOp::CREATE);
+  EXPECT_EQ(create.header.objectType, SAI_OBJECT_TYPE_PORT);
+  EXPECT_EQ(create.header.objectId, 42);
+  EXPECT_EQ(create.header.switchId, 1);
+  EXPECT_EQ(create.name, "create_port");
+  ASSERT_EQ(create.attrs.size(), 2);
+  EXPECT_EQ(create.attrs[0].id, SAI_PORT_ATTR_HW_LANE_LIST);
+  const auto& laneList = create.attrs[0].value.u32list;
+  ASSERT_EQ(laneList.count, lanes.size());
+  // Points into the decoded record, not the original list
+  EXPECT_NE(laneList.list, lanes.data());
+  EXPECT_EQ(
+      std::vector<sai_uint32_t>(laneList.list, laneList.list + laneList.count),
+      lanes);
+  EXPECT_EQ(create.attrs[1].id, SAI_PORT_ATTR_SPEED);
+  EXPECT_EQ(create.attrs[1].value.u32, 100000);
+
+  const auto& route = *records[2];
+  EXPECT_EQ(route.header.op, SaiBinaryTraceOp::CREATE_ENTRY);
+  ASSERT_EQ(route.key.size(), sizeof(sai_route_entry_t));
+  EXPECT_EQ(
+      memcmp(route.key.data(), &routeEntry, sizeof(routeEntry)), 0);
+  ASSERT_EQ(route.attrs.size(), 1);
+  EXPECT_EQ(route.attrs[0].value.oid, 7);
+
+  const auto& remove = *records[3];
+  EXPECT_EQ(remove.header.op, SaiBinaryTraceOp::REMOVE);
+  EXPECT_EQ(remove.header.rv, SAI_STATUS_FAILURE);
+  EXPECT_EQ(remove.name, "remove_port");
+
+  EXPECT_FALSE(reader.nextRun(records));
+}
+
+TEST_F(SaiBinaryTraceTest, multipleRuns) {
+  tracer_->logApiQuery(SAI_API_ROUTE, "route_api");
+  // An agent restart appends a new run to the same file
+  tracer_.reset();
+  tracer_ = std::make_unique<SaiBinaryTracer>(logger_.get(), 100);
+  tracer_->logApiQuery(SAI_API_PORT, "port_api");
+  tracer_->logApiQuery(SAI_API_VLAN, "vlan_api");
+
+  auto data = finishTrace();
+  SaiBinaryTraceReader reader(data);
+  std::vector<std::unique_ptr<SaiBinaryTraceRecord>> records;
+  ASSERT_TRUE(reader.nextRun(records));
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0]->name, "route_api");
+  // The new tracer didn't reuse the rings of the first one
+  ASSERT_TRUE(reader.nextRun(records));
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0]->name, "port_api");
+  EXPECT_EQ(records[1]->name, "vlan_api");
+  EXPECT_FALSE(reader.nextRun(records));
+}
+
+TEST_F(SaiBinaryTraceTest, droppedRecords) {
+  for (auto i = 0; i < 4; ++i) {
+    tracer_->logRemove(
+        "remove_port", i, SAI_OBJECT_TYPE_PORT, SAI_STATUS_SUCCESS);
+  }
+  auto data = finishTrace();
+
+  // Drop the second record, as the logger drops whole records
+  std::string dropped = data.substr(0, sizeof(SaiBinaryTraceFileHeader));
+  size_t offset = dropped.size();
+  for (auto i = 0; offset < data.size(); ++i) {
+    SaiBinaryTraceRecordHeader header;
+    memcpy(&header, data.data() + offset, sizeof(header));
+    if (i != 1) {
+      dropped.append(data, offset, header.length);
+    }
+    offset += header.length;
+  }
+
+  SaiBinaryTraceReader reader(dropped);
+  std::vector<std::unique_ptr<SaiBinaryTraceRecord>> records;
+  ASSERT_TRUE(reader.nextRun(records));
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(reader.missingRecords(), 1);
+  EXPECT_EQ(records[1]->header.objectId, 2);
+}
+
+TEST_F(SaiBinaryTraceTest, truncated) {
+  tracer_->logApiQuery(SAI_API_ROUTE, "route_api");
+  auto data = finishTrace();
+  data.resize(data.size() - 1);
+
+  SaiBinaryTraceReader reader(data);
+  std::vector<std::unique_ptr<SaiBinaryTraceRecord>> records;
+  EXPECT_THROW(reader.nextRun(records), FbossError);
+}
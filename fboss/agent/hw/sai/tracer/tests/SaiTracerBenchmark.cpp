@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <cstdio>
+
+DECLARE_string(sai_binary_log);
+
+/*
+ * Cost on the calling thread of tracing route creates, the bulk of what the
+ * agent programs, in text mode (C code generated inline) and in binary mode
+ * (--enable_binary_replayer).
+ */
+
+DEFINE_int32(
+    sai_tracer_benchmark_routes,
+    100000,
+    "Route creates traced per benchmark iteration");
+
+namespace {
+
+constexpr auto kTextLog = "/tmp/sai_tracer_benchmark.log";
+constexpr auto kBinaryLog = "/tmp/sai_tracer_benchmark.bin";
+
+void traceRouteCreates(uint32_t iters, bool binary) {
+  folly::BenchmarkSuspender suspender;
+  FLAGS_enable_replayer = true;
+  FLAGS_enable_binary_replayer = binary;
+  FLAGS_sai_log = kTextLog;
+  FLAGS_sai_binary_log = kBinaryLog;
+  auto tracer = std::make_unique<facebook::fboss::SaiTracer>();
+
+  sai_route_entry_t routeEntry{};
+  routeEntry.switch_id = 1;
+  routeEntry.vr_id = 2;
+  routeEntry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+  routeEntry.destination.mask.ip4 = 0xffffff00;
+  std::array<sai_attribute_t, 2> attrs{};
+  attrs[0].id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+  attrs[0].value.oid = 3;
+  attrs[1].id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+  attrs[1].value.s32 = SAI_PACKET_ACTION_FORWARD;
+  suspender.dismiss();
+
+  for (auto iter = 0; iter < iters; ++iter) {
+    for (auto i = 0; i < FLAGS_sai_tracer_benchmark_routes; ++i) {
+      routeEntry.destination.addr.ip4 = i << 8;
+      tracer->logRouteEntryCreateFn(
+          &routeEntry, attrs.size(), attrs.data(), SAI_STATUS_SUCCESS);
+    }
+  }
+
+  suspender.rehire();
+  tracer.reset();
+  std::remove(kTextLog);
+  std::remove(kBinaryLog);
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(traceRouteCreates, text, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(traceRouteCreates, binary, true)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -57,7 +57,8 @@ TEST_F(HwAclPriorityTest, CheckAclPriorityOrder) {
     }
     int aPrio = getProgrammedState()->getAcl("A")->getPriority();
     int bPrio = getProgrammedState()->getAcl("B")->getPriority();
-    EXPECT_EQ(aPrio + 1, bPrio);
+    // Priorities are spread out, only their order is fixed
+    EXPECT_LT(aPrio, bPrio);
   };
   verifyAcrossWarmBoots(setup, verify);
 }
@@ -82,8 +83,8 @@ TEST_F(HwAclPriorityTest, CheckAclPriortyOrderInsertMiddle) {
     int bPrio = getProgrammedState()->getAcl("B")->getPriority();
     int cPrio = getProgrammedState()->getAcl("C")->getPriority();
     // Order should be A, C, B now
-    EXPECT_EQ(aPrio + 1, cPrio);
-    EXPECT_EQ(aPrio + 2, bPrio);
+    EXPECT_LT(aPrio, cPrio);
+    EXPECT_LT(cPrio, bPrio);
   };
   verifyAcrossWarmBoots(setup, verify);
 }
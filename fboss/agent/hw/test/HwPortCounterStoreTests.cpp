@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/HwPortCounterStore.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/StatsConstants.h"
+
+#include <fb303/ServiceData.h>
+
+#include <gtest/gtest.h>
+using namespace facebook::fboss;
+using namespace facebook::fb303;
+using namespace std::chrono;
+
+namespace {
+HwPortStats makeStats(int64_t inBytes) {
+  HwPortStats stats;
+  stats.inBytes__ref() = inBytes;
+  return stats;
+}
+
+void writeCycle(
+    HwPortCounterStore& store,
+    seconds now,
+    int64_t eth1InBytes,
+    int64_t eth2InBytes) {
+  store.beginCycle(now);
+  store.updatePort("eth1/1/1", makeStats(eth1InBytes));
+  store.updatePort("eth1/2/1", makeStats(eth2InBytes));
+  store.endCycle();
+}
+
+const PortCounterAggregate& findAggregate(
+    const std::vector<PortCounterAggregate>& aggregates,
+    folly::StringPiece counter) {
+  for (const auto& aggregate : aggregates) {
+    if (*aggregate.counter_ref() == counter) {
+      return aggregate;
+    }
+  }
+  throw FbossError("No aggregate for ", counter);
+}
+} // namespace
+
+TEST(HwPortCounterStoreTest, aggregates) {
+  HwPortCounterStore store(10);
+  writeCycle(store, seconds(100), 1000, 3000);
+  writeCycle(store, seconds(110), 2000, 5000);
+
+  auto inBytes = findAggregate(store.getAggregates(), kInBytes());
+  EXPECT_EQ(*inBytes.min_ref(), 2000);
+  EXPECT_EQ(*inBytes.max_ref(), 5000);
+  EXPECT_EQ(*inBytes.sum_ref(), 7000);
+  EXPECT_DOUBLE_EQ(*inBytes.rate_ref(), 300);
+  EXPECT_EQ(*inBytes.timestamp_ref(), 110);
+  // Uninitialized stats count as 0
+  EXPECT_EQ(*findAggregate(store.getAggregates(), kOutBytes()).max_ref(), 0);
+
+  // Also exported to fb303
+  EXPECT_EQ(
+      fbData->getCounter(
+          HwPortCounterStore::aggregateCounterName(kInBytes(), "sum")),
+      7000);
+  EXPECT_EQ(
+      fbData->getCounter(
+          HwPortCounterStore::aggregateCounterName(kInBytes(), "rate")),
+      300);
+}
+
+TEST(HwPortCounterStoreTest, resetPort) {
+  HwPortCounterStore store(10);
+  writeCycle(store, seconds(100), 1000, 3000);
+  store.resetPort("eth1/2/1");
+  // Unknown ports are not added
+  store.resetPort("eth1/3/1");
+  store.beginCycle(seconds(110));
+  store.updatePort("eth1/1/1", makeStats(2000));
+  store.endCycle();
+
+  auto inBytes = findAggregate(store.getAggregates(), kInBytes());
+  EXPECT_EQ(*inBytes.sum_ref(), 2000);
+  EXPECT_THROW(store.getHistory("eth1/3/1", kInBytes().str()), FbossError);
+}
+
+TEST(HwPortCounterStoreTest, history) {
+  HwPortCounterStore store(10);
+  writeCycle(store, seconds(100), 1000, 3000);
+  writeCycle(store, seconds(110), 2000, 5000);
+
+  auto history = store.getHistory("eth1/2/1", kInBytes().str());
+  ASSERT_EQ(history.size(), 2);
+  EXPECT_EQ(*history[0].timestamp_ref(), 110);
+  EXPECT_EQ(*history[0].value_ref(), 5000);
+  EXPECT_EQ(*history[1].timestamp_ref(), 100);
+  EXPECT_EQ(*history[1].value_ref(), 3000);
+  EXPECT_THROW(store.getHistory("eth1/2/1", "no_such_counter"), FbossError);
+}
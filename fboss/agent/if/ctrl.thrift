@@ -545,6 +545,46 @@ struct AclEntryThrift {
   22: optional byte lookupClassL2
 }
 
+/*
+ * Freshness of a thrift response served from a snapshot, see
+ * --thrift_read_snapshot_interval_ms
+ */
+struct ReadSnapshotInfo {
+  1: string name
+  // Generation of the switch state the snapshot was built from
+  2: i64 stateGeneration
+  // Milliseconds since epoch, when the snapshot was last known current
+  3: i64 refreshedAtMs
+  4: i64 ageMs
+  // Time it took to build the snapshot
+  5: i64 buildTimeUs
+  // Calls served from the snapshot, and calls which found it missing or
+  // older than --thrift_read_snapshot_max_age_ms
+  6: i64 numServed
+  7: i64 numStale
+}
+
+/*
+ * A port counter aggregated over all enabled ports, as of the last stats
+ * collection
+ */
+struct PortCounterAggregate {
+  1: string counter
+  2: i64 min
+  3: i64 max
+  4: i64 sum
+  // Increase per second since the collection before, summed over the ports
+  5: double rate
+  // Seconds since epoch of the last stats collection
+  6: i64 timestamp
+}
+
+struct PortCounterSample {
+  // Seconds since epoch
+  1: i64 timestamp
+  2: i64 value
+}
+
 struct ClientInformation {
   1: optional fbstring username,
   2: optional fbstring hostname,
@@ -965,6 +1005,28 @@ service FbossCtrl extends fb303.FacebookService {
   */
   platform_config.PlatformMapping getPlatformMapping()
     throws (1: fboss.FbossBaseError error)
+
+  /*
+   * Freshness of the snapshots getters are served from, empty unless
+   * enabled with --thrift_read_snapshot_interval_ms
+   */
+  list<ReadSnapshotInfo> getReadSnapshotInfo()
+    throws (1: fboss.FbossBaseError error)
+
+  /*
+   * Port counters aggregated over all enabled ports, one entry per counter
+   */
+  list<PortCounterAggregate> getPortCounterAggregates()
+    throws (1: fboss.FbossBaseError error)
+
+  /*
+   * Values of one counter of a port over the stats collections kept (see
+   * --port_counter_history), newest first
+   */
+  list<PortCounterSample> getPortCounterHistory(
+    1: string portName,
+    2: string counter
+  ) throws (1: fboss.FbossBaseError error)
 }
 
 service NeighborListenerClient extends fb303.FacebookService {
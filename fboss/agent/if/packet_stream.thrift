@@ -3,12 +3,27 @@ namespace py3 neteng.fboss
 
 include "common/fb303/if/fb303.thrift"
 
+typedef binary (cpp2.type = "folly::IOBuf") IOBuf
+
 struct TPacket {
   1: i64 timestamp
   2: string l2Port
   3: binary buf
 }
 
+// Same wire format as TPacket, but the payload is kept in an IOBuf so
+// it is neither copied into nor out of a string.
+struct TIOBufPacket {
+  1: i64 timestamp
+  2: string l2Port
+  3: IOBuf buf
+}
+
+// Packets delivered together in a single stream message.
+struct TPacketBatch {
+  1: list<TIOBufPacket> packets
+}
+
 enum TPacketErrorCode {
   INVALID_L2PORT = 1,
   CLIENT_NOT_CONNECTED = 2,
@@ -26,6 +41,10 @@ exception TPacketException {
 service PacketStream extends fb303.FacebookService {
   stream<TPacket throws (1: TPacketException ex)> connect(1: string clientId)
     throws (1: TPacketException ex)
+  // Same as connect(), but packets are streamed in batches
+  stream<TPacketBatch throws (1: TPacketException ex)> connectBatched(
+    1: string clientId,
+  ) throws (1: TPacketException ex)
   void registerPort(1: string clientId, 2: string l2Port)
     throws (1: TPacketException ex)
   void clearPort(1: string clientId, 2: string l2Port)
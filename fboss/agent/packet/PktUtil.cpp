@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/packet/PktUtil.h"
 
+#include <folly/Bits.h>
 #include <folly/Format.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
@@ -16,6 +17,13 @@
 #include <folly/io/Cursor.h>
 #include "fboss/agent/FbossError.h"
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+#include <stdexcept>
+
 using folly::ByteRange;
 using folly::IOBuf;
 using folly::IPAddressV4;
@@ -26,6 +34,121 @@ using folly::io::Appender;
 using folly::io::Cursor;
 using std::string;
 
+namespace {
+
+/*
+ * Checksum kernels. The one's complement sum does not depend on byte order
+ * (RFC 1071 section 2.B), so they sum the buffer as native 16 bit words in
+ * wide accumulators and only the folded result is converted to network
+ * order. An odd trailing byte is summed as the high order byte of a final
+ * word, as if the buffer was padded with a zero.
+ */
+uint64_t sumWordsScalar(const uint8_t* data, size_t len) {
+  uint64_t sum = 0;
+  // 4 bytes at a time, the 64 bit accumulator cannot overflow for any
+  // buffer shorter than 2^34 bytes
+  for (; len >= 4; data += 4, len -= 4) {
+    uint32_t word;
+    memcpy(&word, data, sizeof(word));
+    sum += word;
+  }
+  if (len >= 2) {
+    uint16_t word;
+    memcpy(&word, data, sizeof(word));
+    sum += word;
+    data += 2;
+    len -= 2;
+  }
+  if (len) {
+    uint16_t word = 0;
+    memcpy(&word, data, 1);
+    sum += word;
+  }
+  return sum;
+}
+
+#if defined(__x86_64__)
+// Horizontal sum of 32 bit lanes, widened to 64 bits
+uint64_t sumLanes(__m128i lanes) {
+  alignas(16) uint32_t values[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(values), lanes);
+  return uint64_t(values[0]) + values[1] + values[2] + values[3];
+}
+
+// SSE2 is part of the x86_64 baseline, no dispatch needed
+uint64_t sumWordsSse2(const uint8_t* data, size_t len) {
+  // Each 32 bit lane gains at most 2 * 0xffff per block, flush the lanes
+  // before they can overflow
+  constexpr size_t kBlocksPerFlush = 16384;
+  const __m128i lowMask = _mm_set1_epi32(0xffff);
+  uint64_t sum = 0;
+  while (len >= 16) {
+    __m128i acc = _mm_setzero_si128();
+    for (size_t blocks = 0; len >= 16 && blocks < kBlocksPerFlush;
+         ++blocks, data += 16, len -= 16) {
+      auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+      acc = _mm_add_epi32(acc, _mm_and_si128(v, lowMask));
+      acc = _mm_add_epi32(acc, _mm_srli_epi32(v, 16));
+    }
+    sum += sumLanes(acc);
+  }
+  return sum + sumWordsScalar(data, len);
+}
+
+__attribute__((target("avx2"))) uint64_t sumWordsAvx2(
+    const uint8_t* data,
+    size_t len) {
+  constexpr size_t kBlocksPerFlush = 16384;
+  const __m256i lowMask = _mm256_set1_epi32(0xffff);
+  uint64_t sum = 0;
+  while (len >= 32) {
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t blocks = 0; len >= 32 && blocks < kBlocksPerFlush;
+         ++blocks, data += 32, len -= 32) {
+      auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+      acc = _mm256_add_epi32(acc, _mm256_and_si256(v, lowMask));
+      acc = _mm256_add_epi32(acc, _mm256_srli_epi32(v, 16));
+    }
+    sum += sumLanes(_mm_add_epi32(
+        _mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+  }
+  return sum + sumWordsSse2(data, len);
+}
+#endif
+
+using SumWordsFn = uint64_t (*)(const uint8_t*, size_t);
+
+SumWordsFn selectSumWords() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return sumWordsAvx2;
+  }
+  return sumWordsSse2;
+#else
+  return sumWordsScalar;
+#endif
+}
+
+// Below this size the setup cost of the vector kernels is not worth it
+constexpr size_t kMinVectorLength = 64;
+
+/*
+ * One's complement sum of a contiguous buffer as 16 bit words in network
+ * byte order, folded to 16 bits.
+ */
+uint16_t checksumBytes(const uint8_t* data, size_t len) {
+  static const SumWordsFn sumWords = selectSumWords();
+  uint64_t sum =
+      len < kMinVectorLength ? sumWordsScalar(data, len) : sumWords(data, len);
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return folly::Endian::big(static_cast<uint16_t>(sum));
+}
+
+} // namespace
+
 namespace facebook::fboss {
 
 MacAddress PktUtil::readMac(Cursor* cursor) {
@@ -68,8 +191,7 @@ uint16_t PktUtil::internetChecksum(folly::io::Cursor start, uint64_t length) {
 }
 
 uint16_t PktUtil::internetChecksum(const uint8_t* buffer, uint32_t size) {
-  auto buf = IOBuf(IOBuf::WRAP_BUFFER, buffer, size);
-  return finalizeChecksum(Cursor(&buf), size, 0);
+  return finalizeChecksum(checksumBytes(buffer, size));
 }
 
 uint16_t PktUtil::internetChecksum(const IOBuf* buf) {
@@ -80,18 +202,21 @@ uint32_t PktUtil::partialChecksumImpl(
     folly::io::Cursor cursor,
     uint64_t length,
     uint32_t value) {
-  // Checksum all the pairs of bytes first
-  while (length > 1) {
-    value += cursor.readBE<uint16_t>();
-    length -= 2;
-  }
-  if (length) {
-    // Bytes are interpreted in n/w byte order
-    // so this last octet represents the 8 MSbits
-    // of the last 16 bit number in this buffer.
-    uint16_t last = cursor.read<uint8_t>();
-    value += (last << 8);
-    --length;
+  // Sum each contiguous piece of the chain on its own. A piece starting at an
+  // odd offset has its words shifted by a byte, which just byte swaps its
+  // one's complement sum (RFC 1071 section 2.B).
+  bool oddOffset = false;
+  while (length > 0) {
+    auto bytes = cursor.peekBytes();
+    if (bytes.empty()) {
+      throw std::out_of_range("underflow");
+    }
+    auto pieceLength = std::min<uint64_t>(bytes.size(), length);
+    auto sum = checksumBytes(bytes.data(), pieceLength);
+    value += oddOffset ? folly::Endian::swap(sum) : sum;
+    oddOffset ^= (pieceLength & 1);
+    cursor.skip(pieceLength);
+    length -= pieceLength;
   }
   return value;
 }
@@ -135,15 +260,27 @@ string PktUtil::hexDump(Cursor cursor, uint32_t length) {
   size_t expectedLength = (length * 3) + // 3 bytes for each character
       (numLines * 6); // 5 bytes for each line prefix plus 1 for newline
 
+  static constexpr char kHexDigits[] = "0123456789abcdef";
   string result;
   result.reserve(expectedLength);
-  for (size_t n = 0; n < length; ++n) {
-    if (n == 0) {
-      result.append("0000:");
-    } else if ((n & 0xf) == 0) {
-      folly::format(&result, "\n{:04x}:", n);
+  size_t n = 0;
+  while (n < length) {
+    auto bytes = cursor.peekBytes();
+    if (bytes.empty()) {
+      throw std::out_of_range("underflow");
+    }
+    auto pieceLength = std::min<size_t>(bytes.size(), length - n);
+    for (size_t i = 0; i < pieceLength; ++i, ++n) {
+      if (n == 0) {
+        result.append("0000:");
+      } else if ((n & 0xf) == 0) {
+        folly::format(&result, "\n{:04x}:", n);
+      }
+      char hex[] = {
+          ' ', kHexDigits[bytes[i] >> 4], kHexDigits[bytes[i] & 0xf]};
+      result.append(hex, sizeof(hex));
     }
-    folly::format(&result, " {:02x}", cursor.read<uint8_t>());
+    cursor.skip(pieceLength);
   }
 
   DCHECK_EQ(result.size() + 1, expectedLength);
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/packet/EthHdr.h"
+#include "fboss/agent/packet/IPv4Hdr.h"
+#include "fboss/agent/packet/IPv6Hdr.h"
+#include "fboss/agent/packet/PktUtil.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+
+#include <memory>
+#include <vector>
+
+using namespace facebook::fboss;
+using folly::IOBuf;
+using folly::io::Cursor;
+
+namespace {
+
+std::vector<uint8_t> randomBytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (auto& byte : bytes) {
+    byte = folly::Random::rand32(256);
+  }
+  return bytes;
+}
+
+// The same bytes as a chain of buffers of pieceSize bytes each
+std::unique_ptr<IOBuf> chainedBuf(
+    const std::vector<uint8_t>& bytes,
+    size_t pieceSize) {
+  std::unique_ptr<IOBuf> chain;
+  for (size_t offset = 0; offset < bytes.size(); offset += pieceSize) {
+    auto piece = IOBuf::copyBuffer(
+        bytes.data() + offset, std::min(pieceSize, bytes.size() - offset));
+    if (chain) {
+      chain->prependChain(std::move(piece));
+    } else {
+      chain = std::move(piece);
+    }
+  }
+  return chain;
+}
+
+void checksumContiguous(uint32_t iters, size_t size) {
+  folly::BenchmarkSuspender suspender;
+  auto bytes = randomBytes(size);
+  suspender.dismiss();
+  for (auto i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(PktUtil::internetChecksum(bytes.data(), size));
+  }
+}
+
+void checksumChained(uint32_t iters, size_t size) {
+  folly::BenchmarkSuspender suspender;
+  // Odd piece size, so words straddle buffer boundaries
+  auto buf = chainedBuf(randomBytes(size), 127);
+  suspender.dismiss();
+  for (auto i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(PktUtil::internetChecksum(buf.get()));
+  }
+}
+
+void hexDump(uint32_t iters, size_t size) {
+  folly::BenchmarkSuspender suspender;
+  auto buf = IOBuf::copyBuffer(randomBytes(size).data(), size);
+  suspender.dismiss();
+  for (auto i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(PktUtil::hexDump(Cursor(buf.get())));
+  }
+}
+
+// Ethernet + IPv4/IPv6 header parsing, what the rx path does per packet
+void parseHeaders(uint32_t iters, bool v6) {
+  folly::BenchmarkSuspender suspender;
+  auto bytes = randomBytes(128);
+  // untagged ethernet header with the right ethertype
+  bytes[12] = v6 ? 0x86 : 0x08;
+  bytes[13] = v6 ? 0xdd : 0x00;
+  if (v6) {
+    // version 6, non zero hop limit
+    bytes[14] = 0x60;
+    bytes[21] = 64;
+  } else {
+    // version 4, IHL 5, total length 84, non zero TTL
+    bytes[14] = 0x45;
+    bytes[16] = 0;
+    bytes[17] = 84;
+    bytes[22] = 64;
+  }
+  auto buf = IOBuf::copyBuffer(bytes.data(), bytes.size());
+  suspender.dismiss();
+  for (auto i = 0; i < iters; ++i) {
+    Cursor cursor(buf.get());
+    EthHdr ethHdr(cursor);
+    folly::doNotOptimizeAway(ethHdr);
+    if (v6) {
+      IPv6Hdr ipHdr(cursor);
+      folly::doNotOptimizeAway(ipHdr);
+    } else {
+      IPv4Hdr ipHdr(cursor);
+      folly::doNotOptimizeAway(ipHdr);
+    }
+  }
+}
+
+} // namespace
+
+// IPv4 header, ICMP error, DHCP, full MTU, jumbo
+BENCHMARK_NAMED_PARAM(checksumContiguous, 20_bytes, 20)
+BENCHMARK_NAMED_PARAM(checksumContiguous, 84_bytes, 84)
+BENCHMARK_NAMED_PARAM(checksumContiguous, 576_bytes, 576)
+BENCHMARK_NAMED_PARAM(checksumContiguous, 1500_bytes, 1500)
+BENCHMARK_NAMED_PARAM(checksumContiguous, 9000_bytes, 9000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(checksumChained, 576_bytes, 576)
+BENCHMARK_NAMED_PARAM(checksumChained, 1500_bytes, 1500)
+BENCHMARK_NAMED_PARAM(checksumChained, 9000_bytes, 9000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(hexDump, 64_bytes, 64)
+BENCHMARK_NAMED_PARAM(hexDump, 1500_bytes, 1500)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(parseHeaders, ipv4, false)
+BENCHMARK_NAMED_PARAM(parseHeaders, ipv6, true)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
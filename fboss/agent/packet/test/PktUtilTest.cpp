@@ -222,3 +222,36 @@ TEST(Checksum, TestKnownOdd) {
   expected = ~expected;
   EXPECT_EQ(expected, PktUtil::internetChecksum(bytes, 9));
 }
+
+TEST(Checksum, TestChainedMatchesContiguous) {
+  // Split a buffer long enough for the vector kernels into pieces of odd and
+  // even lengths, so words straddle buffer boundaries
+  constexpr uint32_t kSize = 1500;
+  uint8_t bytes[kSize];
+  for (auto i = 0; i < kSize; ++i) {
+    bytes[i] = Random::rand32(std::numeric_limits<uint8_t>::max());
+  }
+  auto expected = PktUtil::internetChecksum(bytes, kSize);
+
+  for (auto pieceSize : {1, 3, 64, 97, 500, 1499}) {
+    std::unique_ptr<IOBuf> chain;
+    for (uint32_t offset = 0; offset < kSize; offset += pieceSize) {
+      auto length = std::min<uint32_t>(pieceSize, kSize - offset);
+      auto piece = IOBuf::copyBuffer(bytes + offset, length);
+      if (chain) {
+        chain->prependChain(std::move(piece));
+      } else {
+        chain = std::move(piece);
+      }
+    }
+    EXPECT_EQ(expected, PktUtil::internetChecksum(chain.get()))
+        << "piece size " << pieceSize;
+    // Incremental checksum over an even prefix plus the rest
+    Cursor cursor(chain.get());
+    auto partial = PktUtil::partialChecksum(cursor, 100);
+    cursor.skip(100);
+    EXPECT_EQ(
+        expected, PktUtil::finalizeChecksum(cursor, kSize - 100, partial))
+        << "piece size " << pieceSize;
+  }
+}
@@ -21,6 +21,16 @@ namespace fboss {
 MultiPimPlatformMapping::MultiPimPlatformMapping(
     const std::string& jsonPlatformMappingStr)
     : PlatformMapping(jsonPlatformMappingStr) {
+  initPims();
+}
+
+MultiPimPlatformMapping::MultiPimPlatformMapping(
+    const CompiledPlatformMapping& compiledMapping)
+    : PlatformMapping(compiledMapping) {
+  initPims();
+}
+
+void MultiPimPlatformMapping::initPims() {
   for (auto& port : platformPorts_) {
     int portPimID = getPimID(port.second);
 
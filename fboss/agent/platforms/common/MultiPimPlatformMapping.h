@@ -17,6 +17,8 @@ namespace fboss {
 class MultiPimPlatformMapping : public PlatformMapping {
  public:
   explicit MultiPimPlatformMapping(const std::string& jsonPlatformMappingStr);
+  explicit MultiPimPlatformMapping(
+      const CompiledPlatformMapping& compiledMapping);
 
   PlatformMapping* getPimPlatformMapping(uint8_t pimID);
 
@@ -27,6 +29,9 @@ class MultiPimPlatformMapping : public PlatformMapping {
   std::map<uint8_t, std::unique_ptr<PlatformMapping>> pims_;
 
  private:
+  // Split the ports, chips and profiles of the whole mapping per pim
+  void initPims();
+
   // Forbidden copy constructor and assignment operator
   MultiPimPlatformMapping(MultiPimPlatformMapping const&) = delete;
   MultiPimPlatformMapping& operator=(MultiPimPlatformMapping const&) = delete;
@@ -11,6 +11,7 @@
 #include "fboss/agent/platforms/common/PlatformMapping.h"
 
 #include <folly/logging/xlog.h>
+#include <atomic>
 #include <re2/re2.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
@@ -114,10 +115,18 @@ std::string PlatformPortProfileConfigMatcher::toString() const {
       .str();
 }
 
-PlatformMapping::PlatformMapping(const std::string& jsonPlatformMappingStr) {
-  auto mapping =
-      apache::thrift::SimpleJSONSerializer::deserialize<cfg::PlatformMapping>(
-          jsonPlatformMappingStr);
+PlatformMapping::PlatformMapping(const std::string& jsonPlatformMappingStr)
+    : PlatformMapping(
+          apache::thrift::SimpleJSONSerializer::deserialize<
+              cfg::PlatformMapping>(jsonPlatformMappingStr)) {}
+
+PlatformMapping::PlatformMapping(
+    const CompiledPlatformMapping& compiledMapping)
+    : PlatformMapping(
+          apache::thrift::CompactSerializer::deserialize<cfg::PlatformMapping>(
+              folly::ByteRange(compiledMapping.data, compiledMapping.size))) {}
+
+PlatformMapping::PlatformMapping(cfg::PlatformMapping mapping) {
   platformPorts_ = std::move(*mapping.ports_ref());
   platformSupportedProfiles_ =
       std::move(*mapping.platformSupportedProfiles_ref());
@@ -141,6 +150,8 @@ cfg::PlatformMapping PlatformMapping::toThrift() const {
 }
 
 void PlatformMapping::merge(PlatformMapping* mapping) {
+  resetIndices();
+  mapping->resetIndices();
   for (auto port : mapping->platformPorts_) {
     platformPorts_.emplace(port.first, std::move(port.second));
     mergePortConfigOverrides(
@@ -161,6 +172,7 @@ void PlatformMapping::merge(PlatformMapping* mapping) {
 
 void PlatformMapping::mergePlatformSupportedProfile(
     cfg::PlatformPortProfileConfigEntry incomingProfile) {
+  resetIndices();
   for (auto& currentProfile : platformSupportedProfiles_) {
     auto currentFactor = currentProfile.factor_ref();
     auto incomingFactor = incomingProfile.factor_ref();
@@ -203,6 +215,11 @@ void PlatformMapping::mergePlatformSupportedProfile(
 }
 
 int PlatformMapping::getPimID(PortID portID) const {
+  auto indices = getIndices();
+  auto itPimID = indices->pimIDs.find(portID);
+  if (itPimID != indices->pimIDs.end()) {
+    return itPimID->second;
+  }
   auto itPlatformPort = platformPorts_.find(portID);
   if (itPlatformPort == platformPorts_.end()) {
     throw FbossError("Unrecoganized port:", portID);
@@ -214,8 +231,7 @@ int PlatformMapping::getPimID(
     const cfg::PlatformPortEntry& platformPort) const {
   int pimID = 0;
   auto& portName = platformPort.get_mapping().get_name();
-  re2::RE2 portNameRe(kFbossPortNameRegex);
-  if (!re2::RE2::FullMatch(portName, portNameRe, &pimID)) {
+  if (!re2::RE2::FullMatch(portName, portNameRegex, &pimID)) {
     throw FbossError(
         "Invalid port name: ",
         portName,
@@ -232,7 +248,7 @@ cfg::PortSpeed PlatformMapping::getPortMaxSpeed(PortID portID) const {
   }
 
   cfg::PortSpeed maxSpeed{cfg::PortSpeed::DEFAULT};
-  for (auto profile : *itPlatformPort->second.supportedProfiles_ref()) {
+  for (const auto& profile : *itPlatformPort->second.supportedProfiles_ref()) {
     if (auto profileConfig = getPortProfileConfig(
             PlatformPortProfileConfigMatcher(profile.first, portID))) {
       if (static_cast<int>(maxSpeed) <
@@ -255,13 +271,15 @@ std::vector<phy::PinConfig> PlatformMapping::getPortIphyPinConfigs(
       getPlatformPortConfig(portID.value(), profileID);
   const auto& iphyCfg = *platformPortConfig.pins_ref()->iphy_ref();
   // Check whether there's an override
-  for (const auto portConfigOverride : portConfigOverrides_) {
+  auto indices = getIndices();
+  for (auto idx : getOverrideCandidates(*indices, matcher)) {
+    const auto& portConfigOverride = portConfigOverrides_[idx];
     if (!portConfigOverride.pins_ref().has_value()) {
       // The override is not about Iphy pin configs. Skip
       continue;
     }
     if (matcher.matchOverrideWithFactor(*portConfigOverride.factor_ref())) {
-      auto overrideIphy = *portConfigOverride.pins_ref()->iphy_ref();
+      const auto& overrideIphy = *portConfigOverride.pins_ref()->iphy_ref();
       if (!overrideIphy.empty()) {
         // make sure the override iphy config size == iphyCfg or override
         // size == 1, in which case we use the same override for all lanes
@@ -335,7 +353,9 @@ std::vector<phy::PinConfig> PlatformMapping::getPortXphySidePinConfigs(
   }
   const auto& xphySideCfg = xphySideOptional.value();
   // Check whether there's an override
-  for (const auto portConfigOverride : portConfigOverrides_) {
+  auto indices = getIndices();
+  for (auto idx : getOverrideCandidates(*indices, matcher)) {
+    const auto& portConfigOverride = portConfigOverrides_[idx];
     if (!portConfigOverride.pins_ref().has_value()) {
       // The override is not about pin configs. Skip
       continue;
@@ -348,7 +368,7 @@ std::vector<phy::PinConfig> PlatformMapping::getPortXphySidePinConfigs(
       continue;
     }
     if (matcher.matchOverrideWithFactor(*portConfigOverride.factor_ref())) {
-      auto overrideXphySideCfg = overrideXphySideOptional.value();
+      const auto& overrideXphySideCfg = overrideXphySideOptional.value();
       if (!overrideXphySideCfg.empty()) {
         // make sure the override xphy config size == xphySideCfg or
         // override size == 1, in which case we use the same override for all
@@ -402,7 +422,9 @@ phy::PortPinConfig PlatformMapping::getPortXphyPinConfig(
 const std::optional<phy::PortProfileConfig>
 PlatformMapping::getPortProfileConfig(
     PlatformPortProfileConfigMatcher profileMatcher) const {
-  for (const auto portConfigOverride : portConfigOverrides_) {
+  auto indices = getIndices();
+  for (auto idx : getOverrideCandidates(*indices, profileMatcher)) {
+    const auto& portConfigOverride = portConfigOverrides_[idx];
     if (!portConfigOverride.portProfileConfig_ref().has_value()) {
       // The override is not about portProfileConfig. Skip
       continue;
@@ -412,10 +434,15 @@ PlatformMapping::getPortProfileConfig(
       return *portConfigOverride.portProfileConfig_ref();
     }
   }
-  for (auto& supportedProfile : platformSupportedProfiles_) {
-    if (profileMatcher.matchProfileWithFactor(
-            this, supportedProfile.get_factor())) {
-      return supportedProfile.get_profile();
+  auto itProfiles =
+      indices->supportedProfiles.find(profileMatcher.getProfileID());
+  if (itProfiles != indices->supportedProfiles.end()) {
+    for (auto idx : itProfiles->second) {
+      const auto& supportedProfile = platformSupportedProfiles_[idx];
+      if (profileMatcher.matchProfileWithFactor(
+              this, supportedProfile.get_factor())) {
+        return supportedProfile.get_profile();
+      }
     }
   }
   XLOGF(
@@ -446,6 +473,7 @@ PlatformMapping::getPortConfigOverrides(int32_t port) const {
 void PlatformMapping::mergePortConfigOverrides(
     int32_t port,
     std::vector<cfg::PlatformPortConfigOverride> overrides) {
+  resetIndices();
   for (auto& portOverrides : overrides) {
     int numMismatch = 0;
     for (auto& curOverride : portConfigOverrides_) {
@@ -501,5 +529,99 @@ const cfg::PlatformPortConfig& PlatformMapping::getPlatformPortConfig(
   return platformPortConfig->second;
 }
 
+std::shared_ptr<const PlatformMapping::Indices> PlatformMapping::getIndices()
+    const {
+  auto indices = std::atomic_load(&indices_);
+  if (!indices) {
+    indices = buildIndices();
+    std::atomic_store(&indices_, indices);
+  }
+  return indices;
+}
+
+void PlatformMapping::resetIndices() {
+  std::atomic_store(&indices_, std::shared_ptr<const Indices>());
+}
+
+std::shared_ptr<const PlatformMapping::Indices> PlatformMapping::buildIndices()
+    const {
+  auto indices = std::make_shared<Indices>();
+  for (const auto& portConfigOverride : portConfigOverrides_) {
+    const auto& factor = *portConfigOverride.factor_ref();
+    if (auto ports = factor.ports_ref()) {
+      indices->overridePorts.insert(ports->begin(), ports->end());
+    }
+    if (auto profiles = factor.profiles_ref()) {
+      for (auto profile : *profiles) {
+        indices->overrideProfiles.insert(static_cast<int32_t>(profile));
+      }
+    }
+  }
+
+  std::vector<int32_t> allPorts(
+      indices->overridePorts.begin(), indices->overridePorts.end());
+  allPorts.push_back(Indices::kAnyPort);
+  std::vector<int32_t> allProfiles(
+      indices->overrideProfiles.begin(), indices->overrideProfiles.end());
+  allProfiles.push_back(Indices::kAnyProfile);
+
+  for (size_t idx = 0; idx < portConfigOverrides_.size(); ++idx) {
+    const auto& factor = *portConfigOverrides_[idx].factor_ref();
+    std::vector<int32_t> profiles;
+    if (auto overrideProfiles = factor.profiles_ref()) {
+      for (auto profile : *overrideProfiles) {
+        profiles.push_back(static_cast<int32_t>(profile));
+      }
+    }
+    const auto& ports =
+        factor.ports_ref().has_value() ? *factor.ports_ref() : allPorts;
+    for (auto port : ports) {
+      for (auto profile :
+           factor.profiles_ref().has_value() ? profiles : allProfiles) {
+        auto& candidates =
+            indices->overrides[Indices::overrideKey(port, profile)];
+        // A factor may list the same port or profile twice
+        if (candidates.empty() || candidates.back() != idx) {
+          candidates.push_back(idx);
+        }
+      }
+    }
+  }
+
+  for (size_t idx = 0; idx < platformSupportedProfiles_.size(); ++idx) {
+    indices
+        ->supportedProfiles[platformSupportedProfiles_[idx]
+                                .get_factor()
+                                .get_profileID()]
+        .push_back(idx);
+  }
+
+  for (const auto& port : platformPorts_) {
+    int pimID = 0;
+    if (re2::RE2::FullMatch(
+            port.second.get_mapping().get_name(), portNameRegex, &pimID)) {
+      indices->pimIDs.emplace(port.first, pimID);
+    }
+  }
+  return indices;
+}
+
+const std::vector<size_t>& PlatformMapping::getOverrideCandidates(
+    const Indices& indices,
+    PlatformPortProfileConfigMatcher& matcher) const {
+  static const std::vector<size_t> kNoCandidates;
+  auto port = Indices::kAnyPort;
+  if (auto portID = matcher.getPortIDIf(); portID.has_value() &&
+      indices.overridePorts.count(static_cast<int32_t>(portID.value()))) {
+    port = static_cast<int32_t>(portID.value());
+  }
+  auto profile = static_cast<int32_t>(matcher.getProfileID());
+  if (!indices.overrideProfiles.count(profile)) {
+    profile = Indices::kAnyProfile;
+  }
+  auto it = indices.overrides.find(Indices::overrideKey(port, profile));
+  return it == indices.overrides.end() ? kNoCandidates : it->second;
+}
+
 } // namespace fboss
 } // namespace facebook
@@ -13,11 +13,24 @@
 #include "fboss/agent/types.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
 DECLARE_bool(override_cmis_tx_setting);
 
 namespace facebook {
 namespace fboss {
 
+/*
+ * A cfg::PlatformMapping serialized with the compact protocol at build time by
+ * platform_mapping_compiler, see PlatformMappingCompiler.cpp
+ */
+struct CompiledPlatformMapping {
+  const uint8_t* data;
+  size_t size;
+};
+
 class PlatformMapping;
 class PlatformPortProfileConfigMatcher {
  public:
@@ -70,6 +83,8 @@ class PlatformMapping {
  public:
   PlatformMapping() {}
   explicit PlatformMapping(const std::string& jsonPlatformMappingStr);
+  explicit PlatformMapping(const CompiledPlatformMapping& compiledMapping);
+  explicit PlatformMapping(cfg::PlatformMapping mapping);
   virtual ~PlatformMapping() = default;
 
   cfg::PlatformMapping toThrift() const;
@@ -104,6 +119,7 @@ class PlatformMapping {
 
   void setPlatformPort(int32_t portID, cfg::PlatformPortEntry port) {
     platformPorts_.emplace(portID, port);
+    resetIndices();
   }
 
   void setChip(const std::string& chipName, phy::DataPlanePhyChip chip) {
@@ -138,6 +154,45 @@ class PlatformMapping {
       cfg::PortProfileID profileID) const;
 
  private:
+  /*
+   * Lookup tables so that per port queries don't scan every override and
+   * supported profile. They are built on first use and dropped whenever the
+   * mapping is modified, so merging pims one port at a time stays cheap.
+   */
+  struct Indices {
+    static constexpr int32_t kAnyPort = -1;
+    static constexpr int32_t kAnyProfile = -1;
+
+    static uint64_t overrideKey(int32_t port, int32_t profile) {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(port)) << 32) |
+          static_cast<uint32_t>(profile);
+    }
+
+    // Ports and profiles explicitly listed by some override factor. Anything
+    // else is only matched by overrides without such a list, which is what
+    // the kAnyPort/kAnyProfile entries hold.
+    std::unordered_set<int32_t> overridePorts;
+    std::unordered_set<int32_t> overrideProfiles;
+    // (port, profile) => positions in portConfigOverrides_ of the overrides
+    // whose ports and profiles factors admit that pair, in original order.
+    // Remaining factors (cable length, transceiver) are matched per query.
+    std::unordered_map<uint64_t, std::vector<size_t>> overrides;
+    // profileID => positions in platformSupportedProfiles_, in original order
+    std::unordered_map<cfg::PortProfileID, std::vector<size_t>>
+        supportedProfiles;
+    std::unordered_map<int32_t, int> pimIDs;
+  };
+
+  std::shared_ptr<const Indices> getIndices() const;
+  std::shared_ptr<const Indices> buildIndices() const;
+  void resetIndices();
+  const std::vector<size_t>& getOverrideCandidates(
+      const Indices& indices,
+      PlatformPortProfileConfigMatcher& matcher) const;
+
+  // Accessed atomically, const lookups may race to build it
+  mutable std::shared_ptr<const Indices> indices_;
+
   // Forbidden copy constructor and assignment operator
   PlatformMapping(PlatformMapping const&) = delete;
   PlatformMapping& operator=(PlatformMapping const&) = delete;
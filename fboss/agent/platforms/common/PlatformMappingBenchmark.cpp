@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/platforms/common/minipack/MinipackPlatformMapping.h"
+#include "fboss/agent/platforms/common/yamp/YampPlatformMapping.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <functional>
+#include <memory>
+
+using namespace facebook::fboss;
+
+namespace {
+
+/*
+ * Resolve everything config apply and port programming ask the platform
+ * mapping for, for every port and every profile it supports: the profile
+ * config, iphy pins, xphy pins and the port max speed.
+ */
+void resolvePortConfigs(
+    uint32_t iters,
+    const std::function<std::unique_ptr<PlatformMapping>()>& makeMapping) {
+  folly::BenchmarkSuspender suspender;
+  auto mapping = makeMapping();
+  suspender.dismiss();
+
+  for (auto iter = 0; iter < iters; ++iter) {
+    for (const auto& port : mapping->getPlatformPorts()) {
+      PortID portID(port.first);
+      for (const auto& profile : *port.second.supportedProfiles_ref()) {
+        PlatformPortProfileConfigMatcher matcher(profile.first, portID);
+        folly::doNotOptimizeAway(mapping->getPortProfileConfig(matcher));
+        folly::doNotOptimizeAway(mapping->getPortIphyPinConfigs(matcher));
+        folly::doNotOptimizeAway(mapping->getPortXphyPinConfig(matcher));
+      }
+      folly::doNotOptimizeAway(mapping->getPortMaxSpeed(portID));
+    }
+  }
+}
+
+} // namespace
+
+BENCHMARK(MinipackResolvePortConfigs, iters) {
+  resolvePortConfigs(iters, []() {
+    return std::make_unique<MinipackPlatformMapping>(
+        ExternalPhyVersion::MILN5_2);
+  });
+}
+
+BENCHMARK(YampResolvePortConfigs, iters) {
+  resolvePortConfigs(
+      iters, []() { return std::make_unique<YampPlatformMapping>(); });
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -2,6 +2,9 @@
 
 #include "fboss/agent/platforms/common/ebb_lab/Wedge400CEbbLabPlatformMapping.h"
 namespace {
+#ifdef FBOSS_COMPILED_PLATFORM_MAPPINGS
+#include "fboss/agent/platforms/common/ebb_lab/Wedge400CEbbLabPlatformMapping.compiled.h"
+#else
 constexpr auto kJsonPlatformMappingStr = R"(
 {
   "ports": {
@@ -16195,6 +16198,7 @@ constexpr auto kJsonPlatformMappingStr = R"(
   ]
 }
 )";
+#endif
 }
 namespace facebook::fboss {
 
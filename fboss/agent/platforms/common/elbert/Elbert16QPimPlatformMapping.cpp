@@ -11,6 +11,9 @@
 #include "fboss/agent/platforms/common/elbert/Elbert16QPimPlatformMapping.h"
 
 namespace {
+#ifdef FBOSS_COMPILED_PLATFORM_MAPPINGS
+#include "fboss/agent/platforms/common/elbert/Elbert16QPimPlatformMapping.compiled.h"
+#else
 constexpr auto kJsonPlatformMappingStr = R"(
 {
   "ports": {
@@ -29987,6 +29990,7 @@ constexpr auto kJsonPlatformMappingStr = R"(
   ]
 }
 )";
+#endif
 } // namespace
 
 namespace facebook::fboss {
@@ -12,6 +12,9 @@
 #include <folly/logging/xlog.h>
 
 namespace {
+#ifdef FBOSS_COMPILED_PLATFORM_MAPPINGS
+#include "fboss/agent/platforms/common/minipack/Minipack16QPimPlatformMapping.compiled.h"
+#else
 constexpr auto kJsonMiln42PlatformMappingStr = R"(
 {
   "ports": {
@@ -95172,6 +95175,7 @@ constexpr auto kJsonMiln52PlatformMappingStr = R"(
   ]
 }
 )";
+#endif
 } // namespace
 
 namespace facebook {
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Build time compiler for platform mappings.
+ *
+ * Platform mapping sources embed their cfg::PlatformMapping as JSON raw
+ * string literals:
+ *
+ *   constexpr auto kJsonPlatformMappingStr = R"(
+ *   { ... }
+ *   )";
+ *
+ * This tool extracts every such literal, parses it once at build time and
+ * writes a header that defines a CompiledPlatformMapping with the same name,
+ * holding the mapping serialized with the compact protocol. Sources built
+ * with FBOSS_COMPILED_PLATFORM_MAPPINGS include that header instead of the
+ * JSON, so startup deserializes a blob that is a fraction of the size rather
+ * than parsing megabytes of JSON.
+ *
+ * Parse and deserialize times are logged and written to the generated header.
+ * platform_mapping_startup measures construction time and RSS of a mapping in
+ * the built binary.
+ */
+
+#include "fboss/agent/gen-cpp2/platform_config_types.h"
+
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+#include <re2/re2.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+DEFINE_string(input, "", "Platform mapping source with JSON literals");
+DEFINE_string(output, "", "Header to write the compiled mappings to");
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr auto kJsonLiteralRegex =
+    R"re(constexpr\s+auto\s+(\w+)\s*=\s*R"\(((?s:.*?))\)";)re";
+constexpr auto kBytesPerLine = 16;
+
+struct JsonLiteral {
+  std::string name;
+  std::string json;
+};
+
+std::vector<JsonLiteral> extractJsonLiterals(const std::string& source) {
+  std::vector<JsonLiteral> literals;
+  re2::RE2 literalRe(kJsonLiteralRegex);
+  re2::StringPiece input(source);
+  std::string name;
+  std::string json;
+  while (re2::RE2::FindAndConsume(&input, literalRe, &name, &json)) {
+    literals.push_back({name, json});
+  }
+  return literals;
+}
+
+template <typename Fn>
+std::chrono::microseconds timeIt(Fn&& fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+std::string compileLiteral(const JsonLiteral& literal) {
+  cfg::PlatformMapping mapping;
+  auto jsonTime = timeIt([&]() {
+    mapping = apache::thrift::SimpleJSONSerializer::deserialize<
+        cfg::PlatformMapping>(literal.json);
+  });
+  auto compact =
+      apache::thrift::CompactSerializer::serialize<std::string>(mapping);
+
+  // Round trip to make sure nothing is lost and to report the gain
+  cfg::PlatformMapping roundTrip;
+  auto compactTime = timeIt([&]() {
+    roundTrip = apache::thrift::CompactSerializer::deserialize<
+        cfg::PlatformMapping>(compact);
+  });
+  if (roundTrip != mapping) {
+    throw std::runtime_error(
+        folly::to<std::string>(literal.name, " does not round trip"));
+  }
+  auto summary = folly::sformat(
+      "{}: JSON {} bytes parsed in {}us, compact {} bytes deserialized in {}us",
+      literal.name,
+      literal.json.size(),
+      jsonTime.count(),
+      compact.size(),
+      compactTime.count());
+  XLOG(INFO) << FLAGS_input << ":" << summary;
+
+  // Keep the numbers of the build host with the generated data
+  std::string out = folly::sformat(
+      "// {}\nconstexpr uint8_t {}Data[] = {{", summary, literal.name);
+  for (size_t i = 0; i < compact.size(); ++i) {
+    if (i % kBytesPerLine == 0) {
+      out += "\n   ";
+    }
+    out += folly::sformat(" 0x{:02x},", static_cast<uint8_t>(compact[i]));
+  }
+  out += folly::sformat(
+      "\n}};\nconstexpr facebook::fboss::CompiledPlatformMapping {}{{\n"
+      "    {}Data,\n    sizeof({}Data)}};\n\n",
+      literal.name,
+      literal.name,
+      literal.name);
+  return out;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  if (FLAGS_input.empty() || FLAGS_output.empty()) {
+    XLOG(ERR) << "Both --input and --output are required";
+    return 1;
+  }
+
+  std::string source;
+  if (!folly::readFile(FLAGS_input.c_str(), source)) {
+    XLOG(ERR) << "Unable to read " << FLAGS_input;
+    return 1;
+  }
+  auto literals = extractJsonLiterals(source);
+  if (literals.empty()) {
+    XLOG(ERR) << "No JSON platform mapping found in " << FLAGS_input;
+    return 1;
+  }
+
+  std::string header = folly::sformat(
+      "// @{} by platform_mapping_compiler from {}\n"
+      "// Included in the anonymous namespace of that file in place of the\n"
+      "// JSON literals.\n\n",
+      "generated",
+      FLAGS_input);
+  for (const auto& literal : literals) {
+    header += compileLiteral(literal);
+  }
+
+  if (!folly::writeFile(header, FLAGS_output.c_str())) {
+    XLOG(ERR) << "Unable to write " << FLAGS_output;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Startup cost of a platform mapping: time to construct it, growth of the
+ * resident set while doing so and the peak resident set over the process.
+ * Run it once per platform, in a fresh process, from a build with and one
+ * without COMPILED_PLATFORM_MAPPINGS to get the per-platform delta of
+ * compiling the mappings, see PlatformMappingCompiler.cpp.
+ */
+
+#include "fboss/agent/platforms/common/ebb_lab/Wedge400CEbbLabPlatformMapping.h"
+#include "fboss/agent/platforms/common/elbert/ElbertPlatformMapping.h"
+#include "fboss/agent/platforms/common/minipack/MinipackPlatformMapping.h"
+#include "fboss/agent/platforms/common/wedge100/Wedge100PlatformMapping.h"
+#include "fboss/agent/platforms/common/wedge40/Wedge40PlatformMapping.h"
+#include "fboss/agent/platforms/common/wedge400/Wedge400PlatformMapping.h"
+#include "fboss/agent/platforms/common/wedge400c/Wedge400CPlatformMapping.h"
+#include "fboss/agent/platforms/common/yamp/YampPlatformMapping.h"
+#include "fboss/agent/platforms/wedge/fuji/FujiPlatformMapping.h"
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/dynamic.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <folly/logging/xlog.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+DEFINE_string(
+    platform,
+    "",
+    "Platform mapping to construct: minipack, yamp, fuji, elbert, wedge40, "
+    "wedge100, wedge400, wedge400c or wedge400c_ebb_lab");
+DEFINE_bool(json, true, "Output in json form");
+
+using namespace facebook::fboss;
+
+namespace {
+
+using MappingFactory = std::function<std::unique_ptr<PlatformMapping>()>;
+
+const std::map<std::string, MappingFactory>& mappingFactories() {
+  static const std::map<std::string, MappingFactory> kFactories = {
+      {"minipack",
+       []() {
+         return std::make_unique<MinipackPlatformMapping>(
+             ExternalPhyVersion::MILN5_2);
+       }},
+      {"yamp", []() { return std::make_unique<YampPlatformMapping>(); }},
+      {"fuji", []() { return std::make_unique<FujiPlatformMapping>(); }},
+      {"elbert", []() { return std::make_unique<ElbertPlatformMapping>(); }},
+      {"wedge40", []() { return std::make_unique<Wedge40PlatformMapping>(); }},
+      {"wedge100",
+       []() { return std::make_unique<Wedge100PlatformMapping>(); }},
+      {"wedge400",
+       []() { return std::make_unique<Wedge400PlatformMapping>(); }},
+      {"wedge400c",
+       []() { return std::make_unique<Wedge400CPlatformMapping>(); }},
+      {"wedge400c_ebb_lab",
+       []() { return std::make_unique<Wedge400CEbbLabPlatformMapping>(); }},
+  };
+  return kFactories;
+}
+
+/*
+ * Value in KB of the given field of /proc/self/status, VmRSS for the current
+ * resident set and VmHWM for its peak
+ */
+int64_t procStatusKb(folly::StringPiece field) {
+  std::string status;
+  if (!folly::readFile("/proc/self/status", status)) {
+    return -1;
+  }
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', status, lines);
+  for (auto line : lines) {
+    if (line.removePrefix(field) && line.removePrefix(":")) {
+      return folly::to<int64_t>(
+          folly::trimWhitespace(line.subpiece(0, line.find("kB"))));
+    }
+  }
+  return -1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  const auto& factories = mappingFactories();
+  auto factory = factories.find(FLAGS_platform);
+  if (factory == factories.end()) {
+    XLOG(ERR) << "Unknown --platform " << FLAGS_platform;
+    return 1;
+  }
+
+  auto rssBefore = procStatusKb("VmRSS");
+  auto start = std::chrono::steady_clock::now();
+  // Kept alive so the resident set includes the mapping itself
+  auto mapping = factory->second();
+  std::chrono::duration<double, std::milli> construction =
+      std::chrono::steady_clock::now() - start;
+  auto rssAfter = procStatusKb("VmRSS");
+  auto peakRss = procStatusKb("VmHWM");
+
+  if (FLAGS_json) {
+    folly::dynamic result = folly::dynamic::object;
+    result["platform"] = FLAGS_platform;
+    result["ports"] = mapping->getPlatformPorts().size();
+    result["construct_msecs"] = construction.count();
+    result["construct_rss_kb"] = rssAfter - rssBefore;
+    result["peak_rss_kb"] = peakRss;
+    std::cout << result << std::endl;
+  } else {
+    XLOG(INFO) << FLAGS_platform << ": "
+               << mapping->getPlatformPorts().size() << " ports constructed in "
+               << construction.count() << "ms, RSS grew by "
+               << rssAfter - rssBefore << "KB, peak RSS " << peakRss << "KB";
+  }
+  return 0;
+}
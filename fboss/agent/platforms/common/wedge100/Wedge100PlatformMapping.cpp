@@ -11,6 +11,9 @@
 #include "fboss/agent/platforms/common/wedge100/Wedge100PlatformMapping.h"
 
 namespace {
+#ifdef FBOSS_COMPILED_PLATFORM_MAPPINGS
+#include "fboss/agent/platforms/common/wedge100/Wedge100PlatformMapping.compiled.h"
+#else
 constexpr auto kJsonPlatformMappingStr = R"(
 {
   "ports": {
@@ -37497,6 +37500,7 @@ constexpr auto kJsonPlatformMappingStr = R"(
   ]
 }
 )";
+#endif
 } // namespace
 
 namespace facebook {
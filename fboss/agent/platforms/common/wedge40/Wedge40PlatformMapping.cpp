@@ -11,6 +11,9 @@
 #include "fboss/agent/platforms/common/wedge40/Wedge40PlatformMapping.h"
 
 namespace {
+#ifdef FBOSS_COMPILED_PLATFORM_MAPPINGS
+#include "fboss/agent/platforms/common/wedge40/Wedge40PlatformMapping.compiled.h"
+#else
 constexpr auto kJsonPlatformMappingStr = R"(
 {
   "ports": {
@@ -8501,6 +8504,7 @@ constexpr auto kJsonPlatformMappingStr = R"(
   ]
 }
 )";
+#endif
 } // namespace
 
 namespace facebook {
@@ -11,6 +11,9 @@
 #include "fboss/agent/platforms/common/wedge400/Wedge400PlatformMapping.h"
 
 namespace {
+#ifdef FBOSS_COMPILED_PLATFORM_MAPPINGS
+#include "fboss/agent/platforms/common/wedge400/Wedge400PlatformMapping.compiled.h"
+#else
 constexpr auto kJsonPlatformMappingStr = R"(
 {
   "ports": {
@@ -28473,6 +28476,7 @@ constexpr auto kJsonPlatformMappingStr = R"(
   ]
 }
 )";
+#endif
 } // namespace
 
 namespace facebook {
@@ -22,6 +22,7 @@
 #include "fboss/agent/platforms/common/yamp/YampPlatformMapping.h"
 
 #include <gtest/gtest.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 namespace facebook::fboss::test {
 
@@ -872,4 +873,20 @@ TEST_F(PlatformMappingTest, VerifyPlatformSupportedProfileMerge) {
   EXPECT_THROW(
       platformMapping.mergePlatformSupportedProfile(configEntry4), FbossError);
 }
+
+TEST_F(PlatformMappingTest, VerifyCompiledPlatformMapping) {
+  auto mapping = std::make_unique<Minipack16QPimPlatformMapping>(
+      ExternalPhyVersion::MILN5_2);
+  auto compact = apache::thrift::CompactSerializer::serialize<std::string>(
+      mapping->toThrift());
+  MultiPimPlatformMapping compiled(CompiledPlatformMapping{
+      reinterpret_cast<const uint8_t*>(compact.data()), compact.size()});
+
+  EXPECT_EQ(mapping->toThrift(), compiled.toThrift());
+  for (auto pimID = 2; pimID <= 9; ++pimID) {
+    EXPECT_EQ(
+        mapping->getPimPlatformMapping(pimID)->toThrift(),
+        compiled.getPimPlatformMapping(pimID)->toThrift());
+  }
+}
 } // namespace facebook::fboss::test
@@ -150,6 +150,19 @@ ForwardingInformationBaseUpdater::toFibNextHop(
           facebook::fboss::RouteNextHopEntry::Action::TO_CPU,
           ribNextHopEntry.getAdminDistance());
     case facebook::fboss::RouteNextHopEntry::Action::NEXTHOPS: {
+      const auto& ribNextHopSet = ribNextHopEntry.getNextHopSet();
+      if (std::none_of(
+              ribNextHopSet.begin(),
+              ribNextHopSet.end(),
+              [](const auto& ribNextHop) {
+                return !ribNextHop.isResolved() ||
+                    ribNextHop.labelForwardingAction().has_value();
+              })) {
+        // Same next hops in the FIB, share the interned set with the RIB
+        return facebook::fboss::RouteNextHopEntry(
+            ribNextHopEntry.getInternedNextHopSet(),
+            ribNextHopEntry.getAdminDistance());
+      }
       facebook::fboss::RouteNextHopEntry::NextHopSet fibNextHopSet;
       for (const auto& ribNextHop : ribNextHopEntry.getNextHopSet()) {
         fibNextHopSet.insert(facebook::fboss::ResolvedNextHop(
@@ -9,6 +9,8 @@
  */
 #include "fboss/agent/state/InterfaceMap.h"
 #include <folly/Conv.h>
+#include <folly/hash/Hash.h>
+#include <algorithm>
 #include <string>
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/NodeMap-defs.h"
@@ -22,9 +24,53 @@ InterfaceMap::InterfaceMap() {}
 
 InterfaceMap::~InterfaceMap() {}
 
+size_t InterfaceMap::LookupIndex::AddrHash::operator()(
+    const AddrKey& key) const {
+  return folly::hash::hash_combine(
+      static_cast<uint32_t>(key.first), key.second.hash());
+}
+
+size_t InterfaceMap::LookupIndex::SubnetHash::operator()(
+    const SubnetKey& key) const {
+  return folly::hash::hash_combine(key.first.hash(), key.second);
+}
+
+std::unique_ptr<InterfaceMap::LookupIndex> InterfaceMap::buildLookupIndex(
+    const InterfaceMap& intfs) {
+  auto index = std::make_unique<LookupIndex>();
+  size_t rank = 0;
+  for (const auto& intf : intfs) {
+    // emplace() keeps the first interface found, as the linear scans do
+    index->vlanToIntf.emplace(intf->getVlanID(), intf);
+    auto& routerSubnets = index->routerSubnets[intf->getRouterID()];
+    for (const auto& [addr, mask] : intf->getAddresses()) {
+      if (addr.isIPv4Mapped()) {
+        index->hasV4MappedAddrs = true;
+      }
+      index->addrToIntf.emplace(
+          std::make_pair(intf->getRouterID(), addr), intf);
+      auto& masks =
+          addr.isV4() ? routerSubnets.v4Masks : routerSubnets.v6Masks;
+      if (std::find(masks.begin(), masks.end(), mask) == masks.end()) {
+        masks.push_back(mask);
+      }
+      routerSubnets.subnets.emplace(
+          std::make_pair(addr.mask(mask), mask),
+          LookupIndex::SubnetEntry{
+              rank++, IntfAddrToReach(intf.get(), &addr, mask)});
+    }
+  }
+  return index;
+}
+
 std::shared_ptr<Interface> InterfaceMap::getInterfaceIf(
     RouterID router,
     const IPAddress& ip) const {
+  auto index = getLookupIndex();
+  if (index && !index->hasV4MappedAddrs && !ip.isIPv4Mapped()) {
+    auto itr = index->addrToIntf.find(std::make_pair(router, ip));
+    return itr == index->addrToIntf.end() ? nullptr : itr->second;
+  }
   for (auto itr = begin(); itr != end(); ++itr) {
     if ((*itr)->getRouterID() == router && (*itr)->hasAddress(ip)) {
       return *itr;
@@ -36,6 +82,14 @@ std::shared_ptr<Interface> InterfaceMap::getInterfaceIf(
 const std::shared_ptr<Interface>& InterfaceMap::getInterface(
     RouterID router,
     const IPAddress& ip) const {
+  auto index = getLookupIndex();
+  if (index && !index->hasV4MappedAddrs && !ip.isIPv4Mapped()) {
+    auto itr = index->addrToIntf.find(std::make_pair(router, ip));
+    if (itr != index->addrToIntf.end()) {
+      return itr->second;
+    }
+    throw FbossError("No interface with ip : ", ip);
+  }
   for (auto itr = begin(); itr != end(); ++itr) {
     if ((*itr)->getRouterID() == router && (*itr)->hasAddress(ip)) {
       return *itr;
@@ -46,6 +100,10 @@ const std::shared_ptr<Interface>& InterfaceMap::getInterface(
 
 std::shared_ptr<Interface> InterfaceMap::getInterfaceInVlanIf(
     VlanID vlan) const {
+  if (auto index = getLookupIndex()) {
+    auto itr = index->vlanToIntf.find(vlan);
+    return itr == index->vlanToIntf.end() ? nullptr : itr->second;
+  }
   for (auto itr = begin(); itr != end(); ++itr) {
     if ((*itr)->getVlanID() == vlan) {
       return *itr;
@@ -66,6 +124,29 @@ const std::shared_ptr<Interface> InterfaceMap::getInterfaceInVlan(
 InterfaceMap::IntfAddrToReach InterfaceMap::getIntfAddrToReach(
     RouterID router,
     const folly::IPAddress& dest) const {
+  auto index = getLookupIndex();
+  if (index && !index->hasV4MappedAddrs && !dest.isIPv4Mapped()) {
+    auto routerItr = index->routerSubnets.find(router);
+    if (routerItr == index->routerSubnets.end()) {
+      return IntfAddrToReach(nullptr, nullptr, 0);
+    }
+    const auto& routerSubnets = routerItr->second;
+    // The scan returns the first interface address whose subnet has dest,
+    // which is not necessarily the longest match. Look up every prefix
+    // length and keep the match earliest in scan order.
+    const LookupIndex::SubnetEntry* found = nullptr;
+    const auto& masks =
+        dest.isV4() ? routerSubnets.v4Masks : routerSubnets.v6Masks;
+    for (auto mask : masks) {
+      auto itr =
+          routerSubnets.subnets.find(std::make_pair(dest.mask(mask), mask));
+      if (itr != routerSubnets.subnets.end() &&
+          (!found || itr->second.rank < found->rank)) {
+        found = &itr->second;
+      }
+    }
+    return found ? found->intfAddr : IntfAddrToReach(nullptr, nullptr, 0);
+  }
   for (auto iter = begin(); iter != end(); iter++) {
     const auto& intf = *iter;
     if (intf->getRouterID() == router) {
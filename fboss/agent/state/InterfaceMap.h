@@ -9,7 +9,10 @@
  */
 #pragma once
 #include <folly/IPAddress.h>
+#include <folly/container/F14Map.h>
+#include <utility>
 #include <vector>
+#include "fboss/agent/state/LazyNodeIndex.h"
 #include "fboss/agent/state/NodeMap.h"
 #include "fboss/agent/types.h"
 namespace facebook::fboss {
@@ -116,9 +119,53 @@ class InterfaceMap : public NodeMapT<InterfaceMap, InterfaceMapTraits> {
   }
 
  private:
+  /*
+   * Lookup tables over all interfaces, built once per published InterfaceMap
+   * so per packet lookups do not scan every interface. Each table keeps what
+   * the linear scan would have found first.
+   */
+  struct LookupIndex {
+    using AddrKey = std::pair<RouterID, folly::IPAddress>;
+    using SubnetKey = std::pair<folly::IPAddress, uint8_t>;
+    struct AddrHash {
+      size_t operator()(const AddrKey& key) const;
+    };
+    struct SubnetHash {
+      size_t operator()(const SubnetKey& key) const;
+    };
+    struct SubnetEntry {
+      // Position of the interface address in the scan order
+      size_t rank;
+      IntfAddrToReach intfAddr;
+    };
+    struct RouterSubnets {
+      // Distinct prefix lengths of the interface subnets, per family
+      std::vector<uint8_t> v4Masks;
+      std::vector<uint8_t> v6Masks;
+      // (masked address, prefix length) -> interface address
+      folly::F14FastMap<SubnetKey, SubnetEntry, SubnetHash> subnets;
+    };
+
+    folly::F14FastMap<AddrKey, std::shared_ptr<Interface>, AddrHash>
+        addrToIntf;
+    folly::F14FastMap<VlanID, std::shared_ptr<Interface>> vlanToIntf;
+    folly::F14FastMap<RouterID, RouterSubnets> routerSubnets;
+    // IPv4-mapped IPv6 addresses match across families, lookups involving
+    // them use the linear scan
+    bool hasV4MappedAddrs{false};
+  };
+
+  static std::unique_ptr<LookupIndex> buildLookupIndex(
+      const InterfaceMap& intfs);
+  const LookupIndex* getLookupIndex() const {
+    return lookupIndex_.get(*this, buildLookupIndex);
+  }
+
   // Inherit the constructors required for clone()
   using NodeMapT::NodeMapT;
   friend class CloneAllocator;
+
+  LazyNodeIndex<LookupIndex> lookupIndex_;
 };
 
 } // namespace facebook::fboss
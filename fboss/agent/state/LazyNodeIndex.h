@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/state/NodeBase.h"
+
+#include <folly/synchronization/CallOnce.h>
+
+#include <memory>
+
+namespace facebook::fboss {
+
+/*
+ * Lookup index derived from the contents of a published node.
+ *
+ * Published nodes never change, so an index over their contents (e.g.
+ * address -> interface for the InterfaceMap) stays valid for the lifetime of
+ * the node.  LazyNodeIndex builds it the first time a reader asks for it and
+ * shares it with all later readers, from any thread.  A new generation of the
+ * node (from clone()) starts out without an index and builds its own on
+ * first use, so state updates that never look things up pay nothing.
+ *
+ * Unpublished nodes may still change, so get() returns null for them and
+ * callers fall back to looking things up on the node itself.
+ *
+ * Usage, in a node class:
+ *
+ *   struct Index { ... };
+ *   static std::unique_ptr<Index> buildIndex(const MyNode& node);
+ *   LazyNodeIndex<Index> index_;
+ *
+ *   const Index* index = index_.get(*this, buildIndex);
+ */
+template <typename IndexT>
+class LazyNodeIndex {
+ public:
+  LazyNodeIndex() = default;
+  // A copy is of a different node, it builds its own index
+  LazyNodeIndex(const LazyNodeIndex& /*other*/) {}
+  LazyNodeIndex& operator=(const LazyNodeIndex& /*other*/) = delete;
+
+  template <typename NodeT, typename BuildFn>
+  const IndexT* get(const NodeT& node, BuildFn&& build) const {
+    if (!node.isPublished()) {
+      return nullptr;
+    }
+    folly::call_once(built_, [&]() { index_ = build(node); });
+    return index_.get();
+  }
+
+ private:
+  mutable folly::once_flag built_;
+  mutable std::unique_ptr<const IndexT> index_;
+};
+
+} // namespace facebook::fboss
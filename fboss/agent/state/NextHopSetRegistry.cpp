@@ -0,0 +1,228 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/NextHopSetRegistry.h"
+
+#include "fboss/agent/state/RouteNextHopEntry.h"
+
+#include <folly/hash/Hash.h>
+#include <folly/logging/xlog.h>
+
+#include <numeric>
+
+namespace facebook::fboss {
+
+size_t hashNextHop(const NextHop& nextHop) {
+  size_t hash = folly::hash::hash_combine(
+      nextHop.addr().hash(),
+      nextHop.intfID() ? static_cast<uint32_t>(*nextHop.intfID()) : 0,
+      nextHop.weight());
+  auto action = nextHop.labelForwardingAction();
+  if (action) {
+    hash = folly::hash::hash_combine(
+        hash, static_cast<int>(action->type()), action->swapWith().value_or(0));
+    if (action->pushStack()) {
+      for (auto label : *action->pushStack()) {
+        hash = folly::hash::hash_combine(hash, label);
+      }
+    }
+  }
+  return hash;
+}
+
+namespace {
+
+size_t hashNextHopSet(const InternedNextHopSet::NextHopSet& nextHops) {
+  size_t hash = nextHops.size();
+  for (const auto& nextHop : nextHops) {
+    hash = folly::hash::hash_combine(hash, hashNextHop(nextHop));
+  }
+  return hash;
+}
+
+} // namespace
+
+InternedNextHopSet::InternedNextHopSet(
+    NextHopSet nextHops,
+    size_t hash,
+    uint64_t id)
+    : nextHops_(std::move(nextHops)),
+      hash_(hash),
+      id_(id),
+      totalWeight_(fboss::totalWeight(nextHops_)) {}
+
+InternedNextHopSetPtr InternedNextHopSet::normalized(
+    NextHopWeight ecmpWidth) const {
+  {
+    std::lock_guard<std::mutex> g(normalizedLock_);
+    auto itr = normalized_.find(ecmpWidth);
+    if (itr != normalized_.end()) {
+      return itr->second ? itr->second : shared_from_this();
+    }
+  }
+  // Normalize outside of the lock, interning may free other sets
+  auto normalized = internNextHopSet(normalizeNextHops(nextHops_, ecmpWidth));
+  std::lock_guard<std::mutex> g(normalizedLock_);
+  // Another thread may have raced us, both got the same interned set
+  normalized_.emplace(
+      ecmpWidth, normalized.get() == this ? nullptr : normalized);
+  return normalized;
+}
+
+size_t InternedNextHopSet::memoryUsage() const {
+  return sizeof(*this) + nextHops_.capacity() * sizeof(NextHop);
+}
+
+NextHopSetRegistry::NextHopSetRegistry() {
+  emptySet_ = intern(NextHopSet());
+}
+
+NextHopSetRegistry* NextHopSetRegistry::get() {
+  // Never destroyed, sets may outlive static destruction of the registry
+  static auto* registry = new NextHopSetRegistry();
+  return registry;
+}
+
+InternedNextHopSetPtr NextHopSetRegistry::intern(NextHopSet nextHops) {
+  auto hash = hashNextHopSet(nextHops);
+  std::lock_guard<std::mutex> g(lock_);
+  auto range = sets_.equal_range(hash);
+  for (auto itr = range.first; itr != range.second; ++itr) {
+    if (itr->second->nextHops() == nextHops) {
+      // Null if the last reference just went away and the set is waiting
+      // for us to release the lock to remove itself
+      auto interned = itr->second->weak_from_this().lock();
+      if (interned) {
+        return interned;
+      }
+    }
+  }
+  auto* interned =
+      new InternedNextHopSet(std::move(nextHops), hash, nextId_++);
+  sets_.emplace(hash, interned);
+  memoryUsage_ += interned->memoryUsage();
+  return InternedNextHopSetPtr(
+      interned, [this](InternedNextHopSet* nhops) { release(nhops); });
+}
+
+void NextHopSetRegistry::release(InternedNextHopSet* nextHops) {
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    auto range = sets_.equal_range(nextHops->hash());
+    for (auto itr = range.first; itr != range.second; ++itr) {
+      if (itr->second == nextHops) {
+        sets_.erase(itr);
+        break;
+      }
+    }
+    memoryUsage_ -= nextHops->memoryUsage();
+  }
+  // Outside of the lock, this may release the normalized set too
+  delete nextHops;
+}
+
+size_t NextHopSetRegistry::size() const {
+  std::lock_guard<std::mutex> g(lock_);
+  return sets_.size();
+}
+
+size_t NextHopSetRegistry::memoryUsage() const {
+  std::lock_guard<std::mutex> g(lock_);
+  return memoryUsage_;
+}
+
+InternedNextHopSet::NextHopSet normalizeNextHops(
+    const InternedNextHopSet::NextHopSet& nextHops,
+    NextHopWeight ecmpWidth) {
+  using NextHopSet = InternedNextHopSet::NextHopSet;
+  NextHopSet normalizedNextHops;
+  // 1)
+  for (const auto& nhop : nextHops) {
+    normalizedNextHops.insert(ResolvedNextHop(
+        nhop.addr(),
+        nhop.intf(),
+        std::max(nhop.weight(), NextHopWeight(1)),
+        nhop.labelForwardingAction()));
+  }
+  // 2)
+  // Calculate the totalWeight. If that exceeds the max ecmp width, we use the
+  // following heuristic algorithm:
+  // 2a) Calculate the scaled factor ecmpWidth/totalWeight.
+  //     Without rounding, multiplying each weight by this will still yield
+  //     correct weight ratios between the next hops.
+  // 2b) Scale each next hop by the scaling factor, rounding down by default
+  //     except for when weights go below 1. In that case, add them in as
+  //     weight 1. At this point, we might _still_ be above ecmpWidth,
+  //     because we could have rounded too many 0s up to 1.
+  // 2c) Do a final pass where we make up any remaining excess weight above
+  //     ecmpWidth by iteratively decrementing the max weight. If there
+  //     are more than ecmpWidth next hops, this cannot possibly succeed.
+  NextHopWeight totalWeight = std::accumulate(
+      normalizedNextHops.begin(),
+      normalizedNextHops.end(),
+      0,
+      [](NextHopWeight w, const NextHop& nh) { return w + nh.weight(); });
+  // Total weight after applying the scaling factor
+  // ecmpWidth/totalWeight to all next hops.
+  NextHopWeight scaledTotalWeight = 0;
+  if (totalWeight > ecmpWidth) {
+    XLOG(DBG2) << "Total weight of next hops exceeds max ecmp width: "
+               << totalWeight << " > " << ecmpWidth << " ("
+               << normalizedNextHops << ")";
+    // 2a)
+    double factor = ecmpWidth / static_cast<double>(totalWeight);
+    NextHopSet scaledNextHops;
+    // 2b)
+    for (const auto& nhop : normalizedNextHops) {
+      NextHopWeight w = std::max(
+          static_cast<NextHopWeight>(nhop.weight() * factor), NextHopWeight(1));
+      scaledNextHops.insert(ResolvedNextHop(
+          nhop.addr(), nhop.intf(), w, nhop.labelForwardingAction()));
+      scaledTotalWeight += w;
+    }
+    // 2c)
+    if (scaledTotalWeight > ecmpWidth) {
+      XLOG(WARNING) << "Total weight of scaled next hops STILL exceeds max "
+                    << "ecmp width: " << scaledTotalWeight << " > "
+                    << ecmpWidth << " (" << scaledNextHops << ")";
+      // calculate number of times we need to decrement the max next hop
+      NextHopWeight overflow = scaledTotalWeight - ecmpWidth;
+      for (int i = 0; i < overflow; ++i) {
+        // find the max weight next hop
+        auto maxItr = std::max_element(
+            scaledNextHops.begin(),
+            scaledNextHops.end(),
+            [](const NextHop& n1, const NextHop& n2) {
+              return n1.weight() < n2.weight();
+            });
+        XLOG(DBG2) << "Decrementing the weight of next hop: " << *maxItr;
+        // create a clone of the max weight next hop with weight decremented
+        ResolvedNextHop decMax = ResolvedNextHop(
+            maxItr->addr(),
+            maxItr->intf(),
+            maxItr->weight() - 1,
+            maxItr->labelForwardingAction());
+        // remove the max weight next hop and replace with the
+        // decremented version, if the decremented version would
+        // not have weight 0. If it would have weight 0, that means
+        // that we have > ecmpWidth next hops.
+        scaledNextHops.erase(maxItr);
+        if (decMax.weight() > 0) {
+          scaledNextHops.insert(decMax);
+        }
+      }
+    }
+    XLOG(DBG2) << "Scaled next hops from " << nextHops << " to "
+               << scaledNextHops;
+    normalizedNextHops = scaledNextHops;
+  }
+  return normalizedNextHops;
+}
+
+} // namespace facebook::fboss
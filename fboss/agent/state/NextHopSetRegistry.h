@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+
+#include "fboss/agent/state/RouteNextHop.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace facebook::fboss {
+
+class NextHopSetRegistry;
+
+/*
+ * An immutable next hop set shared by every holder of the same set.
+ *
+ * Routes in the RIB and the FIB, and the ECMP groups programmed for them in
+ * hardware, all refer to next hop sets.  A large table has many routes but
+ * few distinct next hop sets, so the sets are interned in the
+ * NextHopSetRegistry: there is at most one InternedNextHopSet for a given
+ * set of next hops, and two sets are equal iff they are the same object.
+ * Comparing and hashing interned sets is therefore O(1).
+ *
+ * A set is freed (and removed from the registry) when its last reference
+ * goes away.  Its id() is unique among all sets interned during the life of
+ * the process.
+ */
+class InternedNextHopSet
+    : public std::enable_shared_from_this<InternedNextHopSet> {
+ public:
+  using NextHopSet = boost::container::flat_set<NextHop>;
+
+  const NextHopSet& nextHops() const {
+    return nextHops_;
+  }
+  uint64_t id() const {
+    return id_;
+  }
+  size_t hash() const {
+    return hash_;
+  }
+  // Sum of the weights of all the next hops in the set
+  NextHopWeight totalWeight() const {
+    return totalWeight_;
+  }
+  size_t size() const {
+    return nextHops_.size();
+  }
+  bool empty() const {
+    return nextHops_.empty();
+  }
+
+  /*
+   * The set with weights normalized for an ECMP group of at most ecmpWidth
+   * members, see normalizeNextHops().  The result is computed once per
+   * width and kept for the lifetime of this set.
+   */
+  std::shared_ptr<const InternedNextHopSet> normalized(
+      NextHopWeight ecmpWidth) const;
+
+  // Bytes used by this set, including its next hops
+  size_t memoryUsage() const;
+
+ private:
+  friend class NextHopSetRegistry;
+
+  InternedNextHopSet(NextHopSet nextHops, size_t hash, uint64_t id);
+
+  const NextHopSet nextHops_;
+  const size_t hash_;
+  const uint64_t id_;
+  const NextHopWeight totalWeight_;
+
+  mutable std::mutex normalizedLock_;
+  // Normalized sets by ECMP width, never replaced so that references into
+  // them stay valid as long as this set is. Null if the set is already
+  // normalized for that width, holding a pointer to ourselves would keep us
+  // alive forever
+  mutable boost::container::
+      flat_map<NextHopWeight, std::shared_ptr<const InternedNextHopSet>>
+          normalized_;
+};
+
+using InternedNextHopSetPtr = std::shared_ptr<const InternedNextHopSet>;
+
+/*
+ * Hash consing table for next hop sets.  Thread safe.
+ */
+class NextHopSetRegistry {
+ public:
+  using NextHopSet = InternedNextHopSet::NextHopSet;
+
+  static NextHopSetRegistry* get();
+
+  /*
+   * Return the interned set equal to nextHops, interning it if no one
+   * holds such a set yet.
+   */
+  InternedNextHopSetPtr intern(NextHopSet nextHops);
+
+  const InternedNextHopSetPtr& emptySet() const {
+    return emptySet_;
+  }
+
+  // Number of distinct sets currently interned
+  size_t size() const;
+
+  // Bytes used by all the interned sets
+  size_t memoryUsage() const;
+
+ private:
+  NextHopSetRegistry();
+  // Not copyable
+  NextHopSetRegistry(const NextHopSetRegistry&) = delete;
+  NextHopSetRegistry& operator=(const NextHopSetRegistry&) = delete;
+
+  void release(InternedNextHopSet* nextHops);
+
+  mutable std::mutex lock_;
+  // Sets by their hash
+  std::unordered_multimap<size_t, InternedNextHopSet*> sets_;
+  uint64_t nextId_{1};
+  size_t memoryUsage_{0};
+  InternedNextHopSetPtr emptySet_;
+};
+
+inline InternedNextHopSetPtr internNextHopSet(
+    InternedNextHopSet::NextHopSet nextHops) {
+  return NextHopSetRegistry::get()->intern(std::move(nextHops));
+}
+
+/*
+ * Normalize the weights of a set of next hops for an ECMP group of at most
+ * ecmpWidth members:
+ * 1) ECMP next hops (weight 0) get weight 1.
+ * 2) If the total weight exceeds ecmpWidth, scale the weights down.
+ */
+InternedNextHopSet::NextHopSet normalizeNextHops(
+    const InternedNextHopSet::NextHopSet& nextHops,
+    NextHopWeight ecmpWidth);
+
+size_t hashNextHop(const NextHop& nextHop);
+
+} // namespace facebook::fboss
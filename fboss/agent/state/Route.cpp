@@ -53,9 +53,9 @@ folly::dynamic RouteFields<AddrT>::toFollyDynamic() const {
   routeFields[kPrefix] = prefix.toFollyDynamic();
   routeFields[kNextHopsMulti] = nexthopsmulti.toFollyDynamic();
   routeFields[kFwdInfo] = fwd.toFollyDynamic();
-  routeFields[kFlags] = flags;
-  if (classID.has_value()) {
-    routeFields[kClassID] = static_cast<int>(classID.value());
+  routeFields[kFlags] = static_cast<uint32_t>(flags);
+  if (auto classID = getClassID()) {
+    routeFields[kClassID] = static_cast<int>(*classID);
   }
 
   return routeFields;
@@ -70,7 +70,7 @@ RouteFields<AddrT> RouteFields<AddrT>::fromFollyDynamic(
   rt.fwd = RouteNextHopEntry::fromFollyDynamic(routeJson[kFwdInfo]);
   rt.flags = routeJson[kFlags].asInt();
   if (routeJson.find(kClassID) != routeJson.items().end()) {
-    rt.classID = cfg::AclLookupClass(routeJson[kClassID].asInt());
+    rt.setClassID(cfg::AclLookupClass(routeJson[kClassID].asInt()));
   }
   return rt;
 }
@@ -132,6 +132,7 @@ std::string RouteFields<AddrT>::str() const {
   ret.append(", => ");
   ret.append(fwd.str());
 
+  auto classID = getClassID();
   auto classIDStr = classID.has_value()
       ? folly::to<std::string>(static_cast<int>(classID.value()))
       : "None";
@@ -68,10 +68,13 @@ struct RouteFields {
     return nexthopsmulti.getBestEntry();
   }
   std::optional<cfg::AclLookupClass> getClassID() const {
-    return classID;
+    if (classID_ == kNoClassID) {
+      return std::nullopt;
+    }
+    return static_cast<cfg::AclLookupClass>(classID_);
   }
   void setClassID(std::optional<cfg::AclLookupClass> c) {
-    classID = c;
+    classID_ = c ? static_cast<int16_t>(*c) : kNoClassID;
   }
   void delEntryForClient(ClientID clientId);
   const RouteNextHopEntry* FOLLY_NULLABLE
@@ -100,7 +103,7 @@ struct RouteFields {
    *             This bit is cleared when setting this route as RESOLVED or
    *             UNRESOLVABLE.
    */
-  enum : uint32_t {
+  enum : uint8_t {
     CONNECTED = 0x1,
     RESOLVED = 0x2,
     UNRESOLVABLE = 0x4,
@@ -129,7 +132,7 @@ struct RouteFields {
   std::string str() const;
   void update(ClientID clientId, RouteNextHopEntry entry);
   void updateClassID(std::optional<cfg::AclLookupClass> c) {
-    classID = c;
+    setClassID(c);
   }
   bool has(ClientID clientId, const RouteNextHopEntry& entry) const;
 
@@ -184,8 +187,13 @@ struct RouteFields {
   RouteNextHopEntry fwd{
       RouteNextHopEntry::Action::DROP,
       AdminDistance::MAX_ADMIN_DISTANCE};
-  uint32_t flags{0};
-  std::optional<cfg::AclLookupClass> classID{std::nullopt};
+  uint8_t flags{0};
+
+ private:
+  static constexpr int16_t kNoClassID = -1;
+  // cfg::AclLookupClass, or kNoClassID. Packed next to the flags rather than
+  // a std::optional, which would add 8 bytes to every route
+  int16_t classID_{kNoClassID};
 };
 
 /// Route<> Class
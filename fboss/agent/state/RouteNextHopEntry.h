@@ -13,6 +13,7 @@
 
 #include <folly/dynamic.h>
 
+#include "fboss/agent/state/NextHopSetRegistry.h"
 #include "fboss/agent/state/RouteNextHop.h"
 #include "fboss/agent/state/RouteTypes.h"
 
@@ -23,19 +24,21 @@ namespace facebook::fboss {
 class RouteNextHopEntry {
  public:
   using Action = RouteForwardAction;
-  using NextHopSet = boost::container::flat_set<NextHop>;
+  using NextHopSet = InternedNextHopSet::NextHopSet;
 
   RouteNextHopEntry(Action action, AdminDistance distance)
-      : adminDistance_(distance), action_(action) {
+      : adminDistance_(distance),
+        action_(action),
+        nhopSet_(NextHopSetRegistry::get()->emptySet()) {
     CHECK_NE(action_, Action::NEXTHOPS);
   }
 
   RouteNextHopEntry(NextHopSet nhopSet, AdminDistance distance);
 
+  RouteNextHopEntry(InternedNextHopSetPtr nhopSet, AdminDistance distance);
+
   RouteNextHopEntry(NextHop nhop, AdminDistance distance)
-      : adminDistance_(distance), action_(Action::NEXTHOPS) {
-    nhopSet_.emplace(std::move(nhop));
-  }
+      : RouteNextHopEntry(NextHopSet{std::move(nhop)}, distance) {}
 
   AdminDistance getAdminDistance() const {
     return adminDistance_;
@@ -46,10 +49,22 @@ class RouteNextHopEntry {
   }
 
   const NextHopSet& getNextHopSet() const {
+    return nhopSet_->nextHops();
+  }
+
+  /*
+   * The next hop set shared with all other entries with the same next hops.
+   * Two entries have the same next hops iff these are the same object.
+   */
+  const InternedNextHopSetPtr& getInternedNextHopSet() const {
     return nhopSet_;
   }
 
-  NextHopSet normalizedNextHops() const;
+  // Next hops with weights normalized for FLAGS_ecmp_width, valid for the
+  // lifetime of this entry
+  const NextHopSet& normalizedNextHops() const;
+
+  InternedNextHopSetPtr normalizedInternedNextHops() const;
 
   // Get the sum of the weights of all the nexthops in the entry
   NextHopWeight getTotalWeight() const;
@@ -79,7 +94,7 @@ class RouteNextHopEntry {
 
   // Reset the NextHopSet
   void reset() {
-    nhopSet_.clear();
+    nhopSet_ = NextHopSetRegistry::get()->emptySet();
     action_ = Action::DROP;
   }
 
@@ -98,7 +113,7 @@ class RouteNextHopEntry {
  private:
   AdminDistance adminDistance_;
   Action action_{Action::DROP};
-  NextHopSet nhopSet_;
+  InternedNextHopSetPtr nhopSet_;
 };
 
 /**
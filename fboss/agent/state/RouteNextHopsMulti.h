@@ -12,6 +12,8 @@
 #include <folly/FBString.h>
 #include <folly/IPAddress.h>
 #include <folly/dynamic.h>
+#include <folly/small_vector.h>
+#include <folly/sorted_vector_types.h>
 
 #include <boost/container/flat_map.hpp>
 
@@ -44,8 +46,19 @@ namespace facebook::fboss {
  */
 class RouteNextHopsMulti {
  protected:
+  using ClientEntry = std::pair<ClientID, RouteNextHopEntry>;
+  // Nearly all routes come from a single client, keep one entry inline
+  // rather than in a separate allocation for every route
+  using ClientEntries = folly::sorted_vector_map<
+      ClientID,
+      RouteNextHopEntry,
+      std::less<ClientID>,
+      std::allocator<ClientEntry>,
+      void,
+      folly::small_vector<ClientEntry, 1>>;
+
   ClientID findLowestAdminDistance();
-  boost::container::flat_map<ClientID, RouteNextHopEntry> map_;
+  ClientEntries map_;
   ClientID lowestAdminDistanceClientId_;
 
  public:
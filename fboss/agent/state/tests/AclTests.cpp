@@ -14,13 +14,17 @@
 #include "fboss/agent/state/AclEntry.h"
 #include "fboss/agent/state/AclMap.h"
 #include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Conv.h>
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace facebook::fboss;
 using folly::MacAddress;
 using std::make_pair;
@@ -30,6 +34,44 @@ using std::shared_ptr;
 namespace {
 // We offset the start point in ApplyThriftConfig
 constexpr auto kAclStartPriority = 100000;
+// ApplyThriftConfig leaves gaps between ACL priorities, and room above the
+// first ACL of a new layout
+constexpr auto kAclPriorityGap = 16;
+constexpr auto kAclFirstPriority =
+    kAclStartPriority + 256 * kAclPriorityGap + kAclPriorityGap;
+
+cfg::AclEntry makeDenyAcl(const std::string& name, int idx) {
+  cfg::AclEntry acl;
+  *acl.name_ref() = name;
+  *acl.actionType_ref() = cfg::AclActionType::DENY;
+  acl.srcIp_ref() = folly::to<std::string>(
+      "10.", idx / 256 % 256, ".", idx % 256, ".1");
+  return acl;
+}
+
+// ACL entries added, removed or changed, each of which is a hardware write
+size_t numAclWrites(
+    const std::shared_ptr<SwitchState>& oldState,
+    const std::shared_ptr<SwitchState>& newState) {
+  StateDelta delta(oldState, newState);
+  auto aclsDelta = delta.getAclsDelta();
+  size_t writes = 0;
+  for (auto iter = aclsDelta.begin(); iter != aclsDelta.end(); ++iter) {
+    ++writes;
+  }
+  return writes;
+}
+
+void checkPrioritiesIncreasing(
+    const std::shared_ptr<SwitchState>& state,
+    const cfg::SwitchConfig& config) {
+  int lastPriority = kAclStartPriority;
+  for (const auto& acl : *config.acls_ref()) {
+    auto priority = state->getAcl(*acl.name_ref())->getPriority();
+    EXPECT_GT(priority, lastPriority);
+    lastPriority = priority;
+  }
+}
 } // namespace
 
 TEST(Acl, applyConfig) {
@@ -66,7 +108,7 @@ TEST(Acl, applyConfig) {
   ASSERT_NE(nullptr, aclV1);
   EXPECT_NE(aclV0, aclV1);
 
-  EXPECT_EQ(0 + kAclStartPriority, aclV1->getPriority());
+  EXPECT_EQ(kAclFirstPriority, aclV1->getPriority());
   EXPECT_EQ(cfg::AclActionType::DENY, aclV1->getActionType());
   EXPECT_EQ(5, aclV1->getSrcPort());
   EXPECT_EQ(8, aclV1->getDstPort());
@@ -133,7 +175,7 @@ TEST(Acl, applyConfig) {
   auto aclV3 = stateV3->getAcl("acl3");
   ASSERT_NE(nullptr, aclV3);
   EXPECT_NE(aclV0, aclV3);
-  EXPECT_EQ(0 + kAclStartPriority, aclV3->getPriority());
+  EXPECT_EQ(kAclFirstPriority, aclV3->getPriority());
   EXPECT_EQ(cfg::AclActionType::PERMIT, aclV3->getActionType());
   EXPECT_FALSE(!aclV3->getL4SrcPort());
   EXPECT_EQ(aclV3->getL4SrcPort().value(), 1);
@@ -265,6 +307,78 @@ TEST(Acl, stateDelta) {
   EXPECT_EQ(iter, aclDelta45.end());
 }
 
+TEST(Acl, sparsePriorities) {
+  auto platform = createMockPlatform();
+  cfg::SwitchConfig config;
+  for (int i = 0; i < 2000; ++i) {
+    config.acls_ref()->push_back(
+        makeDenyAcl(folly::to<std::string>("acl", i), i));
+  }
+  auto state = publishAndApplyConfig(
+      make_shared<SwitchState>(), &config, platform.get());
+  ASSERT_NE(nullptr, state);
+  checkPrioritiesIncreasing(state, config);
+
+  // Inserting at the top or in the middle of the policy only adds the new
+  // entry, the priorities of the others stay the same
+  for (int i = 0; i < 20; ++i) {
+    auto& acls = *config.acls_ref();
+    auto pos = i % 2 ? acls.begin() + 100 * i : acls.begin();
+    acls.insert(
+        pos, makeDenyAcl(folly::to<std::string>("new", i), 2000 + i));
+    auto newState = publishAndApplyConfig(state, &config, platform.get());
+    ASSERT_NE(nullptr, newState);
+    EXPECT_EQ(1, numAclWrites(state, newState));
+    checkPrioritiesIncreasing(newState, config);
+    state = newState;
+  }
+
+  // Moving an entry reprograms just that entry
+  auto& acls = *config.acls_ref();
+  std::rotate(acls.begin() + 10, acls.begin() + 11, acls.begin() + 500);
+  auto newState = publishAndApplyConfig(state, &config, platform.get());
+  ASSERT_NE(nullptr, newState);
+  EXPECT_EQ(1, numAclWrites(state, newState));
+  checkPrioritiesIncreasing(newState, config);
+  state = newState;
+
+  // Once the room between two entries is used up, a few neighbors get new
+  // priorities, not the whole policy
+  size_t totalWrites = 0;
+  for (int i = 0; i < 100; ++i) {
+    acls.insert(
+        acls.begin() + 1000,
+        makeDenyAcl(folly::to<std::string>("dense", i), 3000 + i));
+    newState = publishAndApplyConfig(state, &config, platform.get());
+    ASSERT_NE(nullptr, newState);
+    checkPrioritiesIncreasing(newState, config);
+    totalWrites += numAclWrites(state, newState);
+    state = newState;
+  }
+  EXPECT_LT(totalWrites, 100 * 20);
+}
+
+TEST(Acl, insertBetweenAdjacentPriorities) {
+  auto platform = createMockPlatform();
+  // A, B and C have adjacent priorities, e.g. from a dense layout
+  auto stateV0 = make_shared<SwitchState>();
+  stateV0->addAcl(make_shared<AclEntry>(kAclStartPriority + 1, "A"));
+  stateV0->addAcl(make_shared<AclEntry>(kAclStartPriority + 2, "B"));
+  stateV0->addAcl(make_shared<AclEntry>(kAclStartPriority + 3, "C"));
+
+  // New ACLs in both gaps, so the window widened around the first one ends
+  // on the second one
+  cfg::SwitchConfig config;
+  config.acls_ref()->push_back(makeDenyAcl("A", 0));
+  config.acls_ref()->push_back(makeDenyAcl("AB", 1));
+  config.acls_ref()->push_back(makeDenyAcl("B", 2));
+  config.acls_ref()->push_back(makeDenyAcl("BC", 3));
+  config.acls_ref()->push_back(makeDenyAcl("C", 4));
+  auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+  checkPrioritiesIncreasing(stateV1, config);
+}
+
 TEST(Acl, Icmp) {
   auto platform = createMockPlatform();
   auto stateV0 = make_shared<SwitchState>();
@@ -281,7 +395,7 @@ TEST(Acl, Icmp) {
   EXPECT_NE(nullptr, stateV1);
   auto aclV1 = stateV1->getAcl("acl1");
   ASSERT_NE(nullptr, aclV1);
-  EXPECT_EQ(0 + kAclStartPriority, aclV1->getPriority());
+  EXPECT_EQ(kAclFirstPriority, aclV1->getPriority());
   EXPECT_EQ(cfg::AclActionType::DENY, aclV1->getActionType());
   EXPECT_EQ(128, aclV1->getIcmpType().value());
   EXPECT_EQ(0, aclV1->getIcmpCode().value());
@@ -396,11 +510,19 @@ TEST(Acl, AclGeneration) {
   EXPECT_NE(acls->getEntryIf("acl3"), nullptr);
   EXPECT_NE(acls->getEntryIf("acl5"), nullptr);
 
-  EXPECT_EQ(acls->getEntryIf("acl1")->getPriority(), kAclStartPriority);
-  EXPECT_EQ(acls->getEntryIf("acl4")->getPriority(), kAclStartPriority + 1);
-  EXPECT_EQ(acls->getEntryIf("acl2")->getPriority(), kAclStartPriority + 2);
-  EXPECT_EQ(acls->getEntryIf("acl3")->getPriority(), kAclStartPriority + 3);
-  EXPECT_EQ(acls->getEntryIf("acl5")->getPriority(), kAclStartPriority + 4);
+  EXPECT_EQ(acls->getEntryIf("acl1")->getPriority(), kAclFirstPriority);
+  EXPECT_EQ(
+      acls->getEntryIf("acl4")->getPriority(),
+      kAclFirstPriority + kAclPriorityGap);
+  EXPECT_EQ(
+      acls->getEntryIf("acl2")->getPriority(),
+      kAclFirstPriority + 2 * kAclPriorityGap);
+  EXPECT_EQ(
+      acls->getEntryIf("acl3")->getPriority(),
+      kAclFirstPriority + 3 * kAclPriorityGap);
+  EXPECT_EQ(
+      acls->getEntryIf("acl5")->getPriority(),
+      kAclFirstPriority + 4 * kAclPriorityGap);
 
   // Ensure that the global actions in global traffic policy has been added to
   // the ACL entries
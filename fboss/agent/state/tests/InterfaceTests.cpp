@@ -19,8 +19,12 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Conv.h>
 #include <gtest/gtest.h>
 
+#include <optional>
+#include <tuple>
+
 using namespace facebook::fboss;
 using folly::IPAddress;
 using folly::MacAddress;
@@ -432,3 +436,86 @@ TEST(InterfaceMap, applyConfig) {
   EXPECT_EQ(4, intfsV4->getGeneration());
   EXPECT_EQ(1337, intfsV4->getInterface(InterfaceID(3))->getMtu());
 }
+
+TEST(InterfaceMap, publishedLookupIndex) {
+  auto intfs = make_shared<InterfaceMap>();
+  auto addIntf = [&](int id, int router, Interface::Addresses addrs) {
+    auto intf = make_shared<Interface>(
+        InterfaceID(id),
+        RouterID(router),
+        VlanID(id % 3 + 1),
+        folly::to<std::string>("intf", id),
+        MacAddress("00:02:00:11:22:33"),
+        9000,
+        false, /* is virtual */
+        false /* is state_sync disabled*/);
+    intf->setAddresses(std::move(addrs));
+    intfs->addInterface(intf);
+  };
+  // Overlapping subnets: the first interface in scan order wins, even over a
+  // longer prefix
+  addIntf(1, 0, {{IPAddress("10.0.0.1"), 8}, {IPAddress("2401::1"), 64}});
+  addIntf(2, 0, {{IPAddress("10.1.0.1"), 16}, {IPAddress("2401::2"), 120}});
+  addIntf(3, 0, {{IPAddress("20.0.0.1"), 24}});
+  addIntf(4, 1, {{IPAddress("10.1.0.1"), 16}, {IPAddress("30.0.0.1"), 31}});
+  addIntf(5, 1, {{IPAddress("30.0.0.1"), 24}});
+
+  std::vector<std::pair<RouterID, IPAddress>> lookups;
+  for (auto router : {RouterID(0), RouterID(1), RouterID(2)}) {
+    for (auto ip :
+         {"10.0.0.1",
+          "10.1.0.1",
+          "10.1.2.3",
+          "10.2.0.1",
+          "20.0.0.1",
+          "20.0.0.200",
+          "20.0.1.1",
+          "30.0.0.1",
+          "30.0.0.0",
+          "30.0.0.7",
+          "40.0.0.1",
+          "2401::1",
+          "2401::2",
+          "2401::ff",
+          "2401::1:0",
+          "2402::1"}) {
+      lookups.emplace_back(router, IPAddress(ip));
+    }
+  }
+  auto lookupAll = [&](const InterfaceMap& map) {
+    std::vector<std::tuple<
+        std::shared_ptr<Interface>,
+        const Interface*,
+        std::optional<IPAddress>,
+        uint8_t>>
+        results;
+    for (const auto& [router, ip] : lookups) {
+      auto reach = map.getIntfAddrToReach(router, ip);
+      results.emplace_back(
+          map.getInterfaceIf(router, ip),
+          reach.intf,
+          reach.addr ? std::make_optional(*reach.addr) : std::nullopt,
+          reach.mask);
+    }
+    return results;
+  };
+  auto scanned = lookupAll(*intfs);
+  intfs->publish();
+  EXPECT_EQ(scanned, lookupAll(*intfs));
+
+  EXPECT_EQ(
+      InterfaceID(4),
+      intfs->getIntfAddrToReach(RouterID(1), IPAddress("30.0.0.0"))
+          .intf->getID());
+  EXPECT_EQ(
+      InterfaceID(1),
+      intfs->getIntfAddrToReach(RouterID(0), IPAddress("10.1.2.3"))
+          .intf->getID());
+  EXPECT_EQ(
+      InterfaceID(1),
+      intfs->getInterface(RouterID(0), IPAddress("10.0.0.1"))->getID());
+  EXPECT_THROW(
+      intfs->getInterface(RouterID(1), IPAddress("10.0.0.1")), FbossError);
+  EXPECT_EQ(InterfaceID(3), intfs->getInterfaceInVlanIf(VlanID(1))->getID());
+  EXPECT_EQ(nullptr, intfs->getInterfaceInVlanIf(VlanID(4)));
+}
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/NextHopSetRegistry.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+
+namespace {
+
+RouteNextHopSet makeNextHops(
+    std::vector<std::string> addrs,
+    NextHopWeight weight = ECMP_WEIGHT) {
+  RouteNextHopSet nhops;
+  InterfaceID intf(1);
+  for (const auto& addr : addrs) {
+    nhops.emplace(ResolvedNextHop(IPAddress(addr), intf, weight));
+    intf = InterfaceID(intf + 1);
+  }
+  return nhops;
+}
+
+} // namespace
+
+TEST(NextHopSetRegistry, intern) {
+  auto registry = NextHopSetRegistry::get();
+  auto numSets = registry->size();
+  auto nhops1 = internNextHopSet(makeNextHops({"10.0.0.1", "10.0.0.2"}));
+  auto nhops2 = internNextHopSet(makeNextHops({"10.0.0.2", "10.0.0.1"}));
+  auto nhops3 = internNextHopSet(makeNextHops({"10.0.0.1", "10.0.0.3"}));
+  EXPECT_EQ(nhops1, nhops2);
+  EXPECT_EQ(nhops1->id(), nhops2->id());
+  EXPECT_NE(nhops1, nhops3);
+  EXPECT_NE(nhops1->id(), nhops3->id());
+  EXPECT_EQ(nhops1->nextHops(), makeNextHops({"10.0.0.1", "10.0.0.2"}));
+  EXPECT_EQ(registry->size(), numSets + 2);
+  EXPECT_GT(registry->memoryUsage(), 0);
+
+  // Sets are released with their last reference
+  auto id = nhops1->id();
+  nhops1.reset();
+  EXPECT_EQ(registry->size(), numSets + 2);
+  nhops2.reset();
+  EXPECT_EQ(registry->size(), numSets + 1);
+  // And get a new id when interned again
+  nhops1 = internNextHopSet(makeNextHops({"10.0.0.1", "10.0.0.2"}));
+  EXPECT_NE(nhops1->id(), id);
+}
+
+TEST(NextHopSetRegistry, normalized) {
+  auto nhops = internNextHopSet(makeNextHops({"10.0.0.1", "10.0.0.2"}));
+  // ECMP next hops get weight 1
+  auto normalized = nhops->normalized(64);
+  EXPECT_EQ(normalized->nextHops(), makeNextHops({"10.0.0.1", "10.0.0.2"}, 1));
+  EXPECT_EQ(normalized, nhops->normalized(64));
+  // Already normalized
+  EXPECT_EQ(normalized->normalized(64), normalized);
+
+  RouteNextHopSet ucmp;
+  ucmp.emplace(ResolvedNextHop(IPAddress("10.0.0.1"), InterfaceID(1), 60));
+  ucmp.emplace(ResolvedNextHop(IPAddress("10.0.0.2"), InterfaceID(2), 20));
+  auto ucmpNhops = internNextHopSet(ucmp);
+  EXPECT_EQ(ucmpNhops->totalWeight(), 80);
+  // Fits in the group as is
+  EXPECT_EQ(ucmpNhops->normalized(80), ucmpNhops);
+  EXPECT_EQ(ucmpNhops->normalized(128), ucmpNhops);
+  // Scaled down for narrower groups, and back
+  RouteNextHopSet ucmp64;
+  ucmp64.emplace(ResolvedNextHop(IPAddress("10.0.0.1"), InterfaceID(1), 48));
+  ucmp64.emplace(ResolvedNextHop(IPAddress("10.0.0.2"), InterfaceID(2), 16));
+  EXPECT_EQ(ucmpNhops->normalized(64), internNextHopSet(ucmp64));
+  RouteNextHopSet ucmp8;
+  ucmp8.emplace(ResolvedNextHop(IPAddress("10.0.0.1"), InterfaceID(1), 6));
+  ucmp8.emplace(ResolvedNextHop(IPAddress("10.0.0.2"), InterfaceID(2), 2));
+  auto scaled = ucmpNhops->normalized(8);
+  EXPECT_EQ(scaled, internNextHopSet(ucmp8));
+  EXPECT_EQ(scaled->totalWeight(), 8);
+  EXPECT_EQ(scaled, ucmpNhops->normalized(8));
+  EXPECT_EQ(ucmpNhops->normalized(128), ucmpNhops);
+}
+
+TEST(NextHopSetRegistry, normalizedKeptPerWidth) {
+  RouteNextHopSet ucmp;
+  ucmp.emplace(ResolvedNextHop(IPAddress("10.0.0.1"), InterfaceID(1), 60));
+  ucmp.emplace(ResolvedNextHop(IPAddress("10.0.0.2"), InterfaceID(2), 20));
+  RouteNextHopEntry entry(ucmp, AdminDistance::EBGP);
+  auto& nhops = entry.getInternedNextHopSet();
+  // Only the entry holds the normalized sets
+  std::weak_ptr<const InternedNextHopSet> scaled8 = nhops->normalized(8);
+  auto numSets = NextHopSetRegistry::get()->size();
+  // Normalizing for another width doesn't release the earlier result, which
+  // references handed out point into
+  std::weak_ptr<const InternedNextHopSet> scaled64 = nhops->normalized(64);
+  EXPECT_FALSE(scaled8.expired());
+  EXPECT_FALSE(scaled64.expired());
+  EXPECT_EQ(NextHopSetRegistry::get()->size(), numSets + 1);
+  EXPECT_EQ(nhops->normalized(8), scaled8.lock());
+  EXPECT_EQ(scaled8.lock()->totalWeight(), 8);
+}
+
+TEST(NextHopSetRegistry, sharedByRouteNextHopEntries) {
+  RouteNextHopEntry entry1(
+      makeNextHops({"10.0.0.1", "10.0.0.2"}), AdminDistance::EBGP);
+  RouteNextHopEntry entry2(
+      makeNextHops({"10.0.0.1", "10.0.0.2"}), AdminDistance::EBGP);
+  RouteNextHopEntry entry3(
+      makeNextHops({"10.0.0.1", "10.0.0.2"}), AdminDistance::STATIC_ROUTE);
+  EXPECT_EQ(entry1.getInternedNextHopSet(), entry2.getInternedNextHopSet());
+  EXPECT_EQ(entry1.getInternedNextHopSet(), entry3.getInternedNextHopSet());
+  EXPECT_EQ(entry1, entry2);
+  EXPECT_FALSE(entry1 == entry3);
+  EXPECT_FALSE(entry1 < entry2);
+  EXPECT_FALSE(entry2 < entry1);
+  EXPECT_EQ(
+      &entry1.normalizedNextHops(),
+      &entry2.normalizedInternedNextHops()->nextHops());
+
+  auto deserialized =
+      RouteNextHopEntry::fromFollyDynamic(entry1.toFollyDynamic());
+  EXPECT_EQ(
+      deserialized.getInternedNextHopSet(), entry1.getInternedNextHopSet());
+
+  auto drop = RouteNextHopEntry::createDrop();
+  EXPECT_TRUE(drop.getNextHopSet().empty());
+  EXPECT_EQ(
+      drop.getInternedNextHopSet(), NextHopSetRegistry::get()->emptySet());
+  entry1.reset();
+  EXPECT_EQ(entry1, RouteNextHopEntry::createDrop(AdminDistance::EBGP));
+}
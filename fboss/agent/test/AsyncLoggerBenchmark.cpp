@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AsyncLogger.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+
+#include <thread>
+#include <vector>
+
+DEFINE_int32(
+    async_logger_benchmark_records,
+    100000,
+    "Number of records each thread appends per benchmark iteration");
+DEFINE_int32(
+    async_logger_benchmark_record_size,
+    200,
+    "Size in bytes of each appended record, roughly one traced SAI call");
+
+namespace {
+
+constexpr auto kBenchmarkLog = "/tmp/async_logger_benchmark";
+
+void appendFromThreads(uint32_t iters, int numThreads) {
+  folly::BenchmarkSuspender suspender;
+  facebook::fboss::AsyncLogger logger(kBenchmarkLog, 100);
+  logger.startFlushThread();
+  std::string record(FLAGS_async_logger_benchmark_record_size, '.');
+  record.back() = '\n';
+  suspender.dismiss();
+
+  for (auto iter = 0; iter < iters; ++iter) {
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&]() {
+        for (auto i = 0; i < FLAGS_async_logger_benchmark_records; ++i) {
+          logger.appendLog(record.c_str(), record.size());
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  logger.forceFlush();
+
+  suspender.rehire();
+  auto stats = logger.getStats();
+  XLOG(DBG2) << numThreads << " threads: " << stats.bytesLogged
+             << " bytes logged, " << stats.buffersFlushed
+             << " buffers flushed in " << stats.writeCalls << " writes, "
+             << stats.backpressureWaits << " backpressure waits";
+  logger.stopFlushThread();
+  std::remove(kBenchmarkLog);
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(appendFromThreads, 1_thread, 1)
+BENCHMARK_NAMED_PARAM(appendFromThreads, 2_threads, 2)
+BENCHMARK_NAMED_PARAM(appendFromThreads, 4_threads, 4)
+BENCHMARK_NAMED_PARAM(appendFromThreads, 8_threads, 8)
+BENCHMARK_NAMED_PARAM(appendFromThreads, 16_threads, 16)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -11,8 +11,12 @@
 #include "fboss/agent/AsyncLogger.h"
 
 #include <folly/CPortability.h>
+#include <folly/Conv.h>
 #include <gtest/gtest.h>
 #include <stdio.h>
+#include <fstream>
+#include <thread>
+#include <vector>
 
 #define TEST_LOG "/tmp/sai_logger_test"
 
@@ -127,3 +131,39 @@ TEST_F(AsyncLoggerTest, concurrentWaitTest) {
   // Therefore, the flush count should be equal or greater than two.
   EXPECT_GE(asyncLogger->flushCount_, 2);
 }
+
+TEST_F(AsyncLoggerTest, concurrentAppendTest) {
+  // Records from concurrent writers must land in the file whole, and none of
+  // them may be lost while buffers are rotated.
+  constexpr auto kThreads = 8;
+  constexpr auto kRecordsPerThread = 20000;
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (auto i = 0; i < kRecordsPerThread; ++i) {
+        auto record = folly::to<std::string>(t, ":", i, "\n");
+        asyncLogger->appendLog(record.c_str(), record.size());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  asyncLogger->forceFlush();
+
+  std::ifstream logFile(TEST_LOG);
+  std::vector<int> nextSeq(kThreads, 0);
+  std::string line;
+  auto lines = 0;
+  while (std::getline(logFile, line)) {
+    auto sep = line.find(':');
+    ASSERT_NE(sep, std::string::npos) << line;
+    auto t = folly::to<int>(line.substr(0, sep));
+    auto i = folly::to<int>(line.substr(sep + 1));
+    // Records from the same thread keep their order
+    EXPECT_EQ(nextSeq[t]++, i);
+    ++lines;
+  }
+  EXPECT_EQ(lines, kThreads * kRecordsPerThread);
+  EXPECT_EQ(asyncLogger->getStats().droppedLogs, 0);
+}
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <boost/cast.hpp>
+
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/logging/xlog.h>
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/sim/SimSwitch.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/RouteUpdater.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <vector>
+
+DECLARE_int32(glean_probe_interval_ms);
+
+DEFINE_int32(
+    glean_benchmark_targets,
+    16,
+    "Number of unresolved hosts the glean flood is sent to, at most 200");
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+/*
+ * A flood of packets routed to unresolved hosts on a connected subnet, as
+ * trapped to the CPU when the hosts don't answer ARP, with and without the
+ * glean rate limiting.
+ */
+namespace {
+
+// Global state used by the benchmarks
+unique_ptr<SwSwitch> sw;
+unique_ptr<SwSwitch> swNoRateLimit;
+std::vector<unique_ptr<MockRxPacket>> gleans;
+
+unique_ptr<SwSwitch> setupSwitch() {
+  MacAddress localMac("02:00:01:00:00:01");
+  auto sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+
+  auto updateFn = [&](const shared_ptr<SwitchState>& oldState) {
+    auto state = oldState->clone();
+
+    // Add VLAN 1, and ports 1-9 which belong to it.
+    auto vlan1 = make_shared<Vlan>(VlanID(1), "Vlan1");
+    state->addVlan(vlan1);
+    for (int idx = 1; idx < 10; ++idx) {
+      vlan1->addPort(PortID(idx), false);
+    }
+    // Add Interface 1 to VLAN 1
+    auto intf1 = make_shared<Interface>(
+        InterfaceID(1),
+        RouterID(0),
+        VlanID(1),
+        "interface1",
+        MacAddress("02:00:01:00:00:01"),
+        9000,
+        false, /* is virtual */
+        false /* is state_sync disabled*/);
+    Interface::Addresses addrs1;
+    addrs1.emplace(IPAddress("10.0.0.1"), 24);
+    intf1->setAddresses(addrs1);
+    state->addIntf(intf1);
+    vlan1->setInterfaceID(InterfaceID(1));
+
+    RouteUpdater updater(state->getRouteTables());
+    updater.addInterfaceAndLinkLocalRoutes(state->getInterfaces());
+    state->resetRouteTables(updater.updateDone());
+    return state;
+  };
+
+  sw->updateStateBlocking("setup", updateFn);
+  return sw;
+}
+
+void init() {
+  sw = setupSwitch();
+  auto probeInterval = FLAGS_glean_probe_interval_ms;
+  FLAGS_glean_probe_interval_ms = 0;
+  swNoRateLimit = setupSwitch();
+  FLAGS_glean_probe_interval_ms = probeInterval;
+
+  auto targets = std::min(FLAGS_glean_benchmark_targets, 200);
+  for (int i = 0; i < targets; ++i) {
+    // A TCP packet from 1.2.3.4 for 10.0.0.(50 + i)
+    auto pkt = MockRxPacket::fromHex(std::string(
+        // dst mac, src mac
+        "02 00 01 00 00 01  02 00 02 01 02 03"
+        // 802.1q, VLAN 1
+        "81 00  00 01"
+        // IPv4
+        "08 00"
+        // Version(4), IHL(5), DSCP(0), ECN(0), Total Length(20)
+        "45  00  00 14"
+        // Identification(0), Flags(0), Fragment offset(0)
+        "00 00  00 00"
+        // TTL(31), Protocol(6), Checksum (0, fake)
+        "1F  06  00 00"
+        // Source IP (1.2.3.4)
+        "01 02 03 04") +
+        // Destination IP
+        folly::sformat("0a 00 00 {:02x}", 50 + i));
+    pkt->padToLength(68);
+    pkt->setSrcPort(PortID(1));
+    pkt->setSrcVlan(VlanID(1));
+    gleans.push_back(std::move(pkt));
+  }
+}
+
+void gleanFlood(SwSwitch* sw, size_t numIters) {
+  BENCHMARK_SUSPEND {
+    SimSwitch* sim = boost::polymorphic_downcast<SimSwitch*>(sw->getHw());
+    sim->resetTxCount();
+  }
+
+  for (size_t n = 0; n < numIters; ++n) {
+    sw->packetReceived(gleans[n % gleans.size()]->clone());
+  }
+
+  BENCHMARK_SUSPEND {
+    // Every ARP request sent is also a neighbor update queued
+    SimSwitch* sim = boost::polymorphic_downcast<SimSwitch*>(sw->getHw());
+    XLOG(DBG2) << numIters << " gleans sent " << sim->getTxCount()
+               << " ARP requests";
+  }
+}
+
+} // unnamed namespace
+
+BENCHMARK(GleanFloodNoRateLimit, numIters) {
+  gleanFlood(swNoRateLimit.get(), numIters);
+}
+
+BENCHMARK_RELATIVE(GleanFlood, numIters) {
+  gleanFlood(sw.get(), numIters);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Set up the switches once, see ArpBenchmark
+  init();
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/GleanTable.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using std::chrono::milliseconds;
+
+namespace {
+const RouterID kVrf(0);
+const IPAddress kTarget("10.0.0.10");
+
+// Whether gleans every ms from start up to end probe, keyed by time
+std::vector<int> probeTimes(
+    GleanTable& table,
+    GleanTable::Clock::time_point start,
+    int endMs) {
+  std::vector<int> probes;
+  for (int ms = 0; ms < endMs; ++ms) {
+    if (table.shouldProbe(kVrf, kTarget, start + milliseconds(ms))) {
+      probes.push_back(ms);
+    }
+  }
+  return probes;
+}
+} // namespace
+
+TEST(GleanTable, ProbeOnce) {
+  GleanTable table(milliseconds(100), milliseconds(1000), 16);
+  auto now = GleanTable::Clock::now();
+  EXPECT_TRUE(table.shouldProbe(kVrf, kTarget, now));
+  EXPECT_FALSE(table.shouldProbe(kVrf, kTarget, now));
+  EXPECT_FALSE(table.shouldProbe(kVrf, kTarget, now + milliseconds(99)));
+  EXPECT_EQ(table.size(), 1);
+
+  // Other targets and VRFs are rate limited separately
+  EXPECT_TRUE(table.shouldProbe(kVrf, IPAddress("10.0.0.11"), now));
+  EXPECT_TRUE(table.shouldProbe(RouterID(1), kTarget, now));
+  EXPECT_TRUE(table.shouldProbe(kVrf, IPAddress("2401:db00::10"), now));
+  EXPECT_EQ(table.size(), 4);
+}
+
+TEST(GleanTable, Backoff) {
+  GleanTable table(milliseconds(100), milliseconds(400), 16);
+  auto probes = probeTimes(table, GleanTable::Clock::now(), 2000);
+  std::vector<int> expected{0, 100, 300, 700, 1100, 1500, 1900};
+  EXPECT_EQ(probes, expected);
+}
+
+TEST(GleanTable, IdleReset) {
+  GleanTable table(milliseconds(100), milliseconds(400), 16);
+  auto start = GleanTable::Clock::now();
+  EXPECT_EQ(probeTimes(table, start, 1000).back(), 700);
+
+  // No glean for more than twice the max backoff, back to probeInterval
+  auto later = start + milliseconds(2000);
+  EXPECT_TRUE(table.shouldProbe(kVrf, kTarget, later));
+  EXPECT_FALSE(table.shouldProbe(kVrf, kTarget, later + milliseconds(99)));
+  EXPECT_TRUE(table.shouldProbe(kVrf, kTarget, later + milliseconds(100)));
+}
+
+TEST(GleanTable, Resolved) {
+  GleanTable table(milliseconds(100), milliseconds(1000), 16);
+  auto now = GleanTable::Clock::now();
+  EXPECT_TRUE(table.shouldProbe(kVrf, kTarget, now));
+  EXPECT_FALSE(table.shouldProbe(kVrf, kTarget, now));
+
+  table.resolved(kVrf, kTarget);
+  EXPECT_EQ(table.size(), 0);
+  EXPECT_TRUE(table.shouldProbe(kVrf, kTarget, now));
+  // Resolving a target that isn't tracked is fine
+  table.resolved(kVrf, IPAddress("10.0.0.11"));
+  EXPECT_EQ(table.size(), 1);
+}
+
+TEST(GleanTable, Disabled) {
+  GleanTable table(milliseconds(0), milliseconds(1000), 16);
+  auto now = GleanTable::Clock::now();
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(table.shouldProbe(kVrf, kTarget, now));
+  }
+  EXPECT_EQ(table.size(), 0);
+}
+
+TEST(GleanTable, Full) {
+  GleanTable table(milliseconds(100), milliseconds(400), 2);
+  auto now = GleanTable::Clock::now();
+  EXPECT_TRUE(table.shouldProbe(kVrf, IPAddress("10.0.0.1"), now));
+  EXPECT_TRUE(table.shouldProbe(kVrf, IPAddress("10.0.0.2"), now));
+
+  // Targets that don't fit aren't tracked, so never suppressed
+  EXPECT_TRUE(table.shouldProbe(kVrf, IPAddress("10.0.0.3"), now));
+  EXPECT_TRUE(table.shouldProbe(kVrf, IPAddress("10.0.0.3"), now));
+  EXPECT_FALSE(table.shouldProbe(kVrf, IPAddress("10.0.0.1"), now));
+  EXPECT_EQ(table.size(), 2);
+
+  // Until idle targets make room
+  auto later = now + milliseconds(1000);
+  EXPECT_TRUE(table.shouldProbe(kVrf, IPAddress("10.0.0.3"), later));
+  EXPECT_FALSE(table.shouldProbe(kVrf, IPAddress("10.0.0.3"), later));
+  EXPECT_EQ(table.size(), 1);
+}
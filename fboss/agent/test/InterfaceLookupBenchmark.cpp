@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+DEFINE_int32(
+    interface_lookup_benchmark_intfs,
+    4000,
+    "Number of SVIs configured for the interface lookup benchmarks");
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::IPAddressV4;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+// Global state used by the benchmarks
+unique_ptr<SwSwitch> sw;
+unique_ptr<MockRxPacket> pktToLastIntf;
+// Published, so lookups go through the lookup index
+shared_ptr<InterfaceMap> publishedIntfs;
+// Unpublished clone of the same map, so lookups scan all interfaces
+shared_ptr<InterfaceMap> unpublishedIntfs;
+
+IPAddressV4 intfAddrV4(int idx) {
+  return IPAddressV4(folly::to<std::string>(
+      "10.", idx / 256 % 256, ".", idx % 256, ".1"));
+}
+
+IPAddress intfAddrV6(int idx) {
+  return IPAddress(folly::to<std::string>("2401:db00:", idx, "::1"));
+}
+
+/*
+ * One SVI per VLAN, each with a /24 and a /64. VLAN 1 holds the ports.
+ */
+void setupSwitch() {
+  MacAddress localMac("02:00:01:00:00:01");
+  sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+
+  sw->updateStateBlocking(
+      "setup", [&](const shared_ptr<SwitchState>& oldState) {
+        auto state = oldState->clone();
+        for (int idx = 1; idx <= FLAGS_interface_lookup_benchmark_intfs;
+             ++idx) {
+          auto vlan = make_shared<Vlan>(
+              VlanID(idx), folly::to<std::string>("Vlan", idx));
+          vlan->setInterfaceID(InterfaceID(idx));
+          if (idx == 1) {
+            for (int port = 1; port < 10; ++port) {
+              vlan->addPort(PortID(port), false);
+            }
+          }
+          state->addVlan(vlan);
+          auto intf = make_shared<Interface>(
+              InterfaceID(idx),
+              RouterID(0),
+              VlanID(idx),
+              folly::to<std::string>("interface", idx),
+              localMac,
+              9000,
+              false, /* is virtual */
+              false /* is state_sync disabled*/);
+          Interface::Addresses addrs;
+          addrs.emplace(intfAddrV4(idx), 24);
+          addrs.emplace(intfAddrV6(idx), 64);
+          intf->setAddresses(addrs);
+          state->addIntf(intf);
+        }
+        return state;
+      });
+}
+
+void init() {
+  setupSwitch();
+  publishedIntfs = sw->getState()->getInterfaces();
+  unpublishedIntfs = publishedIntfs->clone();
+
+  auto lastIntf = FLAGS_interface_lookup_benchmark_intfs;
+  auto dstAddr = intfAddrV4(lastIntf).toByteArray();
+  // TCP packet on VLAN 1 to the address of the last SVI, punted to the host
+  pktToLastIntf = MockRxPacket::fromHex(folly::to<std::string>(
+      // dst mac, src mac
+      "02 00 01 00 00 01  00 02 00 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // IPv4
+      "08 00"
+      // Version, IHL, DSCP, length: 20
+      "45 00 00 14"
+      // Id, flags, fragment offset
+      "00 00 00 00"
+      // TTL, protocol: TCP, checksum (not checked)
+      "40 06 00 00"
+      // Source IP: 10.0.0.15
+      "0a 00 00 0f",
+      // Destination IP
+      folly::hexlify(folly::ByteRange(dstAddr.data(), dstAddr.size()))));
+  pktToLastIntf->padToLength(68);
+  pktToLastIntf->setSrcPort(PortID(1));
+  pktToLastIntf->setSrcVlan(VlanID(1));
+}
+
+// Addresses of interfaces spread over the whole map
+template <typename AddrFn>
+std::vector<IPAddress> lookupAddrs(AddrFn addrFn) {
+  std::vector<IPAddress> addrs;
+  for (int idx = 1; idx <= FLAGS_interface_lookup_benchmark_intfs;
+       idx += FLAGS_interface_lookup_benchmark_intfs / 64 + 1) {
+    addrs.push_back(addrFn(idx));
+  }
+  return addrs;
+}
+
+void getInterfaceIf(uint32_t iters, const shared_ptr<InterfaceMap>& intfs) {
+  folly::BenchmarkSuspender suspender;
+  auto addrs = lookupAddrs(intfAddrV4);
+  suspender.dismiss();
+  for (auto i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(
+        intfs->getInterfaceIf(RouterID(0), addrs[i % addrs.size()]));
+  }
+}
+
+void getIntfAddrToReach(
+    uint32_t iters,
+    const shared_ptr<InterfaceMap>& intfs) {
+  folly::BenchmarkSuspender suspender;
+  // Neighbors in the /64 of each SVI
+  auto addrs = lookupAddrs([](int idx) {
+    return IPAddress(folly::to<std::string>("2401:db00:", idx, "::a"));
+  });
+  suspender.dismiss();
+  for (auto i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(
+        intfs->getIntfAddrToReach(RouterID(0), addrs[i % addrs.size()]));
+  }
+}
+
+void getInterfaceInVlanIf(
+    uint32_t iters,
+    const shared_ptr<InterfaceMap>& intfs) {
+  for (auto i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(intfs->getInterfaceInVlanIf(
+        VlanID(i % FLAGS_interface_lookup_benchmark_intfs + 1)));
+  }
+}
+
+} // unnamed namespace
+
+BENCHMARK(PacketToLastIntf, numIters) {
+  for (size_t n = 0; n < numIters; ++n) {
+    sw->packetReceived(pktToLastIntf->clone());
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(getInterfaceIf, scan, unpublishedIntfs)
+BENCHMARK_RELATIVE_NAMED_PARAM(getInterfaceIf, index, publishedIntfs)
+BENCHMARK_NAMED_PARAM(getIntfAddrToReach, scan, unpublishedIntfs)
+BENCHMARK_RELATIVE_NAMED_PARAM(getIntfAddrToReach, index, publishedIntfs)
+BENCHMARK_NAMED_PARAM(getInterfaceInVlanIf, scan, unpublishedIntfs)
+BENCHMARK_RELATIVE_NAMED_PARAM(getInterfaceInVlanIf, index, publishedIntfs)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  // Setting up the switch is fairly expensive, do it once for all benchmarks
+  init();
+  folly::runBenchmarks();
+  pktToLastIntf.reset();
+  unpublishedIntfs.reset();
+  publishedIntfs.reset();
+  sw.reset();
+  return 0;
+}
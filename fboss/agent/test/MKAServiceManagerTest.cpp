@@ -228,6 +228,26 @@ TEST_F(MKAServiceManagerTest, SendPktToMkaServer) {
   counters.checkDelta(SwitchStats::kCounterPrefix + "mkpdu.recvd.sum", 1);
 }
 
+TEST_F(MKAServiceManagerTest, SendPktToMkaServerOwnsBuffer) {
+  init();
+  // Like the SAI and BCM RX buffers, only valid until handlePacket returns
+  auto eapol = createEapol();
+  std::vector<uint8_t> rxBuffer(eapol->data(), eapol->tail());
+  auto expected = rxBuffer;
+  auto rxPkt = std::make_unique<MockRxPacket>(
+      folly::IOBuf::wrapBuffer(rxBuffer.data(), rxBuffer.size()));
+  rxPkt->setSrcPort(activePort_);
+  baton_->reset();
+  sw_->getMKAServiceMgr()->handlePacket(std::move(rxPkt));
+  std::fill(rxBuffer.begin(), rxBuffer.end(), 0xff);
+
+  EXPECT_TRUE(baton_->try_wait_for(std::chrono::milliseconds(200)));
+  ASSERT_EQ(recvAcceptor_->rxIOBufs_.size(), 1);
+  auto rxIOBuf = recvAcceptor_->rxIOBufs_[0]->cloneCoalesced();
+  EXPECT_EQ(
+      std::vector<uint8_t>(rxIOBuf->data(), rxIOBuf->tail()), expected);
+}
+
 TEST_F(MKAServiceManagerTest, SendPktToMkaServerUnregisteredPort) {
   init(false);
   CounterCache counters(sw_);
@@ -0,0 +1,197 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/state/NextHopSetRegistry.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+#include "fboss/lib/RefMap.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+
+DEFINE_int32(next_hop_set_benchmark_routes, 500000, "Number of routes");
+DEFINE_int32(
+    next_hop_set_benchmark_sets,
+    256,
+    "Number of distinct next hop sets shared by the routes");
+DEFINE_int32(next_hop_set_benchmark_width, 16, "Next hops per set");
+
+using namespace facebook::fboss;
+
+/*
+ * Many routes sharing few ECMP groups, as in a large FIB.  Compares
+ * per-route copies of the next hop sets with interned sets for building
+ * the routes, comparing them (as done for every route on each state
+ * update) and programming them into a table of ECMP groups keyed by next
+ * hop set (as BcmMultiPathNextHopTable and SaiNextHopGroupManager do).
+ */
+namespace {
+
+struct EcmpGroup {};
+
+RouteNextHopSet nextHopSet(int set) {
+  RouteNextHopSet nhops;
+  for (int i = 0; i < FLAGS_next_hop_set_benchmark_width; ++i) {
+    auto nhop = set * FLAGS_next_hop_set_benchmark_width + i;
+    nhops.emplace(ResolvedNextHop(
+        folly::IPAddress(folly::to<std::string>(
+            "2401:db00:", nhop / 65536, ":", nhop % 65536, "::1")),
+        InterfaceID(i + 1),
+        ECMP_WEIGHT));
+  }
+  return nhops;
+}
+
+std::vector<RouteNextHopSet> nextHopSets() {
+  std::vector<RouteNextHopSet> sets;
+  for (int set = 0; set < FLAGS_next_hop_set_benchmark_sets; ++set) {
+    sets.push_back(nextHopSet(set));
+  }
+  return sets;
+}
+
+const RouteNextHopSet& routeNextHops(
+    const std::vector<RouteNextHopSet>& sets,
+    int route) {
+  return sets[route % sets.size()];
+}
+
+// Routes as they were before interning, each with its own set
+std::vector<RouteNextHopSet> copiedRoutes(
+    const std::vector<RouteNextHopSet>& sets) {
+  std::vector<RouteNextHopSet> routes;
+  routes.reserve(FLAGS_next_hop_set_benchmark_routes);
+  for (int route = 0; route < FLAGS_next_hop_set_benchmark_routes; ++route) {
+    routes.push_back(routeNextHops(sets, route));
+  }
+  return routes;
+}
+
+std::vector<RouteNextHopEntry> internedRoutes(
+    const std::vector<RouteNextHopSet>& sets) {
+  std::vector<RouteNextHopEntry> routes;
+  routes.reserve(FLAGS_next_hop_set_benchmark_routes);
+  for (int route = 0; route < FLAGS_next_hop_set_benchmark_routes; ++route) {
+    routes.emplace_back(routeNextHops(sets, route), AdminDistance::EBGP);
+  }
+  return routes;
+}
+
+} // namespace
+
+BENCHMARK(CopiedNextHopSetsBuild, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto sets = nextHopSets();
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    auto routes = copiedRoutes(sets);
+    folly::doNotOptimizeAway(routes);
+    suspender.rehire();
+    routes.clear();
+    suspender.dismiss();
+  }
+}
+
+BENCHMARK_RELATIVE(InternedNextHopSetsBuild, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto sets = nextHopSets();
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    auto routes = internedRoutes(sets);
+    folly::doNotOptimizeAway(routes);
+    suspender.rehire();
+    routes.clear();
+    suspender.dismiss();
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(CopiedNextHopSetsCompare, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto sets = nextHopSets();
+  auto oldRoutes = copiedRoutes(sets);
+  auto newRoutes = copiedRoutes(sets);
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    for (size_t route = 0; route < oldRoutes.size(); ++route) {
+      folly::doNotOptimizeAway(oldRoutes[route] == newRoutes[route]);
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(InternedNextHopSetsCompare, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto sets = nextHopSets();
+  auto oldRoutes = internedRoutes(sets);
+  auto newRoutes = internedRoutes(sets);
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    for (size_t route = 0; route < oldRoutes.size(); ++route) {
+      folly::doNotOptimizeAway(oldRoutes[route] == newRoutes[route]);
+    }
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(CopiedNextHopSetsProgram, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto sets = nextHopSets();
+  auto routes = copiedRoutes(sets);
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    FlatRefMap<RouteNextHopSet, EcmpGroup> groups;
+    std::vector<std::shared_ptr<EcmpGroup>> routeGroups;
+    routeGroups.reserve(routes.size());
+    for (const auto& route : routes) {
+      routeGroups.push_back(groups.refOrEmplace(route).first);
+    }
+    folly::doNotOptimizeAway(routeGroups);
+  }
+}
+
+BENCHMARK_RELATIVE(InternedNextHopSetsProgram, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto sets = nextHopSets();
+  auto routes = internedRoutes(sets);
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    UnorderedRefMap<InternedNextHopSetPtr, EcmpGroup> groups;
+    std::vector<std::shared_ptr<EcmpGroup>> routeGroups;
+    routeGroups.reserve(routes.size());
+    for (const auto& route : routes) {
+      routeGroups.push_back(
+          groups.refOrEmplace(route.getInternedNextHopSet()).first);
+    }
+    folly::doNotOptimizeAway(routeGroups);
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  {
+    auto sets = nextHopSets();
+    auto routes = internedRoutes(sets);
+    size_t copiedBytes = 0;
+    for (const auto& set : sets) {
+      copiedBytes += sizeof(RouteNextHopSet) + set.capacity() * sizeof(NextHop);
+    }
+    copiedBytes *= FLAGS_next_hop_set_benchmark_routes / sets.size();
+    auto internedBytes = routes.size() * sizeof(InternedNextHopSetPtr) +
+        NextHopSetRegistry::get()->memoryUsage();
+    XLOG(INFO) << "Next hop sets of " << routes.size() << " routes use "
+               << copiedBytes << " bytes as copies, " << internedBytes
+               << " bytes interned";
+  }
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/MacAddress.h>
+#include <folly/logging/xlog.h>
+
+#include <unistd.h>
+#include <fstream>
+
+DEFINE_int32(route_memory_benchmark_routes, 500000, "Number of route nodes");
+
+using namespace facebook::fboss;
+
+/*
+ * Memory used by route nodes: the size of the nodes themselves, the time to
+ * create a large number of them, and the growth of the resident set when
+ * programming FSW and HGRID scale route distributions through SwSwitch.
+ */
+namespace {
+
+size_t residentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  size_t totalPages = 0;
+  size_t residentPages = 0;
+  statm >> totalPages >> residentPages;
+  return residentPages * sysconf(_SC_PAGESIZE);
+}
+
+size_t numRoutes(
+    const utility::RouteDistributionGenerator::RouteChunks& routeChunks) {
+  size_t routes = 0;
+  for (const auto& routeChunk : routeChunks) {
+    routes += routeChunk.size();
+  }
+  return routes;
+}
+
+template <typename Generator>
+void reportRouteScaleMemory(folly::StringPiece name) {
+  auto constexpr kEcmpWidth = 4;
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle = createTestHandle(&config);
+  auto sw = testHandle->getSw();
+  auto generator = Generator(
+      sw->getState(), sw->isStandaloneRibEnabled(), 1337, kEcmpWidth);
+  // Generate the routes up front, only programming them is measured
+  const auto& routeChunks = generator.get();
+  auto routes = numRoutes(routeChunks);
+  auto before = residentBytes();
+  programRoutes(routeChunks, sw);
+  auto after = residentBytes();
+  XLOG(INFO) << name << ": " << routes << " routes, resident set grew by "
+             << (after - before) << " bytes, "
+             << (after - before) / std::max(routes, size_t(1))
+             << " bytes per route";
+}
+
+RoutePrefix<folly::IPAddressV4> nthPrefix(
+    folly::IPAddressV4 /*unused*/,
+    uint32_t n) {
+  return RoutePrefix<folly::IPAddressV4>{
+      folly::IPAddressV4::fromLongHBO((10u << 24) + (n << 8)), 24};
+}
+
+RoutePrefix<folly::IPAddressV6> nthPrefix(
+    folly::IPAddressV6 /*unused*/,
+    uint32_t n) {
+  folly::ByteArray16 bytes{};
+  bytes[0] = 0x24;
+  bytes[1] = 0x01;
+  bytes[2] = 0xdb;
+  for (int i = 0; i < 4; ++i) {
+    bytes[7 - i] = (n >> (8 * i)) & 0xff;
+  }
+  return RoutePrefix<folly::IPAddressV6>{folly::IPAddressV6(bytes), 64};
+}
+
+// Resolved routes from a single client, as most routes in the FIB are
+template <typename AddrT>
+std::vector<std::shared_ptr<Route<AddrT>>> makeRoutes() {
+  RouteNextHopEntry::NextHopSet nhops;
+  for (int i = 0; i < 4; ++i) {
+    nhops.emplace(ResolvedNextHop(
+        folly::IPAddress(folly::to<std::string>("10.0.0.", i + 1)),
+        InterfaceID(i + 1),
+        ECMP_WEIGHT));
+  }
+  RouteNextHopEntry entry(nhops, AdminDistance::EBGP);
+  std::vector<std::shared_ptr<Route<AddrT>>> routes;
+  routes.reserve(FLAGS_route_memory_benchmark_routes);
+  for (int i = 0; i < FLAGS_route_memory_benchmark_routes; ++i) {
+    auto route = std::make_shared<Route<AddrT>>(
+        nthPrefix(AddrT(), i), ClientID::BGPD, entry);
+    route->setResolved(entry);
+    routes.push_back(std::move(route));
+  }
+  return routes;
+}
+
+template <typename AddrT>
+void createRoutes(uint32_t iters) {
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto routes = makeRoutes<AddrT>();
+    folly::doNotOptimizeAway(routes);
+    folly::BenchmarkSuspender suspender;
+    routes.clear();
+  }
+}
+
+template <typename AddrT>
+void reportRouteNodeMemory(folly::StringPiece name) {
+  auto before = residentBytes();
+  auto routes = makeRoutes<AddrT>();
+  auto after = residentBytes();
+  XLOG(INFO) << name << ": sizeof(Route) " << sizeof(Route<AddrT>)
+             << ", sizeof(RouteFields) " << sizeof(RouteFields<AddrT>)
+             << ", resident set per route "
+             << (after - before) / routes.size() << " bytes";
+}
+
+} // namespace
+
+BENCHMARK(CreateRoutesV4, iters) {
+  createRoutes<folly::IPAddressV4>(iters);
+}
+
+BENCHMARK(CreateRoutesV6, iters) {
+  createRoutes<folly::IPAddressV6>(iters);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  reportRouteNodeMemory<folly::IPAddressV4>("RouteV4");
+  reportRouteNodeMemory<folly::IPAddressV6>("RouteV6");
+  reportRouteScaleMemory<utility::FSWRouteScaleGenerator>("FSW");
+  reportRouteScaleMemory<utility::HgridDuRouteScaleGenerator>("HgridDu");
+  reportRouteScaleMemory<utility::HgridUuRouteScaleGenerator>("HgridUu");
+  folly::runBenchmarks();
+  return 0;
+}
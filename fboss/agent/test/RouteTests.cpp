@@ -276,6 +276,13 @@ TYPED_TEST(RouteTest, routeApi) {
     route.updateClassID(cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1);
     EXPECT_EQ(
         cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1, route.getClassID());
+    EXPECT_EQ(
+        RouteFields<folly::IPAddressV6>::fromFollyDynamic(
+            route.getFields()->toFollyDynamic())
+            .getClassID(),
+        cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1);
+    route.updateClassID(std::nullopt);
+    EXPECT_EQ(std::nullopt, route.getClassID());
   };
   if constexpr (TypeParam::hasStandAloneRib) {
     testRouteApi(RibRouteV6(pfx6, kClientA, nhopEntry));
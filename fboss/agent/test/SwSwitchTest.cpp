@@ -30,6 +30,7 @@
 #include <folly/MacAddress.h>
 
 #include <algorithm>
+#include <thread>
 
 using namespace facebook::fboss;
 using folly::IPAddressV4;
@@ -192,6 +193,42 @@ TEST_F(SwSwitchTest, VerifyIsValidStateUpdate) {
   EXPECT_FALSE(sw->isValidStateUpdate(StateDelta(stateV0, stateV2)));
 }
 
+TEST_F(SwSwitchTest, StateSnapshot) {
+  auto bringPortsUpUpdateFn = [](const std::shared_ptr<SwitchState>& state) {
+    return bringAllPortsUp(state);
+  };
+  auto origState = sw->getState();
+  {
+    auto snapshot = sw->getStateSnapshot();
+    EXPECT_EQ(origState, snapshot.get());
+
+    sw->updateStateBlocking("Bring Ports Up", bringPortsUpUpdateFn);
+    EXPECT_NE(origState, sw->getState());
+    // Live snapshot and snapshots nested in it keep seeing the same state
+    EXPECT_EQ(origState, snapshot.get());
+    auto nested = sw->getStateSnapshot();
+    EXPECT_EQ(origState, nested.get());
+  }
+  // Once no snapshot is alive, the next one picks up the new state
+  auto snapshot = sw->getStateSnapshot();
+  EXPECT_EQ(sw->getState(), snapshot.get());
+  EXPECT_EQ(
+      snapshot->getPort(PortID(1))->getName(),
+      sw->getState()->getPort(PortID(1))->getName());
+
+  // Other threads see the current state regardless of this thread's snapshot
+  auto bringPortsDownUpdateFn = [](const std::shared_ptr<SwitchState>& state) {
+    return bringAllPortsDown(state);
+  };
+  sw->updateStateBlocking("Bring Ports Down", bringPortsDownUpdateFn);
+  std::shared_ptr<SwitchState> otherThreadState;
+  std::thread([&]() {
+    otherThreadState = sw->getStateSnapshot().get();
+  }).join();
+  EXPECT_EQ(sw->getState(), otherThreadState);
+  EXPECT_NE(sw->getState(), snapshot.get());
+}
+
 TEST_F(SwSwitchTest, gracefulExit) {
   auto bringPortsUpUpdateFn = [](const std::shared_ptr<SwitchState>& state) {
     return bringAllPortsUp(state);
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+DEFINE_int32(
+    state_read_benchmark_update_interval_us,
+    100,
+    "Interval between state updates published while readers run");
+
+using namespace facebook::fboss;
+using folly::MacAddress;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+// Global state used by the benchmarks
+unique_ptr<SwSwitch> sw;
+
+void init() {
+  MacAddress localMac("02:00:01:00:00:01");
+  sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+}
+
+/*
+ * Publish a new state every --state_read_benchmark_update_interval_us until
+ * stopped, so readers keep seeing fresh states like they would while routes
+ * and neighbors churn.
+ */
+class StatePublisher {
+ public:
+  StatePublisher()
+      : thread_([this]() {
+          int64_t generation = 0;
+          while (!stop_.load()) {
+            auto arpTimeout = std::chrono::seconds(60 + (++generation % 2));
+            sw->updateStateBlocking(
+                "benchmark update",
+                [arpTimeout](const shared_ptr<SwitchState>& oldState) {
+                  auto state = oldState->clone();
+                  state->setArpTimeout(arpTimeout);
+                  return state;
+                });
+            updates_++;
+            std::this_thread::sleep_for(std::chrono::microseconds(
+                FLAGS_state_read_benchmark_update_interval_us));
+          }
+        }) {}
+
+  ~StatePublisher() {
+    stop_ = true;
+    thread_.join();
+  }
+
+  uint64_t updates() const {
+    return updates_.load();
+  }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::atomic<uint64_t> updates_{0};
+  std::thread thread_;
+};
+
+// Reads the VLAN map, about what an rx handler does first with the state
+template <typename ReadFn>
+void readFromThreads(uint32_t iters, int numThreads, ReadFn read) {
+  folly::BenchmarkSuspender suspender;
+  auto publisher = std::make_unique<StatePublisher>();
+  suspender.dismiss();
+
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&]() {
+      for (auto i = 0; i < iters; ++i) {
+        folly::doNotOptimizeAway(read());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  suspender.rehire();
+  publisher.reset();
+}
+
+void getState(uint32_t iters, int numThreads) {
+  readFromThreads(iters, numThreads, []() {
+    return sw->getState()->getVlans()->size();
+  });
+}
+
+void getStateSnapshot(uint32_t iters, int numThreads) {
+  readFromThreads(iters, numThreads, []() {
+    return sw->getStateSnapshot()->getVlans()->size();
+  });
+}
+
+} // unnamed namespace
+
+BENCHMARK_NAMED_PARAM(getState, 1_thread, 1)
+BENCHMARK_RELATIVE_NAMED_PARAM(getStateSnapshot, 1_thread, 1)
+BENCHMARK_NAMED_PARAM(getState, 4_threads, 4)
+BENCHMARK_RELATIVE_NAMED_PARAM(getStateSnapshot, 4_threads, 4)
+BENCHMARK_NAMED_PARAM(getState, 16_threads, 16)
+BENCHMARK_RELATIVE_NAMED_PARAM(getStateSnapshot, 16_threads, 16)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  // Setting up the switch is fairly expensive, do it once for all benchmarks
+  init();
+  folly::runBenchmarks();
+  sw.reset();
+  return 0;
+}
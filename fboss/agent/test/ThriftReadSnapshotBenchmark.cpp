@@ -0,0 +1,276 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Format.h>
+#include <folly/IPAddressV4.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/ThriftHandler.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/RouteUpdater.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+DECLARE_int32(thrift_read_snapshot_interval_ms);
+
+DEFINE_int32(
+    read_benchmark_getter_threads,
+    4,
+    "Threads calling the thrift getters back to back");
+DEFINE_int32(
+    read_benchmark_routes,
+    1000,
+    "Routes added, then deleted, by each route churn call");
+DEFINE_int32(read_benchmark_seconds, 5, "Duration of each scenario");
+DEFINE_int32(
+    read_benchmark_snapshot_interval_ms,
+    100,
+    "--thrift_read_snapshot_interval_ms of the snapshot scenarios");
+
+using namespace facebook::fboss;
+using facebook::network::toBinaryAddress;
+using folly::IPAddress;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+/*
+ * Thrift getters (getAllPortInfo, getArpTable, getNdpTable, getL2Table and
+ * getAclTable) called back to back by several threads, concurrently with
+ * route churn through addUnicastRoutes and deleteUnicastRoutes, with and
+ * without the read snapshots.
+ *
+ * Each scenario reports the latency percentiles of both: how much the
+ * getters slow down route programming, and how much programming slows
+ * down the getters.  The SimSwitch programs routes instantly, so the
+ * interference measured here is in the SwSwitch threads, stats and locks
+ * only, the hardware adds to it on a real switch.
+ */
+namespace {
+
+const int16_t kClient = 786;
+
+unique_ptr<SwSwitch> setupSwitch() {
+  MacAddress localMac("02:00:01:00:00:01");
+  auto sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+
+  auto updateFn = [&](const shared_ptr<SwitchState>& oldState) {
+    auto state = oldState->clone();
+
+    // Add VLAN 1, and ports 1-9 which belong to it.
+    auto vlan1 = make_shared<Vlan>(VlanID(1), "Vlan1");
+    state->addVlan(vlan1);
+    for (int idx = 1; idx < 10; ++idx) {
+      vlan1->addPort(PortID(idx), false);
+    }
+    // Add Interface 1 to VLAN 1
+    auto intf1 = make_shared<Interface>(
+        InterfaceID(1),
+        RouterID(0),
+        VlanID(1),
+        "interface1",
+        MacAddress("02:00:01:00:00:01"),
+        9000,
+        false, /* is virtual */
+        false /* is state_sync disabled*/);
+    Interface::Addresses addrs1;
+    addrs1.emplace(IPAddress("10.0.0.1"), 24);
+    intf1->setAddresses(addrs1);
+    state->addIntf(intf1);
+    vlan1->setInterfaceID(InterfaceID(1));
+
+    RouteUpdater updater(state->getRouteTables());
+    updater.addInterfaceAndLinkLocalRoutes(state->getInterfaces());
+    state->resetRouteTables(updater.updateDone());
+    return state;
+  };
+
+  sw->updateStateBlocking("setup", updateFn);
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  sw->fibSynced();
+  return sw;
+}
+
+// 100.0.0.0/24, 100.0.1.0/24, ... through 10.0.0.2
+std::vector<UnicastRoute> makeRoutes(int numRoutes) {
+  std::vector<UnicastRoute> routes;
+  for (int i = 0; i < numRoutes; ++i) {
+    UnicastRoute route;
+    auto addr = folly::IPAddressV4::fromLongHBO((100 << 24) + (i << 8));
+    route.dest_ref()->ip_ref() = toBinaryAddress(IPAddress(addr));
+    route.dest_ref()->prefixLength_ref() = 24;
+    route.nextHopAddrs_ref()->push_back(
+        toBinaryAddress(IPAddress("10.0.0.2")));
+    routes.push_back(std::move(route));
+  }
+  return routes;
+}
+
+class Latencies {
+ public:
+  void add(std::chrono::steady_clock::duration latency) {
+    us_.push_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(latency)
+            .count());
+  }
+  void merge(Latencies&& other) {
+    us_.insert(us_.end(), other.us_.begin(), other.us_.end());
+  }
+  size_t size() const {
+    return us_.size();
+  }
+  // Nearest rank percentile
+  int64_t percentile(double pct) {
+    if (us_.empty()) {
+      return 0;
+    }
+    std::sort(us_.begin(), us_.end());
+    auto rank = static_cast<size_t>(std::ceil(pct / 100 * us_.size()));
+    return us_[std::max(rank, size_t(1)) - 1];
+  }
+
+ private:
+  std::vector<int64_t> us_;
+};
+
+template <typename Fn>
+std::chrono::steady_clock::duration timed(Fn&& fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::steady_clock::now() - start;
+}
+
+void callGetters(ThriftHandler* handler, Latencies* latencies) {
+  std::map<int32_t, PortInfoThrift> portInfo;
+  latencies->add(timed([&] { handler->getAllPortInfo(portInfo); }));
+  std::vector<ArpEntryThrift> arpTable;
+  latencies->add(timed([&] { handler->getArpTable(arpTable); }));
+  std::vector<NdpEntryThrift> ndpTable;
+  latencies->add(timed([&] { handler->getNdpTable(ndpTable); }));
+  std::vector<L2EntryThrift> l2Table;
+  latencies->add(timed([&] { handler->getL2Table(l2Table); }));
+  std::vector<AclEntryThrift> aclTable;
+  latencies->add(timed([&] { handler->getAclTable(aclTable); }));
+}
+
+void churnRoutes(
+    ThriftHandler* handler,
+    const std::vector<UnicastRoute>& routes,
+    Latencies* latencies) {
+  latencies->add(timed([&] {
+    handler->addUnicastRoutes(
+        kClient, make_unique<std::vector<UnicastRoute>>(routes));
+  }));
+  auto prefixes = make_unique<std::vector<IpPrefix>>();
+  for (const auto& route : routes) {
+    prefixes->push_back(*route.dest_ref());
+  }
+  latencies->add(timed(
+      [&] { handler->deleteUnicastRoutes(kClient, std::move(prefixes)); }));
+}
+
+void runScenario(
+    SwSwitch* sw,
+    const std::string& name,
+    bool churn,
+    int getterThreads,
+    bool snapshots) {
+  FLAGS_thrift_read_snapshot_interval_ms =
+      snapshots ? FLAGS_read_benchmark_snapshot_interval_ms : 0;
+  ThriftHandler handler(sw);
+  if (snapshots) {
+    // Let the first snapshots be built
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+        2 * FLAGS_read_benchmark_snapshot_interval_ms));
+  }
+  auto routes = makeRoutes(FLAGS_read_benchmark_routes);
+
+  std::atomic<bool> stop{false};
+  std::mutex mutex;
+  Latencies getterLatencies;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < getterThreads; ++i) {
+    threads.emplace_back([&] {
+      Latencies latencies;
+      while (!stop) {
+        callGetters(&handler, &latencies);
+      }
+      std::lock_guard<std::mutex> guard(mutex);
+      getterLatencies.merge(std::move(latencies));
+    });
+  }
+  Latencies churnLatencies;
+  if (churn) {
+    threads.emplace_back([&] {
+      while (!stop) {
+        churnRoutes(&handler, routes, &churnLatencies);
+      }
+    });
+  }
+  std::this_thread::sleep_for(
+      std::chrono::seconds(FLAGS_read_benchmark_seconds));
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::cout << folly::sformat(
+                   "{:<24}{:>10}{:>10}{:>10}  {:>10}{:>10}{:>10}{:>10}",
+                   name,
+                   churnLatencies.size(),
+                   churnLatencies.percentile(50),
+                   churnLatencies.percentile(99),
+                   getterLatencies.size() / FLAGS_read_benchmark_seconds,
+                   getterLatencies.percentile(50),
+                   getterLatencies.percentile(99),
+                   getterLatencies.percentile(99.9))
+            << std::endl;
+}
+
+} // unnamed namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  auto sw = setupSwitch();
+  auto getters = FLAGS_read_benchmark_getter_threads;
+
+  std::cout << folly::sformat(
+                   "{:<24}{:>10}{:>10}{:>10}  {:>10}{:>10}{:>10}{:>10}",
+                   "scenario",
+                   "churn",
+                   "p50 us",
+                   "p99 us",
+                   "getters/s",
+                   "p50 us",
+                   "p99 us",
+                   "p999 us")
+            << std::endl;
+  runScenario(sw.get(), "churn_only", true, 0, false);
+  runScenario(sw.get(), "getters_only", false, getters, false);
+  runScenario(sw.get(), "getters_only_snapshot", false, getters, true);
+  runScenario(sw.get(), "churn_getters", true, getters, false);
+  runScenario(sw.get(), "churn_getters_snapshot", true, getters, true);
+  return 0;
+}
@@ -26,6 +26,10 @@
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+#include <thread>
+
+DECLARE_int32(thrift_read_snapshot_interval_ms);
+
 using namespace facebook::fboss;
 using apache::thrift::TEnumTraits;
 using cfg::PortSpeed;
@@ -922,3 +926,113 @@ TYPED_TEST(ThriftTest, addMplsRoutesIsHwProtected) {
       },
       FbossFibUpdateError);
 }
+
+TYPED_TEST(ThriftTest, readSnapshotPerStateGeneration) {
+  ThriftHandler handler(this->sw_);
+  // Not started, only refreshed by the test
+  ThriftReadSnapshots snapshots(
+      this->sw_, std::chrono::hours(1), std::chrono::hours(1));
+  int numBuilds = 0;
+  auto snapshot = snapshots.add<std::map<int32_t, bool>>(
+      "portEnabled",
+      [&](const shared_ptr<SwitchState>& state) {
+        ++numBuilds;
+        std::map<int32_t, bool> enabled;
+        for (const auto& port : *state->getPorts()) {
+          enabled[port->getID()] = port->isEnabled();
+        }
+        return enabled;
+      },
+      true /* stateOnly */);
+
+  std::map<int32_t, bool> enabled;
+  EXPECT_FALSE(snapshot->serve(enabled));
+
+  // Not rebuilt while the state doesn't change
+  snapshots.refresh();
+  snapshots.refresh();
+  EXPECT_EQ(numBuilds, 1);
+  ASSERT_TRUE(snapshot->serve(enabled));
+  bool port1Enabled = enabled.at(1);
+
+  handler.setPortState(1, !port1Enabled);
+  waitForStateUpdates(this->sw_);
+  snapshots.refresh();
+  EXPECT_EQ(numBuilds, 2);
+  ASSERT_TRUE(snapshot->serve(enabled));
+  EXPECT_EQ(enabled.at(1), !port1Enabled);
+
+  auto infos = snapshots.getInfo();
+  ASSERT_EQ(infos.size(), 1);
+  EXPECT_EQ(*infos[0].name_ref(), "portEnabled");
+  EXPECT_EQ(
+      *infos[0].stateGeneration_ref(),
+      this->sw_->getState()->getGeneration());
+  EXPECT_EQ(*infos[0].numServed_ref(), 2);
+  EXPECT_EQ(*infos[0].numStale_ref(), 1);
+}
+
+TYPED_TEST(ThriftTest, readSnapshotStale) {
+  ThriftReadSnapshots snapshots(
+      this->sw_, std::chrono::hours(1), std::chrono::milliseconds(0));
+  bool fail = false;
+  auto snapshot = snapshots.add<int>(
+      "value",
+      [&](const shared_ptr<SwitchState>& /*state*/) {
+        if (fail) {
+          throw FbossError("build failed");
+        }
+        return 42;
+      },
+      false /* stateOnly */);
+  snapshots.refresh();
+  auto value = snapshot->get();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value->response, 42);
+
+  // Older than the max age, the caller builds the response itself
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  int response = 0;
+  EXPECT_FALSE(snapshot->serve(response));
+  EXPECT_EQ(response, 0);
+
+  // A failed build keeps the last snapshot
+  fail = true;
+  snapshots.refresh();
+  EXPECT_EQ(snapshot->get(), value);
+}
+
+TYPED_TEST(ThriftTest, getAclTableFromSnapshot) {
+  ThriftHandler liveHandler(this->sw_);
+  gflags::FlagSaver flagSaver;
+  FLAGS_thrift_read_snapshot_interval_ms = 10;
+  ThriftHandler handler(this->sw_);
+
+  auto aclSnapshotInfo = [&handler]() {
+    std::vector<ReadSnapshotInfo> infos;
+    handler.getReadSnapshotInfo(infos);
+    for (const auto& info : infos) {
+      if (*info.name_ref() == "aclTable") {
+        return info;
+      }
+    }
+    throw FbossError("no aclTable snapshot");
+  };
+  // Wait for the first refresh
+  for (int i = 0; i < 500 && *aclSnapshotInfo().refreshedAtMs_ref() == 0;
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::vector<AclEntryThrift> acls;
+  handler.getAclTable(acls);
+  EXPECT_EQ(*aclSnapshotInfo().numServed_ref(), 1);
+  std::vector<AclEntryThrift> liveAcls;
+  liveHandler.getAclTable(liveAcls);
+  EXPECT_EQ(acls, liveAcls);
+
+  // Disabled by default
+  std::vector<ReadSnapshotInfo> infos;
+  liveHandler.getReadSnapshotInfo(infos);
+  EXPECT_TRUE(infos.empty());
+}
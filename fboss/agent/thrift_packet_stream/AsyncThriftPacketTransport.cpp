@@ -10,11 +10,30 @@ ssize_t AsyncThriftPacketTransport::send(
   if (!buf) {
     return 0;
   }
-  TPacket packet;
-  *packet.l2Port_ref() = iface();
-  *packet.buf_ref() = buf->moveToFbString().toStdString();
+  std::vector<std::unique_ptr<folly::IOBuf>> bufs;
+  bufs.push_back(buf->clone());
+  return send(bufs);
+}
+
+ssize_t AsyncThriftPacketTransport::send(
+    const std::vector<std::unique_ptr<folly::IOBuf>>& bufs) {
+  TPacketBatch batch;
+  batch.packets_ref()->reserve(bufs.size());
+  for (const auto& buf : bufs) {
+    if (!buf) {
+      continue;
+    }
+    TIOBufPacket packet;
+    *packet.l2Port_ref() = iface();
+    // Shares the buffer rather than copying it
+    *packet.buf_ref() = buf->cloneAsValue();
+    batch.packets_ref()->push_back(std::move(packet));
+  }
+  if (batch.packets_ref()->empty()) {
+    return 0;
+  }
   if (auto serverSharedPtr = server_.lock()) {
-    return serverSharedPtr->send(std::move(packet));
+    return serverSharedPtr->send(std::move(batch));
   }
   LOG(ERROR) << "AsyncThriftPacketTransport server not available";
   return 0;
@@ -6,6 +6,7 @@
 #include "fboss/agent/thrift_packet_stream/BidirectionalPacketStream.h"
 
 #include <memory>
+#include <vector>
 
 namespace facebook {
 namespace fboss {
@@ -26,6 +27,11 @@ class AsyncThriftPacketTransport : public AsyncPacketTransport {
    * Send the data in buffer to destination. Returns the return code from send.
    */
   virtual ssize_t send(const std::unique_ptr<folly::IOBuf>& buf) override;
+  /**
+   * Send all the buffers in one stream message. Returns the number of bytes
+   * sent, or -1 on failure.
+   */
+  ssize_t send(const std::vector<std::unique_ptr<folly::IOBuf>>& bufs);
 
   void recvPacket(TPacket&& packet) {
     if (!isReading()) {
@@ -33,6 +39,13 @@ class AsyncThriftPacketTransport : public AsyncPacketTransport {
     }
     readCallback_->onDataAvailable(folly::IOBuf::copyBuffer(*packet.buf_ref()));
   }
+  void recvPacket(TIOBufPacket&& packet) {
+    if (!isReading()) {
+      return;
+    }
+    readCallback_->onDataAvailable(
+        std::make_unique<folly::IOBuf>(std::move(*packet.buf_ref())));
+  }
   /**
    * Stop listening on the socket.
    */
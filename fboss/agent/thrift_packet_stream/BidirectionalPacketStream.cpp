@@ -2,6 +2,7 @@
 
 #include "fboss/agent/thrift_packet_stream/BidirectionalPacketStream.h"
 #include "fboss/agent/thrift_packet_stream/AsyncThriftPacketTransport.h"
+#include "fboss/agent/thrift_packet_stream/TPacketConversions.h"
 
 namespace facebook {
 namespace fboss {
@@ -71,9 +72,10 @@ BidirectionalPacketStream::BidirectionalPacketStream(
     folly::EventBase* ioEventBase,
     folly::EventBase* timerEventBase,
     double timeout,
-    BidirectionalPacketAcceptor* acceptor)
+    BidirectionalPacketAcceptor* acceptor,
+    bool batched)
     : PacketStreamService(serviceName),
-      PacketStreamClient(serviceName, ioEventBase),
+      PacketStreamClient(serviceName, ioEventBase, batched),
       folly::AsyncTimeout(timerEventBase),
       evb_(timerEventBase),
       timeout_(timeout),
@@ -251,6 +253,41 @@ void BidirectionalPacketStream::recvPacket(TPacket&& packet) {
   }
 }
 
+void BidirectionalPacketStream::recvPacketBatch(TPacketBatch&& batch) {
+  auto& packets = *batch.packets_ref();
+  STATS_pkt_recvd.add(packets.size());
+  size_t failed = 0;
+  transportMap_.withRLock([&](auto& lockedMap) {
+    for (auto& packet : packets) {
+      const auto& port = *packet.l2Port_ref();
+      if (port.empty()) {
+        LOG(ERROR) << "Packet received with port empty";
+        STATS_err_pkt_recv_empty_port.add(1);
+        continue;
+      }
+      auto iter = lockedMap.find(port);
+      if (iter != lockedMap.end()) {
+        auto* transport =
+            reinterpret_cast<AsyncThriftPacketTransport*>(iter->second.get());
+        transport->recvPacket(std::move(packet));
+        continue;
+      }
+      // pass the packet to default receiver.
+      auto acceptor = acceptor_.load();
+      if (acceptor) {
+        acceptor->recvPacket(toTPacket(std::move(packet)));
+        continue;
+      }
+      LOG(ERROR) << "Packet received for port:" << port
+                 << " that's doesn't have transport to forward";
+      ++failed;
+    }
+  });
+  if (failed) {
+    throw std::runtime_error("acceptor not registered");
+  }
+}
+
 ssize_t BidirectionalPacketStream::send(TPacket&& packet) {
   if (!clientConnected_.load()) {
     STATS_err_send_client_not_connected.add(1);
@@ -271,6 +308,28 @@ ssize_t BidirectionalPacketStream::send(TPacket&& packet) {
   return sz;
 }
 
+ssize_t BidirectionalPacketStream::send(TPacketBatch&& batch) {
+  if (!clientConnected_.load()) {
+    STATS_err_send_client_not_connected.add(1);
+    LOG(ERROR) << "client not yet connected";
+    return -1;
+  }
+  ssize_t sz = 0;
+  for (const auto& packet : *batch.packets_ref()) {
+    sz += packet.buf_ref()->computeChainDataLength();
+  }
+  auto numPackets = batch.packets_ref()->size();
+  try {
+    PacketStreamService::send(connectedClientId_, std::move(batch));
+  } catch (const std::exception& ex) {
+    LOG(ERROR) << "send packets failed:" << ex.what();
+    STATS_err_send_pkt_failed.add(1);
+    return -1;
+  }
+  STATS_pkt_send_success.add(numPackets);
+  return sz;
+}
+
 // server calls. Right now supports one birectional connection so we don't
 // care about the client id.
 void BidirectionalPacketStream::clientConnected(const std::string& clientId) {
@@ -30,7 +30,8 @@ class BidirectionalPacketStream
       folly::EventBase* ioEventBase,
       folly::EventBase* timerEventBase,
       double timeout,
-      BidirectionalPacketAcceptor* acceptor = nullptr);
+      BidirectionalPacketAcceptor* acceptor = nullptr,
+      bool batched = false);
 
   virtual ~BidirectionalPacketStream() override;
 
@@ -42,6 +43,8 @@ class BidirectionalPacketStream
   std::shared_ptr<AsyncPacketTransport> listen(const std::string& port);
   void close(const std::string& port);
   ssize_t send(TPacket&& packet);
+  // Returns the number of bytes sent, or -1 if no packet was sent
+  ssize_t send(TPacketBatch&& batch);
 
   void setPacketAcceptor(BidirectionalPacketAcceptor* acceptor) {
     acceptor_.store(acceptor);
@@ -55,6 +58,7 @@ class BidirectionalPacketStream
  protected:
   // client calls
   virtual void recvPacket(TPacket&& packet) override;
+  virtual void recvPacketBatch(TPacketBatch&& batch) override;
   // server calls
   virtual void clientConnected(const std::string& clientId) override;
   virtual void clientDisconnected(const std::string& clientId) override;
@@ -1,5 +1,6 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 #include "fboss/agent/thrift_packet_stream/PacketStreamClient.h"
+#include "fboss/agent/thrift_packet_stream/TPacketConversions.h"
 #include <folly/io/async/AsyncSocket.h>
 #include <thrift/lib/cpp2/async/RocketClientChannel.h>
 
@@ -8,8 +9,10 @@ namespace fboss {
 
 PacketStreamClient::PacketStreamClient(
     const std::string& clientId,
-    folly::EventBase* evb)
+    folly::EventBase* evb,
+    bool batched)
     : clientId_(clientId),
+      batched_(batched),
       evb_(evb),
       clientEvbThread_(
           std::make_unique<folly::ScopedEventBaseThread>(clientId)) {
@@ -80,8 +83,8 @@ void PacketStreamClient::connectToServer(const std::string& ip, uint16_t port) {
 }
 
 #if FOLLY_HAS_COROUTINES
-folly::coro::Task<void> PacketStreamClient::connect() {
-  auto result = co_await client_->co_connect(clientId_);
+template <typename Stream>
+folly::coro::Task<void> PacketStreamClient::receive(Stream stream) {
   if (cancelSource_->isCancellationRequested()) {
     state_.store(State::INIT);
     LOG(ERROR) << "Cancellation Requested;";
@@ -92,11 +95,11 @@ folly::coro::Task<void> PacketStreamClient::connect() {
   co_await folly::coro::co_withCancellation(
       cancelSource_->getToken(),
       folly::coro::co_invoke(
-          [gen = std::move(result).toAsyncGenerator(),
+          [gen = std::move(stream).toAsyncGenerator(),
            this]() mutable -> folly::coro::Task<void> {
             try {
-              while (auto packet = co_await gen.next()) {
-                recvPacket(std::move(*packet));
+              while (auto message = co_await gen.next()) {
+                dispatch(std::move(*message));
               }
             } catch (const std::exception& ex) {
               LOG(ERROR) << clientId_
@@ -107,8 +110,22 @@ folly::coro::Task<void> PacketStreamClient::connect() {
           }));
   VLOG(2) << "Client Cancellation Completed";
 }
+
+folly::coro::Task<void> PacketStreamClient::connect() {
+  if (batched_) {
+    co_await receive(co_await client_->co_connectBatched(clientId_));
+  } else {
+    co_await receive(co_await client_->co_connect(clientId_));
+  }
+}
 #endif
 
+void PacketStreamClient::recvPacketBatch(TPacketBatch&& batch) {
+  for (auto& packet : *batch.packets_ref()) {
+    recvPacket(toTPacket(std::move(packet)));
+  }
+}
+
 void PacketStreamClient::cancel() {
   LOG(INFO) << "Cancel PacketStreamClient";
 
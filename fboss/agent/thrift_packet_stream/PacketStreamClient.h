@@ -14,9 +14,12 @@ namespace facebook {
 namespace fboss {
 class PacketStreamClient {
  public:
+  // A batched client connects with connectBatched(), and receives packets
+  // through recvPacketBatch()
   explicit PacketStreamClient(
       const std::string& clientId,
-      folly::EventBase* evb);
+      folly::EventBase* evb,
+      bool batched = false);
 
   virtual ~PacketStreamClient();
   void connectToServer(const std::string& ip, uint16_t port);
@@ -30,6 +33,9 @@ class PacketStreamClient {
   // will have the logic to do operation after receiving this
   // packet.
   virtual void recvPacket(TPacket&& packet) = 0;
+  // Batched clients should override this to handle the packets without
+  // copying them, by default they are passed on to recvPacket().
+  virtual void recvPacketBatch(TPacketBatch&& batch);
 
  private:
   enum class State : uint16_t {
@@ -38,11 +44,20 @@ class PacketStreamClient {
     CONNECTED = 2,
   };
   void createClient(const std::string& ip, uint16_t port);
+  void dispatch(TPacket&& packet) {
+    recvPacket(std::move(packet));
+  }
+  void dispatch(TPacketBatch&& batch) {
+    recvPacketBatch(std::move(batch));
+  }
 #if FOLLY_HAS_COROUTINES
   folly::coro::Task<void> connect();
+  template <typename Stream>
+  folly::coro::Task<void> receive(Stream stream);
   std::unique_ptr<folly::CancellationSource> cancelSource_;
 #endif
   std::string clientId_;
+  bool batched_;
   std::unique_ptr<PacketStreamAsyncClient> client_;
   folly::EventBase* evb_;
   std::atomic<State> state_{State::INIT};
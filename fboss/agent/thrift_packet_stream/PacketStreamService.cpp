@@ -1,6 +1,7 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 
 #include "fboss/agent/thrift_packet_stream/PacketStreamService.h"
+#include "fboss/agent/thrift_packet_stream/TPacketConversions.h"
 
 namespace facebook {
 namespace fboss {
@@ -9,9 +10,7 @@ PacketStreamService::~PacketStreamService() {
   try {
     clientMap_.withWLock([](auto& lockedMap) {
       for (auto& iter : lockedMap) {
-        auto& clientInfo = iter.second;
-        auto publisher = std::move(clientInfo.publisher_);
-        std::move(*publisher.get()).complete();
+        iter.second.complete();
       }
       lockedMap.clear();
     });
@@ -29,8 +28,30 @@ static TPacketException createTPacketException(
   return ex;
 }
 
+void PacketStreamService::ClientInfo::complete() {
+  if (publisher_) {
+    auto publisher = std::move(publisher_);
+    std::move(*publisher.get()).complete();
+  }
+  if (batchPublisher_) {
+    auto publisher = std::move(batchPublisher_);
+    std::move(*publisher.get()).complete();
+  }
+}
+
 apache::thrift::ServerStream<TPacket> PacketStreamService::connect(
     std::unique_ptr<std::string> clientIdPtr) {
+  return connectClient<TPacket>(std::move(clientIdPtr));
+}
+
+apache::thrift::ServerStream<TPacketBatch> PacketStreamService::connectBatched(
+    std::unique_ptr<std::string> clientIdPtr) {
+  return connectClient<TPacketBatch>(std::move(clientIdPtr));
+}
+
+template <typename T>
+apache::thrift::ServerStream<T> PacketStreamService::connectClient(
+    std::unique_ptr<std::string> clientIdPtr) {
   try {
     if (!clientIdPtr || clientIdPtr->empty()) {
       LOG(ERROR) << "Invalid Client";
@@ -38,16 +59,15 @@ apache::thrift::ServerStream<TPacket> PacketStreamService::connect(
           TPacketErrorCode::INVALID_CLIENT, "Invalid client");
     }
     const auto& clientId = *clientIdPtr;
-    auto streamAndPublisher =
-        apache::thrift::ServerStream<TPacket>::createPublisher(
-            [client = clientId, this] {
-              // when the client is disconnected run this section.
-              LOG(INFO) << "Client disconnected: " << client;
-              clientMap_.withWLock([client = client](auto& lockedMap) {
-                lockedMap.erase(client);
-              });
-              clientDisconnected(client);
-            });
+    auto streamAndPublisher = apache::thrift::ServerStream<T>::createPublisher(
+        [client = clientId, this] {
+          // when the client is disconnected run this section.
+          LOG(INFO) << "Client disconnected: " << client;
+          clientMap_.withWLock([client = client](auto& lockedMap) {
+            lockedMap.erase(client);
+          });
+          clientDisconnected(client);
+        });
 
     clientMap_.withWLock(
         [client = clientId,
@@ -65,22 +85,57 @@ apache::thrift::ServerStream<TPacket> PacketStreamService::connect(
   }
 }
 
+const PacketStreamService::ClientInfo& PacketStreamService::getClientInfo(
+    const ClientMap& clientMap,
+    const std::string& clientId) {
+  auto iter = clientMap.find(clientId);
+  if (iter == clientMap.end()) {
+    LOG(ERROR) << "Client '" << clientId << "' Not Connected";
+    throw createTPacketException(
+        TPacketErrorCode::CLIENT_NOT_CONNECTED, "client not connected");
+  }
+  return iter->second;
+}
+
+void PacketStreamService::checkPortRegistered(
+    const ClientInfo& clientInfo,
+    const std::string& port) {
+  if (clientInfo.portList_.find(port) == clientInfo.portList_.end()) {
+    LOG(ERROR) << "Port '" << port << "'Not Registered";
+    throw createTPacketException(
+        TPacketErrorCode::PORT_NOT_REGISTERED, "PORT not registered");
+  }
+}
+
 void PacketStreamService::send(const std::string& clientId, TPacket&& packet) {
   clientMap_.withRLock([&](auto& lockedMap) {
-    auto iter = lockedMap.find(clientId);
-    if (iter == lockedMap.end()) {
-      LOG(ERROR) << "Client '" << clientId << "' Not Connected";
-      throw createTPacketException(
-          TPacketErrorCode::CLIENT_NOT_CONNECTED, "client not connected");
+    const auto& clientInfo = getClientInfo(lockedMap, clientId);
+    checkPortRegistered(clientInfo, *packet.l2Port_ref());
+    if (clientInfo.batchPublisher_) {
+      TPacketBatch batch;
+      batch.packets_ref()->push_back(toIOBufPacket(std::move(packet)));
+      clientInfo.batchPublisher_->next(std::move(batch));
+    } else {
+      clientInfo.publisher_->next(std::move(packet));
     }
-    const auto& clientInfo = iter->second;
-    auto portIter = clientInfo.portList_.find(*packet.l2Port_ref());
-    if (portIter == clientInfo.portList_.end()) {
-      LOG(ERROR) << "Port '" << *packet.l2Port_ref() << "'Not Registered";
-      throw createTPacketException(
-          TPacketErrorCode::PORT_NOT_REGISTERED, "PORT not registered");
+  });
+}
+
+void PacketStreamService::send(
+    const std::string& clientId,
+    TPacketBatch&& batch) {
+  clientMap_.withRLock([&](auto& lockedMap) {
+    const auto& clientInfo = getClientInfo(lockedMap, clientId);
+    for (const auto& packet : *batch.packets_ref()) {
+      checkPortRegistered(clientInfo, *packet.l2Port_ref());
+    }
+    if (clientInfo.batchPublisher_) {
+      clientInfo.batchPublisher_->next(std::move(batch));
+    } else {
+      for (auto& packet : *batch.packets_ref()) {
+        clientInfo.publisher_->next(toTPacket(std::move(packet)));
+      }
     }
-    clientInfo.publisher_->next(packet);
   });
 }
 
@@ -185,9 +240,7 @@ void PacketStreamService::disconnect(std::unique_ptr<std::string> clientIdPtr) {
       throw createTPacketException(
           TPacketErrorCode::CLIENT_NOT_CONNECTED, "client not connected");
     }
-    auto& clientInfo = iter->second;
-    auto publisher = std::move(clientInfo.publisher_);
-    std::move(*publisher.get()).complete();
+    iter->second.complete();
     lockedMap.erase(iter);
     clientDisconnected(clientId);
   });
@@ -15,6 +15,9 @@ class PacketStreamService : virtual public PacketStreamSvIf,
 
   // helper functions.
   void send(const std::string& clientId, TPacket&& packet);
+  // Sends all the packets in one stream message to clients connected with
+  // connectBatched().  Nothing is sent if any port isn't registered.
+  void send(const std::string& clientId, TPacketBatch&& batch);
   bool isClientConnected(const std::string& clientId);
   bool isPortRegistered(const std::string& clientId, const std::string& port);
 
@@ -24,6 +27,8 @@ class PacketStreamService : virtual public PacketStreamSvIf,
   }
   apache::thrift::ServerStream<TPacket> connect(
       std::unique_ptr<std::string> clientId) override;
+  apache::thrift::ServerStream<TPacketBatch> connectBatched(
+      std::unique_ptr<std::string> clientId) override;
   void registerPort(
       std::unique_ptr<std::string> clientId,
       std::unique_ptr<std::string> l2Port) override;
@@ -50,10 +55,35 @@ class PacketStreamService : virtual public PacketStreamSvIf,
         : publisher_(
               std::make_unique<apache::thrift::ServerStreamPublisher<TPacket>>(
                   std::move(pub))) {}
+    explicit ClientInfo(
+        apache::thrift::ServerStreamPublisher<TPacketBatch> pub)
+        : batchPublisher_(
+              std::make_unique<
+                  apache::thrift::ServerStreamPublisher<TPacketBatch>>(
+                  std::move(pub))) {}
+    void complete();
+
     std::unordered_set<std::string> portList_;
+    // Only one of the publishers is set, depending on how the client
+    // connected
     std::unique_ptr<apache::thrift::ServerStreamPublisher<TPacket>> publisher_;
+    std::unique_ptr<apache::thrift::ServerStreamPublisher<TPacketBatch>>
+        batchPublisher_;
   };
   using ClientMap = std::unordered_map<std::string, ClientInfo>;
+
+  template <typename T>
+  apache::thrift::ServerStream<T> connectClient(
+      std::unique_ptr<std::string> clientIdPtr);
+  // Throw TPacketException if the client isn't connected, or the port
+  // isn't registered
+  static const ClientInfo& getClientInfo(
+      const ClientMap& clientMap,
+      const std::string& clientId);
+  static void checkPortRegistered(
+      const ClientInfo& clientInfo,
+      const std::string& port);
+
   folly::Synchronized<ClientMap> clientMap_;
 };
 
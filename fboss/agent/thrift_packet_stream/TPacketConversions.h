@@ -0,0 +1,30 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <fboss/agent/if/gen-cpp2/packet_stream_types.h>
+
+namespace facebook {
+namespace fboss {
+
+// Takes over the payload of the string without copying it
+inline TIOBufPacket toIOBufPacket(TPacket&& packet) {
+  TIOBufPacket ioBufPacket;
+  *ioBufPacket.timestamp_ref() = *packet.timestamp_ref();
+  *ioBufPacket.l2Port_ref() = std::move(*packet.l2Port_ref());
+  *ioBufPacket.buf_ref() =
+      std::move(*folly::IOBuf::fromString(std::move(*packet.buf_ref())));
+  return ioBufPacket;
+}
+
+// Copies the payload, for peers that only handle TPacket
+inline TPacket toTPacket(TIOBufPacket&& ioBufPacket) {
+  TPacket packet;
+  *packet.timestamp_ref() = *ioBufPacket.timestamp_ref();
+  *packet.l2Port_ref() = std::move(*ioBufPacket.l2Port_ref());
+  *packet.buf_ref() = ioBufPacket.buf_ref()->moveToFbString().toStdString();
+  return packet;
+}
+
+} // namespace fboss
+} // namespace facebook
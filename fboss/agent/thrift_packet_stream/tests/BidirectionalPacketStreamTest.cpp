@@ -1,6 +1,7 @@
 // Copyright 2004-present Facebook.  All rights reserved.
 
 #include "fboss/agent/thrift_packet_stream/BidirectionalPacketStream.h"
+#include "fboss/agent/thrift_packet_stream/AsyncThriftPacketTransport.h"
 #include <folly/Memory.h>
 #include <folly/Random.h>
 #include <folly/io/async/EventBase.h>
@@ -316,7 +317,12 @@ class BidirectionalPacketStreamTest : public Test {
     baton_ = std::make_shared<folly::Baton<>>();
 
     mkaServerStream_ = std::make_shared<BidirectionalPacketStream>(
-        "mka_server", mkaClientThread_->getEventBase(), &evb_, g_connect_timer);
+        "mka_server",
+        mkaClientThread_->getEventBase(),
+        &evb_,
+        g_connect_timer,
+        nullptr,
+        batched_);
     mkaServer_ = std::make_unique<apache::thrift::ScopedServerInterfaceThread>(
         mkaServerStream_);
 
@@ -324,7 +330,9 @@ class BidirectionalPacketStreamTest : public Test {
         "fboss_agent",
         fbossClientThread_->getEventBase(),
         &evb_,
-        g_connect_timer);
+        g_connect_timer,
+        nullptr,
+        batched_);
     fbossAgent_ = std::make_unique<apache::thrift::ScopedServerInterfaceThread>(
         fbossAgentStream_);
   }
@@ -345,6 +353,8 @@ class BidirectionalPacketStreamTest : public Test {
   }
 
   std::shared_ptr<folly::Baton<>> baton_;
+  // Whether the streams connect to each other with connectBatched()
+  bool batched_{false};
 
   std::unique_ptr<folly::ScopedEventBaseThread> mkaClientThread_;
   std::unique_ptr<folly::ScopedEventBaseThread> fbossClientThread_;
@@ -357,6 +367,14 @@ class BidirectionalPacketStreamTest : public Test {
   std::unique_ptr<std::thread> timeThread_;
 };
 
+class BatchedBidirectionalPacketStreamTest
+    : public BidirectionalPacketStreamTest {
+ public:
+  BatchedBidirectionalPacketStreamTest() {
+    batched_ = true;
+  }
+};
+
 #if FOLLY_HAS_COROUTINES
 TEST_F(BidirectionalPacketStreamTest, InvalidTimerTest) {
   EXPECT_THROW(
@@ -645,4 +663,36 @@ TEST_F(BidirectionalPacketStreamTest, MKADisconnect) {
   EXPECT_EQ(-1, fbossAgentStream_->send(std::move(packet)));
   EXPECT_FALSE(baton_->try_wait_for(std::chrono::milliseconds(50)));
 }
+TEST_F(BatchedBidirectionalPacketStreamTest, TestMultiplePkts) {
+  tryConnect();
+  auto port = "eth0";
+  auto transport = mkaServerStream_->listen(port);
+
+  sendMkaToFboss(100, port, transport);
+  sendFbossToMka(100, port, transport);
+}
+
+TEST_F(BatchedBidirectionalPacketStreamTest, SendBatch) {
+  tryConnect();
+  auto port = "eth0";
+  auto transport = std::dynamic_pointer_cast<AsyncThriftPacketTransport>(
+      mkaServerStream_->listen(port));
+  ASSERT_NE(transport, nullptr);
+
+  PacketRecvAcceptor rcvAcceptor(baton_);
+  rcvAcceptor.setExpectedPackets(10);
+  fbossAgentStream_->setPacketAcceptor(&rcvAcceptor);
+  baton_->reset();
+  std::vector<std::unique_ptr<folly::IOBuf>> bufs;
+  for (auto i = 0; i < 10; i++) {
+    bufs.push_back(folly::IOBuf::copyBuffer(g_mkaTofboss));
+  }
+  EXPECT_EQ(g_mkaTofboss.size() * 10, transport->send(bufs));
+  EXPECT_TRUE(baton_->try_wait_for(std::chrono::milliseconds(500)));
+  fbossAgentStream_->setPacketAcceptor(nullptr);
+  EXPECT_EQ(rcvAcceptor.packets_.size(), 10);
+  for (auto& pkt : rcvAcceptor.packets_) {
+    EXPECT_EQ(g_mkaTofboss, *pkt.buf_ref());
+  }
+}
 #endif
@@ -0,0 +1,170 @@
+// Copyright 2004-present Facebook.  All rights reserved.
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+#include "fboss/agent/thrift_packet_stream/PacketStreamClient.h"
+#include "fboss/agent/thrift_packet_stream/PacketStreamService.h"
+
+#include <atomic>
+#include <thread>
+
+DEFINE_int32(packet_stream_benchmark_pkt_size, 128, "Packet size in bytes");
+DEFINE_int32(
+    packet_stream_benchmark_batch_size,
+    32,
+    "Packets per stream message in the batched benchmarks");
+
+using namespace facebook::fboss;
+
+#if FOLLY_HAS_COROUTINES
+/*
+ * Packets streamed from a PacketStreamService to a client over loopback,
+ * one TPacket per stream message, and in TPacketBatch messages to a client
+ * connected with connectBatched().  Each iteration is one packet, and
+ * completes when the client received it.
+ */
+namespace {
+
+const std::string kClient = "benchmarkClient";
+const std::string kPort = "eth0";
+
+class BenchmarkService : public PacketStreamService {
+ public:
+  BenchmarkService() : PacketStreamService("PacketStreamBenchmark") {}
+
+ protected:
+  void clientConnected(const std::string& /* clientId */) override {}
+  void clientDisconnected(const std::string& /* clientId */) override {}
+  void addPort(const std::string& /* clientId */, const std::string& /* port */)
+      override {}
+  void removePort(
+      const std::string& /* clientId */,
+      const std::string& /* port */) override {}
+};
+
+class BenchmarkClient : public PacketStreamClient {
+ public:
+  BenchmarkClient(folly::EventBase* evb, bool batched)
+      : PacketStreamClient(kClient, evb, batched) {}
+
+  void waitForPackets(size_t numPkts) {
+    while (received_.load() < numPkts) {
+      std::this_thread::yield();
+    }
+    received_ = 0;
+  }
+
+ protected:
+  void recvPacket(TPacket&& packet) override {
+    folly::doNotOptimizeAway(packet.buf_ref()->size());
+    ++received_;
+  }
+  void recvPacketBatch(TPacketBatch&& batch) override {
+    for (const auto& packet : *batch.packets_ref()) {
+      folly::doNotOptimizeAway(packet.buf_ref()->length());
+    }
+    received_ += batch.packets_ref()->size();
+  }
+
+ private:
+  std::atomic<size_t> received_{0};
+};
+
+class BenchmarkSetup {
+ public:
+  explicit BenchmarkSetup(bool batched)
+      : service_(std::make_shared<BenchmarkService>()),
+        server_(service_),
+        client_(clientThread_.getEventBase(), batched) {
+    client_.connectToServer("::1", server_.getPort());
+    while (!client_.isConnectedToServer() ||
+           !service_->isClientConnected(kClient)) {
+      std::this_thread::yield();
+    }
+    client_.registerPortToServer(kPort);
+  }
+
+  PacketStreamService& service() {
+    return *service_;
+  }
+  BenchmarkClient& client() {
+    return client_;
+  }
+
+ private:
+  folly::ScopedEventBaseThread clientThread_;
+  std::shared_ptr<BenchmarkService> service_;
+  apache::thrift::ScopedServerInterfaceThread server_;
+  BenchmarkClient client_;
+};
+
+TPacket makePacket() {
+  TPacket packet;
+  *packet.l2Port_ref() = kPort;
+  *packet.buf_ref() = std::string(FLAGS_packet_stream_benchmark_pkt_size, 'x');
+  return packet;
+}
+
+TIOBufPacket makeIOBufPacket() {
+  TIOBufPacket packet;
+  *packet.l2Port_ref() = kPort;
+  auto buf = folly::IOBuf::create(FLAGS_packet_stream_benchmark_pkt_size);
+  buf->append(FLAGS_packet_stream_benchmark_pkt_size);
+  *packet.buf_ref() = std::move(*buf);
+  return packet;
+}
+
+void sendBatches(bool batched, size_t numIters) {
+  folly::BenchmarkSuspender suspender;
+  BenchmarkSetup setup(batched);
+  size_t batchSize = FLAGS_packet_stream_benchmark_batch_size;
+  suspender.dismiss();
+
+  for (size_t sent = 0; sent < numIters;) {
+    auto numPkts = std::min(batchSize, numIters - sent);
+    TPacketBatch batch;
+    batch.packets_ref()->reserve(numPkts);
+    for (size_t i = 0; i < numPkts; ++i) {
+      batch.packets_ref()->push_back(makeIOBufPacket());
+    }
+    setup.service().send(kClient, std::move(batch));
+    sent += numPkts;
+  }
+  setup.client().waitForPackets(numIters);
+
+  suspender.rehire();
+}
+
+} // namespace
+
+BENCHMARK(PacketStreamSend, numIters) {
+  folly::BenchmarkSuspender suspender;
+  BenchmarkSetup setup(false /* batched */);
+  suspender.dismiss();
+
+  for (size_t i = 0; i < numIters; ++i) {
+    setup.service().send(kClient, makePacket());
+  }
+  setup.client().waitForPackets(numIters);
+
+  suspender.rehire();
+}
+
+// Batches are split in one TPacket per packet for a client that isn't
+// batched, this only saves the client map lookups
+BENCHMARK_RELATIVE(PacketStreamSendBatchUnbatchedClient, numIters) {
+  sendBatches(false /* batched */, numIters);
+}
+
+BENCHMARK_RELATIVE(PacketStreamSendBatch, numIters) {
+  sendBatches(true /* batched */, numIters);
+}
+#endif
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -53,8 +53,9 @@ class DerivedPacketStreamClient : public PacketStreamClient {
   DerivedPacketStreamClient(
       const std::string& clientId,
       folly::EventBase* evb,
-      std::shared_ptr<folly::Baton<>> baton)
-      : PacketStreamClient(clientId, evb), baton_(baton) {}
+      std::shared_ptr<folly::Baton<>> baton,
+      bool batched = false)
+      : PacketStreamClient(clientId, evb, batched), baton_(baton) {}
   virtual void recvPacket(TPacket&& packet) override {
     EXPECT_FALSE(g_ports.find(*packet.l2Port_ref()) == g_ports.end());
     EXPECT_EQ(g_pktCnt, *packet.buf_ref());
@@ -63,11 +64,23 @@ class DerivedPacketStreamClient : public PacketStreamClient {
       baton_->post();
     }
   }
+  virtual void recvPacketBatch(TPacketBatch&& batch) override {
+    batchCnt_++;
+    for (auto& packet : *batch.packets_ref()) {
+      EXPECT_FALSE(g_ports.find(*packet.l2Port_ref()) == g_ports.end());
+      EXPECT_EQ(g_pktCnt, packet.buf_ref()->moveToFbString().toStdString());
+      pktCnt_[*packet.l2Port_ref()]++;
+    }
+    if (baton_) {
+      baton_->post();
+    }
+  }
   size_t getPckCnt(const std::string& port) {
     return pktCnt_[port].load();
   }
 
   std::unordered_map<std::string, std::atomic<size_t>> pktCnt_;
+  std::atomic<size_t> batchCnt_{0};
   std::shared_ptr<folly::Baton<>> baton_;
 };
 
@@ -118,6 +131,17 @@ class PacketStreamTest : public Test {
     *pkt.buf_ref() = g_pktCnt;
     EXPECT_NO_THROW(handler_->send(g_client, std::move(pkt)));
   }
+
+  TPacketBatch makeBatch(const std::string& port, size_t numPkts) {
+    TPacketBatch batch;
+    for (size_t i = 0; i < numPkts; i++) {
+      TIOBufPacket pkt;
+      *pkt.l2Port_ref() = port;
+      *pkt.buf_ref() = folly::IOBuf(folly::IOBuf::COPY_BUFFER, g_pktCnt);
+      batch.packets_ref()->push_back(std::move(pkt));
+    }
+    return batch;
+  }
   std::shared_ptr<folly::Baton<>> baton_;
   std::shared_ptr<DerivedPacketStreamService> handler_;
   std::unique_ptr<apache::thrift::ScopedServerInterfaceThread> server_;
@@ -167,6 +191,66 @@ TEST_F(PacketStreamTest, PacketSendMultiple) {
   clientReset(std::move(streamClient));
 }
 
+TEST_F(PacketStreamTest, PacketSendBatch) {
+  std::string port(*g_ports.begin());
+  auto baton = std::make_shared<folly::Baton<>>();
+  auto streamClient = std::make_unique<DerivedPacketStreamClient>(
+      g_client, clientThread_.getEventBase(), baton);
+  tryConnect(baton, *streamClient);
+  EXPECT_NO_THROW(streamClient->registerPortToServer(port));
+  streamClient->baton_ = nullptr;
+  // The client didn't connect batched, so it gets one packet at a time
+  EXPECT_NO_THROW(handler_->send(g_client, makeBatch(port, 10)));
+  baton->reset();
+  EXPECT_FALSE(baton->try_wait_for(std::chrono::milliseconds(50)));
+  EXPECT_EQ(streamClient->getPckCnt(port), 10);
+  EXPECT_EQ(streamClient->batchCnt_.load(), 0);
+  clientReset(std::move(streamClient));
+}
+
+TEST_F(PacketStreamTest, BatchedClientPacketSend) {
+  std::string port(*g_ports.begin());
+  auto baton = std::make_shared<folly::Baton<>>();
+  auto streamClient = std::make_unique<DerivedPacketStreamClient>(
+      g_client, clientThread_.getEventBase(), baton, true /* batched */);
+  tryConnect(baton, *streamClient);
+  EXPECT_NO_THROW(streamClient->registerPortToServer(port));
+
+  baton->reset();
+  sendPkt(port);
+  EXPECT_TRUE(baton->try_wait_for(std::chrono::milliseconds(50)));
+  EXPECT_EQ(streamClient->getPckCnt(port), 1);
+  EXPECT_EQ(streamClient->batchCnt_.load(), 1);
+
+  baton->reset();
+  EXPECT_NO_THROW(handler_->send(g_client, makeBatch(port, 10)));
+  EXPECT_TRUE(baton->try_wait_for(std::chrono::milliseconds(50)));
+  EXPECT_EQ(streamClient->getPckCnt(port), 11);
+  EXPECT_EQ(streamClient->batchCnt_.load(), 2);
+  clientReset(std::move(streamClient));
+}
+
+TEST_F(PacketStreamTest, PacketSendBatchUnregisteredPort) {
+  auto it = g_ports.begin();
+  std::string port(*it++);
+  std::string unregisteredPort(*it);
+  auto baton = std::make_shared<folly::Baton<>>();
+  auto streamClient = std::make_unique<DerivedPacketStreamClient>(
+      g_client, clientThread_.getEventBase(), baton, true /* batched */);
+  tryConnect(baton, *streamClient);
+  EXPECT_NO_THROW(streamClient->registerPortToServer(port));
+
+  auto batch = makeBatch(port, 2);
+  auto other = makeBatch(unregisteredPort, 1);
+  batch.packets_ref()->push_back(std::move(other.packets_ref()->front()));
+  EXPECT_THROW(handler_->send(g_client, std::move(batch)), TPacketException);
+  // None of the packets are sent
+  baton->reset();
+  EXPECT_FALSE(baton->try_wait_for(std::chrono::milliseconds(50)));
+  EXPECT_EQ(streamClient->batchCnt_.load(), 0);
+  clientReset(std::move(streamClient));
+}
+
 TEST_F(PacketStreamTest, UnregisterPortToServerFail) {
   std::string port(*g_ports.begin());
   auto baton = std::make_shared<folly::Baton<>>();
@@ -0,0 +1,318 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/ColumnarCounterStore.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+using facebook::fboss::ColumnarCounterStore;
+
+uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+      static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void appendVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+uint64_t readVarint(const char*& in) {
+  uint64_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    auto byte = static_cast<uint8_t>(*in++);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+}
+
+void skipVarint(const char*& in) {
+  while (static_cast<uint8_t>(*in++) & 0x80) {
+  }
+}
+
+uint64_t encode(
+    ColumnarCounterStore::Encoding encoding,
+    int64_t older,
+    int64_t newer) {
+  if (encoding == ColumnarCounterStore::Encoding::XOR) {
+    return static_cast<uint64_t>(older) ^ static_cast<uint64_t>(newer);
+  }
+  // Wrap around subtraction, the difference of two counters may not fit
+  return zigzag(static_cast<int64_t>(
+      static_cast<uint64_t>(older) - static_cast<uint64_t>(newer)));
+}
+
+int64_t decode(
+    ColumnarCounterStore::Encoding encoding,
+    uint64_t encoded,
+    int64_t newer) {
+  if (encoding == ColumnarCounterStore::Encoding::XOR) {
+    return static_cast<int64_t>(encoded ^ static_cast<uint64_t>(newer));
+  }
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(unzigzag(encoded)) + static_cast<uint64_t>(newer));
+}
+
+/*
+ * Aggregation kernels. Sums wrap around on overflow rather than being
+ * undefined.
+ */
+ColumnarCounterStore::Aggregate aggregateScalar(
+    const int64_t* values,
+    size_t count) {
+  ColumnarCounterStore::Aggregate result;
+  if (!count) {
+    return result;
+  }
+  result.min = std::numeric_limits<int64_t>::max();
+  result.max = std::numeric_limits<int64_t>::min();
+  uint64_t sum = 0;
+  for (size_t i = 0; i < count; ++i) {
+    result.min = std::min(result.min, values[i]);
+    result.max = std::max(result.max, values[i]);
+    sum += static_cast<uint64_t>(values[i]);
+  }
+  result.sum = static_cast<int64_t>(sum);
+  return result;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) ColumnarCounterStore::Aggregate
+aggregateAvx2(const int64_t* values, size_t count) {
+  if (count < 4) {
+    return aggregateScalar(values, count);
+  }
+  auto minLanes = _mm256_set1_epi64x(std::numeric_limits<int64_t>::max());
+  auto maxLanes = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+  auto sumLanes = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    // No 64 bit min/max before AVX-512, select with a compare
+    minLanes =
+        _mm256_blendv_epi8(minLanes, v, _mm256_cmpgt_epi64(minLanes, v));
+    maxLanes =
+        _mm256_blendv_epi8(maxLanes, v, _mm256_cmpgt_epi64(v, maxLanes));
+    sumLanes = _mm256_add_epi64(sumLanes, v);
+  }
+  alignas(32) int64_t mins[4];
+  alignas(32) int64_t maxs[4];
+  alignas(32) int64_t sums[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(mins), minLanes);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), maxLanes);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sums), sumLanes);
+  ColumnarCounterStore::Aggregate result;
+  result.min = *std::min_element(mins, mins + 4);
+  result.max = *std::max_element(maxs, maxs + 4);
+  uint64_t sum = 0;
+  for (auto lane : sums) {
+    sum += static_cast<uint64_t>(lane);
+  }
+  if (i < count) {
+    auto tail = aggregateScalar(values + i, count - i);
+    result.min = std::min(result.min, tail.min);
+    result.max = std::max(result.max, tail.max);
+    sum += static_cast<uint64_t>(tail.sum);
+  }
+  result.sum = static_cast<int64_t>(sum);
+  return result;
+}
+#endif
+
+using AggregateFn =
+    ColumnarCounterStore::Aggregate (*)(const int64_t*, size_t);
+
+AggregateFn selectAggregate() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return aggregateAvx2;
+  }
+#endif
+  return aggregateScalar;
+}
+
+ColumnarCounterStore::Aggregate aggregateValues(
+    const int64_t* values,
+    size_t count) {
+  static const AggregateFn aggregateFn = selectAggregate();
+  return aggregateFn(values, count);
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+ColumnarCounterStore::ColumnarCounterStore(
+    std::vector<Column> columns,
+    size_t maxHistory)
+    : columns_(std::move(columns)),
+      maxHistory_(maxHistory),
+      current_(columns_.size()),
+      latest_(columns_.size()),
+      previous_(columns_.size()) {}
+
+size_t ColumnarCounterStore::rowIndex(const std::string& rowName) {
+  auto [itr, inserted] = rowIndices_.emplace(rowName, rowNames_.size());
+  if (inserted) {
+    rowNames_.push_back(rowName);
+    for (size_t column = 0; column < columns_.size(); ++column) {
+      current_[column].push_back(0);
+      latest_[column].push_back(0);
+      previous_[column].push_back(0);
+    }
+  }
+  return itr->second;
+}
+
+std::optional<size_t> ColumnarCounterStore::findRow(
+    const std::string& rowName) const {
+  auto itr = rowIndices_.find(rowName);
+  if (itr == rowIndices_.end()) {
+    return std::nullopt;
+  }
+  return itr->second;
+}
+
+void ColumnarCounterStore::resetRow(size_t row) {
+  for (auto& values : current_) {
+    values[row] = 0;
+  }
+}
+
+void ColumnarCounterStore::beginCycle(std::chrono::seconds timestamp) {
+  currentTimestamp_ = timestamp;
+}
+
+void ColumnarCounterStore::endCycle() {
+  if (numCycles_ >= 2 && maxHistory_) {
+    compressPrevious();
+  }
+  previous_.swap(latest_);
+  previousTimestamp_ = latestTimestamp_;
+  previousNumRows_ = latestNumRows_;
+  // current_ keeps its values, so counters not set in the next cycle carry
+  // over
+  latest_ = current_;
+  latestTimestamp_ = currentTimestamp_;
+  latestNumRows_ = numRows();
+  ++numCycles_;
+}
+
+void ColumnarCounterStore::compressPrevious() {
+  CompressedCycle cycle;
+  cycle.timestamp = previousTimestamp_;
+  cycle.numRows = previousNumRows_;
+  cycle.columns.resize(columns_.size());
+  for (size_t column = 0; column < columns_.size(); ++column) {
+    auto encoding = columns_[column].encoding;
+    auto& out = cycle.columns[column];
+    out.reserve(previousNumRows_ * 2);
+    for (size_t row = 0; row < previousNumRows_; ++row) {
+      appendVarint(
+          out,
+          encode(encoding, previous_[column][row], latest_[column][row]));
+    }
+    out.shrink_to_fit();
+  }
+  history_.push_front(std::move(cycle));
+  while (history_.size() > maxHistory_) {
+    history_.pop_back();
+  }
+}
+
+ColumnarCounterStore::Aggregate ColumnarCounterStore::aggregate(
+    size_t column) const {
+  return aggregateValues(latest_[column].data(), latestNumRows_);
+}
+
+std::vector<double> ColumnarCounterStore::rates(size_t column) const {
+  std::vector<double> result(latestNumRows_, 0);
+  auto interval = (latestTimestamp_ - previousTimestamp_).count();
+  if (numCycles_ < 2 || interval <= 0) {
+    return result;
+  }
+  const auto* latest = latest_[column].data();
+  const auto* previous = previous_[column].data();
+  for (size_t row = 0; row < previousNumRows_; ++row) {
+    result[row] = static_cast<double>(latest[row] - previous[row]) / interval;
+  }
+  return result;
+}
+
+double ColumnarCounterStore::rateSum(size_t column) const {
+  auto interval = (latestTimestamp_ - previousTimestamp_).count();
+  if (numCycles_ < 2 || interval <= 0) {
+    return 0;
+  }
+  auto latest = aggregateValues(latest_[column].data(), previousNumRows_);
+  auto previous = aggregateValues(previous_[column].data(), previousNumRows_);
+  return static_cast<double>(static_cast<int64_t>(
+             static_cast<uint64_t>(latest.sum) -
+             static_cast<uint64_t>(previous.sum))) /
+      interval;
+}
+
+ColumnarCounterStore::History ColumnarCounterStore::history(
+    size_t column,
+    size_t row) const {
+  History result;
+  if (numCycles_ < 1 || row >= latestNumRows_) {
+    return result;
+  }
+  result.emplace_back(latestTimestamp_, latest_[column][row]);
+  if (numCycles_ < 2 || row >= previousNumRows_) {
+    return result;
+  }
+  auto newer = previous_[column][row];
+  result.emplace_back(previousTimestamp_, newer);
+  auto encoding = columns_[column].encoding;
+  for (const auto& cycle : history_) {
+    if (row >= cycle.numRows) {
+      break;
+    }
+    const char* in = cycle.columns[column].data();
+    for (size_t i = 0; i < row; ++i) {
+      skipVarint(in);
+    }
+    newer = decode(encoding, readVarint(in), newer);
+    result.emplace_back(cycle.timestamp, newer);
+  }
+  return result;
+}
+
+size_t ColumnarCounterStore::historyBytes() const {
+  size_t bytes = 0;
+  for (const auto& cycle : history_) {
+    for (const auto& column : cycle.columns) {
+      bytes += column.size();
+    }
+  }
+  return bytes;
+}
+
+} // namespace facebook::fboss
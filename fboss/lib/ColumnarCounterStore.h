@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * In process store for a fixed set of counters (columns) collected for many
+ * entities (rows), e.g. the port counters of every port.
+ *
+ * Collectors write all rows once per collection cycle:
+ *
+ *   store.beginCycle(now);
+ *   for (port : ports) {
+ *     store.set(kInBytes, store.rowIndex(port), inBytes);
+ *     ...
+ *   }
+ *   store.endCycle();
+ *
+ * Each column keeps the values of all rows next to each other, so
+ * aggregating a counter across all rows (min, max, sum, rate) is a pass
+ * over a contiguous array, done with vector instructions where available.
+ *
+ * The last two cycles are kept as is. Older cycles, up to maxHistory, are
+ * compressed: each value is stored relative to the same value one cycle
+ * later, as a varint of the zigzag encoded difference (counters, which grow
+ * slowly) or of the XOR of both (gauges, which stay close to their previous
+ * value). That brings most values down to one or two bytes.
+ *
+ * Not thread safe, callers serialize writers and readers.
+ */
+class ColumnarCounterStore {
+ public:
+  enum class Encoding {
+    DELTA,
+    XOR,
+  };
+  struct Column {
+    std::string name;
+    Encoding encoding{Encoding::DELTA};
+  };
+  struct Aggregate {
+    int64_t min{0};
+    int64_t max{0};
+    int64_t sum{0};
+  };
+  using History = std::vector<std::pair<std::chrono::seconds, int64_t>>;
+
+  ColumnarCounterStore(std::vector<Column> columns, size_t maxHistory);
+
+  const std::vector<Column>& columns() const {
+    return columns_;
+  }
+  size_t numRows() const {
+    return rowNames_.size();
+  }
+  const std::string& rowName(size_t row) const {
+    return rowNames_[row];
+  }
+  /*
+   * Index of the row with the given name, added with all counters at 0 if
+   * it does not exist yet. Rows are never removed, use resetRow() when the
+   * entity goes away.
+   */
+  size_t rowIndex(const std::string& rowName);
+  // Index of the row with the given name, if there is one
+  std::optional<size_t> findRow(const std::string& rowName) const;
+  void resetRow(size_t row);
+
+  /*
+   * Writer API. Counters not set in a cycle keep their previous value.
+   */
+  void beginCycle(std::chrono::seconds timestamp);
+  void set(size_t column, size_t row, int64_t value) {
+    current_[column][row] = value;
+  }
+  void endCycle();
+
+  /*
+   * Reader API, over completed cycles only.
+   */
+  size_t numCycles() const {
+    return numCycles_;
+  }
+  std::chrono::seconds latestTimestamp() const {
+    return latestTimestamp_;
+  }
+  int64_t latest(size_t column, size_t row) const {
+    return latest_[column][row];
+  }
+  // Over all rows, as of the latest cycle
+  Aggregate aggregate(size_t column) const;
+  // Per row increase per second between the last two cycles
+  std::vector<double> rates(size_t column) const;
+  // Sum of rates() over all rows
+  double rateSum(size_t column) const;
+  // Values of one counter, newest first, for all the cycles kept
+  History history(size_t column, size_t row) const;
+  // Memory held by the compressed history
+  size_t historyBytes() const;
+
+ private:
+  struct CompressedCycle {
+    std::chrono::seconds timestamp;
+    // Number of rows when the cycle was collected
+    size_t numRows;
+    // Per column, values relative to the following cycle
+    std::vector<std::string> columns;
+  };
+
+  void compressPrevious();
+
+  std::vector<Column> columns_;
+  size_t maxHistory_;
+  folly::F14FastMap<std::string, size_t> rowIndices_;
+  std::vector<std::string> rowNames_;
+  // [column][row]
+  std::vector<std::vector<int64_t>> current_;
+  std::vector<std::vector<int64_t>> latest_;
+  std::vector<std::vector<int64_t>> previous_;
+  std::chrono::seconds currentTimestamp_{0};
+  std::chrono::seconds latestTimestamp_{0};
+  std::chrono::seconds previousTimestamp_{0};
+  size_t latestNumRows_{0};
+  size_t previousNumRows_{0};
+  size_t numCycles_{0};
+  // Newest first, the first one is relative to previous_
+  std::deque<CompressedCycle> history_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * FixedSizeArena hands out blocks of one size, carved out of large slabs.
+ * Freed blocks go on a free list and are handed out again. This suits the
+ * hundreds of thousands of small, identically sized objects we keep for
+ * routes, neighbors and next hops: it saves malloc's per allocation
+ * header and keeps the objects packed together. Slabs are never returned
+ * to the system.
+ *
+ * There is one arena per block size and alignment, shared by every type
+ * of that size.
+ */
+template <std::size_t kSize, std::size_t kAlign>
+class FixedSizeArena {
+ public:
+  // Free blocks hold the free list link, so they need room and alignment
+  // for a pointer
+  static constexpr std::size_t kBlockAlign = std::max(kAlign, alignof(void*));
+  static constexpr std::size_t kBlockSize =
+      (std::max(kSize, sizeof(void*)) + kBlockAlign - 1) / kBlockAlign *
+      kBlockAlign;
+  static constexpr std::size_t kSlabBytes = 64 * 1024;
+  static constexpr std::size_t kBlocksPerSlab =
+      std::max<std::size_t>(1, kSlabBytes / kBlockSize);
+
+  static FixedSizeArena& get() {
+    // Leaked, so objects destroyed during static destruction can still
+    // return their blocks
+    static auto* arena = new FixedSizeArena();
+    return *arena;
+  }
+
+  void* allocate() {
+    std::lock_guard<std::mutex> g(lock_);
+    if (!freeList_) {
+      addSlab();
+    }
+    auto block = freeList_;
+    freeList_ = block->next;
+    ++allocatedBlocks_;
+    return block;
+  }
+
+  void deallocate(void* p) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = freeList_;
+    freeList_ = block;
+    --allocatedBlocks_;
+  }
+
+  std::size_t allocatedBlocks() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return allocatedBlocks_;
+  }
+
+  std::size_t reservedBytes() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return slabs_.size() * kBlocksPerSlab * kBlockSize;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FixedSizeArena() = default;
+  FixedSizeArena(const FixedSizeArena&) = delete;
+  FixedSizeArena& operator=(const FixedSizeArena&) = delete;
+
+  void addSlab() {
+    auto slab = static_cast<char*>(::operator new(
+        kBlocksPerSlab * kBlockSize, std::align_val_t(kBlockAlign)));
+    slabs_.push_back(slab);
+    // Thread the new blocks on the free list in address order
+    for (auto i = kBlocksPerSlab; i > 0; --i) {
+      auto block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * kBlockSize);
+      block->next = freeList_;
+      freeList_ = block;
+    }
+  }
+
+  mutable std::mutex lock_;
+  FreeBlock* freeList_{nullptr};
+  std::vector<char*> slabs_;
+  std::size_t allocatedBlocks_{0};
+};
+
+/*
+ * Standard allocator backed by the FixedSizeArena for sizeof(T). Only
+ * single object allocations come from the arena, arrays go to the heap.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using Arena = FixedSizeArena<sizeof(T), alignof(T)>;
+
+  ArenaAllocator() = default;
+  template <typename U>
+  /* implicit */ ArenaAllocator(const ArenaAllocator<U>& /*other*/) {}
+
+  T* allocate(std::size_t n) {
+    if (n == 1) {
+      return static_cast<T*>(Arena::get().allocate());
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    if (n == 1) {
+      Arena::get().deallocate(p);
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& /*other*/) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& /*other*/) const {
+    return false;
+  }
+};
+
+} // namespace facebook::fboss
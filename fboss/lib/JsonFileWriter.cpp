@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/JsonFileWriter.h"
+
+#include <folly/Conv.h>
+#include <folly/Exception.h>
+#include <folly/FileUtil.h>
+#include <folly/json.h>
+
+#include <fcntl.h>
+#include <libgen.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+namespace {
+constexpr auto kIndentWidth = 2;
+
+void fsyncDir(const std::string& filename) {
+  std::string path(filename);
+  std::string dir(::dirname(path.data()));
+  int fd = folly::openNoInt(dir.c_str(), O_RDONLY | O_DIRECTORY);
+  folly::checkUnixError(fd, "Unable to open directory ", dir);
+  auto rv = folly::fsyncNoInt(fd);
+  folly::closeNoInt(fd);
+  folly::checkUnixError(rv, "Unable to fsync directory ", dir);
+}
+} // namespace
+
+namespace facebook::fboss {
+
+JsonFileWriter::JsonFileWriter(const std::string& filename, size_t bufferSize)
+    : filename_(filename),
+      tmpFilename_(folly::to<std::string>(filename, ".tmp")),
+      bufferSize_(bufferSize) {
+  buffer_.reserve(bufferSize_);
+  fd_ = folly::openNoInt(
+      tmpFilename_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  folly::checkUnixError(fd_, "Unable to open ", tmpFilename_);
+}
+
+JsonFileWriter::~JsonFileWriter() {
+  if (fd_ >= 0) {
+    folly::closeNoInt(fd_);
+  }
+  if (!committed_) {
+    ::unlink(tmpFilename_.c_str());
+  }
+}
+
+void JsonFileWriter::write(const folly::dynamic& json) {
+  writeValue(json, 0);
+}
+
+void JsonFileWriter::writeAndRelease(folly::dynamic&& json) {
+  writeValue(json, 0);
+}
+
+template <typename Dynamic>
+void JsonFileWriter::writeValue(Dynamic& json, size_t indent) {
+  constexpr bool kRelease = !std::is_const_v<Dynamic>;
+  if (json.isObject()) {
+    if (json.empty()) {
+      append("{}");
+      return;
+    }
+    append("{\n");
+    // Keys in the same order as folly::toPrettyJson, which sorts them
+    std::vector<decltype(&*json.items().begin())> items;
+    items.reserve(json.size());
+    for (auto& item : json.items()) {
+      items.push_back(&item);
+    }
+    std::sort(items.begin(), items.end(), [](auto a, auto b) {
+      return a->first < b->first;
+    });
+    bool first = true;
+    for (auto item : items) {
+      if (!first) {
+        append(",\n");
+      }
+      first = false;
+      writeIndent(indent + kIndentWidth);
+      append(folly::toJson(item->first));
+      append(": ");
+      writeValue(item->second, indent + kIndentWidth);
+      if constexpr (kRelease) {
+        item->second = nullptr;
+      }
+    }
+    append("\n");
+    writeIndent(indent);
+    append("}");
+  } else if (json.isArray()) {
+    if (json.empty()) {
+      append("[]");
+      return;
+    }
+    append("[\n");
+    bool first = true;
+    for (auto& value : json) {
+      if (!first) {
+        append(",\n");
+      }
+      first = false;
+      writeIndent(indent + kIndentWidth);
+      writeValue(value, indent + kIndentWidth);
+      if constexpr (kRelease) {
+        value = nullptr;
+      }
+    }
+    append("\n");
+    writeIndent(indent);
+    append("]");
+  } else {
+    // Leave escaping and number formatting of scalars to folly, so the
+    // output is identical to folly::toPrettyJson
+    append(folly::toJson(json));
+  }
+  if constexpr (kRelease) {
+    if (indent == 0) {
+      json = nullptr;
+    }
+  }
+}
+
+void JsonFileWriter::writeIndent(size_t indent) {
+  buffer_.append(indent, ' ');
+}
+
+void JsonFileWriter::append(folly::StringPiece str) {
+  buffer_.append(str.data(), str.size());
+  if (buffer_.size() >= bufferSize_) {
+    flush();
+  }
+}
+
+void JsonFileWriter::flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+  auto rv = folly::writeFull(fd_, buffer_.data(), buffer_.size());
+  folly::checkUnixError(rv, "Unable to write to ", tmpFilename_);
+  buffer_.clear();
+}
+
+void JsonFileWriter::commit() {
+  flush();
+  folly::checkUnixError(
+      folly::fsyncNoInt(fd_), "Unable to fsync ", tmpFilename_);
+  auto fd = fd_;
+  fd_ = -1;
+  folly::checkUnixError(
+      folly::closeNoInt(fd), "Unable to close ", tmpFilename_);
+  folly::checkUnixError(
+      ::rename(tmpFilename_.c_str(), filename_.c_str()),
+      "Unable to rename ",
+      tmpFilename_,
+      " to ",
+      filename_);
+  committed_ = true;
+  // Make the rename itself durable
+  fsyncDir(filename_);
+}
+
+} // namespace facebook::fboss
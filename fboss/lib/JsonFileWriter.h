@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/dynamic.h>
+
+#include <string>
+
+namespace facebook::fboss {
+
+/*
+ * Writes a folly::dynamic to a file as pretty printed JSON (same format and
+ * key order as folly::toPrettyJson), serializing it straight into a small
+ * buffer that is flushed to the file as it fills up, rather than building the
+ * whole JSON string in memory first.
+ *
+ * The JSON goes to a temporary file next to the destination, which only
+ * replaces the destination on commit(), after being fsync'ed. So readers see
+ * either the old file or the complete new one, even if we crash half way.
+ * A writer destroyed without commit() removes the temporary file.
+ *
+ * Throws std::system_error on I/O errors.
+ */
+class JsonFileWriter {
+ public:
+  static constexpr size_t kDefaultBufferSize = 1 << 20;
+
+  explicit JsonFileWriter(
+      const std::string& filename,
+      size_t bufferSize = kDefaultBufferSize);
+  ~JsonFileWriter();
+
+  void write(const folly::dynamic& json);
+  /*
+   * Same as write, but frees every array and object as soon as it was
+   * written, so that memory goes down while the file is written.
+   */
+  void writeAndRelease(folly::dynamic&& json);
+
+  void commit();
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  JsonFileWriter(JsonFileWriter const&) = delete;
+  JsonFileWriter& operator=(JsonFileWriter const&) = delete;
+
+  template <typename Dynamic>
+  void writeValue(Dynamic& json, size_t indent);
+  void writeIndent(size_t indent);
+  void append(folly::StringPiece str);
+  void flush();
+
+  std::string filename_;
+  std::string tmpFilename_;
+  size_t bufferSize_;
+  std::string buffer_;
+  int fd_{-1};
+  bool committed_{false};
+};
+
+} // namespace facebook::fboss
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <memory>
+#include <new>
 #include <unordered_map>
 
 #include <boost/container/flat_map.hpp>
@@ -35,7 +36,16 @@ using RefMapUMap = std::unordered_map<K, V>;
 template <typename K, typename V>
 using RefMapFlatMap = boost::container::flat_map<K, V>;
 
-template <template <class, class> class M, typename K, typename V>
+/*
+ * Values, along with their shared_ptr control blocks, are allocated with
+ * Alloc. Maps holding many small values can use an ArenaAllocator (see
+ * FixedSizeArena.h) to avoid a pair of heap allocations per value.
+ */
+template <
+    template <class, class> class M,
+    typename K,
+    typename V,
+    typename Alloc = std::allocator<V>>
 class RefMap {
  public:
   // using MapType = std::unordered_map<K, std::weak_ptr<V>>;
@@ -122,13 +132,25 @@ class RefMap {
   }
 
  private:
+  using AllocTraits = std::allocator_traits<Alloc>;
+
   template <typename... Args>
   std::shared_ptr<V> makeShared(const K& k, Args&&... args) {
+    Alloc alloc;
+    V* vp = AllocTraits::allocate(alloc, 1);
+    try {
+      new (vp) V{std::forward<Args>(args)...};
+    } catch (...) {
+      AllocTraits::deallocate(alloc, vp, 1);
+      throw;
+    }
     auto del = [&m = map_, k](V* v) {
       m.erase(k);
-      std::default_delete<V>()(v);
+      Alloc alloc;
+      v->~V();
+      AllocTraits::deallocate(alloc, v, 1);
     };
-    return std::shared_ptr<V>(new V{std::forward<Args>(args)...}, del);
+    return std::shared_ptr<V>(vp, del, alloc);
   }
 
   template <typename... Args>
@@ -149,10 +171,10 @@ class RefMap {
   MapType map_;
 };
 
-template <typename K, typename V>
-using UnorderedRefMap = RefMap<RefMapUMap, K, V>;
+template <typename K, typename V, typename Alloc = std::allocator<V>>
+using UnorderedRefMap = RefMap<RefMapUMap, K, V, Alloc>;
 
-template <typename K, typename V>
-using FlatRefMap = RefMap<RefMapFlatMap, K, V>;
+template <typename K, typename V, typename Alloc = std::allocator<V>>
+using FlatRefMap = RefMap<RefMapFlatMap, K, V, Alloc>;
 
 } // namespace facebook::fboss
@@ -84,6 +84,13 @@ void MinipackBaseI2cBus::scanPresence(
   }
 }
 
+uint32_t MinipackBaseI2cBus::getBusId(unsigned int module) {
+  // Every pim has its own set of controllers, each serving a few ports
+  auto pim = getPim(module);
+  auto port = getQsfpPimPort(module);
+  return (static_cast<uint32_t>(pim) << 8) | getI2cControllerIdx(port);
+}
+
 uint8_t MinipackBaseI2cBus::getPim(int module) {
   return MinipackBaseSystemContainer::kPimStartNum +
       (module - 1) / portsPerPim_;
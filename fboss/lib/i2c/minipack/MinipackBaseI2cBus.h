@@ -37,6 +37,9 @@ class MinipackBaseI2cBus : public TransceiverI2CApi {
   void scanPresence(std::map<int32_t, ModulePresence>& presences) override;
   void verifyBus(bool /* autoReset */) override {}
 
+  // Each FbFpgaI2cController drives its own bus
+  uint32_t getBusId(unsigned int module) override;
+
  protected:
   uint32_t portsPerPim_ = 16;
   virtual uint8_t getPim(int module);
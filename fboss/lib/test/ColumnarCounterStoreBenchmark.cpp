@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/ColumnarCounterStore.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/container/F14Map.h>
+#include "common/init/Init.h"
+#include "common/stats/MonotonicCounter.h"
+
+#include <vector>
+
+using namespace facebook;
+using namespace facebook::fboss;
+using namespace folly;
+
+/*
+ * One stats collection cycle for 128 ports with 100 counters each, written
+ * counter by counter into fb303 monotonic counters looked up by name (as
+ * HwFb303Stats does), or into a ColumnarCounterStore.
+ */
+namespace {
+constexpr size_t kPorts = 128;
+constexpr size_t kCounters = 100;
+constexpr size_t kHistory = 60;
+
+std::string portName(size_t port) {
+  return folly::to<std::string>("eth", port / 4 + 1, "/", port % 4 + 1, "/1");
+}
+
+std::string counterName(size_t counter) {
+  return folly::to<std::string>("counter", counter);
+}
+
+std::string statName(size_t port, size_t counter) {
+  return folly::to<std::string>(portName(port), ".", counterName(counter));
+}
+
+int64_t counterValue(size_t cycle, size_t port, size_t counter) {
+  return cycle * (port * 1000 + counter);
+}
+
+class PerCounterStats {
+ public:
+  PerCounterStats() {
+    for (size_t port = 0; port < kPorts; ++port) {
+      for (size_t counter = 0; counter < kCounters; ++counter) {
+        auto name = statName(port, counter);
+        counters_.emplace(
+            name, stats::MonotonicCounter(name, fb303::SUM, fb303::RATE));
+      }
+    }
+  }
+
+  void update(size_t cycle) {
+    std::chrono::seconds now(cycle);
+    for (size_t port = 0; port < kPorts; ++port) {
+      for (size_t counter = 0; counter < kCounters; ++counter) {
+        counters_.find(statName(port, counter))
+            ->second.updateValue(now, counterValue(cycle, port, counter));
+      }
+    }
+  }
+
+  int64_t sumOfIncrements(size_t counter) const {
+    int64_t sum = 0;
+    for (size_t port = 0; port < kPorts; ++port) {
+      sum += counters_.find(statName(port, counter))->second.get();
+    }
+    return sum;
+  }
+
+ private:
+  folly::F14FastMap<std::string, stats::MonotonicCounter> counters_;
+};
+
+class ColumnarStats {
+ public:
+  ColumnarStats() : store_(columns(), kHistory) {
+    for (size_t port = 0; port < kPorts; ++port) {
+      rows_.push_back(store_.rowIndex(portName(port)));
+    }
+  }
+
+  void update(size_t cycle) {
+    store_.beginCycle(std::chrono::seconds(cycle));
+    for (size_t port = 0; port < kPorts; ++port) {
+      for (size_t counter = 0; counter < kCounters; ++counter) {
+        store_.set(counter, rows_[port], counterValue(cycle, port, counter));
+      }
+    }
+    store_.endCycle();
+  }
+
+  const ColumnarCounterStore& store() const {
+    return store_;
+  }
+
+ private:
+  static std::vector<ColumnarCounterStore::Column> columns() {
+    std::vector<ColumnarCounterStore::Column> columns;
+    for (size_t counter = 0; counter < kCounters; ++counter) {
+      columns.push_back({counterName(counter)});
+    }
+    return columns;
+  }
+
+  ColumnarCounterStore store_;
+  std::vector<size_t> rows_;
+};
+} // namespace
+
+BENCHMARK(PerCounterUpdate, iters) {
+  BenchmarkSuspender suspender;
+  PerCounterStats stats;
+  suspender.dismiss();
+  for (size_t cycle = 1; cycle <= iters; ++cycle) {
+    stats.update(cycle);
+  }
+}
+
+BENCHMARK_RELATIVE(ColumnarUpdate, iters) {
+  BenchmarkSuspender suspender;
+  ColumnarStats stats;
+  suspender.dismiss();
+  for (size_t cycle = 1; cycle <= iters; ++cycle) {
+    stats.update(cycle);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PerCounterAggregate, iters) {
+  BenchmarkSuspender suspender;
+  PerCounterStats stats;
+  stats.update(1);
+  stats.update(2);
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    for (size_t counter = 0; counter < kCounters; ++counter) {
+      doNotOptimizeAway(stats.sumOfIncrements(counter));
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(ColumnarAggregate, iters) {
+  BenchmarkSuspender suspender;
+  ColumnarStats stats;
+  stats.update(1);
+  stats.update(2);
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    for (size_t counter = 0; counter < kCounters; ++counter) {
+      doNotOptimizeAway(stats.store().aggregate(counter));
+      doNotOptimizeAway(stats.store().rateSum(counter));
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/ColumnarCounterStore.h"
+
+#include <folly/Conv.h>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace facebook::fboss;
+using std::chrono::seconds;
+
+namespace {
+constexpr size_t kCounter = 0;
+constexpr size_t kGauge = 1;
+
+ColumnarCounterStore makeStore(size_t maxHistory) {
+  return ColumnarCounterStore(
+      {{"counter", ColumnarCounterStore::Encoding::DELTA},
+       {"gauge", ColumnarCounterStore::Encoding::XOR}},
+      maxHistory);
+}
+
+int64_t counterValue(size_t cycle, size_t row) {
+  return cycle * cycle * 1000 + row;
+}
+
+int64_t gaugeValue(size_t cycle, size_t row) {
+  return (cycle % 3) * 7 - static_cast<int64_t>(row);
+}
+
+void writeCycle(ColumnarCounterStore& store, size_t cycle, size_t numRows) {
+  store.beginCycle(seconds(100 + cycle * 10));
+  for (size_t row = 0; row < numRows; ++row) {
+    auto index = store.rowIndex(folly::to<std::string>("eth1/", row, "/1"));
+    store.set(kCounter, index, counterValue(cycle, row));
+    store.set(kGauge, index, gaugeValue(cycle, row));
+  }
+  store.endCycle();
+}
+} // namespace
+
+TEST(ColumnarCounterStore, history) {
+  auto store = makeStore(5);
+  for (size_t cycle = 0; cycle < 10; ++cycle) {
+    writeCycle(store, cycle, 9);
+  }
+  EXPECT_EQ(store.numCycles(), 10);
+  EXPECT_EQ(store.numRows(), 9);
+  EXPECT_GT(store.historyBytes(), 0);
+  for (size_t row = 0; row < 9; ++row) {
+    auto counters = store.history(kCounter, row);
+    auto gauges = store.history(kGauge, row);
+    // 2 uncompressed cycles and 5 compressed ones
+    ASSERT_EQ(counters.size(), 7);
+    ASSERT_EQ(gauges.size(), 7);
+    for (size_t i = 0; i < counters.size(); ++i) {
+      auto cycle = 9 - i;
+      EXPECT_EQ(counters[i].first, seconds(100 + cycle * 10));
+      EXPECT_EQ(counters[i].second, counterValue(cycle, row));
+      EXPECT_EQ(gauges[i].second, gaugeValue(cycle, row));
+    }
+  }
+}
+
+TEST(ColumnarCounterStore, rowsAdded) {
+  auto store = makeStore(10);
+  for (size_t cycle = 0; cycle < 5; ++cycle) {
+    writeCycle(store, cycle, cycle < 2 ? 3 : 6);
+  }
+  // Rows added in cycle 2 have no history before that
+  EXPECT_EQ(store.history(kCounter, 0).size(), 5);
+  EXPECT_EQ(store.history(kCounter, 5).size(), 3);
+  EXPECT_EQ(store.history(kCounter, 5).back().second, counterValue(2, 5));
+}
+
+TEST(ColumnarCounterStore, aggregate) {
+  auto store = makeStore(2);
+  store.beginCycle(seconds(10));
+  // Enough rows for the vector kernel and a scalar tail
+  std::vector<int64_t> values{
+      5, -3, 42, 7, std::numeric_limits<int64_t>::max(), 0, -100, 8, 1};
+  for (size_t row = 0; row < values.size(); ++row) {
+    store.set(
+        kGauge,
+        store.rowIndex(folly::to<std::string>("row", row)),
+        values[row]);
+  }
+  store.endCycle();
+  auto aggregate = store.aggregate(kGauge);
+  EXPECT_EQ(aggregate.min, -100);
+  EXPECT_EQ(aggregate.max, std::numeric_limits<int64_t>::max());
+  int64_t sum = 0;
+  for (auto value : values) {
+    sum = static_cast<int64_t>(
+        static_cast<uint64_t>(sum) + static_cast<uint64_t>(value));
+  }
+  EXPECT_EQ(aggregate.sum, sum);
+}
+
+TEST(ColumnarCounterStore, rates) {
+  auto store = makeStore(2);
+  writeCycle(store, 1, 4);
+  EXPECT_EQ(store.rateSum(kCounter), 0);
+  writeCycle(store, 2, 4);
+  auto rates = store.rates(kCounter);
+  ASSERT_EQ(rates.size(), 4);
+  double sum = 0;
+  for (size_t row = 0; row < rates.size(); ++row) {
+    // (4000 - 1000) over 10 seconds
+    EXPECT_DOUBLE_EQ(rates[row], 300);
+    sum += rates[row];
+  }
+  EXPECT_DOUBLE_EQ(store.rateSum(kCounter), sum);
+}
+
+TEST(ColumnarCounterStore, unsetCountersCarryOver) {
+  auto store = makeStore(2);
+  writeCycle(store, 1, 2);
+  store.beginCycle(seconds(1000));
+  store.set(kCounter, 0, 12345);
+  store.endCycle();
+  EXPECT_EQ(store.latest(kCounter, 0), 12345);
+  EXPECT_EQ(store.latest(kCounter, 1), counterValue(1, 1));
+
+  store.resetRow(1);
+  store.beginCycle(seconds(1010));
+  store.endCycle();
+  EXPECT_EQ(store.latest(kCounter, 1), 0);
+}
+
+TEST(ColumnarCounterStore, findRow) {
+  auto store = makeStore(2);
+  writeCycle(store, 1, 2);
+  EXPECT_EQ(store.findRow("eth1/1/1"), 1);
+  EXPECT_EQ(store.findRow("eth1/5/1"), std::nullopt);
+  // Looking a row up does not add it
+  EXPECT_EQ(store.numRows(), 2);
+}
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/JsonFileWriter.h"
+
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/json.h>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+using namespace facebook::fboss;
+
+namespace {
+folly::dynamic testJson() {
+  folly::dynamic json = folly::dynamic::object;
+  json["string"] = "with \"quotes\" and \\ and \n";
+  json["int"] = -42;
+  json["double"] = 0.1;
+  json["bool"] = true;
+  json["null"] = nullptr;
+  json["emptyObject"] = folly::dynamic::object;
+  json["emptyArray"] = folly::dynamic::array;
+  json["nested"] = folly::dynamic::object(
+      "array", folly::dynamic::array(1, "two", folly::dynamic::object("x", 3)));
+  return json;
+}
+
+std::string readFile(const std::string& filename) {
+  std::string contents;
+  EXPECT_TRUE(folly::readFile(filename.c_str(), contents));
+  return contents;
+}
+} // namespace
+
+class JsonFileWriterTest : public ::testing::Test {
+ protected:
+  std::string filename() const {
+    return (tmpDir_.path() / "state").string();
+  }
+
+  folly::test::TemporaryDirectory tmpDir_;
+};
+
+TEST_F(JsonFileWriterTest, matchesPrettyJson) {
+  auto json = testJson();
+  {
+    // Tiny buffer to exercise flushes
+    JsonFileWriter writer(filename(), 8);
+    writer.write(json);
+    writer.commit();
+  }
+  EXPECT_EQ(readFile(filename()), folly::toPrettyJson(json));
+  EXPECT_EQ(folly::parseJson(readFile(filename())), json);
+  EXPECT_NE(access((filename() + ".tmp").c_str(), F_OK), 0);
+}
+
+TEST_F(JsonFileWriterTest, writeAndRelease) {
+  auto json = testJson();
+  auto expected = folly::toPrettyJson(json);
+  {
+    JsonFileWriter writer(filename());
+    writer.writeAndRelease(std::move(json));
+    writer.commit();
+  }
+  EXPECT_EQ(readFile(filename()), expected);
+  EXPECT_TRUE(json.isNull());
+}
+
+TEST_F(JsonFileWriterTest, noCommitKeepsOldFile) {
+  ASSERT_TRUE(folly::writeFile(std::string("old"), filename().c_str()));
+  {
+    JsonFileWriter writer(filename());
+    writer.write(testJson());
+  }
+  EXPECT_EQ(readFile(filename()), "old");
+  EXPECT_NE(access((filename() + ".tmp").c_str(), F_OK), 0);
+}
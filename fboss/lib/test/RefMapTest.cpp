@@ -8,6 +8,7 @@
  *
  */
 
+#include "fboss/lib/FixedSizeArena.h"
 #include "fboss/lib/RefMap.h"
 
 #include <gtest/gtest.h>
@@ -250,3 +251,20 @@ TEST(RefMap, UnorderedRefMapRefCountTest) {
   }
   EXPECT_EQ(refMap.referenceCount(101), 0);
 }
+
+TEST(RefMap, arenaAllocated) {
+  using Map = UnorderedRefMap<int, A, ArenaAllocator<A>>;
+  auto& arena = ArenaAllocator<A>::Arena::get();
+  auto blocksBefore = arena.allocatedBlocks();
+  Map arenaMap;
+  std::vector<std::shared_ptr<A>> refs;
+  for (auto i = 0; i < 1000; ++i) {
+    refs.push_back(arenaMap.refOrEmplace(i, i).first);
+  }
+  EXPECT_EQ(arenaMap.size(), 1000);
+  EXPECT_EQ(arena.allocatedBlocks(), blocksBefore + 1000);
+  EXPECT_EQ(arenaMap.get(42)->x, 42);
+  refs.clear();
+  EXPECT_EQ(arenaMap.size(), 0);
+  EXPECT_EQ(arena.allocatedBlocks(), blocksBefore);
+}
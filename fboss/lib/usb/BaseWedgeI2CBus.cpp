@@ -14,6 +14,8 @@
 
 #include "fboss/lib/usb/UsbError.h"
 
+#include <folly/futures/Future.h>
+
 using folly::MutableByteRange;
 using std::lock_guard;
 
@@ -54,15 +56,25 @@ void BaseWedgeI2CBus::read(uint8_t address, int offset, int len, uint8_t* buf) {
   if (writeReadMode_ == WriteReadMode::WriteReadModeStopStart) {
     // Default addressed read happens in the STOP_START mode. In this mode
     // the "offset" is written to the first address and then we read
-    // from the given address.
-    dev_->writeByte(address, offset);
+    // from the given address.  All the transactions are queued at once,
+    // so that the CP2112 can pipeline them.
+    std::vector<Transaction> transactions;
+    transactions.emplace_back(
+        [&] { return dev_->writeByteAsync(address, offset); });
     if (len > 128) {
-      dev_->read(address, MutableByteRange(buf, 128));
-      dev_->writeByte(address, offset + 128);
-      dev_->read(address, MutableByteRange(buf + 128, len - 128));
+      transactions.emplace_back(
+          [&] { return dev_->readAsync(address, MutableByteRange(buf, 128)); });
+      transactions.emplace_back(
+          [&] { return dev_->writeByteAsync(address, offset + 128); });
+      transactions.emplace_back([&] {
+        return dev_->readAsync(
+            address, MutableByteRange(buf + 128, len - 128));
+      });
     } else {
-      dev_->read(address, MutableByteRange(buf, len));
+      transactions.emplace_back(
+          [&] { return dev_->readAsync(address, MutableByteRange(buf, len)); });
     }
+    runTransactions(std::move(transactions));
   } else {
     // This is no default mode of reading and it is REPEATED_START mode. The
     // addressed read is invoked from the CP2112 device. This is the
@@ -130,6 +142,22 @@ void BaseWedgeI2CBus::write(
   dev_->write(address, MutableByteRange(output, len + 1));
 }
 
+void BaseWedgeI2CBus::runTransactions(std::vector<Transaction>&& transactions) {
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  for (auto& transaction : transactions) {
+    futures.push_back(transaction());
+    // Without an async CP2112 the transaction is already done, don't go on
+    // after a failure
+    if (futures.back().isReady() && futures.back().hasException()) {
+      break;
+    }
+  }
+  // Throw the error of the first transaction which failed
+  for (auto& result : folly::collectAll(std::move(futures)).get()) {
+    result.throwIfFailed();
+  }
+}
+
 void BaseWedgeI2CBus::moduleRead(
     unsigned int module,
     uint8_t address,
@@ -12,8 +12,11 @@
 #include "fboss/lib/usb/CP2112.h"
 #include "fboss/lib/usb/TransceiverI2CApi.h"
 
+#include <folly/Function.h>
 #include <folly/Range.h>
+#include <folly/futures/Future.h>
 #include <mutex>
+#include <vector>
 
 namespace facebook::fboss {
 /*
@@ -102,6 +105,13 @@ class BaseWedgeI2CBus : public TransceiverI2CApi {
   virtual void initBus() = 0;
   virtual void selectQsfpImpl(unsigned int module) = 0;
 
+  /*
+   * Queue transactions with the CP2112Intf async calls, and wait for all of
+   * them.  Throws the error of the first one which failed.
+   */
+  using Transaction = folly::Function<folly::SemiFuture<folly::Unit>()>;
+  static void runTransactions(std::vector<Transaction>&& transactions);
+
   std::unique_ptr<CP2112Intf> dev_;
 
   unsigned int selectedPort_{NO_PORT};
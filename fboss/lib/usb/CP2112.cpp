@@ -27,8 +27,10 @@
  */
 #include "fboss/lib/usb/CP2112.h"
 #include "fboss/lib/BmcRestClient.h"
+#include "fboss/lib/usb/CP2112AsyncEngine.h"
 #include "fboss/lib/usb/UsbError.h"
 
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 
 #include <folly/ScopeGuard.h>
@@ -44,6 +46,12 @@ using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 using std::chrono::steady_clock;
 
+DEFINE_bool(
+    cp2112_async_transfers,
+    false,
+    "Pipeline the CP2112 SMBus reads and writes with asynchronous USB "
+    "transfers");
+
 namespace {
 
 struct ReportType {
@@ -146,9 +154,16 @@ void CP2112::open(bool setSmbusConfig) {
   // when we attached to it, call flushTransfers to cancel any outstanding
   // transfer and ignore any pending interrupt in packets.
   flushTransfers();
+
+  if (FLAGS_cp2112_async_transfers) {
+    engine_ = std::make_unique<CP2112AsyncEngine>(
+        std::make_unique<LibusbCP2112Transport>(ctx_, handle_.handle()));
+  }
 }
 
 void CP2112::close() {
+  // The engine's transfers must be cancelled before closing the handle
+  engine_.reset();
   handle_.close();
   dev_.reset();
 }
@@ -286,6 +301,11 @@ void CP2112::setSMBusConfig(SMBusConfig config) {
 }
 
 void CP2112::read(uint8_t address, MutableByteRange buf, milliseconds timeout) {
+  if (engine_) {
+    readAsync(address, buf, timeout).get();
+    return;
+  }
+
   // Increment the counter for I2c read transaction issued
   incrReadTotal();
 
@@ -324,6 +344,11 @@ void CP2112::read(uint8_t address, MutableByteRange buf, milliseconds timeout) {
 }
 
 void CP2112::write(uint8_t address, ByteRange buf, milliseconds timeout) {
+  if (engine_) {
+    writeAsync(address, buf, timeout).get();
+    return;
+  }
+
   // Increment the counter for I2c write transaction issued
   incrWriteTotal();
 
@@ -422,6 +447,46 @@ void CP2112::writeReadUnsafe(
   incrWriteBytes(writeBuf.size());
 }
 
+folly::SemiFuture<folly::Unit> CP2112::readAsync(
+    uint8_t address,
+    MutableByteRange buf,
+    milliseconds timeout) {
+  if (!engine_) {
+    return CP2112Intf::readAsync(address, buf, timeout);
+  }
+
+  incrReadTotal();
+  return engine_->read(address, buf, timeout)
+      .defer([this, len = buf.size()](folly::Try<folly::Unit>&& result) {
+        if (result.hasException()) {
+          XLOG(DBG5) << "CP2112 i2c read error";
+          incrReadFailed();
+        }
+        result.throwIfFailed();
+        incrReadBytes(len);
+      });
+}
+
+folly::SemiFuture<folly::Unit> CP2112::writeAsync(
+    uint8_t address,
+    ByteRange buf,
+    milliseconds timeout) {
+  if (!engine_) {
+    return CP2112Intf::writeAsync(address, buf, timeout);
+  }
+
+  incrWriteTotal();
+  return engine_->write(address, buf, timeout)
+      .defer([this, len = buf.size()](folly::Try<folly::Unit>&& result) {
+        if (result.hasException()) {
+          XLOG(DBG5) << "cp2112 i2c write error";
+          incrWriteFailed();
+        }
+        result.throwIfFailed();
+        incrWriteBytes(len);
+      });
+}
+
 void CP2112::openDevice() {
   dev_ = UsbDevice::find(ctx_, VENDOR_ID, PRODUCT_ID);
   handle_ = dev_.open();
@@ -14,13 +14,17 @@
 #include "fboss/lib/usb/UsbHandle.h"
 
 #include <folly/Range.h>
+#include <folly/futures/Future.h>
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
 
 struct libusb_transfer;
 
 namespace facebook::fboss {
+class CP2112AsyncEngine;
+
 class CP2112Intf : public I2cController {
   // Bare-bones virtual interface to the CP2112 class. Used for gmock
   // testing.
@@ -50,6 +54,26 @@ class CP2112Intf : public I2cController {
 
   virtual std::chrono::milliseconds getDefaultTimeout() const = 0;
 
+  /*
+   * Queue a read or write without waiting for it to complete.  Queued
+   * operations complete in order, and for a read buf must remain valid
+   * until the returned future completes.
+   *
+   * By default the operation is done synchronously before returning.
+   */
+  virtual folly::SemiFuture<folly::Unit> readAsync(
+      uint8_t address,
+      folly::MutableByteRange buf,
+      std::chrono::milliseconds timeout) {
+    return folly::makeSemiFutureWith([&] { read(address, buf, timeout); });
+  }
+  virtual folly::SemiFuture<folly::Unit> writeAsync(
+      uint8_t address,
+      folly::ByteRange buf,
+      std::chrono::milliseconds timeout) {
+    return folly::makeSemiFutureWith([&] { write(address, buf, timeout); });
+  }
+
   // Move shortened read/write forms to base interface so they
   // can be used in tests
   void read(uint8_t address, folly::MutableByteRange buf) {
@@ -75,15 +99,27 @@ class CP2112Intf : public I2cController {
     write(
         address, folly::ByteRange(&value, sizeof(value)), getDefaultTimeout());
   }
+
+  folly::SemiFuture<folly::Unit> readAsync(
+      uint8_t address,
+      folly::MutableByteRange buf) {
+    return readAsync(address, buf, getDefaultTimeout());
+  }
+  folly::SemiFuture<folly::Unit> writeByteAsync(
+      uint8_t address,
+      uint8_t value) {
+    return writeAsync(
+        address, folly::ByteRange(&value, sizeof(value)), getDefaultTimeout());
+  }
 };
 
 /*
  * An interface to the Silicon Labs CP2112 USB to SMBus bridge.
  *
- * This currently provides only a blocking API.  It would be straightforward to
- * implement a non-blocking API, but Linux's standard I2C APIs only provide
- * blocking APIs.  Code that wants to deal with other I2C interfaces therefore
- * already has to support blocking operation.
+ * The blocking API sends one request at a time.  With
+ * --cp2112_async_transfers, reads and writes are instead queued to a
+ * CP2112AsyncEngine, which pipelines them, and the blocking calls wait on
+ * their completion.  Only the SMBus reads and writes go through the engine.
  */
 class CP2112 : public CP2112Intf {
  public:
@@ -351,6 +387,16 @@ class CP2112 : public CP2112Intf {
       std::chrono::milliseconds timeout) override;
   using CP2112Intf::writeReadUnsafe;
 
+  folly::SemiFuture<folly::Unit> readAsync(
+      uint8_t address,
+      folly::MutableByteRange buf,
+      std::chrono::milliseconds timeout) override;
+  using CP2112Intf::readAsync;
+  folly::SemiFuture<folly::Unit> writeAsync(
+      uint8_t address,
+      folly::ByteRange buf,
+      std::chrono::milliseconds timeout) override;
+
   /*
    * Cancel any pending transfers.
    *
@@ -399,6 +445,9 @@ class CP2112 : public CP2112Intf {
     SERIAL_STRING = 0x24,
   };
 
+  // Shares the report IDs and status messages
+  friend class CP2112AsyncEngine;
+
   // Forbidden copy constructor and assignment operator
   CP2112(CP2112 const&) = delete;
   CP2112& operator=(CP2112 const&) = delete;
@@ -441,6 +490,8 @@ class CP2112 : public CP2112Intf {
   UsbHandle handle_;
   bool ownCtx_{false};
   bool busGood_{true};
+  // Set while open with --cp2112_async_transfers
+  std::unique_ptr<CP2112AsyncEngine> engine_;
   std::chrono::milliseconds defaultTimeout_{500};
   std::chrono::time_point<std::chrono::steady_clock> lastResetTime_;
   std::chrono::milliseconds minResetInterval_{10000}; /* 10 seconds */
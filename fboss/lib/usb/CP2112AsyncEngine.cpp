@@ -0,0 +1,638 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/lib/usb/CP2112AsyncEngine.h"
+
+#include "fboss/lib/usb/CP2112.h"
+#include "fboss/lib/usb/UsbError.h"
+
+#include <glog/logging.h>
+
+#include <folly/system/ThreadName.h>
+#include <libusb-1.0/libusb.h>
+
+#include <cstring>
+
+using folly::ByteRange;
+using folly::MutableByteRange;
+using std::chrono::milliseconds;
+
+namespace {
+
+// Like the blocking CP2112 API, see the comments there
+const milliseconds kOutTimeout(20);
+const milliseconds kStatusTimeout(20);
+const milliseconds kReadResponseTimeout(10);
+
+// How long the engine thread waits for USB events before checking whether
+// the current request timed out, or the engine was stopped
+const milliseconds kEventTimeout(10);
+
+} // namespace
+
+namespace facebook::fboss {
+
+struct LibusbCP2112Transport::Transfer {
+  ~Transfer() {
+    if (xfer) {
+      libusb_free_transfer(xfer);
+    }
+  }
+
+  void complete(int rc) {
+    if (outCallback) {
+      outCallback(rc);
+    } else {
+      inCallback(rc, buf);
+    }
+  }
+
+  LibusbCP2112Transport* transport{nullptr};
+  libusb_transfer* xfer{nullptr};
+  Report buf{};
+  OutCallback outCallback;
+  InCallback inCallback;
+  // Set when the transfer couldn't be submitted
+  int rc{0};
+};
+
+LibusbCP2112Transport::LibusbCP2112Transport(
+    libusb_context* ctx,
+    libusb_device_handle* handle)
+    : ctx_(ctx), handle_(handle) {}
+
+LibusbCP2112Transport::~LibusbCP2112Transport() {
+  for (auto* transfer : transfers_) {
+    libusb_cancel_transfer(transfer->xfer);
+  }
+  // libusb invokes the callback of every cancelled transfer
+  while (!transfers_.empty()) {
+    struct timeval tv {
+      0, 10000
+    };
+    int rc = libusb_handle_events_timeout_completed(ctx_, &tv, nullptr);
+    if (rc != 0 && rc != LIBUSB_ERROR_INTERRUPTED) {
+      LOG(ERROR) << "failed to cancel " << transfers_.size()
+                 << " CP2112 transfers: " << libusb_error_name(rc);
+      break;
+    }
+  }
+  for (auto& transfer : failed_) {
+    transfer->complete(transfer->rc);
+  }
+}
+
+void LibusbCP2112Transport::submitOut(
+    const Report& report,
+    milliseconds timeout,
+    OutCallback callback) {
+  auto transfer = makeTransfer(LIBUSB_ENDPOINT_OUT | 1, timeout);
+  transfer->buf = report;
+  transfer->outCallback = std::move(callback);
+  submit(std::move(transfer));
+}
+
+void LibusbCP2112Transport::submitIn(
+    milliseconds timeout,
+    InCallback callback) {
+  auto transfer = makeTransfer(LIBUSB_ENDPOINT_IN | 1, timeout);
+  transfer->inCallback = std::move(callback);
+  submit(std::move(transfer));
+}
+
+void LibusbCP2112Transport::handleEvents(milliseconds timeout) {
+  if (!failed_.empty()) {
+    auto failed = std::move(failed_);
+    failed_.clear();
+    for (auto& transfer : failed) {
+      transfer->complete(transfer->rc);
+    }
+    return;
+  }
+
+  struct timeval tv {
+    timeout.count() / 1000, (timeout.count() % 1000) * 1000
+  };
+  int rc = libusb_handle_events_timeout_completed(ctx_, &tv, nullptr);
+  if (rc != 0 && rc != LIBUSB_ERROR_INTERRUPTED) {
+    throw LibusbError(rc, "failed to handle CP2112 USB events");
+  }
+}
+
+std::unique_ptr<LibusbCP2112Transport::Transfer>
+LibusbCP2112Transport::makeTransfer(uint8_t endpoint, milliseconds timeout) {
+  auto transfer = std::make_unique<Transfer>();
+  transfer->transport = this;
+  transfer->xfer = libusb_alloc_transfer(0);
+  if (transfer->xfer) {
+    // A timeout of 0 would be no timeout at all
+    unsigned int timeoutMS = std::max<int64_t>(timeout.count(), 1);
+    libusb_fill_interrupt_transfer(
+        transfer->xfer,
+        handle_,
+        endpoint,
+        transfer->buf.data(),
+        transfer->buf.size(),
+        &LibusbCP2112Transport::transferCallback,
+        transfer.get(),
+        timeoutMS);
+  }
+  return transfer;
+}
+
+void LibusbCP2112Transport::submit(std::unique_ptr<Transfer> transfer) {
+  int rc = transfer->xfer ? libusb_submit_transfer(transfer->xfer)
+                          : LIBUSB_ERROR_NO_MEM;
+  if (rc != 0) {
+    // Callers submit from callbacks, which don't expect to be reentered
+    transfer->rc = rc;
+    failed_.push_back(std::move(transfer));
+    return;
+  }
+  transfers_.insert(transfer.release());
+}
+
+void LibusbCP2112Transport::transferCallback(libusb_transfer* xfer) {
+  std::unique_ptr<Transfer> transfer(static_cast<Transfer*>(xfer->user_data));
+  transfer->transport->transfers_.erase(transfer.get());
+
+  int rc;
+  switch (xfer->status) {
+    case LIBUSB_TRANSFER_COMPLETED:
+      rc = (xfer->actual_length == xfer->length) ? 0 : LIBUSB_ERROR_IO;
+      break;
+    case LIBUSB_TRANSFER_TIMED_OUT:
+      rc = LIBUSB_ERROR_TIMEOUT;
+      break;
+    case LIBUSB_TRANSFER_CANCELLED:
+      rc = LIBUSB_ERROR_INTERRUPTED;
+      break;
+    case LIBUSB_TRANSFER_STALL:
+      rc = LIBUSB_ERROR_PIPE;
+      break;
+    case LIBUSB_TRANSFER_NO_DEVICE:
+      rc = LIBUSB_ERROR_NO_DEVICE;
+      break;
+    case LIBUSB_TRANSFER_OVERFLOW:
+      rc = LIBUSB_ERROR_OVERFLOW;
+      break;
+    default:
+      rc = LIBUSB_ERROR_IO;
+      break;
+  }
+  transfer->complete(rc);
+}
+
+CP2112AsyncEngine::CP2112AsyncEngine(
+    std::unique_ptr<CP2112Transport> transport,
+    milliseconds pollInterval)
+    : transport_(std::move(transport)), pollInterval_(pollInterval) {
+  thread_ = std::thread([this] {
+    folly::setThreadName("CP2112Async");
+    run();
+  });
+}
+
+CP2112AsyncEngine::~CP2112AsyncEngine() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
+  // Cancels the outstanding transfers, whose callbacks are now no-ops
+  transport_.reset();
+}
+
+folly::SemiFuture<folly::Unit> CP2112AsyncEngine::read(
+    uint8_t address,
+    MutableByteRange buf,
+    milliseconds timeout) {
+  if (buf.size() > 512) {
+    return folly::makeSemiFuture<folly::Unit>(
+        UsbError("cannot read more than 512 bytes at once"));
+  }
+  if (buf.size() < 1) {
+    return folly::makeSemiFuture<folly::Unit>(
+        UsbError("0-length reads are not allowed"));
+  }
+
+  Request request;
+  request.report[0] = CP2112::READ_REQUEST;
+  request.report[1] = address;
+  request.report[2] = buf.size() >> 8;
+  request.report[3] = buf.size() & 0xff;
+  request.operation = "read";
+  request.readBuf = buf;
+  request.timeout = timeout;
+  return enqueue(std::move(request));
+}
+
+folly::SemiFuture<folly::Unit> CP2112AsyncEngine::write(
+    uint8_t address,
+    ByteRange buf,
+    milliseconds timeout) {
+  if (buf.size() > 61) {
+    return folly::makeSemiFuture<folly::Unit>(
+        UsbError("cannot write more than 61 bytes at once"));
+  }
+  if (buf.size() < 1) {
+    return folly::makeSemiFuture<folly::Unit>(
+        UsbError("attempted 0-length write"));
+  }
+
+  Request request;
+  request.report[0] = CP2112::WRITE;
+  request.report[1] = address;
+  request.report[2] = buf.size();
+  memcpy(request.report.data() + 3, buf.begin(), buf.size());
+  request.operation = "write";
+  request.timeout = timeout;
+  return enqueue(std::move(request));
+}
+
+folly::SemiFuture<folly::Unit> CP2112AsyncEngine::enqueue(Request request) {
+  auto future = request.promise.getSemiFuture();
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (stop_) {
+      return folly::makeSemiFuture<folly::Unit>(
+          UsbError("CP2112 async engine stopped"));
+    }
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_one();
+  return future;
+}
+
+void CP2112AsyncEngine::run() {
+  while (true) {
+    if (!current_ && !inPending_ && outPending_ == 0) {
+      std::unique_lock<std::mutex> guard(mutex_);
+      cv_.wait(guard, [this] { return stop_ || !queue_.empty(); });
+    }
+    if (stop_) {
+      break;
+    }
+
+    if (!current_) {
+      startNext();
+    }
+    auto timeout = kEventTimeout;
+    if (nextPoll_) {
+      auto now = Clock::now();
+      if (now >= *nextPoll_) {
+        nextPoll_.reset();
+        sendStatusRequest();
+      } else {
+        timeout = std::min(
+            timeout,
+            std::chrono::ceil<milliseconds>(*nextPoll_ - now));
+      }
+    }
+
+    try {
+      transport_->handleEvents(timeout);
+    } catch (const UsbError& ex) {
+      fail(folly::exception_wrapper(std::current_exception(), ex), true);
+    }
+    checkDeadline();
+  }
+
+  stopped_ = true;
+  auto error =
+      folly::make_exception_wrapper<UsbError>("CP2112 async engine stopped");
+  if (current_) {
+    current_->promise.setException(error);
+    current_.reset();
+  }
+  for (auto& request : takeQueued()) {
+    request.promise.setException(error);
+  }
+}
+
+void CP2112AsyncEngine::startNext() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (queue_.empty()) {
+      return;
+    }
+    current_ = std::make_unique<Request>(std::move(queue_.front()));
+    queue_.pop_front();
+  }
+  deadline_ = Clock::now() + current_->timeout;
+
+  if (needsResync_) {
+    // Cancel whatever the device is doing, and discard anything it sends
+    // until the response to our status request.
+    VLOG(1) << "resyncing CP2112 device state";
+    phase_ = Phase::RESYNC;
+    Report cancel{};
+    cancel[0] = CP2112::CANCEL_XFER;
+    cancel[1] = 1;
+    sendOut(cancel, "cancel transfer");
+    sendStatusRequest();
+    return;
+  }
+  startRequest();
+}
+
+void CP2112AsyncEngine::startRequest() {
+  VLOG(5) << "sending " << current_->operation << " request to i2c address "
+          << std::hex << (int)current_->report[1];
+  phase_ = Phase::STATUS;
+  bytesRead_ = 0;
+  sendOut(current_->report, current_->operation);
+  sendStatusRequest();
+}
+
+void CP2112AsyncEngine::sendOut(const Report& report, const char* name) {
+  ++outPending_;
+  transport_->submitOut(report, kOutTimeout, [this, name](int rc) {
+    --outPending_;
+    if (stopped_ || rc == 0) {
+      return;
+    }
+    fail(
+        folly::make_exception_wrapper<LibusbError>(
+            rc, "failed to send ", name, " request"),
+        true);
+  });
+}
+
+void CP2112AsyncEngine::sendStatusRequest() {
+  Report status{};
+  status[0] = CP2112::XFER_STATUS_REQUEST;
+  status[1] = 1;
+  ++statusPending_;
+  sendOut(status, "get xfer status");
+  receive(kStatusTimeout);
+}
+
+void CP2112AsyncEngine::sendForceSend() {
+  Report forceSend{};
+  forceSend[0] = CP2112::READ_FORCE_SEND;
+  forceSend[1] = 1;
+  sendOut(forceSend, "read force send");
+  receive(kReadResponseTimeout);
+}
+
+void CP2112AsyncEngine::receive(milliseconds timeout) {
+  // A single interrupt in transfer is enough, the next one is submitted
+  // after processing the report received
+  if (inPending_) {
+    return;
+  }
+  inPending_ = true;
+  transport_->submitIn(
+      timeout, [this](int rc, const Report& report) { inDone(rc, report); });
+}
+
+void CP2112AsyncEngine::inDone(int rc, const Report& report) {
+  inPending_ = false;
+  if (stopped_) {
+    return;
+  }
+
+  if (rc != 0) {
+    if (rc == LIBUSB_ERROR_TIMEOUT && current_) {
+      if (phase_ == Phase::READ_DATA) {
+        // The device may be waiting on another READ_FORCE_SEND
+        VLOG(1) << "timed out waiting on READ_RESPONSE, "
+                << "sending READ_FORCE_SEND";
+        sendForceSend();
+        return;
+      }
+      if (phase_ == Phase::RESYNC) {
+        // The status responses we are waiting on were lost, ask again
+        statusPending_ = 0;
+        sendStatusRequest();
+        return;
+      }
+    }
+    fail(
+        folly::make_exception_wrapper<LibusbError>(
+            rc, "error waiting for interrupt response"),
+        true);
+    return;
+  }
+
+  if (report[0] == CP2112::XFER_STATUS_RESPONSE && statusPending_ > 0) {
+    --statusPending_;
+  }
+  if (!current_) {
+    VLOG(1) << "discarding stale USB interrupt response packet "
+            << (int)report[0];
+    needsResync_ = true;
+    if (statusPending_ > 0) {
+      receive(kStatusTimeout);
+    }
+    return;
+  }
+
+  if (phase_ == Phase::READ_DATA) {
+    processReadResponse(report);
+  } else {
+    processStatus(report);
+  }
+}
+
+void CP2112AsyncEngine::processStatus(const Report& report) {
+  if (phase_ == Phase::RESYNC) {
+    if (report[0] != CP2112::XFER_STATUS_RESPONSE) {
+      VLOG(1) << "discarding stale USB interrupt response packet "
+              << (int)report[0];
+    }
+    if (statusPending_ > 0) {
+      receive(kStatusTimeout);
+      return;
+    }
+    needsResync_ = false;
+    startRequest();
+    return;
+  }
+
+  if (report[0] != CP2112::XFER_STATUS_RESPONSE) {
+    if (report[0] == CP2112::READ_RESPONSE && report[1] == 0 &&
+        report[2] == 0) {
+      // The final empty READ_RESPONSE of an earlier read, see
+      // CP2112::getTransferStatusImpl()
+      receive(kStatusTimeout);
+      return;
+    }
+    LOG(DFATAL) << "received unexpected interrupt response while waiting on "
+                << current_->operation
+                << " transfer status: " << (int)report[0];
+    fail(
+        folly::make_exception_wrapper<UsbError>(
+            "unexpected response ",
+            (int)report[0],
+            "while waiting on ",
+            current_->operation,
+            " transfer status"),
+        true);
+    return;
+  }
+
+  uint8_t status0 = report[1];
+  uint8_t status1 = report[2];
+  VLOG(5) << current_->operation << " xfer status:"
+          << " status0=" << (int)status0 << " status1=" << (int)status1;
+
+  if (status0 == 2) {
+    // successfully completed
+    if (current_->readBuf.empty()) {
+      complete();
+      return;
+    }
+    // Now read the data over USB
+    phase_ = Phase::READ_DATA;
+    sendForceSend();
+    return;
+  } else if (status0 == 3) {
+    // failed, the device is idle again
+    fail(
+        folly::make_exception_wrapper<UsbError>(
+            current_->operation,
+            " failed: ",
+            CP2112::getCompleteStatusMsg(status1)),
+        false);
+    return;
+  } else if (status0 != 1) {
+    // 1 is busy.  Any other status is unexpected.
+    fail(
+        folly::make_exception_wrapper<UsbError>(
+            "unexpected transaction status ",
+            status0,
+            " while waiting on ",
+            current_->operation,
+            " completion"),
+        true);
+    return;
+  }
+
+  if (Clock::now() > deadline_) {
+    // The transfer is cancelled when resyncing
+    fail(
+        folly::make_exception_wrapper<UsbError>(
+            "timed out waiting on ",
+            current_->operation,
+            " response: ",
+            CP2112::getBusyStatusMsg(status1)),
+        true);
+    return;
+  }
+  if (pollInterval_.count() > 0) {
+    nextPoll_ = Clock::now() + pollInterval_;
+  } else {
+    sendStatusRequest();
+  }
+}
+
+void CP2112AsyncEngine::processReadResponse(const Report& report) {
+  auto& buf = current_->readBuf;
+  if (report[0] != CP2112::READ_RESPONSE) {
+    LOG(DFATAL) << "received unexpected interrupt response while waiting on "
+                   "read response: "
+                << (int)report[0];
+    fail(
+        folly::make_exception_wrapper<UsbError>(
+            "unexpected device status waiting on read response"),
+        true);
+    return;
+  }
+
+  uint8_t status = report[1];
+  uint8_t length = report[2];
+  VLOG(5) << "SMBus read response: status=" << (int)status
+          << ", length=" << (int)length;
+  if (length > 61 || bytesRead_ + length > buf.size()) {
+    fail(
+        folly::make_exception_wrapper<UsbError>(
+            "unexpected read response length ", length),
+        true);
+    return;
+  }
+  memcpy(buf.begin() + bytesRead_, report.data() + 3, length);
+  bytesRead_ += length;
+
+  if (status == 0 || status == 2) {
+    // The device always finishes with a 0-length read response, see
+    // CP2112::processReadResponse()
+    if (bytesRead_ == buf.size() && length == 0) {
+      complete();
+      return;
+    }
+  } else if (status != 1) {
+    fail(
+        folly::make_exception_wrapper<UsbError>(
+            "unexpected status ", status, " while waiting on read response"),
+        true);
+    return;
+  }
+
+  if (bytesRead_ < buf.size() && length < 61) {
+    sendForceSend();
+  } else {
+    receive(kReadResponseTimeout);
+  }
+}
+
+void CP2112AsyncEngine::checkDeadline() {
+  if (!current_ || Clock::now() <= deadline_) {
+    return;
+  }
+  // The next status response reports the timeout with the busy status
+  if (phase_ == Phase::STATUS && inPending_) {
+    return;
+  }
+  fail(
+      folly::make_exception_wrapper<UsbError>(
+          "timed out waiting on ", current_->operation, " response data"),
+      true);
+}
+
+void CP2112AsyncEngine::complete() {
+  nextPoll_.reset();
+  auto request = std::move(current_);
+  request->promise.setValue();
+  // Pipelined right behind the previous request
+  startNext();
+}
+
+void CP2112AsyncEngine::fail(
+    const folly::exception_wrapper& error,
+    bool resync) {
+  if (resync) {
+    needsResync_ = true;
+  }
+  if (!current_) {
+    return;
+  }
+  VLOG(3) << "CP2112 " << current_->operation
+          << " failed: " << error.what();
+  nextPoll_.reset();
+  // Take the queued requests first, the requests queued once the caller
+  // sees the failure run
+  auto queue = takeQueued();
+  auto request = std::move(current_);
+  request->promise.setException(error);
+  for (auto& queued : queue) {
+    queued.promise.setException(error);
+  }
+}
+
+std::deque<CP2112AsyncEngine::Request> CP2112AsyncEngine::takeQueued() {
+  std::deque<Request> queue;
+  std::lock_guard<std::mutex> guard(mutex_);
+  queue.swap(queue_);
+  return queue;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Function.h>
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+struct libusb_context;
+struct libusb_device_handle;
+struct libusb_transfer;
+
+namespace facebook::fboss {
+
+/*
+ * Asynchronous interrupt transfers to and from a CP2112.
+ *
+ * All callbacks are invoked from handleEvents(), on the thread calling it.
+ * rc is 0 on success, or a libusb error code.
+ */
+class CP2112Transport {
+ public:
+  // The CP2112 always uses 64-byte interrupt transfers
+  using Report = std::array<uint8_t, 64>;
+  using OutCallback = folly::Function<void(int rc)>;
+  using InCallback = folly::Function<void(int rc, const Report& report)>;
+
+  virtual ~CP2112Transport() {}
+
+  virtual void submitOut(
+      const Report& report,
+      std::chrono::milliseconds timeout,
+      OutCallback callback) = 0;
+  virtual void submitIn(
+      std::chrono::milliseconds timeout,
+      InCallback callback) = 0;
+
+  /*
+   * Run the callbacks of completed transfers, waiting at most timeout for
+   * one to complete.
+   */
+  virtual void handleEvents(std::chrono::milliseconds timeout) = 0;
+};
+
+/*
+ * CP2112Transport using the libusb asynchronous API on endpoint 1.
+ *
+ * Transfers still outstanding on destruction are cancelled, and their
+ * callbacks invoked with LIBUSB_ERROR_INTERRUPTED.
+ */
+class LibusbCP2112Transport : public CP2112Transport {
+ public:
+  LibusbCP2112Transport(libusb_context* ctx, libusb_device_handle* handle);
+  ~LibusbCP2112Transport() override;
+
+  void submitOut(
+      const Report& report,
+      std::chrono::milliseconds timeout,
+      OutCallback callback) override;
+  void submitIn(std::chrono::milliseconds timeout, InCallback callback)
+      override;
+  void handleEvents(std::chrono::milliseconds timeout) override;
+
+ private:
+  struct Transfer;
+
+  // Forbidden copy constructor and assignment operator
+  LibusbCP2112Transport(LibusbCP2112Transport const&) = delete;
+  LibusbCP2112Transport& operator=(LibusbCP2112Transport const&) = delete;
+
+  std::unique_ptr<Transfer> makeTransfer(
+      uint8_t endpoint,
+      std::chrono::milliseconds timeout);
+  void submit(std::unique_ptr<Transfer> transfer);
+  static void transferCallback(libusb_transfer* xfer);
+
+  libusb_context* ctx_{nullptr};
+  libusb_device_handle* handle_{nullptr};
+  std::unordered_set<Transfer*> transfers_;
+  // Transfers which failed to submit, completed by the next handleEvents()
+  std::vector<std::unique_ptr<Transfer>> failed_;
+};
+
+/*
+ * Pipelines reads and writes to the SMBus through a CP2112.
+ *
+ * The blocking CP2112 API sends a request, then polls the transfer status
+ * and sleeps between polls, and returns to the caller before the next
+ * request is sent.  Here requests are queued, and a thread drives all the
+ * USB transfers from the libusb completion callbacks:
+ *
+ * - The transfer status request is sent right behind the request, and
+ *   busy transfers are polled again as soon as the status comes back (or
+ *   after pollInterval).
+ * - The next queued request is sent from the completion of the previous
+ *   one, without waking up any caller in between.
+ *
+ * The chip only runs one SMBus transaction at a time, and has no transfer
+ * ID to match responses to requests.  So requests are still sent one at a
+ * time, when the previous one completed, and at most the request and its
+ * status request are outstanding on the interrupt out endpoint.
+ *
+ * A failed request also fails all the requests queued at that point,
+ * since those were usually queued expecting it to succeed (for instance
+ * the read following the write of an offset).  The device is then
+ * resynchronized before sending the next request.
+ */
+class CP2112AsyncEngine {
+ public:
+  explicit CP2112AsyncEngine(
+      std::unique_ptr<CP2112Transport> transport,
+      std::chrono::milliseconds pollInterval = std::chrono::milliseconds(0));
+  // Fails any request not completed yet
+  ~CP2112AsyncEngine();
+
+  /*
+   * Read from the SMBus, between 1 and 512 bytes.
+   *
+   * buf must remain valid until the returned future completes.  The
+   * timeout starts when the read is sent to the device, not when it is
+   * queued.
+   */
+  folly::SemiFuture<folly::Unit> read(
+      uint8_t address,
+      folly::MutableByteRange buf,
+      std::chrono::milliseconds timeout);
+
+  /*
+   * Write to the SMBus, between 1 and 61 bytes.  buf is copied before
+   * returning.
+   */
+  folly::SemiFuture<folly::Unit> write(
+      uint8_t address,
+      folly::ByteRange buf,
+      std::chrono::milliseconds timeout);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  using Report = CP2112Transport::Report;
+
+  enum class Phase {
+    // Cancelling whatever the device is doing, and waiting on its status
+    RESYNC,
+    // Waiting on the transfer status
+    STATUS,
+    // Receiving the read response data
+    READ_DATA,
+  };
+
+  struct Request {
+    Report report{};
+    const char* operation{nullptr};
+    // Empty for writes
+    folly::MutableByteRange readBuf;
+    std::chrono::milliseconds timeout{0};
+    folly::Promise<folly::Unit> promise;
+  };
+
+  // Forbidden copy constructor and assignment operator
+  CP2112AsyncEngine(CP2112AsyncEngine const&) = delete;
+  CP2112AsyncEngine& operator=(CP2112AsyncEngine const&) = delete;
+
+  folly::SemiFuture<folly::Unit> enqueue(Request request);
+  void run();
+
+  void startNext();
+  void startRequest();
+  void sendOut(const Report& report, const char* name);
+  void sendStatusRequest();
+  void sendForceSend();
+  void receive(std::chrono::milliseconds timeout);
+
+  void inDone(int rc, const Report& report);
+  void processStatus(const Report& report);
+  void processReadResponse(const Report& report);
+  void checkDeadline();
+
+  void complete();
+  void fail(const folly::exception_wrapper& error, bool resync);
+  std::deque<Request> takeQueued();
+
+  std::unique_ptr<CP2112Transport> transport_;
+  const std::chrono::milliseconds pollInterval_;
+
+  // Only accessed from the engine thread
+  std::unique_ptr<Request> current_;
+  Phase phase_{Phase::STATUS};
+  bool needsResync_{true};
+  bool inPending_{false};
+  size_t outPending_{0};
+  // Status requests sent, whose response wasn't received yet
+  size_t statusPending_{0};
+  uint16_t bytesRead_{0};
+  Clock::time_point deadline_;
+  std::optional<Clock::time_point> nextPoll_;
+  bool stopped_{false};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  // Set under mutex_, but read without it by the busy engine thread
+  std::atomic<bool> stop_{false};
+
+  std::thread thread_;
+};
+
+} // namespace facebook::fboss
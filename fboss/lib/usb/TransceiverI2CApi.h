@@ -95,6 +95,16 @@ class TransceiverI2CApi {
     return nullptr;
   };
 
+  /*
+   * Function that returns the id of the I2C bus the module sits on. Modules
+   * behind the same controller or mux share a bus and can only be accessed
+   * one at a time, while modules on different buses can be accessed in
+   * parallel. Platforms with a single I2C bus put every module on bus 0.
+   */
+  virtual uint32_t getBusId(unsigned int /* module */) {
+    return 0;
+  }
+
   /* Virtual function to count the i2c transactions in a platform. This
    * will be overridden by derived classes which are platform specific
    * and has the platform specific implementation for this counter
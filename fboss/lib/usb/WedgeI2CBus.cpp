@@ -20,8 +20,12 @@ namespace facebook::fboss {
 WedgeI2CBus::WedgeI2CBus() {}
 
 void WedgeI2CBus::initBus() {
-  dev_->writeByte(ADDR_SWITCH_1, 0);
-  dev_->writeByte(ADDR_SWITCH_2, 0);
+  std::vector<Transaction> transactions;
+  transactions.emplace_back(
+      [&] { return dev_->writeByteAsync(ADDR_SWITCH_1, 0); });
+  transactions.emplace_back(
+      [&] { return dev_->writeByteAsync(ADDR_SWITCH_2, 0); });
+  runTransactions(std::move(transactions));
 }
 
 void WedgeI2CBus::verifyBus(bool autoReset) {
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/usb/CP2112AsyncEngine.h"
+#include "fboss/lib/usb/tests/FakeCP2112Device.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <array>
+
+DEFINE_int32(
+    cp2112_benchmark_modules,
+    16,
+    "Number of QSFP modules read per refresh cycle");
+DEFINE_int32(
+    cp2112_benchmark_usb_latency_us,
+    1000,
+    "Latency of each USB interrupt transfer, the CP2112 polling interval");
+DEFINE_int32(
+    cp2112_benchmark_byte_time_us,
+    23,
+    "Time to transfer one byte on the SMBus, 23us is 400kHz");
+
+using namespace facebook::fboss;
+using folly::ByteRange;
+using folly::MutableByteRange;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+/*
+ * A DOM refresh cycle on a Wedge bus: for each module select it on the
+ * PCA9548 switches, read the lower and upper pages 128 bytes at a time,
+ * and unselect it, against a fake CP2112 with USB and SMBus latencies.
+ * Each iteration is one cycle.
+ *
+ * The blocking CP2112 API is modeled by waiting on each transaction before
+ * sending the next, and sleeping 10ms between status polls.
+ */
+namespace {
+
+const uint8_t kSwitch1 = 0xe8;
+const uint8_t kSwitch2 = 0xec;
+const uint8_t kQsfp = 0xa0;
+const milliseconds kTimeout(500);
+
+class Transactions {
+ public:
+  Transactions(CP2112AsyncEngine* engine, bool pipelined)
+      : engine_(engine), pipelined_(pipelined) {}
+
+  void write(uint8_t address, uint8_t value) {
+    add(engine_->write(address, ByteRange(&value, 1), kTimeout));
+  }
+  void read(uint8_t address, MutableByteRange buf) {
+    add(engine_->read(address, buf, kTimeout));
+  }
+  void wait() {
+    folly::collectAll(std::move(futures_)).get();
+    futures_.clear();
+  }
+
+ private:
+  void add(folly::SemiFuture<folly::Unit> future) {
+    if (pipelined_) {
+      futures_.push_back(std::move(future));
+    } else {
+      std::move(future).get();
+    }
+  }
+
+  CP2112AsyncEngine* engine_{nullptr};
+  bool pipelined_{false};
+  std::vector<folly::SemiFuture<folly::Unit>> futures_;
+};
+
+void refreshCycles(size_t numIters, bool pipelined, milliseconds pollInterval) {
+  std::unique_ptr<CP2112AsyncEngine> engine;
+  BENCHMARK_SUSPEND {
+    auto device = std::make_unique<FakeCP2112Device>();
+    device->addDevice(kSwitch1);
+    device->addDevice(kSwitch2);
+    device->addDevice(kQsfp);
+    device->setUsbLatency(microseconds(FLAGS_cp2112_benchmark_usb_latency_us));
+    device->setByteTime(microseconds(FLAGS_cp2112_benchmark_byte_time_us));
+    engine = std::make_unique<CP2112AsyncEngine>(
+        std::move(device), pollInterval);
+  }
+
+  std::array<uint8_t, 256> page;
+  for (size_t n = 0; n < numIters; ++n) {
+    for (int module = 0; module < FLAGS_cp2112_benchmark_modules; ++module) {
+      Transactions transactions(engine.get(), pipelined);
+      transactions.write(kSwitch1, 1 << (module % 8));
+      transactions.write(kSwitch2, 0);
+      transactions.write(kQsfp, 0);
+      transactions.read(kQsfp, MutableByteRange(page.data(), 128));
+      transactions.write(kQsfp, 128);
+      transactions.read(kQsfp, MutableByteRange(page.data() + 128, 128));
+      transactions.write(kSwitch1, 0);
+      transactions.write(kSwitch2, 0);
+      transactions.wait();
+    }
+  }
+
+  BENCHMARK_SUSPEND {
+    engine.reset();
+  }
+}
+
+} // namespace
+
+BENCHMARK(CP2112RefreshBlocking, numIters) {
+  refreshCycles(numIters, false, milliseconds(10));
+}
+
+BENCHMARK_RELATIVE(CP2112RefreshOneInFlight, numIters) {
+  refreshCycles(numIters, false, milliseconds(0));
+}
+
+BENCHMARK_RELATIVE(CP2112RefreshPipelined, numIters) {
+  refreshCycles(numIters, true, milliseconds(0));
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
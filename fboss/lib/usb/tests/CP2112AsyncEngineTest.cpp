@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/usb/CP2112AsyncEngine.h"
+#include "fboss/lib/usb/UsbError.h"
+#include "fboss/lib/usb/tests/FakeCP2112Device.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+using namespace facebook::fboss;
+using folly::ByteRange;
+using folly::MutableByteRange;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace {
+const uint8_t kEeprom = 0xa0;
+const uint8_t kAbsent = 0xa2;
+const milliseconds kTimeout(500);
+
+class CP2112AsyncEngineTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto device = std::make_unique<FakeCP2112Device>();
+    device_ = device.get();
+    device_->addDevice(kEeprom);
+    engine_ = std::make_unique<CP2112AsyncEngine>(std::move(device));
+  }
+
+  folly::SemiFuture<folly::Unit> writeAt(
+      uint8_t offset,
+      const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> buf{offset};
+    buf.insert(buf.end(), data.begin(), data.end());
+    return engine_->write(kEeprom, ByteRange(buf.data(), buf.size()), kTimeout);
+  }
+
+  std::vector<uint8_t> readAt(uint8_t offset, size_t len) {
+    std::vector<uint8_t> buf(len);
+    auto write = engine_->write(kEeprom, ByteRange(&offset, 1), kTimeout);
+    auto read = engine_->read(
+        kEeprom, MutableByteRange(buf.data(), buf.size()), kTimeout);
+    std::move(write).get();
+    std::move(read).get();
+    return buf;
+  }
+
+ protected:
+  FakeCP2112Device* device_{nullptr};
+  std::unique_ptr<CP2112AsyncEngine> engine_;
+};
+
+std::vector<uint8_t> iota(size_t len, uint8_t start) {
+  std::vector<uint8_t> data(len);
+  std::iota(data.begin(), data.end(), start);
+  return data;
+}
+} // namespace
+
+TEST_F(CP2112AsyncEngineTest, WriteRead) {
+  writeAt(0x10, iota(8, 1)).get();
+  EXPECT_EQ(readAt(0x10, 8), iota(8, 1));
+  // The engine resyncs once before the first request
+  EXPECT_EQ(device_->numReports(FakeCP2112Device::CANCEL_XFER), 1);
+}
+
+TEST_F(CP2112AsyncEngineTest, Pipelined) {
+  // Queue writes and reads back to back, and only then wait
+  std::vector<std::vector<uint8_t>> bufs(16, std::vector<uint8_t>(4));
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  for (uint8_t i = 0; i < bufs.size(); ++i) {
+    uint8_t offset = i * 4;
+    futures.push_back(writeAt(offset, iota(4, offset)));
+    futures.push_back(engine_->write(kEeprom, ByteRange(&offset, 1), kTimeout));
+    futures.push_back(engine_->read(
+        kEeprom, MutableByteRange(bufs[i].data(), bufs[i].size()), kTimeout));
+  }
+  for (auto& result : folly::collectAll(std::move(futures)).get()) {
+    EXPECT_TRUE(result.hasValue());
+  }
+  for (uint8_t i = 0; i < bufs.size(); ++i) {
+    EXPECT_EQ(bufs[i], iota(4, i * 4));
+  }
+}
+
+TEST_F(CP2112AsyncEngineTest, BusyPolling) {
+  device_->setByteTime(microseconds(200));
+  writeAt(0, iota(32, 0)).get();
+  EXPECT_EQ(readAt(0, 32), iota(32, 0));
+  // The status is polled until the bus transactions completed
+  EXPECT_GT(device_->numReports(FakeCP2112Device::XFER_STATUS_REQUEST), 4);
+}
+
+TEST_F(CP2112AsyncEngineTest, LargeRead) {
+  for (int offset = 0; offset < 256; offset += 32) {
+    writeAt(offset, iota(32, offset)).get();
+  }
+  // Longer than returned by one READ_FORCE_SEND, wraps around the EEPROM
+  auto data = readAt(0, 512);
+  for (int i = 0; i < 512; ++i) {
+    EXPECT_EQ(data[i], i % 256);
+  }
+  EXPECT_GT(device_->numReports(FakeCP2112Device::READ_FORCE_SEND), 1);
+}
+
+TEST_F(CP2112AsyncEngineTest, InvalidLength) {
+  std::vector<uint8_t> buf(513);
+  EXPECT_THROW(
+      engine_
+          ->read(kEeprom, MutableByteRange(buf.data(), buf.size()), kTimeout)
+          .get(),
+      UsbError);
+  EXPECT_THROW(
+      engine_->write(kEeprom, ByteRange(buf.data(), 62), kTimeout).get(),
+      UsbError);
+  EXPECT_THROW(
+      engine_->write(kEeprom, ByteRange(buf.data(), 0), kTimeout).get(),
+      UsbError);
+}
+
+TEST_F(CP2112AsyncEngineTest, NackFailsQueued) {
+  device_->setByteTime(microseconds(100));
+  uint8_t offset = 0;
+  uint8_t data = 0;
+  auto nacked = engine_->write(kAbsent, ByteRange(&offset, 1), kTimeout);
+  auto queued = engine_->read(kAbsent, MutableByteRange(&data, 1), kTimeout);
+  EXPECT_THROW(std::move(nacked).get(), UsbError);
+  EXPECT_THROW(std::move(queued).get(), UsbError);
+
+  // Requests queued after the failure run
+  writeAt(0, {42}).get();
+  EXPECT_EQ(readAt(0, 1), std::vector<uint8_t>{42});
+}
+
+TEST_F(CP2112AsyncEngineTest, Timeout) {
+  // 64ms for the read, while the timeout is 20ms
+  device_->setByteTime(milliseconds(1));
+  std::vector<uint8_t> buf(63);
+  auto read = engine_->read(
+      kEeprom, MutableByteRange(buf.data(), buf.size()), milliseconds(20));
+  EXPECT_THROW(std::move(read).get(), UsbError);
+
+  // The transfer is cancelled before the next request
+  device_->setByteTime(microseconds(0));
+  EXPECT_EQ(readAt(0, 4), std::vector<uint8_t>(4, 0));
+  EXPECT_EQ(device_->numReports(FakeCP2112Device::CANCEL_XFER), 2);
+}
+
+TEST_F(CP2112AsyncEngineTest, OutFailure) {
+  device_->failNextOut(LIBUSB_ERROR_IO);
+  EXPECT_THROW(writeAt(0, {1}).get(), LibusbError);
+  writeAt(0, {1}).get();
+  EXPECT_EQ(readAt(0, 1), std::vector<uint8_t>{1});
+}
+
+TEST_F(CP2112AsyncEngineTest, DiscardsStaleResponses) {
+  // Left over from a read before the engine started
+  device_->injectStaleReadResponse(61);
+  device_->injectStaleReadResponse(0);
+  writeAt(0, iota(4, 7)).get();
+  EXPECT_EQ(readAt(0, 4), iota(4, 7));
+}
+
+TEST_F(CP2112AsyncEngineTest, StopFailsQueued) {
+  device_->setByteTime(milliseconds(1));
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  for (int i = 0; i < 4; ++i) {
+    futures.push_back(writeAt(0, iota(60, 0)));
+  }
+  engine_.reset();
+  for (auto& result : folly::collectAll(std::move(futures)).get()) {
+    EXPECT_TRUE(result.hasException());
+  }
+}
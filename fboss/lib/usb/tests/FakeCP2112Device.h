@@ -0,0 +1,302 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/lib/usb/CP2112AsyncEngine.h"
+
+#include <libusb-1.0/libusb.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * A CP2112 behind a fake USB transport, with EEPROM like devices on its
+ * SMBus: the first byte written sets the offset, which reads and writes
+ * then advance.
+ *
+ * Each interrupt transfer takes usbLatency, one at a time per endpoint,
+ * and each SMBus transaction keeps the bus busy for byteTime per byte
+ * (plus one for the address).  Like the real chip, a READ_FORCE_SEND only
+ * returns part of a large read.
+ */
+class FakeCP2112Device : public CP2112Transport {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum : uint8_t {
+    READ_REQUEST = 0x10,
+    READ_FORCE_SEND = 0x12,
+    READ_RESPONSE = 0x13,
+    WRITE = 0x14,
+    XFER_STATUS_REQUEST = 0x15,
+    XFER_STATUS_RESPONSE = 0x16,
+    CANCEL_XFER = 0x17,
+  };
+
+  // READ_RESPONSE packets returned per READ_FORCE_SEND
+  static constexpr size_t kPacketsPerForceSend = 5;
+
+  void addDevice(uint8_t address) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    devices_[address].fill(0);
+  }
+  void removeDevice(uint8_t address) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    devices_.erase(address);
+  }
+  void setUsbLatency(std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    usbLatency_ = latency;
+  }
+  void setByteTime(std::chrono::microseconds byteTime) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    byteTime_ = byteTime;
+  }
+  // Fail the next interrupt out transfer with rc
+  void failNextOut(int rc) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    failNextOut_ = rc;
+  }
+  // A response left over from before the engine started
+  void injectStaleReadResponse(uint8_t length) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    Report report{};
+    report[0] = READ_RESPONSE;
+    report[1] = 2;
+    report[2] = length;
+    responses_.push_back({Clock::now(), report});
+  }
+
+  size_t numReports(uint8_t reportId) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return numReports_[reportId];
+  }
+
+  void submitOut(
+      const Report& report,
+      std::chrono::milliseconds /* timeout */,
+      OutCallback callback) override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    lastOutDone_ = std::max(Clock::now(), lastOutDone_) + usbLatency_;
+    outs_.push_back({lastOutDone_, report, std::move(callback)});
+  }
+
+  void submitIn(std::chrono::milliseconds timeout, InCallback callback)
+      override {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ins_.push_back({Clock::now() + timeout, std::move(callback)});
+  }
+
+  void handleEvents(std::chrono::milliseconds timeout) override {
+    if (!runCallbacks()) {
+      std::this_thread::sleep_until(
+          std::min(nextEvent(), Clock::now() + timeout));
+      runCallbacks();
+    }
+  }
+
+ private:
+  struct Out {
+    Clock::time_point doneAt;
+    Report report;
+    OutCallback callback;
+  };
+  struct In {
+    Clock::time_point timeoutAt;
+    InCallback callback;
+  };
+  struct Response {
+    Clock::time_point readyAt;
+    Report report;
+  };
+
+  // Returns whether any callback ran.  Callbacks run without the lock,
+  // since they submit more transfers, which are left to the next call.
+  bool runCallbacks() {
+    size_t numTransfers;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      numTransfers = outs_.size() + ins_.size();
+    }
+    bool ran = false;
+    for (size_t i = 0; i < numTransfers; ++i) {
+      std::unique_lock<std::mutex> guard(mutex_);
+      auto now = Clock::now();
+      if (!outs_.empty() && outs_.front().doneAt <= now) {
+        auto out = std::move(outs_.front());
+        outs_.pop_front();
+        int rc = failNextOut_;
+        failNextOut_ = 0;
+        if (rc == 0) {
+          process(out.doneAt, out.report);
+        }
+        guard.unlock();
+        out.callback(rc);
+        ran = true;
+        continue;
+      }
+      if (!ins_.empty()) {
+        auto inDoneAt = responses_.empty()
+            ? Clock::time_point::max()
+            : std::max(responses_.front().readyAt, lastInDone_ + usbLatency_);
+        if (inDoneAt <= now) {
+          auto in = std::move(ins_.front());
+          ins_.pop_front();
+          auto report = responses_.front().report;
+          responses_.pop_front();
+          lastInDone_ = inDoneAt;
+          guard.unlock();
+          in.callback(0, report);
+          ran = true;
+          continue;
+        }
+        if (ins_.front().timeoutAt <= now) {
+          auto in = std::move(ins_.front());
+          ins_.pop_front();
+          guard.unlock();
+          in.callback(LIBUSB_ERROR_TIMEOUT, Report{});
+          ran = true;
+          continue;
+        }
+      }
+      break;
+    }
+    return ran;
+  }
+
+  Clock::time_point nextEvent() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto next = Clock::time_point::max();
+    if (!outs_.empty()) {
+      next = outs_.front().doneAt;
+    }
+    if (!ins_.empty()) {
+      next = std::min(next, ins_.front().timeoutAt);
+      if (!responses_.empty()) {
+        next = std::min(
+            next,
+            std::max(responses_.front().readyAt, lastInDone_ + usbLatency_));
+      }
+    }
+    return next;
+  }
+
+  void process(Clock::time_point now, const Report& report) {
+    ++numReports_[report[0]];
+    switch (report[0]) {
+      case WRITE: {
+        uint8_t length = report[2];
+        startTransaction(now, report[1], length, false);
+        auto device = devices_.find(report[1]);
+        if (device != devices_.end()) {
+          offset_ = report[3];
+          for (int i = 1; i < length; ++i) {
+            device->second[offset_++] = report[3 + i];
+          }
+        }
+        break;
+      }
+      case READ_REQUEST: {
+        uint16_t length = (report[2] << 8) | report[3];
+        startTransaction(now, report[1], length, true);
+        auto device = devices_.find(report[1]);
+        if (device != devices_.end()) {
+          for (int i = 0; i < length; ++i) {
+            readData_.push_back(device->second[offset_++]);
+          }
+        }
+        break;
+      }
+      case XFER_STATUS_REQUEST: {
+        Report status{};
+        status[0] = XFER_STATUS_RESPONSE;
+        if (!inTransaction_) {
+          status[1] = 0; // idle
+        } else if (now < busyUntil_) {
+          status[1] = 1; // busy
+          status[2] = readTransaction_ ? 2 : 3; // read or write in progress
+        } else if (nacked_) {
+          status[1] = 3; // failed
+          status[2] = 0; // address not acknowledged
+        } else {
+          status[1] = 2; // succeeded
+          status[2] = 5;
+        }
+        responses_.push_back({now, status});
+        break;
+      }
+      case READ_FORCE_SEND:
+        for (size_t i = 0; i < kPacketsPerForceSend && !readData_.empty();
+             ++i) {
+          Report response{};
+          response[0] = READ_RESPONSE;
+          response[1] = 2;
+          response[2] = std::min<size_t>(readData_.size(), 61);
+          std::copy_n(readData_.begin(), response[2], response.begin() + 3);
+          readData_.erase(readData_.begin(), readData_.begin() + response[2]);
+          responses_.push_back({now, response});
+        }
+        if (readData_.empty()) {
+          // The final empty response
+          Report response{};
+          response[0] = READ_RESPONSE;
+          responses_.push_back({now, response});
+        }
+        break;
+      case CANCEL_XFER:
+        inTransaction_ = false;
+        readData_.clear();
+        break;
+    }
+  }
+
+  void startTransaction(
+      Clock::time_point now,
+      uint8_t address,
+      size_t length,
+      bool read) {
+    inTransaction_ = true;
+    readTransaction_ = read;
+    nacked_ = devices_.find(address) == devices_.end();
+    busyUntil_ = now + byteTime_ * (nacked_ ? 1 : length + 1);
+    readData_.clear();
+  }
+
+  std::mutex mutex_;
+  std::chrono::microseconds usbLatency_{0};
+  std::chrono::microseconds byteTime_{0};
+  int failNextOut_{0};
+
+  std::deque<Out> outs_;
+  std::deque<In> ins_;
+  std::deque<Response> responses_;
+  Clock::time_point lastOutDone_;
+  Clock::time_point lastInDone_;
+
+  std::map<uint8_t, std::array<uint8_t, 256>> devices_;
+  uint8_t offset_{0};
+  bool inTransaction_{false};
+  bool readTransaction_{false};
+  bool nacked_{false};
+  Clock::time_point busyUntil_;
+  std::vector<uint8_t> readData_;
+  std::map<uint8_t, size_t> numReports_;
+};
+
+} // namespace facebook::fboss
@@ -17,6 +17,11 @@
 namespace {
 
 constexpr uint32_t kDefaultTxnWaitMillis = 10000;
+// A Clause 45 transaction is two 64 bit frames, ~52us at the default 2.5MHz
+// MDC, and down to ~10us at 12.5MHz. Poll the status register back to back
+// for that long before sleeping between polls, as usleep() rounds up to the
+// timer slack (50us by default) and would dominate short transactions.
+constexpr auto kSpinWait = std::chrono::microseconds(100);
 
 } // namespace
 
@@ -67,13 +72,32 @@ void FbFpgaMdio::setFastMode(bool enable) {
 }
 
 void FbFpgaMdio::clearStatus() {
+  clearStatusUnchecked();
+  auto status = readReg<MdioStatus>();
+  XCHECK(!status.done && !status.err, "Failed to clear mdio status reg...");
+}
+
+void FbFpgaMdio::clearStatusUnchecked() {
   MdioStatus status;
   status.reg = 0;
   status.done = 1;
   status.err = 1;
   writeReg(status);
-  status = readReg<MdioStatus>();
-  XCHECK(!status.done && !status.err, "Failed to clear mdio status reg...");
+}
+
+void FbFpgaMdio::issueCommand(
+    phy::PhyAddress physAddr,
+    phy::Cl45DeviceAddress devAddr,
+    phy::Cl45RegisterAddress regAddr,
+    bool read) {
+  MdioCommand command;
+  command.reg = 0;
+  command.devAddr = devAddr;
+  command.regAddr = regAddr;
+  command.rw = read ? 1 : 0;
+  command.phySel = physAddr & 0b11111;
+  writeReg(command);
+  waitUntilDone(kDefaultTxnWaitMillis, command);
 }
 
 void FbFpgaMdio::waitUntilDone(uint32_t millis, MdioCommand command) {
@@ -84,9 +108,10 @@ void FbFpgaMdio::waitUntilDone(uint32_t millis, MdioCommand command) {
     throw std::runtime_error(ss.str());
   };
 
-  auto endTime =
-      std::chrono::steady_clock::now() + std::chrono::milliseconds(millis);
-  while (std::chrono::steady_clock::now() < endTime) {
+  auto now = std::chrono::steady_clock::now();
+  auto spinEndTime = now + kSpinWait;
+  auto endTime = now + std::chrono::milliseconds(millis);
+  while (now < endTime) {
     auto status = readReg<MdioStatus>();
     if (status.done) {
       if (status.err) {
@@ -94,7 +119,10 @@ void FbFpgaMdio::waitUntilDone(uint32_t millis, MdioCommand command) {
       }
       return;
     }
-    usleep(10);
+    if (now >= spinEndTime) {
+      usleep(10);
+    }
+    now = std::chrono::steady_clock::now();
   }
   throwErr("Mdio transaction timed out");
 }
@@ -106,14 +134,7 @@ phy::Cl45Data FbFpgaMdio::readCl45(
   // needed?
   clearStatus();
 
-  MdioCommand command;
-  command.reg = 0;
-  command.devAddr = devAddr;
-  command.regAddr = regAddr;
-  command.rw = 1;
-  command.phySel = physAddr & 0b11111;
-  writeReg(command);
-  waitUntilDone(kDefaultTxnWaitMillis, command);
+  issueCommand(physAddr, devAddr, regAddr, true);
 
   auto readData = readReg<MdioRead>();
   return phy::Cl45Data(readData.data);
@@ -131,14 +152,30 @@ void FbFpgaMdio::writeCl45(
   // needed?
   clearStatus();
 
-  MdioCommand command;
-  command.reg = 0;
-  command.devAddr = devAddr;
-  command.regAddr = regAddr;
-  command.rw = 0;
-  command.phySel = physAddr & 0b11111;
-  writeReg(command);
-  waitUntilDone(kDefaultTxnWaitMillis, command);
+  issueCommand(physAddr, devAddr, regAddr, false);
+}
+
+void FbFpgaMdio::executeCl45Batch(Cl45Batch& batch) {
+  clearStatus();
+  bool first = true;
+  for (auto& op : batch.operations()) {
+    if (!op.read) {
+      MdioWrite writeData;
+      writeData.reg = 0;
+      writeData.data = op.data;
+      writeReg(writeData);
+    }
+    // The status was verified clear before the first transaction, clearing
+    // it after a successful one cannot fail
+    if (!first) {
+      clearStatusUnchecked();
+    }
+    first = false;
+    issueCommand(op.physAddr, op.devAddr, op.regAddr, op.read);
+    if (op.read) {
+      op.data = readReg<MdioRead>().data;
+    }
+  }
 }
 
 template <typename Register>
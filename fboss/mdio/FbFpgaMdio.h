@@ -41,6 +41,9 @@ class FbFpgaMdio : public Mdio {
       phy::Cl45RegisterAddress regAddr,
       phy::Cl45Data data) override;
 
+  // Checks the status register once per batch rather than per transaction
+  void executeCl45Batch(Cl45Batch& batch) override;
+
   void reset();
 
   void setClockDivisor(int div);
@@ -49,6 +52,13 @@ class FbFpgaMdio : public Mdio {
 
  private:
   void clearStatus();
+  // Clear the done and error bits without reading them back
+  void clearStatusUnchecked();
+  void issueCommand(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr,
+      bool read);
   void waitUntilDone(uint32_t millis, MdioCommand command);
 
   template <typename Register>
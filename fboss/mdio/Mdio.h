@@ -13,10 +13,14 @@
 #include "fboss/mdio/Phy.h"
 #include "folly/File.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <mutex>
+#include <vector>
 
 #include <folly/Synchronized.h>
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 
 namespace {
@@ -48,8 +52,65 @@ namespace fboss {
  *
  * MdioController and MdioDevice are templated types based on the
  * variant of Mdio being used.
+ *
+ * Cl45Batch: a sequence of Clause 45 reads and writes run on one
+ * controller with a single acquisition of its locks, letting the Mdio
+ * variant amortize its per transaction overhead. Batches on different
+ * controllers can run in parallel, see executeCl45Batches().
  */
 
+class Cl45Batch {
+ public:
+  struct Operation {
+    bool read{false};
+    phy::PhyAddress physAddr{0};
+    phy::Cl45DeviceAddress devAddr{0};
+    phy::Cl45RegisterAddress regAddr{0};
+    // Data to write, or the data read once the batch ran
+    phy::Cl45Data data{0};
+  };
+
+  // Queue a read, returns the index to get its data() from
+  size_t read(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr) {
+    operations_.push_back(Operation{true, physAddr, devAddr, regAddr, 0});
+    return operations_.size() - 1;
+  }
+
+  void write(
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr,
+      phy::Cl45Data data) {
+    operations_.push_back(Operation{false, physAddr, devAddr, regAddr, data});
+  }
+
+  phy::Cl45Data data(size_t index) const {
+    return operations_.at(index).data;
+  }
+
+  size_t size() const {
+    return operations_.size();
+  }
+
+  bool empty() const {
+    return operations_.empty();
+  }
+
+  std::vector<Operation>& operations() {
+    return operations_;
+  }
+
+  const std::vector<Operation>& operations() const {
+    return operations_;
+  }
+
+ private:
+  std::vector<Operation> operations_;
+};
+
 class Mdio {
  public:
   virtual ~Mdio() {}
@@ -67,6 +128,17 @@ class Mdio {
       phy::Cl45DeviceAddress devAddr,
       phy::Cl45RegisterAddress regAddr,
       phy::Cl45Data data) = 0;
+
+  // Run the operations of the batch in order, filling in the data of reads
+  virtual void executeCl45Batch(Cl45Batch& batch) {
+    for (auto& op : batch.operations()) {
+      if (op.read) {
+        op.data = readCl45(op.physAddr, op.devAddr, op.regAddr);
+      } else {
+        writeCl45(op.physAddr, op.devAddr, op.regAddr, op.data);
+      }
+    }
+  }
 };
 
 template <typename IO>
@@ -74,6 +146,22 @@ class MdioController {
  public:
   using LockedPtr = typename folly::Synchronized<IO, std::mutex>::LockedPtr;
 
+  struct Stats {
+    // Reads and writes done through the controller
+    uint64_t transactions{0};
+    // Lock acquisitions, a single read or write counts as a batch of one
+    uint64_t batches{0};
+    // Time spent running transactions, excluding waiting for the locks
+    std::chrono::nanoseconds busyTime{0};
+
+    // Transactions per second of busy time
+    double throughput() const {
+      return busyTime.count()
+          ? transactions * 1e9 / static_cast<double>(busyTime.count())
+          : 0;
+    }
+  };
+
   template <typename... Args>
   explicit MdioController(int id, Args&&... args)
       : id_(id),
@@ -91,7 +179,8 @@ class MdioController {
         io_(std::move(old.io_)),
         lockFile_(std::move(old.lockFile_)),
         controllerThread_(std::move(old.controllerThread_)),
-        eventBase_(std::move(old.eventBase_)) {}
+        eventBase_(std::move(old.eventBase_)),
+        stats_(std::move(old.stats_)) {}
 
   // Delete the copy constructor. If we try to copy this object while io_ is
   // locked then the process will immediately deadlock.
@@ -116,7 +205,10 @@ class MdioController {
       phy::PhyAddress physAddr,
       phy::Cl45DeviceAddress devAddr,
       phy::Cl45RegisterAddress regAddr) {
-    return rawIO_.readCl45(physAddr, devAddr, regAddr);
+    auto start = std::chrono::steady_clock::now();
+    auto data = rawIO_.readCl45(physAddr, devAddr, regAddr);
+    recordBatch(1, start);
+    return data;
   }
 
   void writeCl45Unlocked(
@@ -124,7 +216,9 @@ class MdioController {
       phy::Cl45DeviceAddress devAddr,
       phy::Cl45RegisterAddress regAddr,
       phy::Cl45Data data) {
+    auto start = std::chrono::steady_clock::now();
     rawIO_.writeCl45(physAddr, devAddr, regAddr, data);
+    recordBatch(1, start);
   }
 
   phy::Cl45Data readCl45(
@@ -132,7 +226,10 @@ class MdioController {
       phy::Cl45DeviceAddress devAddr,
       phy::Cl45RegisterAddress regAddr) {
     auto locked = fully_lock();
-    return locked->readCl45(physAddr, devAddr, regAddr);
+    auto start = std::chrono::steady_clock::now();
+    auto data = locked->readCl45(physAddr, devAddr, regAddr);
+    recordBatch(1, start);
+    return data;
   }
 
   void writeCl45(
@@ -141,7 +238,37 @@ class MdioController {
       phy::Cl45RegisterAddress regAddr,
       phy::Cl45Data data) {
     auto locked = fully_lock();
+    auto start = std::chrono::steady_clock::now();
     locked->writeCl45(physAddr, devAddr, regAddr, data);
+    recordBatch(1, start);
+  }
+
+  // Run all the operations of the batch while holding the locks once
+  void executeCl45Batch(Cl45Batch& batch) {
+    if (batch.empty()) {
+      return;
+    }
+    auto locked = fully_lock();
+    auto start = std::chrono::steady_clock::now();
+    locked->executeCl45Batch(batch);
+    recordBatch(batch.size(), start);
+  }
+
+  // Same as executeCl45Batch(), on the controller thread
+  folly::Future<Cl45Batch> executeCl45BatchAsync(Cl45Batch batch) {
+    return folly::via(
+        eventBase_.get(), [this, batch = std::move(batch)]() mutable {
+          executeCl45Batch(batch);
+          return std::move(batch);
+        });
+  }
+
+  Stats getStats() const {
+    Stats stats;
+    stats.transactions = stats_->transactions.load();
+    stats.batches = stats_->batches.load();
+    stats.busyTime = std::chrono::nanoseconds(stats_->busyNanos.load());
+    return stats;
   }
 
   int id() const {
@@ -226,14 +353,47 @@ class MdioController {
   }
 
  private:
+  struct AtomicStats {
+    std::atomic<uint64_t> transactions{0};
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> busyNanos{0};
+  };
+
+  void recordBatch(
+      size_t transactions,
+      std::chrono::steady_clock::time_point start) {
+    auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    stats_->transactions += transactions;
+    stats_->batches += 1;
+    stats_->busyNanos += busy.count();
+  }
+
   int id_;
   IO rawIO_;
   folly::Synchronized<IO, std::mutex> io_;
   std::shared_ptr<folly::File> lockFile_;
   std::unique_ptr<std::thread> controllerThread_{nullptr};
   std::unique_ptr<folly::EventBase> eventBase_;
+  std::unique_ptr<AtomicStats> stats_{std::make_unique<AtomicStats>()};
 };
 
+/*
+ * Run each batch on the thread of its controller, so that batches on
+ * different controllers run in parallel, and return them with the data of
+ * their reads filled in, in the same order.
+ */
+template <typename IO>
+std::vector<Cl45Batch> executeCl45Batches(
+    std::vector<std::pair<MdioController<IO>*, Cl45Batch>> batches) {
+  std::vector<folly::Future<Cl45Batch>> futures;
+  futures.reserve(batches.size());
+  for (auto& [controller, batch] : batches) {
+    futures.push_back(controller->executeCl45BatchAsync(std::move(batch)));
+  }
+  return folly::collect(futures).get();
+}
+
 template <typename IO>
 struct MdioDevice {
   // MdioDevice is convenience wrapper for bundling a controller and a
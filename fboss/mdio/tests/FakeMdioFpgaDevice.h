@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/lib/fpga/FbFpgaRegisters.h"
+#include "fboss/lib/fpga/FpgaDevice.h"
+#include "fboss/mdio/Phy.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+namespace facebook::fboss {
+
+/*
+ * Register model of an FPGA with FbFpgaMdio controllers, to test and
+ * benchmark FbFpgaMdio without hardware.
+ *
+ * Each controller added with addController() has a bank of Clause 45
+ * registers per PHY address.  A transaction starts when the command
+ * register is written and completes transactionTime later, as seen
+ * through the done bit of the status register.  Writes to the status
+ * register clear the bits written as 1.  Registers outside of the
+ * controllers read back what was last written to them.
+ */
+class FakeMdioFpgaDevice : public FpgaDevice {
+ public:
+  explicit FakeMdioFpgaDevice(
+      std::chrono::nanoseconds transactionTime = std::chrono::nanoseconds(0))
+      : FpgaDevice(kFakeFpgaAddr, kFakeFpgaSize),
+        transactionTime_(transactionTime) {}
+
+  void mmap() override {}
+
+  void addController(uint32_t baseAddr) {
+    std::lock_guard<std::mutex> g(lock_);
+    controllers_[baseAddr];
+  }
+
+  uint32_t read(uint32_t offset) const override {
+    std::lock_guard<std::mutex> g(lock_);
+    auto controller = getController(offset);
+    if (!controller) {
+      auto reg = registers_.find(offset);
+      return reg == registers_.end() ? 0 : reg->second;
+    }
+    switch (offset - controller->first) {
+      case MdioConfig::addr::value:
+        return controller->second.config.reg;
+      case MdioWrite::addr::value:
+        return controller->second.write.reg;
+      case MdioRead::addr::value:
+        return controller->second.read.reg;
+      case MdioStatus::addr::value:
+        return status(controller->second).reg;
+    }
+    return 0;
+  }
+
+  void write(uint32_t offset, uint32_t value) override {
+    std::lock_guard<std::mutex> g(lock_);
+    auto controller = getController(offset);
+    if (!controller) {
+      registers_[offset] = value;
+      return;
+    }
+    auto& state = controller->second;
+    switch (offset - controller->first) {
+      case MdioConfig::addr::value:
+        state.config.reg = value;
+        break;
+      case MdioWrite::addr::value:
+        state.write.reg = value;
+        break;
+      case MdioStatus::addr::value:
+        state.status.reg &= ~value;
+        break;
+      case MdioCommand::addr::value: {
+        MdioCommand command;
+        command.reg = value;
+        startTransaction(state, command);
+        break;
+      }
+    }
+  }
+
+  phy::Cl45Data phyRegister(
+      uint32_t baseAddr,
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr) const {
+    std::lock_guard<std::mutex> g(lock_);
+    const auto& registers = controllers_.at(baseAddr).phyRegisters;
+    auto reg = registers.find(std::make_tuple(physAddr, devAddr, regAddr));
+    return reg == registers.end() ? 0 : reg->second;
+  }
+
+  void setPhyRegister(
+      uint32_t baseAddr,
+      phy::PhyAddress physAddr,
+      phy::Cl45DeviceAddress devAddr,
+      phy::Cl45RegisterAddress regAddr,
+      phy::Cl45Data data) {
+    std::lock_guard<std::mutex> g(lock_);
+    controllers_.at(baseAddr)
+        .phyRegisters[std::make_tuple(physAddr, devAddr, regAddr)] = data;
+  }
+
+  // Transactions on PHY addresses marked absent complete with an error
+  void setPhyAbsent(uint32_t baseAddr, phy::PhyAddress physAddr) {
+    std::lock_guard<std::mutex> g(lock_);
+    controllers_.at(baseAddr).absentPhys.insert(physAddr);
+  }
+
+  uint64_t transactions(uint32_t baseAddr) const {
+    std::lock_guard<std::mutex> g(lock_);
+    return controllers_.at(baseAddr).transactions;
+  }
+
+  uint64_t statusReads(uint32_t baseAddr) const {
+    std::lock_guard<std::mutex> g(lock_);
+    return controllers_.at(baseAddr).statusReads;
+  }
+
+ private:
+  static constexpr uint32_t kFakeFpgaAddr = 0xfb000000;
+  static constexpr uint32_t kFakeFpgaSize = 0x40000;
+  static constexpr uint32_t kControllerSize = MdioStatus::addr::value + 4;
+
+  using PhyRegister = std::
+      tuple<phy::PhyAddress, phy::Cl45DeviceAddress, phy::Cl45RegisterAddress>;
+
+  struct Controller {
+    MdioConfig config{0};
+    MdioWrite write{0};
+    MdioRead read{0};
+    MdioStatus status{0};
+    std::chrono::steady_clock::time_point doneAt;
+    bool error{false};
+    std::set<phy::PhyAddress> absentPhys;
+    std::map<PhyRegister, phy::Cl45Data> phyRegisters;
+    uint64_t transactions{0};
+    uint64_t statusReads{0};
+  };
+
+  using Controllers = std::map<uint32_t, Controller>;
+
+  Controllers::value_type* getController(uint32_t offset) const {
+    auto itr = controllers_.upper_bound(offset);
+    if (itr == controllers_.begin()) {
+      return nullptr;
+    }
+    --itr;
+    if (offset - itr->first >= kControllerSize) {
+      return nullptr;
+    }
+    return &*itr;
+  }
+
+  void startTransaction(Controller& state, const MdioCommand& command) {
+    ++state.transactions;
+    state.status.active = 1;
+    state.doneAt = std::chrono::steady_clock::now() + transactionTime_;
+    state.error = state.absentPhys.count(command.phySel);
+    if (state.error) {
+      return;
+    }
+    PhyRegister reg(command.phySel, command.devAddr, command.regAddr);
+    if (command.rw) {
+      state.read.reg = 0;
+      auto data = state.phyRegisters.find(reg);
+      state.read.data = data == state.phyRegisters.end() ? 0 : data->second;
+    } else {
+      state.phyRegisters[reg] = state.write.data;
+    }
+  }
+
+  MdioStatus status(Controller& state) const {
+    ++state.statusReads;
+    if (state.status.active &&
+        std::chrono::steady_clock::now() >= state.doneAt) {
+      state.status.active = 0;
+      state.status.done = 1;
+      state.status.err = state.error;
+    }
+    return state.status;
+  }
+
+  const std::chrono::nanoseconds transactionTime_;
+  mutable std::mutex lock_;
+  mutable Controllers controllers_;
+  std::map<uint32_t, uint32_t> registers_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "fboss/mdio/FbFpgaMdio.h"
+#include "fboss/mdio/tests/FakeMdioFpgaDevice.h"
+
+namespace facebook::fboss {
+
+namespace {
+constexpr uint32_t kRegionSize = 0x10000;
+constexpr int kNumControllers = 4;
+constexpr int kFirstControllerId = 1000;
+constexpr phy::Cl45DeviceAddress kDevAddr = 1;
+
+uint32_t controllerBase(int controller) {
+  return 0x1000 * controller;
+}
+} // namespace
+
+class FbFpgaMdioTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    region_ =
+        std::make_unique<FpgaMemoryRegion>("mdio", &device_, 0, kRegionSize);
+    for (int i = 0; i < kNumControllers; ++i) {
+      device_.addController(controllerBase(i));
+      controllers_.push_back(std::make_unique<MdioController<FbFpgaMdio>>(
+          kFirstControllerId + i, region_.get(), controllerBase(i)));
+      controllers_.back()->init();
+    }
+  }
+
+ protected:
+  FakeMdioFpgaDevice device_;
+  std::unique_ptr<FpgaMemoryRegion> region_;
+  std::vector<std::unique_ptr<MdioController<FbFpgaMdio>>> controllers_;
+};
+
+TEST_F(FbFpgaMdioTest, readWrite) {
+  auto& controller = *controllers_[1];
+  controller.writeCl45(3, kDevAddr, 0x1234, 0xabcd);
+  EXPECT_EQ(
+      device_.phyRegister(controllerBase(1), 3, kDevAddr, 0x1234), 0xabcd);
+  EXPECT_EQ(controller.readCl45(3, kDevAddr, 0x1234), 0xabcd);
+  // Other PHYs and controllers are independent
+  EXPECT_EQ(controller.readCl45(4, kDevAddr, 0x1234), 0);
+  EXPECT_EQ(controllers_[0]->readCl45(3, kDevAddr, 0x1234), 0);
+
+  auto stats = controller.getStats();
+  EXPECT_EQ(stats.transactions, 3);
+  EXPECT_EQ(stats.batches, 3);
+  EXPECT_EQ(device_.transactions(controllerBase(1)), 3);
+}
+
+TEST_F(FbFpgaMdioTest, batch) {
+  auto& controller = *controllers_[0];
+  device_.setPhyRegister(controllerBase(0), 2, kDevAddr, 0x10, 0x5555);
+  Cl45Batch batch;
+  auto before = batch.read(2, kDevAddr, 0x10);
+  batch.write(2, kDevAddr, 0x10, 0x1111);
+  batch.write(2, kDevAddr, 0x11, 0x2222);
+  auto after = batch.read(2, kDevAddr, 0x10);
+  auto other = batch.read(2, kDevAddr, 0x11);
+  auto statusReads = device_.statusReads(controllerBase(0));
+  controller.executeCl45Batch(batch);
+
+  EXPECT_EQ(batch.data(before), 0x5555);
+  EXPECT_EQ(batch.data(after), 0x1111);
+  EXPECT_EQ(batch.data(other), 0x2222);
+  EXPECT_EQ(
+      device_.phyRegister(controllerBase(0), 2, kDevAddr, 0x11), 0x2222);
+  EXPECT_EQ(device_.transactions(controllerBase(0)), 5);
+  // The status is read back once for the batch, then only polled for the
+  // completion of each transaction
+  EXPECT_EQ(device_.statusReads(controllerBase(0)) - statusReads, 1 + 5);
+
+  auto stats = controller.getStats();
+  EXPECT_EQ(stats.transactions, 5);
+  EXPECT_EQ(stats.batches, 1);
+  EXPECT_GT(stats.throughput(), 0);
+}
+
+TEST_F(FbFpgaMdioTest, batchError) {
+  auto& controller = *controllers_[2];
+  device_.setPhyAbsent(controllerBase(2), 7);
+  Cl45Batch batch;
+  batch.write(6, kDevAddr, 0x20, 0x1);
+  batch.write(7, kDevAddr, 0x20, 0x1);
+  batch.write(6, kDevAddr, 0x21, 0x1);
+  EXPECT_THROW(controller.executeCl45Batch(batch), std::runtime_error);
+  // The batch stops at the failed transaction
+  EXPECT_EQ(device_.phyRegister(controllerBase(2), 6, kDevAddr, 0x20), 0x1);
+  EXPECT_EQ(device_.phyRegister(controllerBase(2), 6, kDevAddr, 0x21), 0);
+  // And the controller is usable again
+  controller.writeCl45(6, kDevAddr, 0x21, 0x1);
+  EXPECT_EQ(controller.readCl45(6, kDevAddr, 0x21), 0x1);
+}
+
+TEST_F(FbFpgaMdioTest, parallelBatches) {
+  std::vector<std::pair<MdioController<FbFpgaMdio>*, Cl45Batch>> batches;
+  for (int i = 0; i < kNumControllers; ++i) {
+    Cl45Batch batch;
+    for (int reg = 0; reg < 16; ++reg) {
+      batch.write(0, kDevAddr, reg, i * 100 + reg);
+    }
+    for (int reg = 0; reg < 16; ++reg) {
+      batch.read(0, kDevAddr, reg);
+    }
+    batches.emplace_back(controllers_[i].get(), std::move(batch));
+  }
+  auto results = executeCl45Batches(std::move(batches));
+
+  ASSERT_EQ(results.size(), kNumControllers);
+  for (int i = 0; i < kNumControllers; ++i) {
+    for (int reg = 0; reg < 16; ++reg) {
+      EXPECT_EQ(results[i].data(16 + reg), i * 100 + reg);
+    }
+    EXPECT_EQ(controllers_[i]->getStats().transactions, 32);
+    EXPECT_EQ(controllers_[i]->getStats().batches, 1);
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/mdio/FbFpgaMdio.h"
+#include "fboss/mdio/tests/FakeMdioFpgaDevice.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+
+DEFINE_int32(
+    mdio_benchmark_transaction_us,
+    52,
+    "Duration of a Clause 45 transaction, 52us at a 2.5MHz MDC");
+DEFINE_int32(
+    mdio_benchmark_transactions,
+    64,
+    "Transactions per benchmark iteration, e.g. programming one port");
+DEFINE_int32(mdio_benchmark_controllers, 4, "Number of MDIO controllers");
+
+using namespace facebook::fboss;
+
+/*
+ * Clause 45 writes on the fake FPGA register model, one transaction at a
+ * time (as ExternalPhy programming does today), in a batch on one
+ * controller, and split in batches across controllers running in parallel.
+ */
+namespace {
+
+constexpr int kFirstControllerId = 2000;
+constexpr phy::Cl45DeviceAddress kDevAddr = 1;
+
+uint32_t controllerBase(int controller) {
+  return 0x1000 * controller;
+}
+
+class MdioBenchmarkSetup {
+ public:
+  MdioBenchmarkSetup()
+      : device_(std::chrono::microseconds(FLAGS_mdio_benchmark_transaction_us)),
+        region_(
+            "mdio",
+            &device_,
+            0,
+            controllerBase(FLAGS_mdio_benchmark_controllers)) {
+    for (int i = 0; i < FLAGS_mdio_benchmark_controllers; ++i) {
+      device_.addController(controllerBase(i));
+      controllers_.push_back(std::make_unique<MdioController<FbFpgaMdio>>(
+          kFirstControllerId + i, &region_, controllerBase(i)));
+      controllers_.back()->init();
+    }
+  }
+
+  ~MdioBenchmarkSetup() {
+    for (const auto& controller : controllers_) {
+      auto stats = controller->getStats();
+      XLOG(INFO) << "Controller " << controller->id() << ": "
+                 << stats.transactions << " transactions in " << stats.batches
+                 << " batches, " << stats.throughput()
+                 << " transactions/s of busy time";
+    }
+  }
+
+  MdioController<FbFpgaMdio>& controller(int i) {
+    return *controllers_[i];
+  }
+
+ private:
+  FakeMdioFpgaDevice device_;
+  FpgaMemoryRegion region_;
+  std::vector<std::unique_ptr<MdioController<FbFpgaMdio>>> controllers_;
+};
+
+Cl45Batch writes(int count) {
+  Cl45Batch batch;
+  for (int reg = 0; reg < count; ++reg) {
+    batch.write(0, kDevAddr, reg, reg);
+  }
+  return batch;
+}
+
+} // namespace
+
+BENCHMARK(MdioSingleTransactions, iters) {
+  folly::BenchmarkSuspender suspender;
+  MdioBenchmarkSetup setup;
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    for (int reg = 0; reg < FLAGS_mdio_benchmark_transactions; ++reg) {
+      setup.controller(0).writeCl45(0, kDevAddr, reg, reg);
+    }
+  }
+  suspender.rehire();
+}
+
+BENCHMARK_RELATIVE(MdioBatch, iters) {
+  folly::BenchmarkSuspender suspender;
+  MdioBenchmarkSetup setup;
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    auto batch = writes(FLAGS_mdio_benchmark_transactions);
+    setup.controller(0).executeCl45Batch(batch);
+  }
+  suspender.rehire();
+}
+
+BENCHMARK_RELATIVE(MdioParallelBatches, iters) {
+  folly::BenchmarkSuspender suspender;
+  MdioBenchmarkSetup setup;
+  suspender.dismiss();
+  for (size_t i = 0; i < iters; ++i) {
+    std::vector<std::pair<MdioController<FbFpgaMdio>*, Cl45Batch>> batches;
+    for (int c = 0; c < FLAGS_mdio_benchmark_controllers; ++c) {
+      batches.emplace_back(
+          &setup.controller(c),
+          writes(
+              FLAGS_mdio_benchmark_transactions /
+              FLAGS_mdio_benchmark_controllers));
+    }
+    folly::doNotOptimizeAway(executeCl45Batches(std::move(batches)));
+  }
+  suspender.rehire();
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -156,6 +156,12 @@ void QsfpModule::getQsfpValue(
   memcpy(data, ptr, length);
 }
 
+void QsfpModule::readQsfpData(int offset, int length, uint8_t* data) {
+  qsfpImpl_->readTransceiver(
+      TransceiverI2CApi::ADDR_QSFP, offset, length, data);
+  bytesRead_.fetch_add(length, std::memory_order_relaxed);
+}
+
 // Note that this needs to be called while holding the
 // qsfpModuleMutex_
 bool QsfpModule::cacheIsValid() const {
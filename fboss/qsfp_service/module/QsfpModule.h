@@ -8,6 +8,7 @@
  *
  */
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
@@ -107,6 +108,10 @@ class QsfpModule : public Transceiver {
    */
   bool writeTransceiver(TransceiverIOParameters param, uint8_t data) override;
 
+  uint64_t getBytesRead() const override {
+    return bytesRead_.load(std::memory_order_relaxed);
+  }
+
   /*
    * The size of the pages used by QSFP.  See below for an explanation of
    * how they are laid out.  This needs to be publicly accessible for
@@ -244,6 +249,8 @@ class QsfpModule : public Transceiver {
   // last time we know transceiver was working because at least one port was up
   time_t lastWorkingTime_{0};
 
+  std::atomic<uint64_t> bytesRead_{0};
+
   // This is a map of system level port id to the local port id inside the
   // module. The local port id is used to identify the Port State Machine
   // instance within the module
@@ -279,6 +286,12 @@ class QsfpModule : public Transceiver {
    */
   void getQsfpValue(int dataAddress, int offset, int length, uint8_t* data)
       const;
+  /*
+   * Read length bytes at offset of the currently selected page into data,
+   * accounting them in getBytesRead(). Used by updateQsfpData() to fill the
+   * cache. The thread needs to have the lock before calling this function.
+   */
+  void readQsfpData(int offset, int length, uint8_t* data);
   /*
    * Based on identifier, sets whether the upper memory of the module is flat or
    * paged.
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/module/ReadPlan.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <glog/logging.h>
+
+namespace facebook {
+namespace fboss {
+
+void ReadPlan::addRange(int page, int offset, int length) {
+  CHECK_GT(length, 0);
+  CHECK_LE(length, kMaxSegmentLength);
+
+  auto it = std::upper_bound(
+      segments_.begin(),
+      segments_.end(),
+      std::make_pair(page, offset),
+      [](const std::pair<int, int>& key, const Segment& segment) {
+        return key < std::make_pair(segment.page, segment.offset);
+      });
+  segments_.insert(it, Segment{page, offset, length});
+
+  // Plans are built once and are short, so just merge over the whole list
+  std::vector<Segment> merged;
+  for (const auto& segment : segments_) {
+    if (!merged.empty()) {
+      auto& last = merged.back();
+      auto mergedEnd = std::max(last.end(), segment.end());
+      if (last.page == segment.page &&
+          segment.offset - last.end() <= kMaxMergeGap &&
+          mergedEnd - last.offset <= kMaxSegmentLength) {
+        last.length = mergedEnd - last.offset;
+        continue;
+      }
+    }
+    merged.push_back(segment);
+  }
+  segments_ = std::move(merged);
+}
+
+int ReadPlan::getTotalBytes() const {
+  int total = 0;
+  for (const auto& segment : segments_) {
+    total += segment.length;
+  }
+  return total;
+}
+
+} // namespace fboss
+} // namespace facebook
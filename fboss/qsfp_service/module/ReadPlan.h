@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook {
+namespace fboss {
+
+/*
+ * A ReadPlan is the list of eeprom reads needed to refresh a set of fields.
+ * Fields are added as (page, offset, length) ranges, where page is the
+ * module specific page enum (CmisPages, SffPages). Ranges on the same page
+ * that overlap or are at most kMaxMergeGap bytes apart are merged into one
+ * read, since an I2C transaction costs much more than a few extra bytes.
+ * Segments are kept sorted by page and offset.
+ */
+class ReadPlan {
+ public:
+  struct Segment {
+    int page;
+    int offset;
+    int length;
+
+    int end() const {
+      return offset + length;
+    }
+  };
+
+  // Largest hole between two fields that is read through rather than split
+  static constexpr int kMaxMergeGap = 8;
+  // Largest single read, a full eeprom page
+  static constexpr int kMaxSegmentLength = 128;
+
+  void addRange(int page, int offset, int length);
+
+  const std::vector<Segment>& getSegments() const {
+    return segments_;
+  }
+
+  int getTotalBytes() const;
+
+  int getNumReads() const {
+    return segments_.size();
+  }
+
+ private:
+  std::vector<Segment> segments_;
+};
+
+} // namespace fboss
+} // namespace facebook
@@ -92,6 +92,13 @@ class Transceiver {
       TransceiverIOParameters param,
       uint8_t data) = 0;
 
+  /*
+   * Total number of eeprom bytes read while refreshing this transceiver
+   */
+  virtual uint64_t getBytesRead() const {
+    return 0;
+  }
+
  private:
   // no copy or assignment
   Transceiver(Transceiver const&) = delete;
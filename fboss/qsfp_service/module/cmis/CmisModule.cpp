@@ -10,6 +10,7 @@
 #include "fboss/lib/usb/TransceiverI2CApi.h"
 #include "fboss/qsfp_service/StatsPublisher.h"
 #include "fboss/qsfp_service/TransceiverManager.h"
+#include "fboss/qsfp_service/module/ReadPlan.h"
 #include "fboss/qsfp_service/module/TransceiverImpl.h"
 #include "fboss/qsfp_service/module/cmis/CmisFieldInfo.h"
 
@@ -210,6 +211,127 @@ void getQsfpFieldAddress(
   length = info.length;
 }
 
+static void addToReadPlan(
+    ReadPlan& plan,
+    const std::vector<CmisField>& fields) {
+  for (auto field : fields) {
+    int dataAddress;
+    int offset;
+    int length;
+    getQsfpFieldAddress(field, dataAddress, offset, length);
+    plan.addRange(dataAddress, offset, length);
+  }
+}
+
+static ReadPlan makeReadPlan(const std::vector<CmisField>& fields) {
+  ReadPlan plan;
+  addToReadPlan(plan, fields);
+  return plan;
+}
+
+// Lower page fields that change at runtime, read on every partial refresh
+static const ReadPlan& getLowerPageReadPlan() {
+  static const ReadPlan plan = makeReadPlan({
+      CmisField::IDENTIFIER,
+      CmisField::FLAT_MEM,
+      CmisField::MODULE_STATE,
+      CmisField::MODULE_FLAG,
+      CmisField::MODULE_ALARMS,
+      CmisField::TEMPERATURE,
+      CmisField::VCC,
+      CmisField::MODULE_CONTROL,
+  });
+  return plan;
+}
+
+// Upper page fields that change at runtime, read on every partial refresh.
+// The page 10h controls are included since customization and remediation
+// write them.
+static const std::vector<CmisField> kUpperPageVolatileFields = {
+    CmisField::DATA_PATH_DEINIT,
+    CmisField::TX_POLARITY_FLIP,
+    CmisField::TX_DISABLE,
+    CmisField::TX_SQUELCH_DISABLE,
+    CmisField::TX_FORCE_SQUELCH,
+    CmisField::TX_ADAPTATION_FREEZE,
+    CmisField::TX_ADAPTATION_STORE,
+    CmisField::RX_POLARITY_FLIP,
+    CmisField::RX_DISABLE,
+    CmisField::RX_SQUELCH_DISABLE,
+    CmisField::STAGE_CTRL_SET_0,
+    CmisField::APP_SEL_LANE_1,
+    CmisField::APP_SEL_LANE_2,
+    CmisField::APP_SEL_LANE_3,
+    CmisField::APP_SEL_LANE_4,
+    CmisField::DATA_PATH_STATE,
+    CmisField::CHANNEL_TX_PWR,
+    CmisField::CHANNEL_TX_BIAS,
+    CmisField::CHANNEL_RX_PWR,
+    CmisField::ACTIVE_CTRL_LANE_1,
+    CmisField::ACTIVE_CTRL_LANE_2,
+    CmisField::ACTIVE_CTRL_LANE_3,
+    CmisField::ACTIVE_CTRL_LANE_4,
+    CmisField::TX_CDR_CONTROL,
+    CmisField::RX_CDR_CONTROL,
+};
+
+// Latched lane flags, only worth reading when the module raised an interrupt
+static const std::vector<CmisField> kLaneFlagFields = {
+    CmisField::TX_FAULT_FLAG,
+    CmisField::TX_LOS_FLAG,
+    CmisField::TX_LOL_FLAG,
+    CmisField::TX_EQ_FLAG,
+    CmisField::TX_PWR_FLAG,
+    CmisField::TX_BIAS_FLAG,
+    CmisField::RX_LOS_FLAG,
+    CmisField::RX_LOL_FLAG,
+    CmisField::RX_PWR_FLAG,
+};
+
+static const ReadPlan& getUpperPageReadPlan(bool withLaneFlags) {
+  static const ReadPlan plan = makeReadPlan(kUpperPageVolatileFields);
+  static const ReadPlan planWithFlags = [] {
+    auto result = makeReadPlan(kUpperPageVolatileFields);
+    addToReadPlan(result, kLaneFlagFields);
+    return result;
+  }();
+  return withLaneFlags ? planWithFlags : plan;
+}
+
+static const ReadPlan& getLaneFlagsReadPlan() {
+  static const ReadPlan plan = makeReadPlan(kLaneFlagFields);
+  return plan;
+}
+
+static const ReadPlan& getSnrReadPlan() {
+  static const ReadPlan plan = makeReadPlan(
+      {CmisField::HOST_BER,
+       CmisField::MEDIA_BER_HOST_SNR,
+       CmisField::MEDIA_SNR});
+  return plan;
+}
+
+static uint8_t getPageNumber(int dataAddress) {
+  switch (dataAddress) {
+    case CmisPages::PAGE00:
+      return 0x00;
+    case CmisPages::PAGE01:
+      return 0x01;
+    case CmisPages::PAGE02:
+      return 0x02;
+    case CmisPages::PAGE10:
+      return 0x10;
+    case CmisPages::PAGE11:
+      return 0x11;
+    case CmisPages::PAGE13:
+      return 0x13;
+    case CmisPages::PAGE14:
+      return 0x14;
+    default:
+      throw FbossError("Invalid Data Address 0x%d", dataAddress);
+  }
+}
+
 CmisModule::CmisModule(
     TransceiverManager* transceiverManager,
     std::unique_ptr<TransceiverImpl> qsfpImpl,
@@ -940,6 +1062,62 @@ void CmisModule::getFieldValueLocked(CmisField fieldName, uint8_t* fieldValue)
   getQsfpValue(dataAddress, offset, length, fieldValue);
 }
 
+uint8_t* CmisModule::getPageCache(int dataAddress) {
+  switch (dataAddress) {
+    case CmisPages::LOWER:
+      return lowerPage_;
+    case CmisPages::PAGE00:
+      return page0_;
+    case CmisPages::PAGE01:
+      return page01_;
+    case CmisPages::PAGE02:
+      return page02_;
+    case CmisPages::PAGE10:
+      return page10_;
+    case CmisPages::PAGE11:
+      return page11_;
+    case CmisPages::PAGE13:
+      return page13_;
+    case CmisPages::PAGE14:
+      return page14_;
+    default:
+      throw FbossError("Invalid Data Address 0x%d", dataAddress);
+  }
+}
+
+void CmisModule::readPlanLocked(const ReadPlan& plan, int& selectedPage) {
+  for (const auto& segment : plan.getSegments()) {
+    auto cache = getPageCache(segment.page);
+    if (segment.page == CmisPages::LOWER) {
+      readQsfpData(segment.offset, segment.length, cache + segment.offset);
+      continue;
+    }
+    // Upper pages other than 00h are not there on flat memory modules
+    if (flatMem_ && segment.page != CmisPages::PAGE00) {
+      continue;
+    }
+    if (!flatMem_ && segment.page != selectedPage) {
+      uint8_t page = getPageNumber(segment.page);
+      qsfpImpl_->writeTransceiver(
+          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+      selectedPage = segment.page;
+    }
+    readQsfpData(
+        segment.offset,
+        segment.length,
+        cache + segment.offset - MAX_QSFP_PAGE_SIZE);
+  }
+}
+
+void CmisModule::clearPlanLocked(const ReadPlan& plan) {
+  for (const auto& segment : plan.getSegments()) {
+    auto offset = segment.page == CmisPages::LOWER
+        ? segment.offset
+        : segment.offset - MAX_QSFP_PAGE_SIZE;
+    memset(getPageCache(segment.page) + offset, 0, segment.length);
+  }
+}
+
 void CmisModule::updateQsfpData(bool allPages) {
   // expects the lock to be held
   if (!present_) {
@@ -949,8 +1127,12 @@ void CmisModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
+    int selectedPage = -1;
+    if (allPages) {
+      readQsfpData(0, sizeof(lowerPage_), lowerPage_);
+    } else {
+      readPlanLocked(getLowerPageReadPlan(), selectedPage);
+    }
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
     setQsfpFlatMem();
@@ -961,26 +1143,50 @@ void CmisModule::updateQsfpData(bool allPages) {
       opticsModuleStateMachine_.get_attribute(cmisModuleReady) = false;
     }
 
+    if (!allPages) {
+      // Only the fields that change are read here, the static pages were
+      // read when the module was first seen. The lane flags are latched and
+      // raise the module interrupt when set, so while the interrupt is
+      // deasserted they are all clear and don't need to be read.
+      bool interrupt = !(getSettingsValue(CmisField::MODULE_STATE) & 0x1);
+      readPlanLocked(getUpperPageReadPlan(interrupt), selectedPage);
+      if (!interrupt) {
+        clearPlanLocked(getLaneFlagsReadPlan());
+      }
+      if (!flatMem_ &&
+          opticsModuleStateMachine_.get_attribute(cmisModuleReady)) {
+        uint8_t page = 0x14;
+        auto diagFeature = (uint8_t)DiagnosticFeatureEncoding::SNR;
+        qsfpImpl_->writeTransceiver(
+            TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+        qsfpImpl_->writeTransceiver(
+            TransceiverI2CApi::ADDR_QSFP,
+            128,
+            sizeof(diagFeature),
+            &diagFeature);
+        selectedPage = CmisPages::PAGE14;
+        readPlanLocked(getSnrReadPlan(), selectedPage);
+      }
+      return;
+    }
+
     // If we have flat memory, we don't have to set the page
     if (!flatMem_) {
       uint8_t page = 0x00;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
     }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
+    readQsfpData(128, sizeof(page0_), page0_);
     if (!flatMem_) {
       uint8_t page = 0x10;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page10_), page10_);
+      readQsfpData(128, sizeof(page10_), page10_);
 
       page = 0x11;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page11_), page11_);
+      readQsfpData(128, sizeof(page11_), page11_);
 
       if (opticsModuleStateMachine_.get_attribute(cmisModuleReady)) {
         page = 0x14;
@@ -992,36 +1198,26 @@ void CmisModule::updateQsfpData(bool allPages) {
             128,
             sizeof(diagFeature),
             &diagFeature);
-        qsfpImpl_->readTransceiver(
-            TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page14_), page14_);
+        readQsfpData(128, sizeof(page14_), page14_);
       }
-    }
 
-    if (!allPages) {
       // The information on the following pages are static. Thus no need to
       // fetch them every time. We just need to do it when we first retriving
       // the data from this module.
-      return;
-    }
-
-    if (!flatMem_) {
-      uint8_t page = 0x01;
+      page = 0x01;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page01_), page01_);
+      readQsfpData(128, sizeof(page01_), page01_);
 
       page = 0x02;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page02_), page02_);
+      readQsfpData(128, sizeof(page02_), page02_);
 
       page = 0x13;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page13_), page13_);
+      readQsfpData(128, sizeof(page13_), page13_);
     }
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
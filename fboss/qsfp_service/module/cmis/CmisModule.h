@@ -11,6 +11,7 @@ namespace facebook {
 namespace fboss {
 
 enum class CmisField;
+class ReadPlan;
 
 class CmisModule : public QsfpModule {
  public:
@@ -282,6 +283,20 @@ class CmisModule : public QsfpModule {
 
  private:
   void getFieldValueLocked(CmisField fieldName, uint8_t* fieldValue) const;
+  /*
+   * Returns the cache buffer of a page, indexed from the start of the page.
+   */
+  uint8_t* getPageCache(int dataAddress);
+  /*
+   * Read the segments of a ReadPlan into the page caches. selectedPage is the
+   * page currently selected on the module (-1 if unknown), the page select
+   * byte is only written when a segment is on a different page.
+   */
+  void readPlanLocked(const ReadPlan& plan, int& selectedPage);
+  /*
+   * Zero the cached bytes covered by a ReadPlan
+   */
+  void clearPlanLocked(const ReadPlan& plan);
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
    * extra fields that FB has vendors put in the 'Vendor specific'
@@ -10,6 +10,7 @@
 #include "fboss/agent/platforms/common/PlatformMode.h"
 #include "fboss/lib/usb/TransceiverI2CApi.h"
 #include "fboss/qsfp_service/StatsPublisher.h"
+#include "fboss/qsfp_service/module/ReadPlan.h"
 #include "fboss/qsfp_service/module/TransceiverImpl.h"
 #include "fboss/qsfp_service/module/sff/SffFieldInfo.h"
 
@@ -135,6 +136,52 @@ void getQsfpFieldAddress(
   length = info.length;
 }
 
+static ReadPlan makeReadPlan(const std::vector<SffField>& fields) {
+  ReadPlan plan;
+  for (auto field : fields) {
+    int dataAddress;
+    int offset;
+    int length;
+    getQsfpFieldAddress(field, dataAddress, offset, length);
+    plan.addRange(dataAddress, offset, length);
+  }
+  return plan;
+}
+
+// Lower page fields that change at runtime, read on every partial refresh
+static const ReadPlan& getVolatileReadPlan() {
+  static const ReadPlan plan = makeReadPlan({
+      SffField::IDENTIFIER,
+      SffField::STATUS,
+      SffField::TEMPERATURE,
+      SffField::VCC,
+      SffField::CHANNEL_RX_PWR,
+      SffField::CHANNEL_TX_BIAS,
+      SffField::CHANNEL_TX_PWR,
+      SffField::TX_DISABLE,
+      SffField::RATE_SELECT_RX,
+      SffField::RATE_SELECT_TX,
+      SffField::POWER_CONTROL,
+      SffField::CDR_CONTROL,
+  });
+  return plan;
+}
+
+// Latched flags, only worth reading when the module raised an interrupt
+static const ReadPlan& getFlagsReadPlan() {
+  static const ReadPlan plan = makeReadPlan({
+      SffField::LOS,
+      SffField::FAULT,
+      SffField::LOL,
+      SffField::TEMPERATURE_ALARMS,
+      SffField::VCC_ALARMS,
+      SffField::CHANNEL_RX_PWR_ALARMS,
+      SffField::CHANNEL_TX_BIAS_ALARMS,
+      SffField::CHANNEL_TX_PWR_ALARMS,
+  });
+  return plan;
+}
+
 SffModule::SffModule(
     TransceiverManager* transceiverManager,
     std::unique_ptr<TransceiverImpl> qsfpImpl,
@@ -759,6 +806,13 @@ void SffModule::getFieldValue(SffField fieldName, uint8_t* fieldValue) {
   getQsfpValue(dataAddress, offset, length, fieldValue);
 }
 
+void SffModule::readLowerPagePlanLocked(const ReadPlan& plan) {
+  for (const auto& segment : plan.getSegments()) {
+    CHECK_EQ(segment.page, SffPages::LOWER);
+    readQsfpData(segment.offset, segment.length, lowerPage_ + segment.offset);
+  }
+}
+
 void SffModule::updateQsfpData(bool allPages) {
   // expects the lock to be held
   if (!present_) {
@@ -768,18 +822,35 @@ void SffModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
+    if (allPages) {
+      readQsfpData(0, sizeof(lowerPage_), lowerPage_);
+    } else {
+      // Only the first page has fields that change often so provide
+      // an option to only fetch the fields there that do. Also the write
+      // path is particularly slow due to using an i2c bus, so writing the
+      // bytes needed to select later pages on non-flat memories can
+      // be quite expensive.
+      readLowerPagePlanLocked(getVolatileReadPlan());
+    }
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
     setQsfpFlatMem();
 
     if (!allPages) {
-      // Only the first page has fields that change often so provide
-      // an option to only fetch that page. Also the write path is
-      // particularly slow due to using an i2c bus, so writing the
-      // bytes needed to select later pages on non-flat memories can
-      // be quite expensive.
+      // The flags are latched and assert IntL when set, so while it is
+      // deasserted they are all clear and don't need to be read.
+      int offset;
+      int length;
+      int dataAddress;
+      getQsfpFieldAddress(SffField::STATUS, dataAddress, offset, length);
+      const uint8_t* status = getQsfpValuePtr(dataAddress, offset, length);
+      if (status[1] & (1 << 1)) {
+        for (const auto& segment : getFlagsReadPlan().getSegments()) {
+          memset(lowerPage_ + segment.offset, 0, segment.length);
+        }
+      } else {
+        readLowerPagePlanLocked(getFlagsReadPlan());
+      }
       return;
     }
 
@@ -789,14 +860,12 @@ void SffModule::updateQsfpData(bool allPages) {
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
     }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
+    readQsfpData(128, sizeof(page0_), page0_);
     if (!flatMem_) {
       uint8_t page = 3;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page3_), page3_);
+      readQsfpData(128, sizeof(page3_), page3_);
     }
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
@@ -11,6 +11,7 @@ namespace facebook {
 namespace fboss {
 
 enum class SffField;
+class ReadPlan;
 
 class SffModule : public QsfpModule {
  public:
@@ -244,6 +245,10 @@ class SffModule : public QsfpModule {
   void updateQsfpData(bool allPages = true) override;
 
  private:
+  /*
+   * Read the lower page segments of a ReadPlan into the cache
+   */
+  void readLowerPagePlanLocked(const ReadPlan& plan);
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
    * extra fields that FB has vendors put in the 'Vendor specific'
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/qsfp_service/module/ReadPlan.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+void expectSegment(
+    const ReadPlan::Segment& segment,
+    int page,
+    int offset,
+    int length) {
+  EXPECT_EQ(page, segment.page);
+  EXPECT_EQ(offset, segment.offset);
+  EXPECT_EQ(length, segment.length);
+}
+
+TEST(ReadPlanTest, mergeCloseFields) {
+  ReadPlan plan;
+  plan.addRange(0, 14, 2);
+  plan.addRange(0, 3, 1);
+  plan.addRange(0, 8, 4);
+  ASSERT_EQ(1, plan.getNumReads());
+  expectSegment(plan.getSegments()[0], 0, 3, 13);
+  EXPECT_EQ(13, plan.getTotalBytes());
+}
+
+TEST(ReadPlanTest, splitDistantFields) {
+  ReadPlan plan;
+  plan.addRange(0, 3, 1);
+  plan.addRange(0, 26, 1);
+  ASSERT_EQ(2, plan.getNumReads());
+  expectSegment(plan.getSegments()[0], 0, 3, 1);
+  expectSegment(plan.getSegments()[1], 0, 26, 1);
+  EXPECT_EQ(2, plan.getTotalBytes());
+}
+
+TEST(ReadPlanTest, fieldClosesGap) {
+  ReadPlan plan;
+  plan.addRange(0, 0, 4);
+  plan.addRange(0, 20, 4);
+  ASSERT_EQ(2, plan.getNumReads());
+  plan.addRange(0, 10, 4);
+  ASSERT_EQ(1, plan.getNumReads());
+  expectSegment(plan.getSegments()[0], 0, 0, 24);
+}
+
+TEST(ReadPlanTest, overlappingFields) {
+  ReadPlan plan;
+  plan.addRange(1, 154, 16);
+  plan.addRange(1, 160, 4);
+  plan.addRange(1, 154, 48);
+  ASSERT_EQ(1, plan.getNumReads());
+  expectSegment(plan.getSegments()[0], 1, 154, 48);
+}
+
+TEST(ReadPlanTest, neverMergeAcrossPages) {
+  ReadPlan plan;
+  plan.addRange(2, 128, 4);
+  plan.addRange(1, 128, 4);
+  ASSERT_EQ(2, plan.getNumReads());
+  expectSegment(plan.getSegments()[0], 1, 128, 4);
+  expectSegment(plan.getSegments()[1], 2, 128, 4);
+}
+
+TEST(ReadPlanTest, wholePage) {
+  ReadPlan plan;
+  plan.addRange(1, 128, 64);
+  plan.addRange(1, 192, 64);
+  plan.addRange(1, 250, 6);
+  EXPECT_EQ(1, plan.getNumReads());
+  EXPECT_EQ(128, plan.getTotalBytes());
+}
+
+} // namespace
@@ -0,0 +1,388 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/platforms/wedge/I2cTransactionScheduler.h"
+
+#include <fb303/ServiceData.h>
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/Conv.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <tuple>
+
+DEFINE_int32(
+    i2c_link_critical_deadline_ms,
+    20,
+    "Queueing budget of link critical I2C transactions. Transactions waiting "
+    "longer than their budget are dispatched ahead of any priority order");
+DEFINE_int32(
+    i2c_thrift_deadline_ms,
+    200,
+    "Queueing budget of I2C transactions requested over thrift");
+DEFINE_int32(
+    i2c_background_deadline_ms,
+    2000,
+    "Queueing budget of background (DOM polling) I2C transactions");
+
+namespace {
+
+using facebook::fboss::I2cPriority;
+
+thread_local I2cPriority currentPriority = I2cPriority::BACKGROUND;
+
+constexpr std::array<I2cPriority, 3> kPriorities = {
+    I2cPriority::LINK_CRITICAL,
+    I2cPriority::THRIFT,
+    I2cPriority::BACKGROUND,
+};
+
+std::string priorityName(I2cPriority priority) {
+  switch (priority) {
+    case I2cPriority::LINK_CRITICAL:
+      return "link_critical";
+    case I2cPriority::THRIFT:
+      return "thrift";
+    case I2cPriority::BACKGROUND:
+      return "background";
+  }
+  return "unknown";
+}
+
+std::string queueLatencyKey(I2cPriority priority) {
+  return folly::to<std::string>(
+      "qsfp.i2c_queue_latency_us.", priorityName(priority));
+}
+
+std::chrono::milliseconds deadlineBudget(I2cPriority priority) {
+  switch (priority) {
+    case I2cPriority::LINK_CRITICAL:
+      return std::chrono::milliseconds(FLAGS_i2c_link_critical_deadline_ms);
+    case I2cPriority::THRIFT:
+      return std::chrono::milliseconds(FLAGS_i2c_thrift_deadline_ms);
+    case I2cPriority::BACKGROUND:
+      return std::chrono::milliseconds(FLAGS_i2c_background_deadline_ms);
+  }
+  return std::chrono::milliseconds(FLAGS_i2c_background_deadline_ms);
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+I2cPriorityGuard::I2cPriorityGuard(I2cPriority priority)
+    : previous_(currentPriority) {
+  currentPriority = priority;
+}
+
+I2cPriorityGuard::~I2cPriorityGuard() {
+  currentPriority = previous_;
+}
+
+I2cTransactionScheduler::I2cTransactionScheduler(
+    std::unique_ptr<TransceiverI2CApi> bus)
+    : bus_(std::move(bus)) {
+  for (auto priority : kPriorities) {
+    auto key = queueLatencyKey(priority);
+    // Buckets of 100us up to 100ms
+    fb303::fbData->addHistogram(key, 100, 0, 100000);
+    fb303::fbData->exportHistogramPercentile(key, 50, 95, 99);
+  }
+}
+
+I2cTransactionScheduler::~I2cTransactionScheduler() {}
+
+I2cPriority I2cTransactionScheduler::getCurrentPriority() {
+  return currentPriority;
+}
+
+I2cTransactionScheduler::BusQueue& I2cTransactionScheduler::getBusQueue(
+    unsigned int module) {
+  auto busId = bus_->getBusId(module);
+  {
+    auto lockedQueues = queues_.rlock();
+    if (auto it = lockedQueues->find(busId); it != lockedQueues->end()) {
+      return *it->second;
+    }
+  }
+  auto lockedQueues = queues_.wlock();
+  auto& queue = (*lockedQueues)[busId];
+  if (!queue) {
+    queue = std::make_unique<BusQueue>();
+  }
+  return *queue;
+}
+
+void I2cTransactionScheduler::moduleRead(
+    unsigned int module,
+    uint8_t i2cAddress,
+    int offset,
+    int len,
+    uint8_t* buf) {
+  Transaction txn;
+  txn.module = module;
+  txn.i2cAddress = i2cAddress;
+  txn.offset = offset;
+  txn.len = len;
+  txn.readBuf = buf;
+  submit(txn);
+}
+
+void I2cTransactionScheduler::moduleWrite(
+    unsigned int module,
+    uint8_t i2cAddress,
+    int offset,
+    int len,
+    const uint8_t* buf) {
+  Transaction txn;
+  txn.module = module;
+  txn.i2cAddress = i2cAddress;
+  txn.offset = offset;
+  txn.len = len;
+  txn.writeBuf = buf;
+  submit(txn);
+}
+
+void I2cTransactionScheduler::submit(Transaction& txn) {
+  txn.priority = currentPriority;
+  txn.enqueued = std::chrono::steady_clock::now();
+  txn.deadline = txn.enqueued + deadlineBudget(txn.priority);
+  txn.seq = nextSeq_++;
+
+  auto& queue = getBusQueue(txn.module);
+  std::unique_lock<std::mutex> lock(queue.mutex);
+  queue.pending.push_back(&txn);
+  queue.queued.notify_all();
+  while (!txn.done) {
+    if (queue.busy) {
+      queue.cv.wait(lock);
+      continue;
+    }
+    // Bus is idle, dispatch on behalf of everyone until our own transaction
+    // has gone through
+    auto batch = takeNextLocked(queue);
+    queue.busy = true;
+    lock.unlock();
+    execute(batch);
+    lock.lock();
+    for (auto done : batch) {
+      done->done = true;
+    }
+    queue.busy = false;
+    queue.cv.notify_all();
+  }
+  lock.unlock();
+
+  if (txn.error) {
+    std::rethrow_exception(txn.error);
+  }
+}
+
+std::vector<I2cTransactionScheduler::Transaction*>
+I2cTransactionScheduler::takeNextLocked(BusQueue& queue) {
+  auto now = std::chrono::steady_clock::now();
+  auto& pending = queue.pending;
+
+  // Expired transactions first, earliest deadline first. Otherwise highest
+  // priority, FIFO within a priority class.
+  auto before = [now](const Transaction* a, const Transaction* b) {
+    bool aExpired = a->deadline <= now;
+    bool bExpired = b->deadline <= now;
+    if (aExpired != bExpired) {
+      return aExpired;
+    }
+    if (aExpired) {
+      return a->deadline < b->deadline;
+    }
+    return std::tie(a->priority, a->seq) < std::tie(b->priority, b->seq);
+  };
+  auto next = std::min_element(pending.begin(), pending.end(), before);
+  std::vector<Transaction*> batch{*next};
+  pending.erase(next);
+  auto first = batch.front();
+
+  bool deadlineDispatch = false;
+  if (first->deadline <= now) {
+    deadlineDispatch = std::any_of(
+        pending.begin(), pending.end(), [first](const Transaction* other) {
+          return other->priority < first->priority;
+        });
+  }
+
+  if (first->isRead()) {
+    // Reordering reads around a write of the same module (e.g. a page
+    // select) could change what they return, so only coalesce when there is
+    // none queued.
+    bool moduleWritePending = std::any_of(
+        pending.begin(), pending.end(), [first](const Transaction* other) {
+          return other->module == first->module && !other->isRead();
+        });
+    auto spanStart = first->offset;
+    auto spanEnd = first->offset + first->len;
+    bool merged = !moduleWritePending;
+    while (merged) {
+      merged = false;
+      for (auto it = pending.begin(); it != pending.end(); ++it) {
+        auto other = *it;
+        if (!other->isRead() || other->module != first->module ||
+            other->i2cAddress != first->i2cAddress) {
+          continue;
+        }
+        auto otherEnd = other->offset + other->len;
+        if (other->offset > spanEnd || otherEnd < spanStart) {
+          // Not adjacent to what we read already
+          continue;
+        }
+        auto newStart = std::min(spanStart, other->offset);
+        auto newEnd = std::max(spanEnd, otherEnd);
+        if (newEnd - newStart > kMaxCoalescedReadLen) {
+          continue;
+        }
+        spanStart = newStart;
+        spanEnd = newEnd;
+        batch.push_back(other);
+        pending.erase(it);
+        merged = true;
+        break;
+      }
+    }
+  }
+
+  auto stats = stats_.wlock();
+  stats->transactions += batch.size();
+  stats->busTransactions++;
+  stats->coalescedReads += batch.size() - 1;
+  if (deadlineDispatch) {
+    stats->deadlineDispatches++;
+  }
+  return batch;
+}
+
+void I2cTransactionScheduler::execute(const std::vector<Transaction*>& batch) {
+  for (auto txn : batch) {
+    recordQueueLatency(*txn);
+  }
+
+  auto first = batch.front();
+  try {
+    if (!first->isRead()) {
+      bus_->moduleWrite(
+          first->module,
+          first->i2cAddress,
+          first->offset,
+          first->len,
+          first->writeBuf);
+    } else if (batch.size() == 1) {
+      bus_->moduleRead(
+          first->module,
+          first->i2cAddress,
+          first->offset,
+          first->len,
+          first->readBuf);
+    } else {
+      auto spanStart = first->offset;
+      auto spanEnd = first->offset + first->len;
+      for (auto txn : batch) {
+        spanStart = std::min(spanStart, txn->offset);
+        spanEnd = std::max(spanEnd, txn->offset + txn->len);
+      }
+      std::array<uint8_t, kMaxCoalescedReadLen> buf;
+      bus_->moduleRead(
+          first->module,
+          first->i2cAddress,
+          spanStart,
+          spanEnd - spanStart,
+          buf.data());
+      for (auto txn : batch) {
+        memcpy(txn->readBuf, buf.data() + txn->offset - spanStart, txn->len);
+      }
+    }
+  } catch (const std::exception&) {
+    for (auto txn : batch) {
+      txn->error = std::current_exception();
+    }
+  }
+}
+
+void I2cTransactionScheduler::recordQueueLatency(const Transaction& txn) {
+  auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - txn.enqueued);
+  fb303::fbData->addHistogramValue(
+      queueLatencyKey(txn.priority), latency.count());
+}
+
+I2cTransactionScheduler::Stats I2cTransactionScheduler::getStats() const {
+  return *stats_.rlock();
+}
+
+size_t I2cTransactionScheduler::numPending(unsigned int module) {
+  auto& queue = getBusQueue(module);
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  return queue.pending.size();
+}
+
+void I2cTransactionScheduler::waitForPending(
+    unsigned int module,
+    size_t count) {
+  auto& queue = getBusQueue(module);
+  std::unique_lock<std::mutex> lock(queue.mutex);
+  queue.queued.wait(
+      lock, [&queue, count]() { return queue.pending.size() >= count; });
+}
+
+void I2cTransactionScheduler::open() {
+  bus_->open();
+}
+
+void I2cTransactionScheduler::close() {
+  bus_->close();
+}
+
+void I2cTransactionScheduler::verifyBus(bool autoReset) {
+  bus_->verifyBus(autoReset);
+}
+
+bool I2cTransactionScheduler::isPresent(unsigned int module) {
+  return bus_->isPresent(module);
+}
+
+void I2cTransactionScheduler::scanPresence(
+    std::map<int32_t, ModulePresence>& presence) {
+  bus_->scanPresence(presence);
+}
+
+void I2cTransactionScheduler::ensureOutOfReset(unsigned int module) {
+  bus_->ensureOutOfReset(module);
+}
+
+void I2cTransactionScheduler::triggerQsfpHardReset(unsigned int module) {
+  bus_->triggerQsfpHardReset(module);
+}
+
+void I2cTransactionScheduler::clearAllTransceiverReset() {
+  bus_->clearAllTransceiverReset();
+}
+
+folly::EventBase* I2cTransactionScheduler::getEventBase(unsigned int module) {
+  return bus_->getEventBase(module);
+}
+
+uint32_t I2cTransactionScheduler::getBusId(unsigned int module) {
+  return bus_->getBusId(module);
+}
+
+std::vector<std::reference_wrapper<const I2cControllerStats>>
+I2cTransactionScheduler::getI2cControllerStats() {
+  return bus_->getI2cControllerStats();
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/lib/usb/TransceiverI2CApi.h"
+
+#include <folly/Synchronized.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Priority classes of I2C transactions, most urgent first.
+ */
+enum class I2cPriority : uint8_t {
+  // Transceiver customization on port speed change, on the link bringup path
+  LINK_CRITICAL = 0,
+  // Register reads and writes requested over thrift
+  THRIFT = 1,
+  // Periodic DOM polling from refreshTransceivers()
+  BACKGROUND = 2,
+};
+
+/*
+ * Sets the priority of the I2C transactions issued by the current thread for
+ * the lifetime of the guard. Threads that never set one issue BACKGROUND
+ * transactions.
+ */
+class I2cPriorityGuard {
+ public:
+  explicit I2cPriorityGuard(I2cPriority priority);
+  ~I2cPriorityGuard();
+
+ private:
+  I2cPriorityGuard(I2cPriorityGuard const&) = delete;
+  I2cPriorityGuard& operator=(I2cPriorityGuard const&) = delete;
+
+  I2cPriority previous_;
+};
+
+/*
+ * Wraps a TransceiverI2CApi and orders module transactions per I2C bus.
+ *
+ * Callers queue their transaction on the module's bus and whichever caller
+ * finds the bus idle dispatches queued transactions until its own is done.
+ * Transactions are picked by priority class, FIFO within a class, except that
+ * any transaction past its deadline (enqueue time plus the class budget) goes
+ * first, so background polling cannot be starved forever. Reads of the same
+ * module that cover adjacent or overlapping ranges are coalesced into one
+ * bus transaction.
+ *
+ * QsfpModule holds its qsfpModuleMutex_ across each page select and the
+ * reads that follow it, and that lock stays: the scheduler cannot tell which
+ * page a read targets. So QsfpModule never has more than one transaction of
+ * a module queued here, and what the scheduler does for it is order the
+ * transactions of the different modules sharing a bus, which the module lock
+ * does not serialize. Coalescing only kicks in when other callers, like the
+ * identifier and part number reads of WedgeQsfp, which don't take the module
+ * lock, queue a read next to one of QsfpModule's.
+ *
+ * Queue latency per priority class is exported as fb303 histograms.
+ */
+class I2cTransactionScheduler : public TransceiverI2CApi {
+ public:
+  // Largest read issued when coalescing, the limit of most I2C controllers
+  static constexpr int kMaxCoalescedReadLen = 128;
+
+  explicit I2cTransactionScheduler(std::unique_ptr<TransceiverI2CApi> bus);
+  ~I2cTransactionScheduler() override;
+
+  void open() override;
+  void close() override;
+  void moduleRead(
+      unsigned int module,
+      uint8_t i2cAddress,
+      int offset,
+      int len,
+      uint8_t* buf) override;
+  void moduleWrite(
+      unsigned int module,
+      uint8_t i2cAddress,
+      int offset,
+      int len,
+      const uint8_t* buf) override;
+
+  void verifyBus(bool autoReset) override;
+  bool isPresent(unsigned int module) override;
+  void scanPresence(std::map<int32_t, ModulePresence>& presence) override;
+  void ensureOutOfReset(unsigned int module) override;
+  void triggerQsfpHardReset(unsigned int module) override;
+  void clearAllTransceiverReset() override;
+  folly::EventBase* getEventBase(unsigned int module) override;
+  uint32_t getBusId(unsigned int module) override;
+  std::vector<std::reference_wrapper<const I2cControllerStats>>
+  getI2cControllerStats() override;
+
+  static I2cPriority getCurrentPriority();
+
+  struct Stats {
+    uint64_t transactions{0};
+    uint64_t busTransactions{0};
+    uint64_t coalescedReads{0};
+    uint64_t deadlineDispatches{0};
+  };
+  Stats getStats() const;
+
+  // Transactions waiting on the bus of module, for tests
+  size_t numPending(unsigned int module);
+  // Blocks until at least count transactions wait on the bus of module
+  void waitForPending(unsigned int module, size_t count);
+
+ private:
+  struct Transaction {
+    I2cPriority priority;
+    std::chrono::steady_clock::time_point enqueued;
+    std::chrono::steady_clock::time_point deadline;
+    uint64_t seq;
+    unsigned int module;
+    uint8_t i2cAddress;
+    int offset;
+    int len;
+    uint8_t* readBuf{nullptr};
+    const uint8_t* writeBuf{nullptr};
+    bool done{false};
+    std::exception_ptr error;
+
+    bool isRead() const {
+      return readBuf != nullptr;
+    }
+  };
+
+  struct BusQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    // Notified when a transaction is queued
+    std::condition_variable queued;
+    bool busy{false};
+    std::vector<Transaction*> pending;
+  };
+
+  // Forbidden copy constructor and assignment operator
+  I2cTransactionScheduler(I2cTransactionScheduler const&) = delete;
+  I2cTransactionScheduler& operator=(I2cTransactionScheduler const&) = delete;
+
+  BusQueue& getBusQueue(unsigned int module);
+  void submit(Transaction& txn);
+  // Pick the next transactions to run, with queue lock held
+  std::vector<Transaction*> takeNextLocked(BusQueue& queue);
+  void execute(const std::vector<Transaction*>& batch);
+  void recordQueueLatency(const Transaction& txn);
+
+  std::unique_ptr<TransceiverI2CApi> bus_;
+  folly::Synchronized<std::map<uint32_t, std::unique_ptr<BusQueue>>> queues_;
+  std::atomic<uint64_t> nextSeq_{0};
+  folly::Synchronized<Stats> stats_;
+};
+
+} // namespace facebook::fboss
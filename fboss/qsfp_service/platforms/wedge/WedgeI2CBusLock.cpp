@@ -28,7 +28,8 @@ void WedgeI2CBusLock::openLocked() {
 }
 
 void WedgeI2CBusLock::open() {
-  lock_guard<std::mutex> g(busMutex_);
+  std::unique_lock<folly::SharedMutex> g(deviceMutex_);
+  lock_guard<std::mutex> openGuard(openMutex_);
   openLocked();
 }
 
@@ -38,8 +39,44 @@ void WedgeI2CBusLock::closeLocked() {
 }
 
 void WedgeI2CBusLock::close() {
-  lock_guard<std::mutex> g(busMutex_);
+  std::unique_lock<folly::SharedMutex> g(deviceMutex_);
+  lock_guard<std::mutex> openGuard(openMutex_);
   closeLocked();
+  openedByGuard_ = false;
+}
+
+std::mutex& WedgeI2CBusLock::getBusMutex(unsigned int module) {
+  auto busId = wedgeI2CBus_->getBusId(module);
+  {
+    auto lockedMutexes = busMutexes_.rlock();
+    if (auto it = lockedMutexes->find(busId); it != lockedMutexes->end()) {
+      return *it->second;
+    }
+  }
+  auto lockedMutexes = busMutexes_.wlock();
+  auto& busMutex = (*lockedMutexes)[busId];
+  if (!busMutex) {
+    busMutex = std::make_unique<std::mutex>();
+  }
+  return *busMutex;
+}
+
+void WedgeI2CBusLock::acquireDevice() {
+  // The first guard opens the device unless someone opened it explicitly,
+  // the last one closes it again
+  lock_guard<std::mutex> g(openMutex_);
+  if (activeGuards_++ == 0 && !opened_) {
+    openLocked();
+    openedByGuard_ = true;
+  }
+}
+
+void WedgeI2CBusLock::releaseDevice() {
+  lock_guard<std::mutex> g(openMutex_);
+  if (--activeGuards_ == 0 && openedByGuard_) {
+    closeLocked();
+    openedByGuard_ = false;
+  }
 }
 
 void WedgeI2CBusLock::verifyBus(bool autoReset) {
@@ -53,7 +90,7 @@ void WedgeI2CBusLock::moduleRead(
     int offset,
     int len,
     uint8_t* buf) {
-  BusGuard g(this);
+  BusGuard g(this, module);
   wedgeI2CBus_->moduleRead(module, address, offset, len, buf);
 }
 
@@ -63,7 +100,7 @@ void WedgeI2CBusLock::moduleWrite(
     int offset,
     int len,
     const uint8_t* buf) {
-  BusGuard g(this);
+  BusGuard g(this, module);
   wedgeI2CBus_->moduleWrite(module, address, offset, len, buf);
 }
 
@@ -82,7 +119,7 @@ void WedgeI2CBusLock::write(
 }
 
 bool WedgeI2CBusLock::isPresent(unsigned int module) {
-  BusGuard g(this);
+  BusGuard g(this, module);
   return wedgeI2CBus_->isPresent(module);
 }
 
@@ -93,7 +130,7 @@ void WedgeI2CBusLock::scanPresence(
 }
 
 void WedgeI2CBusLock::ensureOutOfReset(unsigned int module) {
-  BusGuard g(this);
+  BusGuard g(this, module);
   wedgeI2CBus_->ensureOutOfReset(module);
 }
 
@@ -110,5 +147,9 @@ WedgeI2CBusLock::getI2cControllerStats() {
 folly::EventBase* WedgeI2CBusLock::getEventBase(unsigned int module) {
   return wedgeI2CBus_->getEventBase(module);
 }
+
+uint32_t WedgeI2CBusLock::getBusId(unsigned int module) {
+  return wedgeI2CBus_->getBusId(module);
+}
 } // namespace fboss
 } // namespace facebook
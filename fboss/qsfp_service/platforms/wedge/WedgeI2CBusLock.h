@@ -12,7 +12,11 @@
 #include "fboss/lib/usb/BaseWedgeI2CBus.h"
 
 #include <folly/Range.h>
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
+#include <map>
 #include <mutex>
+#include <shared_mutex>
 
 namespace facebook {
 namespace fboss {
@@ -20,6 +24,10 @@ namespace fboss {
 /*
  * A small wrapper around CP2112 which is aware of the topology of wedge's QSFP
  * I2C bus, and can select specific QSFPs to query.
+ *
+ * Module accesses only lock the bus the module sits on (see
+ * TransceiverI2CApi::getBusId), so modules on independent buses can be
+ * accessed in parallel. Accesses that are not tied to a module lock every bus.
  */
 class WedgeI2CBusLock : public TransceiverI2CApi {
  public:
@@ -55,6 +63,8 @@ class WedgeI2CBusLock : public TransceiverI2CApi {
 
   folly::EventBase* getEventBase(unsigned int module) override;
 
+  uint32_t getBusId(unsigned int module) override;
+
  private:
   // Forbidden copy constructor and assignment operator
   WedgeI2CBusLock(WedgeI2CBusLock const&) = delete;
@@ -63,38 +73,52 @@ class WedgeI2CBusLock : public TransceiverI2CApi {
   void openLocked();
   void closeLocked();
 
+  std::mutex& getBusMutex(unsigned int module);
+  void acquireDevice();
+  void releaseDevice();
+
   std::unique_ptr<BaseWedgeI2CBus> wedgeI2CBus_{nullptr};
-  mutable std::mutex busMutex_;
+  // Held shared by module accesses and exclusively by whole device accesses
+  folly::SharedMutex deviceMutex_;
+  folly::Synchronized<std::map<uint32_t, std::unique_ptr<std::mutex>>>
+      busMutexes_;
+  // Protects opened_ and the guard bookkeeping below
+  std::mutex openMutex_;
   bool opened_{false};
+  int activeGuards_{0};
+  bool openedByGuard_{false};
 
   class BusGuard {
     /* This class is a simple guard that:
-       1. locks access to the device
+       1. locks access to the bus, or to the whole device
        2. opens/closes the device if it is not already open
 
-       This makes sure that only one person is accessing the device,
+       This makes sure that only one person is accessing a bus at a time,
        but allows us to only open the device once in the case of batch
-       read/writes.
+       read/writes or of accesses to several buses in parallel.
     */
    public:
     explicit BusGuard(WedgeI2CBusLock* busLock)
-        : busLock_(busLock), lock_(busLock->busMutex_) {
-      if (!busLock_->opened_) {
-        busLock_->openLocked();
-        performedOpen_ = true;
-      }
+        : busLock_(busLock), deviceLock_(busLock->deviceMutex_) {
+      busLock_->acquireDevice();
+    }
+
+    BusGuard(WedgeI2CBusLock* busLock, unsigned int module)
+        : busLock_(busLock),
+          sharedDeviceLock_(busLock->deviceMutex_),
+          moduleBusLock_(busLock->getBusMutex(module)) {
+      busLock_->acquireDevice();
     }
 
     ~BusGuard() {
-      if (performedOpen_) {
-        busLock_->closeLocked();
-      }
+      busLock_->releaseDevice();
     }
 
    private:
     WedgeI2CBusLock* busLock_{nullptr};
-    bool performedOpen_{false};
-    std::lock_guard<std::mutex> lock_;
+    std::unique_lock<folly::SharedMutex> deviceLock_;
+    std::shared_lock<folly::SharedMutex> sharedDeviceLock_;
+    std::unique_lock<std::mutex> moduleBusLock_;
   };
 };
 
@@ -4,14 +4,28 @@
 #include "fboss/qsfp_service/module/QsfpModule.h"
 #include "fboss/qsfp_service/module/cmis/CmisModule.h"
 #include "fboss/qsfp_service/module/sff/SffModule.h"
+#include "fboss/qsfp_service/platforms/wedge/I2cTransactionScheduler.h"
 #include "fboss/qsfp_service/platforms/wedge/WedgeQsfp.h"
 
 #include <fb303/ThreadCachedServiceData.h>
 
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/gen/Base.h>
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+DEFINE_int32(
+    transceiver_refresh_threads,
+    16,
+    "Number of threads used to refresh transceivers. Transceivers on "
+    "different I2C buses are refreshed in parallel, up to this many at a time");
+
+DEFINE_bool(
+    i2c_priority_scheduling,
+    true,
+    "Order I2C transactions on each bus by priority, so that transceiver "
+    "customization and thrift requests do not wait behind DOM polling");
+
 namespace {
 
 constexpr int kSecAfterModuleOutOfReset = 2;
@@ -27,7 +41,10 @@ WedgeManager::WedgeManager(
     PlatformMode mode)
     : TransceiverManager(std::move(api)),
       platformMapping_(std::move(platformMapping)),
-      platformMode_(mode) {
+      platformMode_(mode),
+      refreshThreadPool_(std::make_unique<folly::CPUThreadPoolExecutor>(
+          FLAGS_transceiver_refresh_threads,
+          std::make_shared<folly::NamedThreadFactory>("TcvrRefresh"))) {
   /* Constructor for WedgeManager class:
    * Get the TransceiverPlatformApi object from the creator of this object,
    * this object will be used for controlling the QSFP devices on board.
@@ -83,7 +100,11 @@ void WedgeManager::initTransceiverMap() {
   // create the QSFP objects;  this is likely to be a permanent
   // error.
   try {
-    wedgeI2cBus_ = getI2CBus();
+    auto i2cBus = getI2CBus();
+    if (FLAGS_i2c_priority_scheduling) {
+      i2cBus = std::make_unique<I2cTransactionScheduler>(std::move(i2cBus));
+    }
+    wedgeI2cBus_ = std::move(i2cBus);
   } catch (const I2cError& ex) {
     XLOG(ERR) << "failed to initialize I2C interface: " << ex.what();
     return;
@@ -202,6 +223,7 @@ void WedgeManager::getTransceiversDOMDataUnion(
 void WedgeManager::readTransceiverRegister(
     std::map<int32_t, ReadResponse>& responses,
     std::unique_ptr<ReadRequest> request) {
+  I2cPriorityGuard priority(I2cPriority::THRIFT);
   auto ids = *(request->ids_ref());
   XLOG(INFO) << "Received request for reading transceiver registers for ids: "
              << (ids.size() > 0 ? folly::join(",", ids) : "None");
@@ -231,6 +253,7 @@ void WedgeManager::readTransceiverRegister(
 void WedgeManager::writeTransceiverRegister(
     std::map<int32_t, WriteResponse>& responses,
     std::unique_ptr<WriteRequest> request) {
+  I2cPriorityGuard priority(I2cPriority::THRIFT);
   auto ids = *(request->ids_ref());
   XLOG(INFO) << "Received request for writing transceiver register for ids: "
              << (ids.size() > 0 ? folly::join(",", ids) : "None");
@@ -259,6 +282,7 @@ void WedgeManager::customizeTransceiver(int32_t idx, cfg::PortSpeed speed) {
   if (!isValidTransceiver(idx)) {
     return;
   }
+  I2cPriorityGuard priority(I2cPriority::LINK_CRITICAL);
   auto lockedTransceivers = transceivers_.rlock();
   if (auto it = lockedTransceivers->find(TransceiverID(idx));
       it != lockedTransceivers->end()) {
@@ -285,6 +309,8 @@ void WedgeManager::syncPorts(
                 }) |
       folly::gen::as<std::vector>();
 
+  // Port changes customize the transceivers on the link bringup path
+  I2cPriorityGuard priority(I2cPriority::LINK_CRITICAL);
   auto lockedTransceivers = transceivers_.rlock();
   auto lockedPorts = ports_.wlock();
   for (auto& group : groups) {
@@ -330,19 +356,81 @@ void WedgeManager::refreshTransceivers() {
   // transceiver mapping and type here.
   updateTransceiverMap();
 
-  std::vector<folly::Future<folly::Unit>> futs;
+  refreshTransceiversByBus();
+}
+
+void WedgeManager::refreshTransceiversByBus() {
   XLOG(INFO) << "Start refreshing all transceivers...";
+  auto cycleStart = std::chrono::steady_clock::now();
 
   auto lockedTransceivers = transceivers_.rlock();
 
+  uint64_t bytesReadBefore = 0;
+  std::map<uint32_t, std::vector<Transceiver*>> busToTransceivers;
   for (const auto& transceiver : *lockedTransceivers) {
-    XLOG(DBG3) << "Fired to refresh transceiver "
-               << transceiver.second->getID();
-    futs.push_back(transceiver.second->futureRefresh());
+    bytesReadBefore += transceiver.second->getBytesRead();
+    // I2C apis use 1 based module ids
+    auto busId = wedgeI2cBus_
+        ? wedgeI2cBus_->getBusId(static_cast<int>(transceiver.first) + 1)
+        : 0;
+    busToTransceivers[busId].push_back(transceiver.second.get());
   }
 
-  folly::collectAll(futs.begin(), futs.end()).wait();
-  XLOG(INFO) << "Finished refreshing all transceivers";
+  std::vector<folly::Future<std::pair<uint32_t, std::chrono::microseconds>>>
+      futs;
+  for (const auto& busTransceivers : busToTransceivers) {
+    auto busId = busTransceivers.first;
+    const auto& transceivers = busTransceivers.second;
+    futs.push_back(
+        folly::via(refreshThreadPool_.get(), [busId, &transceivers]() {
+          auto busStart = std::chrono::steady_clock::now();
+          for (auto transceiver : transceivers) {
+            XLOG(DBG3) << "Fired to refresh transceiver "
+                       << transceiver->getID() << " on bus " << busId;
+            // Transceivers with their own I2C event base are refreshed there,
+            // wait for it so that the bus only has one refresh in flight.
+            transceiver->futureRefresh().wait();
+          }
+          return std::make_pair(
+              busId,
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - busStart));
+        }));
+  }
+
+  RefreshStats stats;
+  for (auto& result : folly::collectAll(futs.begin(), futs.end()).get()) {
+    if (result.hasValue()) {
+      stats.busBusyTime.insert(result.value());
+    }
+  }
+  stats.cycleDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - cycleStart);
+  for (const auto& transceiver : *lockedTransceivers) {
+    stats.bytesRead += transceiver.second->getBytesRead();
+  }
+  stats.bytesRead -= bytesReadBefore;
+
+  XLOG(INFO) << "Finished refreshing all transceivers on "
+             << busToTransceivers.size() << " I2C buses in "
+             << stats.cycleDuration.count() / 1000 << "ms, read "
+             << stats.bytesRead << " bytes";
+  *lastRefreshStats_.wlock() = std::move(stats);
+}
+
+void WedgeManager::publishRefreshStats(const RefreshStats& stats) {
+  tcData().setCounter(
+      "qsfp.refresh_cycle_ms", stats.cycleDuration.count() / 1000);
+  tcData().setCounter("qsfp.refresh_bytes_read", stats.bytesRead);
+  if (stats.cycleDuration.count() == 0) {
+    return;
+  }
+  for (const auto& [busId, busyTime] : stats.busBusyTime) {
+    auto statName = folly::to<std::string>(
+        "qsfp.i2c_bus.", busId, ".refresh_utilization_pct");
+    tcData().setCounter(
+        statName, busyTime.count() * 100 / stats.cycleDuration.count());
+  }
 }
 
 int WedgeManager::scanTransceiverPresence(
@@ -502,6 +590,9 @@ void WedgeManager::updateTransceiverMap() {
  * That class has the function to get the I2c transaction status.
  */
 void WedgeManager::publishI2cTransactionStats() {
+  // Bytes read and time taken by the last transceiver refresh cycle
+  publishRefreshStats(getLastRefreshStats());
+
   // Get the i2c transaction stats from TransactionManager class (its
   // sub-class having platform specific implementation)
   auto counters = getI2cControllerStats();
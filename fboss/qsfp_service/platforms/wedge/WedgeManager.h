@@ -1,6 +1,7 @@
 #pragma once
 
 #include <boost/container/flat_map.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include "fboss/agent/AgentConfig.h"
 #include "fboss/agent/platforms/common/PlatformMapping.h"
@@ -20,6 +21,15 @@ class WedgeManager : public TransceiverManager {
   using PortNameMap = std::map<std::string, int32_t>;
   using PortGroups = std::map<int32_t, std::set<cfg::Port>>;
 
+  struct RefreshStats {
+    // Wall clock time of the last refresh of all transceivers
+    std::chrono::microseconds cycleDuration{0};
+    // Time each I2C bus spent refreshing its transceivers during that cycle
+    std::map<uint32_t, std::chrono::microseconds> busBusyTime;
+    // Eeprom bytes read from all transceivers during that cycle
+    uint64_t bytesRead{0};
+  };
+
   explicit WedgeManager(
       std::unique_ptr<TransceiverPlatformApi> api,
       std::unique_ptr<PlatformMapping> platformMapping,
@@ -58,6 +68,10 @@ class WedgeManager : public TransceiverManager {
   }
   void refreshTransceivers() override;
 
+  RefreshStats getLastRefreshStats() const {
+    return *lastRefreshStats_.rlock();
+  }
+
   int scanTransceiverPresence(
       std::unique_ptr<std::vector<int32_t>> ids) override;
 
@@ -102,6 +116,14 @@ class WedgeManager : public TransceiverManager {
  protected:
   virtual std::unique_ptr<TransceiverI2CApi> getI2CBus();
   void updateTransceiverMap();
+  /*
+   * Refresh every transceiver, one bus at a time within a bus but all buses
+   * in parallel. Transceivers sharing an I2C bus cannot be accessed
+   * concurrently anyway, so there is no point in running more than one
+   * refresh per bus.
+   */
+  void refreshTransceiversByBus();
+  void publishRefreshStats(const RefreshStats& stats);
   std::unique_ptr<TransceiverI2CApi>
       wedgeI2cBus_; /* thread safe handle to access bus */
 
@@ -115,6 +137,9 @@ class WedgeManager : public TransceiverManager {
 
   PlatformMode platformMode_;
 
+  std::unique_ptr<folly::CPUThreadPoolExecutor> refreshThreadPool_;
+  folly::Synchronized<RefreshStats> lastRefreshStats_;
+
  private:
   void loadConfig() override;
   // Forbidden copy constructor and assignment operator
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include "fboss/lib/usb/BaseWedgeI2CBus.h"
+
+#include <folly/Synchronized.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::fboss {
+
+class NullCP2112 : public CP2112Intf {
+ public:
+  void open(bool /* setSmbusConfig */) override {}
+  void close() override {}
+  void resetDevice() override {}
+  bool isOpen() const override {
+    return true;
+  }
+
+  void read(
+      uint8_t /* address */,
+      folly::MutableByteRange /* buf */,
+      std::chrono::milliseconds /* timeout */) override {}
+  using CP2112Intf::read;
+
+  void write(
+      uint8_t /* address */,
+      folly::ByteRange /* buf */,
+      std::chrono::milliseconds /* timeout */) override {}
+  using CP2112Intf::write;
+
+  void writeReadUnsafe(
+      uint8_t /* address */,
+      folly::ByteRange /* writeBuf */,
+      folly::MutableByteRange /* readBuf */,
+      std::chrono::milliseconds /* timeout */) override {}
+  using CP2112Intf::writeReadUnsafe;
+
+  std::chrono::milliseconds getDefaultTimeout() const override {
+    return std::chrono::milliseconds(500);
+  }
+};
+
+/*
+ * An I2C bus split into independent buses, each serving modulesPerBus
+ * consecutive modules. Every module transaction takes `latency` to complete,
+ * which makes it possible to measure how well transceiver accesses are
+ * spread across buses without any hardware. All modules are present and
+ * return an all zero eeprom, except for the identifier byte.
+ */
+class FakeI2cBus : public BaseWedgeI2CBus {
+ public:
+  FakeI2cBus(
+      unsigned int modulesPerBus,
+      std::chrono::microseconds latency,
+      uint8_t identifier = 0x0d /* QSFP+ */)
+      : BaseWedgeI2CBus(std::make_unique<NullCP2112>()),
+        modulesPerBus_(modulesPerBus),
+        latency_(latency),
+        identifier_(identifier) {}
+
+  void open() override {}
+  void close() override {}
+  void verifyBus(bool /* autoReset */) override {}
+
+  void moduleRead(
+      unsigned int module,
+      uint8_t /* i2cAddress */,
+      int offset,
+      int len,
+      uint8_t* buf) override {
+    transaction(module);
+    memset(buf, 0, len);
+    if (offset == 0 && len > 0) {
+      buf[0] = identifier_;
+    }
+  }
+
+  void moduleWrite(
+      unsigned int module,
+      uint8_t /* i2cAddress */,
+      int /* offset */,
+      int /* len */,
+      const uint8_t* /* buf */) override {
+    transaction(module);
+  }
+
+  bool isPresent(unsigned int /* module */) override {
+    return true;
+  }
+
+  void scanPresence(std::map<int32_t, ModulePresence>& presences) override {
+    for (auto& presence : presences) {
+      presence.second = ModulePresence::PRESENT;
+    }
+  }
+
+  uint32_t getBusId(unsigned int module) override {
+    return (module - 1) / modulesPerBus_;
+  }
+
+  // Largest number of transactions that were ever in flight on one bus
+  int maxConcurrentTransactions() const {
+    int result = 0;
+    for (const auto& bus : *buses_.rlock()) {
+      result = std::max(result, bus.second.maxInFlight);
+    }
+    return result;
+  }
+
+  // Modules in the order their transactions were started
+  std::vector<unsigned int> transactionLog() const {
+    return *transactionLog_.rlock();
+  }
+
+  /*
+   * While held, transactions started on the bus block until release(), so
+   * tests can queue more transactions behind them without relying on timing.
+   */
+  void hold() {
+    std::lock_guard<std::mutex> lock(holdMutex_);
+    held_ = true;
+  }
+  void release() {
+    std::lock_guard<std::mutex> lock(holdMutex_);
+    held_ = false;
+    holdCv_.notify_all();
+  }
+  // Blocks until at least count transactions were started
+  void waitForStarted(uint64_t count) {
+    std::unique_lock<std::mutex> lock(holdMutex_);
+    holdCv_.wait(lock, [this, count]() { return started_ >= count; });
+  }
+
+  uint64_t numTransactions() const {
+    uint64_t result = 0;
+    for (const auto& bus : *buses_.rlock()) {
+      result += bus.second.transactions;
+    }
+    return result;
+  }
+
+ protected:
+  void initBus() override {}
+  void selectQsfpImpl(unsigned int /* module */) override {}
+
+ private:
+  struct BusState {
+    int inFlight{0};
+    int maxInFlight{0};
+    uint64_t transactions{0};
+  };
+
+  void transaction(unsigned int module) {
+    auto busId = getBusId(module);
+    {
+      auto lockedBuses = buses_.wlock();
+      auto& bus = (*lockedBuses)[busId];
+      bus.maxInFlight = std::max(bus.maxInFlight, ++bus.inFlight);
+      ++bus.transactions;
+    }
+    transactionLog_.wlock()->push_back(module);
+    {
+      std::unique_lock<std::mutex> lock(holdMutex_);
+      ++started_;
+      holdCv_.notify_all();
+      holdCv_.wait(lock, [this]() { return !held_; });
+    }
+    if (latency_.count()) {
+      std::this_thread::sleep_for(latency_);
+    }
+    --(*buses_.wlock())[busId].inFlight;
+  }
+
+  const unsigned int modulesPerBus_;
+  const std::chrono::microseconds latency_;
+  const uint8_t identifier_;
+  folly::Synchronized<std::map<uint32_t, BusState>> buses_;
+  folly::Synchronized<std::vector<unsigned int>> transactionLog_;
+  std::mutex holdMutex_;
+  std::condition_variable holdCv_;
+  bool held_{false};
+  uint64_t started_{0};
+};
+
+} // namespace facebook::fboss
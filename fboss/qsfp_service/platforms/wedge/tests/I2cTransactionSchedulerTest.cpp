@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/qsfp_service/platforms/wedge/I2cTransactionScheduler.h"
+#include "fboss/qsfp_service/platforms/wedge/tests/FakeI2cBus.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+DECLARE_int32(i2c_background_deadline_ms);
+DECLARE_int32(i2c_link_critical_deadline_ms);
+DECLARE_int32(i2c_thrift_deadline_ms);
+
+using namespace facebook::fboss;
+
+namespace {
+
+class I2cTransactionSchedulerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // No transaction expires while a test queues them, however slow it runs
+    FLAGS_i2c_link_critical_deadline_ms = 600000;
+    FLAGS_i2c_thrift_deadline_ms = 600000;
+    FLAGS_i2c_background_deadline_ms = 600000;
+
+    // Every module on the same bus
+    auto bus = std::make_unique<FakeI2cBus>(16, std::chrono::microseconds(0));
+    fakeBus_ = bus.get();
+    scheduler_ = std::make_unique<I2cTransactionScheduler>(std::move(bus));
+  }
+
+  // Module 1 takes the bus, and keeps it until releaseBus()
+  void holdBus() {
+    fakeBus_->hold();
+    threads_.push_back(startRead(1, I2cPriority::BACKGROUND));
+    fakeBus_->waitForStarted(1);
+  }
+
+  void releaseBus() {
+    fakeBus_->release();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+    threads_.clear();
+    numQueued_ = 0;
+  }
+
+  // Queue a read behind the transactions already queued
+  void queueRead(
+      unsigned int module,
+      I2cPriority priority,
+      int offset = 0,
+      int len = 1,
+      uint8_t* buf = nullptr) {
+    threads_.push_back(startRead(module, priority, offset, len, buf));
+    scheduler_->waitForPending(module, ++numQueued_);
+  }
+
+  void queueWrite(unsigned int module, I2cPriority priority, uint8_t page) {
+    threads_.emplace_back([=]() {
+      I2cPriorityGuard guard(priority);
+      scheduler_->moduleWrite(
+          module, TransceiverI2CApi::ADDR_QSFP, 127, 1, &page);
+    });
+    scheduler_->waitForPending(module, ++numQueued_);
+  }
+
+  FakeI2cBus* fakeBus_;
+  std::unique_ptr<I2cTransactionScheduler> scheduler_;
+
+ private:
+  std::thread startRead(
+      unsigned int module,
+      I2cPriority priority,
+      int offset = 0,
+      int len = 1,
+      uint8_t* buf = nullptr) {
+    return std::thread([=]() {
+      I2cPriorityGuard guard(priority);
+      uint8_t scratch[128];
+      scheduler_->moduleRead(
+          module,
+          TransceiverI2CApi::ADDR_QSFP,
+          offset,
+          len,
+          buf ? buf : scratch);
+    });
+  }
+
+  gflags::FlagSaver flagSaver_;
+  std::vector<std::thread> threads_;
+  size_t numQueued_{0};
+};
+
+} // namespace
+
+TEST_F(I2cTransactionSchedulerTest, priorityGuard) {
+  EXPECT_EQ(
+      I2cTransactionScheduler::getCurrentPriority(), I2cPriority::BACKGROUND);
+  {
+    I2cPriorityGuard thrift(I2cPriority::THRIFT);
+    EXPECT_EQ(
+        I2cTransactionScheduler::getCurrentPriority(), I2cPriority::THRIFT);
+    {
+      I2cPriorityGuard critical(I2cPriority::LINK_CRITICAL);
+      EXPECT_EQ(
+          I2cTransactionScheduler::getCurrentPriority(),
+          I2cPriority::LINK_CRITICAL);
+    }
+    EXPECT_EQ(
+        I2cTransactionScheduler::getCurrentPriority(), I2cPriority::THRIFT);
+  }
+  EXPECT_EQ(
+      I2cTransactionScheduler::getCurrentPriority(), I2cPriority::BACKGROUND);
+}
+
+TEST_F(I2cTransactionSchedulerTest, higherPriorityGoesFirst) {
+  // Module 1 holds the bus while the others queue up behind it
+  holdBus();
+  queueRead(2, I2cPriority::BACKGROUND);
+  queueRead(3, I2cPriority::THRIFT);
+  queueRead(4, I2cPriority::LINK_CRITICAL);
+  releaseBus();
+  EXPECT_EQ(
+      fakeBus_->transactionLog(), (std::vector<unsigned int>{1, 4, 3, 2}));
+  EXPECT_EQ(fakeBus_->maxConcurrentTransactions(), 1);
+}
+
+TEST_F(I2cTransactionSchedulerTest, expiredTransactionGoesFirst) {
+  FLAGS_i2c_background_deadline_ms = 0;
+
+  holdBus();
+  queueRead(2, I2cPriority::BACKGROUND);
+  queueRead(3, I2cPriority::LINK_CRITICAL);
+  releaseBus();
+  // Module 2 waited past its budget so it is not starved by module 3
+  EXPECT_EQ(fakeBus_->transactionLog(), (std::vector<unsigned int>{1, 2, 3}));
+  EXPECT_EQ(scheduler_->getStats().deadlineDispatches, 1);
+}
+
+TEST_F(I2cTransactionSchedulerTest, adjacentReadsAreCoalesced) {
+  std::array<uint8_t, 64> lower;
+  std::array<uint8_t, 64> upper;
+  lower.fill(0xff);
+  upper.fill(0xff);
+
+  holdBus();
+  queueRead(2, I2cPriority::BACKGROUND, 0, lower.size(), lower.data());
+  queueRead(
+      2, I2cPriority::THRIFT, lower.size(), upper.size(), upper.data());
+  // Not adjacent to the other two, read on its own
+  queueRead(2, I2cPriority::BACKGROUND, 200, 10);
+  releaseBus();
+
+  EXPECT_EQ(fakeBus_->numTransactions(), 3);
+  auto stats = scheduler_->getStats();
+  EXPECT_EQ(stats.transactions, 4);
+  EXPECT_EQ(stats.busTransactions, 3);
+  EXPECT_EQ(stats.coalescedReads, 1);
+
+  // The fake eeprom has the identifier at offset 0 and zeros elsewhere, each
+  // caller must get its own slice of the coalesced read
+  EXPECT_EQ(lower[0], 0x0d);
+  for (auto i = 1; i < lower.size(); ++i) {
+    EXPECT_EQ(lower[i], 0);
+  }
+  for (auto byte : upper) {
+    EXPECT_EQ(byte, 0);
+  }
+}
+
+TEST_F(I2cTransactionSchedulerTest, readsAreNotCoalescedAcrossWrites) {
+  holdBus();
+  queueRead(2, I2cPriority::THRIFT, 0, 64);
+  queueWrite(2, I2cPriority::BACKGROUND, 3);
+  queueRead(2, I2cPriority::THRIFT, 64, 64);
+  releaseBus();
+  EXPECT_EQ(scheduler_->getStats().coalescedReads, 0);
+  EXPECT_EQ(fakeBus_->numTransactions(), 4);
+}
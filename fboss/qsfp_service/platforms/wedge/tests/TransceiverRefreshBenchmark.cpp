@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/qsfp_service/module/sff/SffModule.h"
+#include "fboss/qsfp_service/platforms/wedge/WedgeManager.h"
+#include "fboss/qsfp_service/platforms/wedge/WedgeQsfp.h"
+#include "fboss/qsfp_service/platforms/wedge/tests/FakeI2cBus.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+
+DEFINE_int32(
+    fake_i2c_latency_us,
+    100,
+    "Latency of every transaction on the fake I2C bus, in microseconds");
+
+namespace facebook::fboss {
+
+/*
+ * A WedgeManager with 128 SFF modules behind a fake I2C bus, to measure how
+ * long a refresh of all transceivers takes for a given bus topology.
+ */
+class FakeBusWedgeManager : public WedgeManager {
+ public:
+  explicit FakeBusWedgeManager(unsigned int modulesPerBus)
+      : WedgeManager(nullptr, nullptr, PlatformMode::MINIPACK),
+        modulesPerBus_(modulesPerBus) {
+    wedgeI2cBus_ = getI2CBus();
+    auto lockedTransceivers = transceivers_.wlock();
+    for (int idx = 0; idx < getNumQsfpModules(); idx++) {
+      lockedTransceivers->emplace(
+          TransceiverID(idx),
+          std::make_unique<SffModule>(
+              this,
+              std::make_unique<WedgeQsfp>(idx, wedgeI2cBus_.get()),
+              numPortsPerTransceiver()));
+    }
+  }
+
+  int getNumQsfpModules() override {
+    return 128;
+  }
+
+  void refresh() {
+    refreshTransceiversByBus();
+  }
+
+ protected:
+  std::unique_ptr<TransceiverI2CApi> getI2CBus() override {
+    return std::make_unique<WedgeI2CBusLock>(std::make_unique<FakeI2cBus>(
+        modulesPerBus_,
+        std::chrono::microseconds(FLAGS_fake_i2c_latency_us)));
+  }
+
+ private:
+  unsigned int modulesPerBus_;
+};
+
+} // namespace facebook::fboss
+
+using facebook::fboss::FakeBusWedgeManager;
+
+void refreshAllTransceivers(uint32_t iters, unsigned int modulesPerBus) {
+  folly::BenchmarkSuspender suspender;
+  FakeBusWedgeManager manager(modulesPerBus);
+  suspender.dismiss();
+
+  for (auto i = 0; i < iters; ++i) {
+    manager.refresh();
+  }
+
+  suspender.rehire();
+  auto stats = manager.getLastRefreshStats();
+  std::chrono::microseconds busyTime{0};
+  for (const auto& bus : stats.busBusyTime) {
+    busyTime += bus.second;
+  }
+  XLOG(INFO) << stats.busBusyTime.size() << " buses: refresh cycle took "
+             << stats.cycleDuration.count() << "us, average bus utilization "
+             << busyTime.count() * 100 /
+          (stats.cycleDuration.count() * stats.busBusyTime.size())
+             << "%, " << stats.bytesRead << " bytes read";
+}
+
+// Every module behind one CP2112, like Wedge100
+BENCHMARK_NAMED_PARAM(refreshAllTransceivers, single_bus, 128)
+// One bus per PIM
+BENCHMARK_NAMED_PARAM(refreshAllTransceivers, bus_per_pim, 16)
+// One bus per FPGA I2C controller, like Minipack
+BENCHMARK_NAMED_PARAM(refreshAllTransceivers, bus_per_controller, 4)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
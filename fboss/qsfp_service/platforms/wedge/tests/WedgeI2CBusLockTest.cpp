@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/qsfp_service/platforms/wedge/WedgeI2CBusLock.h"
+#include "fboss/qsfp_service/platforms/wedge/tests/FakeI2cBus.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr auto kLatency = std::chrono::milliseconds(10);
+constexpr auto kNumModules = 8;
+constexpr auto kReadsPerModule = 5;
+
+std::chrono::milliseconds readAllModules(WedgeI2CBusLock& busLock) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned int module = 1; module <= kNumModules; ++module) {
+    threads.emplace_back([&busLock, module]() {
+      uint8_t buf[128];
+      for (auto i = 0; i < kReadsPerModule; ++i) {
+        busLock.moduleRead(
+            module, TransceiverI2CApi::ADDR_QSFP, 0, sizeof(buf), buf);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+} // namespace
+
+TEST(WedgeI2CBusLockTest, sameBusIsSerialized) {
+  auto bus = std::make_unique<FakeI2cBus>(kNumModules, kLatency);
+  auto fakeBus = bus.get();
+  WedgeI2CBusLock busLock(std::move(bus));
+
+  auto elapsed = readAllModules(busLock);
+  EXPECT_EQ(fakeBus->maxConcurrentTransactions(), 1);
+  EXPECT_EQ(fakeBus->numTransactions(), kNumModules * kReadsPerModule);
+  EXPECT_GE(elapsed, kLatency * kNumModules * kReadsPerModule);
+}
+
+TEST(WedgeI2CBusLockTest, independentBusesRunInParallel) {
+  // Two modules per bus, four buses
+  auto bus = std::make_unique<FakeI2cBus>(2, kLatency);
+  auto fakeBus = bus.get();
+  WedgeI2CBusLock busLock(std::move(bus));
+  EXPECT_EQ(busLock.getBusId(1), busLock.getBusId(2));
+  EXPECT_NE(busLock.getBusId(2), busLock.getBusId(3));
+
+  auto elapsed = readAllModules(busLock);
+  // Still only one transaction at a time on a given bus
+  EXPECT_EQ(fakeBus->maxConcurrentTransactions(), 1);
+  EXPECT_EQ(fakeBus->numTransactions(), kNumModules * kReadsPerModule);
+  // Serializing all of them would take 8x as long as one module's reads
+  EXPECT_LT(elapsed, kLatency * kNumModules * kReadsPerModule / 2);
+}
+
+TEST(WedgeI2CBusLockTest, deviceAccessExcludesModuleAccess) {
+  auto bus = std::make_unique<FakeI2cBus>(1, kLatency);
+  WedgeI2CBusLock busLock(std::move(bus));
+
+  std::thread reader([&busLock]() {
+    uint8_t buf[128];
+    for (auto i = 0; i < kReadsPerModule; ++i) {
+      busLock.moduleRead(1, TransceiverI2CApi::ADDR_QSFP, 0, sizeof(buf), buf);
+    }
+  });
+  // Whole device accesses lock every bus, they must not deadlock with or
+  // interleave module reads
+  std::map<int32_t, ModulePresence> presence{{0, ModulePresence::UNKNOWN}};
+  for (auto i = 0; i < kReadsPerModule; ++i) {
+    busLock.scanPresence(presence);
+  }
+  reader.join();
+  EXPECT_EQ(presence[0], ModulePresence::PRESENT);
+}
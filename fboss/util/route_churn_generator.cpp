@@ -0,0 +1,519 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+
+#include <folly/Conv.h>
+#include <folly/Format.h>
+#include <folly/IPAddress.h>
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/AsyncSocket.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/logging/xlog.h>
+#include <thrift/lib/cpp2/async/HeaderClientChannel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+
+DEFINE_string(agent_host, "::1", "Host running the agent");
+DEFINE_int32(agent_port, 5909, "Thrift port of the agent");
+DEFINE_int32(thrift_timeout_ms, 600000, "Timeout of each thrift call");
+DEFINE_string(
+    pattern,
+    "full_sync",
+    "Churn pattern: full_sync (syncFib of the full table with some routes "
+    "changed), withdraw_storm (withdraw and re-add some routes) or "
+    "ecmp_churn (remove and restore one next hop of every ECMP group using "
+    "it)");
+DEFINE_string(
+    clients,
+    "0",
+    "Comma separated client ids, each churning its own routes concurrently "
+    "over its own connection");
+DEFINE_int32(vrfs, 1, "Number of VRFs, starting at 0, each client programs");
+DEFINE_int32(routes, 10000, "Routes per client per VRF");
+DEFINE_int32(
+    batch_size,
+    1000,
+    "Routes per addUnicastRoutes/deleteUnicastRoutes call");
+DEFINE_int32(iterations, 10, "Number of churn iterations");
+DEFINE_int32(
+    churn_percent,
+    10,
+    "Percent of the routes changed (full_sync) or withdrawn (withdraw_storm) "
+    "in each iteration");
+DEFINE_int32(ecmp_width, 4, "Next hops per route");
+DEFINE_int32(next_hops, 64, "Size of the pool of next hops routes use");
+DEFINE_string(
+    next_hop_base_v6,
+    "2401:db00:e000::1",
+    "First next hop of IPv6 routes, use an interface subnet of the agent "
+    "to have the routes resolve");
+DEFINE_string(
+    next_hop_base_v4,
+    "172.16.0.1",
+    "First next hop of IPv4 routes, use an interface subnet of the agent "
+    "to have the routes resolve");
+DEFINE_bool(ipv4, false, "Churn IPv4 /24s rather than IPv6 /64s");
+DEFINE_bool(
+    agent_stats,
+    true,
+    "Correlate each call with the state update counters of the agent");
+DEFINE_bool(cleanup, true, "Delete all the routes when done");
+DEFINE_int64(seed, 0, "Seed of the choice of routes and next hops to churn");
+
+using namespace facebook::fboss;
+using namespace apache::thrift;
+using facebook::network::toBinaryAddress;
+
+/*
+ * Route churn load generator.
+ *
+ * Drives addUnicastRoutes, deleteUnicastRoutes and syncFib (in their VRF
+ * flavors) against a running agent, e.g. one built with FakeSai on the same
+ * Linux host, and reports latency percentiles of each kind of call.  Every
+ * call is timed on the client, and, with --agent_stats, correlated with the
+ * time the agent spent in SwSwitch state updates while serving it, read from
+ * the state_update.time_us counters before and after the call.  The
+ * difference between the two is the time spent outside of state updates:
+ * thrift, (de)serialization, RIB processing and waiting for the update
+ * thread.
+ *
+ * Each client id in --clients runs in its own thread with its own
+ * connection.  Concurrent clients share the state update thread of the
+ * agent, so the agent time of a call then includes updates made on behalf
+ * of other clients.
+ */
+namespace {
+
+enum class Op { INITIAL_SYNC, SYNC, ADD, DELETE };
+
+const char* opName(Op op) {
+  switch (op) {
+    case Op::INITIAL_SYNC:
+      return "initial_sync";
+    case Op::SYNC:
+      return "sync";
+    case Op::ADD:
+      return "add";
+    case Op::DELETE:
+      return "delete";
+  }
+  return "unknown";
+}
+
+struct Sample {
+  size_t routes{0};
+  int64_t clientUs{0};
+  // Time spent in and number of state updates during the call
+  int64_t agentUs{0};
+  int64_t agentUpdates{0};
+};
+
+class LatencyStats {
+ public:
+  void add(Op op, const Sample& sample) {
+    std::lock_guard<std::mutex> g(lock_);
+    samples_[op].push_back(sample);
+  }
+
+  void report(std::ostream& os) const;
+
+ private:
+  mutable std::mutex lock_;
+  std::map<Op, std::vector<Sample>> samples_;
+};
+
+// Nearest rank percentile of sorted values
+int64_t percentile(const std::vector<int64_t>& values, double pct) {
+  if (values.empty()) {
+    return 0;
+  }
+  auto rank = static_cast<size_t>(std::ceil(pct / 100 * values.size()));
+  return values[std::max(rank, size_t(1)) - 1];
+}
+
+void LatencyStats::report(std::ostream& os) const {
+  std::lock_guard<std::mutex> g(lock_);
+  os << folly::sformat(
+            "{:<14}{:>8}{:>10}  {:>10}{:>10}{:>10}{:>10}  {:>10}{:>10}{:>10}"
+            "{:>10}",
+            "op",
+            "calls",
+            "routes",
+            "p50 us",
+            "p99 us",
+            "p999 us",
+            "max us",
+            "agent p50",
+            "agent p99",
+            "agent p999",
+            "updates")
+     << std::endl;
+  for (const auto& [op, samples] : samples_) {
+    std::vector<int64_t> client;
+    std::vector<int64_t> agent;
+    size_t routes = 0;
+    int64_t updates = 0;
+    for (const auto& sample : samples) {
+      client.push_back(sample.clientUs);
+      agent.push_back(sample.agentUs);
+      routes += sample.routes;
+      updates += sample.agentUpdates;
+    }
+    std::sort(client.begin(), client.end());
+    std::sort(agent.begin(), agent.end());
+    os << folly::sformat(
+              "{:<14}{:>8}{:>10}  {:>10}{:>10}{:>10}{:>10}  {:>10}{:>10}{:>10}"
+              "{:>10}",
+              opName(op),
+              samples.size(),
+              routes,
+              percentile(client, 50),
+              percentile(client, 99),
+              percentile(client, 99.9),
+              client.back(),
+              percentile(agent, 50),
+              percentile(agent, 99),
+              percentile(agent, 99.9),
+              updates)
+       << std::endl;
+  }
+}
+
+struct AgentCounters {
+  int64_t stateUpdateUs{0};
+  int64_t stateUpdates{0};
+};
+
+AgentCounters readAgentCounters(FbossCtrlAsyncClient* client) {
+  static const std::vector<std::string> kCounters = {
+      "state_update.time_us.sum", "state_update.time_us.count"};
+  // Publish the thread local stats, or the counters lag by up to a second
+  client->sync_flushCountersNow();
+  std::map<std::string, int64_t> counters;
+  client->sync_getSelectedCounters(counters, kCounters);
+  AgentCounters agentCounters;
+  agentCounters.stateUpdateUs = counters[kCounters[0]];
+  agentCounters.stateUpdates = counters[kCounters[1]];
+  return agentCounters;
+}
+
+std::unique_ptr<FbossCtrlAsyncClient> agentClient(folly::EventBase* evb) {
+  folly::SocketAddress agent(FLAGS_agent_host, FLAGS_agent_port);
+  auto socket = folly::AsyncSocket::newSocket(evb, agent);
+  auto chan = HeaderClientChannel::newChannel(std::move(socket));
+  chan->setTimeout(FLAGS_thrift_timeout_ms);
+  return std::make_unique<FbossCtrlAsyncClient>(std::move(chan));
+}
+
+folly::IPAddress nthNextHop(int n) {
+  if (FLAGS_ipv4) {
+    auto base = folly::IPAddressV4(FLAGS_next_hop_base_v4);
+    return folly::IPAddressV4::fromLongHBO(base.toLongHBO() + n);
+  }
+  auto bytes = folly::IPAddressV6(FLAGS_next_hop_base_v6).toByteArray();
+  uint32_t low = 0;
+  for (int i = 12; i < 16; ++i) {
+    low = (low << 8) | bytes[i];
+  }
+  low += n;
+  for (int i = 15; i >= 12; --i) {
+    bytes[i] = low & 0xff;
+    low >>= 8;
+  }
+  return folly::IPAddressV6(bytes);
+}
+
+std::vector<NextHopThrift> nextHopPool() {
+  std::vector<NextHopThrift> nextHops;
+  for (int i = 0; i < FLAGS_next_hops; ++i) {
+    NextHopThrift nhop;
+    nhop.address_ref() = toBinaryAddress(nthNextHop(i));
+    nextHops.push_back(std::move(nhop));
+  }
+  return nextHops;
+}
+
+/*
+ * Churns the routes of one client in all VRFs.  Routes of different clients
+ * have distinct prefixes.  Route r of a table uses --ecmp_width consecutive
+ * next hops of the pool, starting at an offset that moves whenever the route
+ * is changed.
+ */
+class RouteChurner {
+ public:
+  RouteChurner(int16_t clientId, int clientIndex, LatencyStats* stats)
+      : clientId_(clientId),
+        clientIndex_(clientIndex),
+        stats_(stats),
+        rng_(FLAGS_seed + clientIndex) {
+    for (int vrf = 0; vrf < FLAGS_vrfs; ++vrf) {
+      generations_.emplace_back(FLAGS_routes, 0);
+    }
+  }
+
+  void run();
+
+ private:
+  using RouteIds = std::vector<int>;
+
+  IpPrefix prefix(int route) const;
+  UnicastRoute route(int vrf, int route, int withoutNextHop = -1) const;
+  RouteIds pickRoutes();
+
+  void fullSync();
+  void withdrawStorm();
+  void ecmpChurn();
+
+  void sync(Op op, int vrf);
+  // Add routes in batches of --batch_size
+  void add(int vrf, const RouteIds& routes, int withoutNextHop = -1);
+  void del(int vrf, const RouteIds& routes);
+
+  template <typename Fn>
+  void timed(Op op, size_t routes, Fn&& fn);
+
+  const int16_t clientId_;
+  const int clientIndex_;
+  LatencyStats* stats_;
+  folly::EventBase evb_;
+  std::unique_ptr<FbossCtrlAsyncClient> client_{agentClient(&evb_)};
+  std::mt19937 rng_;
+  const std::vector<NextHopThrift> nextHops_{nextHopPool()};
+  // Per VRF, the number of times each route was changed
+  std::vector<std::vector<int>> generations_;
+};
+
+IpPrefix RouteChurner::prefix(int route) const {
+  IpPrefix pfx;
+  if (FLAGS_ipv4) {
+    // 16.0.0.0/8 and up, one /8 per client
+    auto addr = folly::IPAddressV4::fromLongHBO(
+        ((16u + clientIndex_) << 24) + (static_cast<uint32_t>(route) << 8));
+    pfx.ip_ref() = toBinaryAddress(addr);
+    pfx.prefixLength_ref() = 24;
+  } else {
+    // 2401:db<client>:<route>::/64
+    folly::ByteArray16 bytes{};
+    bytes[0] = 0x24;
+    bytes[1] = 0x01;
+    bytes[2] = 0xdb;
+    bytes[3] = clientIndex_;
+    for (int i = 0; i < 4; ++i) {
+      bytes[7 - i] = (route >> (8 * i)) & 0xff;
+    }
+    pfx.ip_ref() = toBinaryAddress(folly::IPAddressV6(bytes));
+    pfx.prefixLength_ref() = 64;
+  }
+  return pfx;
+}
+
+UnicastRoute RouteChurner::route(int vrf, int route, int withoutNextHop)
+    const {
+  UnicastRoute unicastRoute;
+  unicastRoute.dest_ref() = prefix(route);
+  auto offset = route + generations_[vrf][route];
+  for (int i = 0; i < FLAGS_ecmp_width; ++i) {
+    auto nextHop = (offset + i) % FLAGS_next_hops;
+    if (nextHop != withoutNextHop) {
+      unicastRoute.nextHops_ref()->push_back(nextHops_[nextHop]);
+    }
+  }
+  return unicastRoute;
+}
+
+RouteChurner::RouteIds RouteChurner::pickRoutes() {
+  RouteIds routes(FLAGS_routes);
+  std::iota(routes.begin(), routes.end(), 0);
+  std::shuffle(routes.begin(), routes.end(), rng_);
+  routes.resize(std::max(FLAGS_routes * FLAGS_churn_percent / 100, 1));
+  std::sort(routes.begin(), routes.end());
+  return routes;
+}
+
+template <typename Fn>
+void RouteChurner::timed(Op op, size_t routes, Fn&& fn) {
+  AgentCounters before;
+  if (FLAGS_agent_stats) {
+    before = readAgentCounters(client_.get());
+  }
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto end = std::chrono::steady_clock::now();
+  Sample sample;
+  sample.routes = routes;
+  sample.clientUs =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count();
+  if (FLAGS_agent_stats) {
+    auto after = readAgentCounters(client_.get());
+    sample.agentUs = after.stateUpdateUs - before.stateUpdateUs;
+    sample.agentUpdates = after.stateUpdates - before.stateUpdates;
+  }
+  stats_->add(op, sample);
+}
+
+void RouteChurner::sync(Op op, int vrf) {
+  std::vector<UnicastRoute> routes;
+  routes.reserve(FLAGS_routes);
+  for (int r = 0; r < FLAGS_routes; ++r) {
+    routes.push_back(route(vrf, r));
+  }
+  timed(op, routes.size(), [&] {
+    client_->sync_syncFibInVrf(clientId_, routes, vrf);
+  });
+}
+
+void RouteChurner::add(int vrf, const RouteIds& routes, int withoutNextHop) {
+  for (size_t start = 0; start < routes.size(); start += FLAGS_batch_size) {
+    auto end = std::min(start + FLAGS_batch_size, routes.size());
+    std::vector<UnicastRoute> batch;
+    batch.reserve(end - start);
+    for (auto i = start; i < end; ++i) {
+      batch.push_back(route(vrf, routes[i], withoutNextHop));
+    }
+    timed(Op::ADD, batch.size(), [&] {
+      client_->sync_addUnicastRoutesInVrf(clientId_, batch, vrf);
+    });
+  }
+}
+
+void RouteChurner::del(int vrf, const RouteIds& routes) {
+  for (size_t start = 0; start < routes.size(); start += FLAGS_batch_size) {
+    auto end = std::min(start + FLAGS_batch_size, routes.size());
+    std::vector<IpPrefix> batch;
+    batch.reserve(end - start);
+    for (auto i = start; i < end; ++i) {
+      batch.push_back(prefix(routes[i]));
+    }
+    timed(Op::DELETE, batch.size(), [&] {
+      client_->sync_deleteUnicastRoutesInVrf(clientId_, batch, vrf);
+    });
+  }
+}
+
+void RouteChurner::fullSync() {
+  for (int vrf = 0; vrf < FLAGS_vrfs; ++vrf) {
+    for (auto r : pickRoutes()) {
+      ++generations_[vrf][r];
+    }
+    sync(Op::SYNC, vrf);
+  }
+}
+
+void RouteChurner::withdrawStorm() {
+  for (int vrf = 0; vrf < FLAGS_vrfs; ++vrf) {
+    auto routes = pickRoutes();
+    del(vrf, routes);
+    add(vrf, routes);
+  }
+}
+
+void RouteChurner::ecmpChurn() {
+  int nextHop = folly::Random::rand32(FLAGS_next_hops, rng_);
+  for (int vrf = 0; vrf < FLAGS_vrfs; ++vrf) {
+    // Routes whose ECMP group has the next hop
+    RouteIds routes;
+    for (int r = 0; r < FLAGS_routes; ++r) {
+      auto offset = (r + generations_[vrf][r]) % FLAGS_next_hops;
+      if ((nextHop + FLAGS_next_hops - offset) % FLAGS_next_hops <
+          FLAGS_ecmp_width) {
+        routes.push_back(r);
+      }
+    }
+    add(vrf, routes, nextHop);
+    add(vrf, routes);
+  }
+}
+
+void RouteChurner::run() {
+  for (int vrf = 0; vrf < FLAGS_vrfs; ++vrf) {
+    sync(Op::INITIAL_SYNC, vrf);
+  }
+  for (int i = 0; i < FLAGS_iterations; ++i) {
+    if (FLAGS_pattern == "full_sync") {
+      fullSync();
+    } else if (FLAGS_pattern == "withdraw_storm") {
+      withdrawStorm();
+    } else {
+      ecmpChurn();
+    }
+    XLOG(DBG2) << "Client " << clientId_ << " done with iteration " << i;
+  }
+  if (FLAGS_cleanup) {
+    for (int vrf = 0; vrf < FLAGS_vrfs; ++vrf) {
+      client_->sync_syncFibInVrf(clientId_, {}, vrf);
+    }
+  }
+}
+
+void checkFlags() {
+  if (FLAGS_pattern != "full_sync" && FLAGS_pattern != "withdraw_storm" &&
+      FLAGS_pattern != "ecmp_churn") {
+    throw FbossError("Unknown churn pattern: ", FLAGS_pattern);
+  }
+  if (FLAGS_routes <= 0 || FLAGS_batch_size <= 0 || FLAGS_vrfs <= 0) {
+    throw FbossError("--routes, --batch_size and --vrfs must be positive");
+  }
+  if (FLAGS_ecmp_width <= 0 || FLAGS_ecmp_width > FLAGS_next_hops) {
+    throw FbossError("--ecmp_width must be between 1 and --next_hops");
+  }
+  if (FLAGS_ipv4 && FLAGS_routes > (1 << 16)) {
+    throw FbossError("At most 65536 IPv4 routes per client");
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  checkFlags();
+
+  std::vector<int16_t> clientIds;
+  folly::splitTo<int16_t>(
+      ',', FLAGS_clients, std::back_inserter(clientIds), true);
+  // Prefixes of each client are in their own /8 or /32
+  if (clientIds.empty() || clientIds.size() > (FLAGS_ipv4 ? 200 : 256)) {
+    throw FbossError("Between 1 and 256 (200 for IPv4) clients supported");
+  }
+  LatencyStats stats;
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < clientIds.size(); ++i) {
+    threads.emplace_back([clientId = clientIds[i], i, &stats] {
+      RouteChurner(clientId, i, &stats).run();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << FLAGS_pattern << ": " << clientIds.size() << " clients, "
+            << FLAGS_vrfs << " vrfs, " << FLAGS_routes
+            << " routes per client per vrf, took " << duration.count() << "ms"
+            << std::endl;
+  stats.report(std::cout);
+  return 0;
+}